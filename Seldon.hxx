@@ -72,14 +72,22 @@ namespace Seldon
 #include "matrix/Matrix_HermPacked.cxx"
 #include "matrix/Matrix_TriangPacked.cxx"
 #include "vector/Vector.cxx"
+#include "vector/VectorExpression.cxx"
 #include "vector/VectorCollection.cxx"
 #include "vector/Functions_Arrays.cxx"
 #include "vector/SparseVector.cxx"
+#include "matrix_sparse/Matrix_SellSparse.cxx"
+#include "matrix_sparse/Matrix_BlockSparse.cxx"
+#include "matrix_sparse/Matrix_LongSparse.cxx"
 #include "matrix/Functions.cxx"
 #include "matrix_sparse/Matrix_Conversions.cxx"
+#include "matrix_sparse/SparseAssembler.cxx"
 #include "computation/basic_functions/Functions_Matrix.cxx"
 #include "computation/basic_functions/Functions_Vector.cxx"
 #include "computation/basic_functions/Functions_MatVect.cxx"
+#include "vector/TinyVector.cxx"
+#include "matrix/TinyMatrix.cxx"
+#include "array3d/Functions_Array3D.cxx"
 
 #include "matrix/SubMatrix_Base.cxx"
 #include "matrix/SubMatrix.cxx"
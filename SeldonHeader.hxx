@@ -21,6 +21,7 @@
 
 #include <iostream>
 #include <algorithm>
+#include <utility>
 #include <vector>
 #include <complex>
 #include <cstring>
@@ -104,6 +105,16 @@ extern "C"
 #endif
 #endif
 
+// Move constructors and move assignments are defined if the compiler
+// supports C++11, unless 'SELDON_WITHOUT_CXX11' is defined.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#ifndef SELDON_WITHOUT_CXX11
+#ifndef SELDON_WITH_CXX11
+#define SELDON_WITH_CXX11
+#endif
+#endif
+#endif
+
 // Convenient macros to catch exceptions.
 #ifndef TRY
 #define TRY try {
@@ -205,6 +216,10 @@ namespace Seldon
   template <class T, class Allocator>
   class Vector<T, Collection, Allocator>;
 
+  // Expression on full vectors.
+  template <class E>
+  class VectorExpression;
+
   // Matrix class - specialized for each used type.
   template <class T, class Prop = General,
 	    class Storage = RowMajor,
@@ -275,6 +290,22 @@ namespace Seldon
   template <class T, class Prop, class Allocator>
   class Matrix<T, Prop, RowSymComplexSparse, Allocator>;
 
+  // column-major sparse matrix with 64-bit start indices.
+  template <class T, class Prop, class Allocator>
+  class Matrix<T, Prop, ColLongSparse, Allocator>;
+
+  // row-major sparse matrix with 64-bit start indices.
+  template <class T, class Prop, class Allocator>
+  class Matrix<T, Prop, RowLongSparse, Allocator>;
+
+  // row-major sparse matrix in SELL-C-sigma format.
+  template <class T, class Prop, class Allocator>
+  class Matrix<T, Prop, RowSellSparse, Allocator>;
+
+  // row-major block sparse matrix.
+  template <class T, class Prop, int B, class Allocator>
+  class Matrix<T, Prop, RowBlockSparse<B>, Allocator>;
+
   // column-major sparse matrix.
   template <class T, class Prop, class Allocator>
   class Matrix<T, Prop, ArrayColSparse, Allocator>;
@@ -321,6 +352,9 @@ namespace Seldon
 #include "matrix/Matrix_Triangular.hxx"
 #include "matrix/Matrix_Symmetric.hxx"
 #include "matrix/Matrix_Hermitian.hxx"
+#include "vector/Vector.hxx"
+#include "vector/VectorExpression.hxx"
+#include "vector/SparseVector.hxx"
 #include "matrix_sparse/Matrix_Sparse.hxx"
 #include "matrix_sparse/Matrix_ComplexSparse.hxx"
 #include "matrix_sparse/Matrix_SymSparse.hxx"
@@ -328,13 +362,18 @@ namespace Seldon
 #include "matrix/Matrix_SymPacked.hxx"
 #include "matrix/Matrix_HermPacked.hxx"
 #include "matrix/Matrix_TriangPacked.hxx"
-#include "vector/Vector.hxx"
-#include "vector/SparseVector.hxx"
+#include "matrix_sparse/Matrix_SellSparse.hxx"
+#include "matrix_sparse/Matrix_BlockSparse.hxx"
+#include "matrix_sparse/Matrix_LongSparse.hxx"
 #include "matrix/Functions.hxx"
 #include "matrix_sparse/Matrix_Conversions.hxx"
+#include "matrix_sparse/SparseAssembler.hxx"
 #include "computation/basic_functions/Functions_Matrix.hxx"
 #include "computation/basic_functions/Functions_Vector.hxx"
 #include "computation/basic_functions/Functions_MatVect.hxx"
+#include "vector/TinyVector.hxx"
+#include "matrix/TinyMatrix.hxx"
+#include "array3d/Functions_Array3D.hxx"
 
 #include "matrix/SubMatrix_Base.hxx"
 #include "matrix/SubMatrix.hxx"
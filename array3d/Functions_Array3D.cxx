@@ -0,0 +1,653 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_FUNCTIONS_ARRAY3D_CXX
+
+#include "Functions_Array3D.hxx"
+
+
+namespace Seldon
+{
+
+
+  /////////////////////
+  // BATCHED KERNELS //
+
+
+  //! Interleaves a group of consecutive arrays.
+  /*!
+    The entry k of the array g is copied into buf[k * SELDON_BATCH_SIZE + g].
+    \param[in] count number of arrays, at most SELDON_BATCH_SIZE.
+    \param[in] size length of each array.
+    \param[in] x the \a count arrays, stored one after the other.
+    \param[out] buf interleaved arrays.
+  */
+  template <class T0, class T1>
+  void GatherBatch(int count, int size, const T0* x, T1* buf)
+  {
+    const int nb = SELDON_BATCH_SIZE;
+    for (int k = 0; k < size; k++)
+      for (int g = 0; g < count; g++)
+        buf[long(k) * nb + g] = x[long(g) * size + k];
+  }
+
+
+  //! Copies interleaved arrays back into consecutive arrays.
+  /*!
+    This is the reverse operation of GatherBatch.
+    \param[in] count number of arrays, at most SELDON_BATCH_SIZE.
+    \param[in] size length of each array.
+    \param[in] buf interleaved arrays.
+    \param[out] x the \a count arrays, stored one after the other.
+  */
+  template <class T0, class T1>
+  void ScatterBatch(int count, int size, const T0* buf, T1* x)
+  {
+    const int nb = SELDON_BATCH_SIZE;
+    for (int g = 0; g < count; g++)
+      for (int k = 0; k < size; k++)
+        x[long(g) * size + k] = buf[long(k) * nb + g];
+  }
+
+
+  //! Sets the unused slices of an interleaved group to the identity.
+  /*!
+    The last group of a 3D array may contain fewer than SELDON_BATCH_SIZE
+    slices. The kernels still process the whole group, so that the other
+    slices are set to the identity to avoid divisions by zero.
+    \param[in] count number of slices actually used.
+    \param[in] n number of rows and columns of the slices.
+    \param[in,out] buf interleaved slices.
+  */
+  template <class T>
+  void FillIdentityBatch(int count, int n, T* buf)
+  {
+    const int nb = SELDON_BATCH_SIZE;
+    for (int g = count; g < nb; g++)
+      for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+          buf[long(i * n + j) * nb + g] = (i == j) ? T(1) : T(0);
+  }
+
+
+  //! Multiplies interleaved matrices.
+  /*!
+    It performs \f$ c = \alpha a b + \beta c \f$ on the SELDON_BATCH_SIZE
+    matrices of a group, interleaved by GatherBatch. The innermost loops run
+    over the matrices of the group.
+    \param[in] alpha scalar.
+    \param[in] m number of rows of \a a and \a c.
+    \param[in] n number of columns of \a b and \a c.
+    \param[in] k number of columns of \a a and rows of \a b.
+    \param[in] a interleaved row-major m x k matrices.
+    \param[in] b interleaved row-major k x n matrices.
+    \param[in] beta scalar. If it is zero, \a c is not read.
+    \param[in,out] c interleaved row-major m x n matrices.
+  */
+  template <class T0, class T1, class T2, class T3, class T4>
+  void MltAddBatchKernel(const T0& alpha, int m, int n, int k, const T1* a,
+                         const T2* b, const T3& beta, T4* c)
+  {
+    const int nb = SELDON_BATCH_SIZE;
+    int i, j, l, g;
+    T4 acc[nb];
+
+    for (i = 0; i < m; i++)
+      for (j = 0; j < n; j++)
+        {
+          for (g = 0; g < nb; g++)
+            acc[g] = T4(0);
+          for (l = 0; l < k; l++)
+            {
+              const T1* a_il = a + long(i * k + l) * nb;
+              const T2* b_lj = b + long(l * n + j) * nb;
+              for (g = 0; g < nb; g++)
+                acc[g] += a_il[g] * b_lj[g];
+            }
+
+          T4* c_ij = c + long(i * n + j) * nb;
+          if (beta == T3(0))
+            for (g = 0; g < nb; g++)
+              c_ij[g] = alpha * acc[g];
+          else
+            for (g = 0; g < nb; g++)
+              c_ij[g] = alpha * acc[g] + beta * c_ij[g];
+        }
+  }
+
+
+  //! LU factorization of interleaved matrices, with partial pivoting.
+  /*!
+    Each of the SELDON_BATCH_SIZE interleaved n x n matrices is seen as a
+    column-major matrix and factorized as in GetLUBlocked. Only the search
+    for the pivots and the row interchanges are performed matrix by matrix;
+    the scaling and the updates run over the matrices of the group.
+    \param[in] n number of rows and columns of the matrices.
+    \param[in,out] a on entry, the interleaved matrices; on exit, their LU
+    factorizations.
+    \param[out] ipiv interleaved pivot indices (starting from 1): the pivot
+    of the column k of the matrix g is ipiv[k * SELDON_BATCH_SIZE + g].
+  */
+  template <class T>
+  void GetLUBatchKernel(int n, T* a, int* ipiv)
+  {
+    const int nb = SELDON_BATCH_SIZE;
+    long lda = long(n) * nb;
+    int k, r, c, p, g;
+    int row[nb];
+    T pivot[nb];
+
+    for (k = 0; k < n; k++)
+      {
+        T* a_k = a + k * lda;
+
+        // Searches for the pivots of all matrices at once.
+        for (g = 0; g < nb; g++)
+          {
+            row[g] = k;
+            pivot[g] = a_k[k * nb + g];
+          }
+        for (r = k + 1; r < n; r++)
+          for (g = 0; g < nb; g++)
+            {
+              bool larger = abs(a_k[r * nb + g]) > abs(pivot[g]);
+              row[g] = larger ? r : row[g];
+              pivot[g] = larger ? a_k[r * nb + g] : pivot[g];
+            }
+
+        for (g = 0; g < nb; g++)
+          {
+            p = row[g];
+            ipiv[k * nb + g] = p + 1;
+            if (p != k)
+              for (c = 0; c < n; c++)
+                swap(a[c * lda + k * nb + g], a[c * lda + p * nb + g]);
+
+            // A zero pivot means that the rest of the column is zero, which
+            // is left unchanged.
+            if (pivot[g] == T(0))
+              pivot[g] = T(1);
+          }
+
+        for (r = k + 1; r < n; r++)
+          for (g = 0; g < nb; g++)
+            a_k[r * nb + g] /= pivot[g];
+
+        for (c = k + 1; c < n; c++)
+          {
+            T* a_c = a + c * lda;
+            for (r = k + 1; r < n; r++)
+              for (g = 0; g < nb; g++)
+                a_c[r * nb + g] -= a_k[r * nb + g] * a_c[k * nb + g];
+          }
+      }
+  }
+
+
+  //! Solves linear systems with interleaved LU factorizations.
+  /*!
+    The factorizations are those computed by GetLUBatchKernel, and the
+    systems are solved as in SolveLUBlocked, the innermost loops running
+    over the matrices of the group.
+    \param[in] TransA status of the matrices: SeldonNoTrans or SeldonTrans.
+    \param[in] n number of rows and columns of the matrices.
+    \param[in] a interleaved LU factorizations.
+    \param[in] ipiv interleaved pivot indices (starting from 1).
+    \param[in,out] b on entry, the interleaved right-hand sides; on exit,
+    the interleaved solutions.
+  */
+  template <class T0, class T1>
+  void SolveLUBatchKernel(const SeldonTranspose& TransA, int n, const T0* a,
+                          const int* ipiv, T1* b)
+  {
+    if (TransA.ConjTrans())
+      throw WrongArgument("SolveLU(TransA, A, P, Y)",
+                          "Complex conjugation not supported.");
+
+    const int nb = SELDON_BATCH_SIZE;
+    long lda = long(n) * nb;
+    int i, r, g, p;
+
+    if (TransA.NoTrans())
+      {
+        for (i = 0; i < n; i++)
+          for (g = 0; g < nb; g++)
+            {
+              p = ipiv[i * nb + g] - 1;
+              if (p != i)
+                swap(b[i * nb + g], b[p * nb + g]);
+            }
+
+        // Forward substitution with L, column by column.
+        for (i = 0; i < n; i++)
+          {
+            const T0* a_i = a + i * lda;
+            for (r = i + 1; r < n; r++)
+              for (g = 0; g < nb; g++)
+                b[r * nb + g] -= a_i[r * nb + g] * b[i * nb + g];
+          }
+
+        // Back substitution with U, column by column.
+        for (i = n - 1; i >= 0; i--)
+          {
+            const T0* a_i = a + i * lda;
+            for (g = 0; g < nb; g++)
+              b[i * nb + g] /= a_i[i * nb + g];
+            for (r = 0; r < i; r++)
+              for (g = 0; g < nb; g++)
+                b[r * nb + g] -= a_i[r * nb + g] * b[i * nb + g];
+          }
+      }
+    else
+      {
+        // Forward substitution with U^T.
+        for (i = 0; i < n; i++)
+          {
+            const T0* a_i = a + i * lda;
+            for (r = 0; r < i; r++)
+              for (g = 0; g < nb; g++)
+                b[i * nb + g] -= a_i[r * nb + g] * b[r * nb + g];
+            for (g = 0; g < nb; g++)
+              b[i * nb + g] /= a_i[i * nb + g];
+          }
+
+        // Back substitution with L^T.
+        for (i = n - 1; i >= 0; i--)
+          {
+            const T0* a_i = a + i * lda;
+            for (r = i + 1; r < n; r++)
+              for (g = 0; g < nb; g++)
+                b[i * nb + g] -= a_i[r * nb + g] * b[r * nb + g];
+          }
+
+        for (i = n - 1; i >= 0; i--)
+          for (g = 0; g < nb; g++)
+            {
+              p = ipiv[i * nb + g] - 1;
+              if (p != i)
+                swap(b[i * nb + g], b[p * nb + g]);
+            }
+      }
+  }
+
+
+  // BATCHED KERNELS //
+  /////////////////////
+
+
+  ////////////
+  // MLTADD //
+
+
+  //! Multiplies the slices of two 3D arrays.
+  /*!
+    It performs \f$ C_i = \alpha A_i B_i + \beta C_i \f$ for every slice
+    \f$ A_i = A(i, :, :) \f$. The slices are processed by groups of
+    SELDON_BATCH_SIZE, and the groups are split among the threads.
+    \param[in] alpha scalar.
+    \param[in] A 3D array whose slices are m x k matrices.
+    \param[in] B 3D array whose slices are k x n matrices.
+    \param[in] beta scalar.
+    \param[in,out] C 3D array whose slices are m x n matrices.
+  */
+  template <class T0, class T1, class Allocator1, class T2, class Allocator2,
+            class T3, class T4, class Allocator4>
+  void MltAdd(const T0& alpha, const Array3D<T1, Allocator1>& A,
+              const Array3D<T2, Allocator2>& B, const T3& beta,
+              Array3D<T4, Allocator4>& C)
+  {
+    int nb_slice = A.GetLength1();
+    int m = A.GetLength2();
+    int k = A.GetLength3();
+    int n = B.GetLength3();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (B.GetLength1() != nb_slice || C.GetLength1() != nb_slice
+        || B.GetLength2() != k || C.GetLength2() != m
+        || C.GetLength3() != n)
+      throw WrongDim("MltAdd(alpha, A, B, beta, C)",
+                     string("Operation A B + C -> C not permitted:")
+                     + string("\n     A (") + to_str(&A) + string(") is a ")
+                     + to_str(nb_slice) + " x " + to_str(m) + " x "
+                     + to_str(k) + string(" array;\n     B (")
+                     + to_str(&B) + string(") is a ")
+                     + to_str(B.GetLength1()) + " x "
+                     + to_str(B.GetLength2()) + " x "
+                     + to_str(B.GetLength3()) + string(" array;\n     C (")
+                     + to_str(&C) + string(") is a ")
+                     + to_str(C.GetLength1()) + " x "
+                     + to_str(C.GetLength2()) + " x "
+                     + to_str(C.GetLength3()) + " array.");
+#endif
+
+    if (nb_slice == 0 || m == 0 || n == 0)
+      return;
+
+    const int nb = SELDON_BATCH_SIZE;
+    int nb_group = (nb_slice + nb - 1) / nb;
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(nb_slice) * m * n * (k + 1));
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int group, group_begin, group_end, first, count;
+      GetThreadRange(nb_group, group_begin, group_end);
+
+      Vector<T1> a(long(m) * k * nb);
+      Vector<T2> b(long(k) * n * nb);
+      Vector<T4> c(long(m) * n * nb);
+      a.Zero();
+      b.Zero();
+      c.Zero();
+
+      for (group = group_begin; group < group_end; group++)
+        {
+          first = group * nb;
+          count = min(nb, nb_slice - first);
+          GatherBatch(count, m * k, A.GetData() + long(first) * m * k,
+                      a.GetData());
+          GatherBatch(count, k * n, B.GetData() + long(first) * k * n,
+                      b.GetData());
+          if (beta != T3(0))
+            GatherBatch(count, m * n, C.GetData() + long(first) * m * n,
+                        c.GetData());
+
+          MltAddBatchKernel(alpha, m, n, k, a.GetData(), b.GetData(), beta,
+                            c.GetData());
+
+          ScatterBatch(count, m * n, c.GetData(),
+                       C.GetData() + long(first) * m * n);
+        }
+    }
+  }
+
+
+  //! Multiplies the slices of two 3D arrays.
+  /*!
+    It performs \f$ C_i = A_i B_i \f$ for every slice \f$ A_i = A(i, :, :)
+    \f$.
+    \param[in] A 3D array whose slices are m x k matrices.
+    \param[in] B 3D array whose slices are k x n matrices.
+    \param[out] C 3D array whose slices are m x n matrices. It must have the
+    right dimensions.
+  */
+  template <class T1, class Allocator1, class T2, class Allocator2,
+            class T4, class Allocator4>
+  void Mlt(const Array3D<T1, Allocator1>& A,
+           const Array3D<T2, Allocator2>& B, Array3D<T4, Allocator4>& C)
+  {
+    MltAdd(T4(1), A, B, T4(0), C);
+  }
+
+
+  // MLTADD //
+  ////////////
+
+
+  ///////////
+  // GETLU //
+
+
+  //! Returns the LU factorizations of the slices of a 3D array.
+  /*!
+    Each slice \f$ A_i = A(i, :, :) \f$ is factorized in place, exactly as
+    the row-major matrix \f$ A_i \f$ by GetLU(A, P): its factors and pivots
+    may be used with SolveLU on a row-major matrix, and conversely. The
+    slices are processed by groups of SELDON_BATCH_SIZE, and the groups are
+    split among the threads.
+    \param[in,out] A on entry, the 3D array whose slices are the matrices to
+    be factorized; on exit, the LU factorizations.
+    \param[out] P pivot indices (starting from 1). The row i contains the
+    pivots of the slice i.
+  */
+  template <class T, class Allocator, class Allocator1>
+  void GetLU(Array3D<T, Allocator>& A,
+             Matrix<int, General, RowMajor, Allocator1>& P)
+  {
+    int nb_slice = A.GetLength1();
+    int n = A.GetLength2();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetLength3() != n)
+      throw WrongDim("GetLU(A, P)", "The slices must be squared.");
+#endif
+
+    P.Reallocate(nb_slice, n);
+    if (nb_slice == 0 || n == 0)
+      return;
+
+    const int nb = SELDON_BATCH_SIZE;
+    int nb_group = (nb_slice + nb - 1) / nb;
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(nb_slice) * n * n * n);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int group, group_begin, group_end, first, count;
+      GetThreadRange(nb_group, group_begin, group_end);
+
+      Vector<T> a(long(n) * n * nb);
+      Vector<int> ipiv(n * nb);
+
+      for (group = group_begin; group < group_end; group++)
+        {
+          first = group * nb;
+          count = min(nb, nb_slice - first);
+          GatherBatch(count, n * n, A.GetData() + long(first) * n * n,
+                      a.GetData());
+          FillIdentityBatch(count, n, a.GetData());
+
+          GetLUBatchKernel(n, a.GetData(), ipiv.GetData());
+
+          ScatterBatch(count, n * n, a.GetData(),
+                       A.GetData() + long(first) * n * n);
+          ScatterBatch(count, n, ipiv.GetData(),
+                       P.GetData() + long(first) * n);
+        }
+    }
+  }
+
+
+  //! Solves linear systems whose matrices are the slices of a 3D array.
+  /*!
+    It solves \f$ A_i X_i = Y_i \f$ for every slice \f$ A_i = A(i, :, :)
+    \f$, where \f$ Y_i \f$ is the row i of \a Y, and where the LU
+    factorizations of the slices have been computed by GetLU(A, P).
+    \param[in] A LU factorizations of the slices.
+    \param[in] P pivot indices (starting from 1), one row per slice.
+    \param[in,out] Y on entry, the right-hand sides, one row per slice; on
+    exit, the solutions.
+  */
+  template <class T0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const Array3D<T0, Allocator0>& A,
+               const Matrix<int, General, RowMajor, Allocator1>& P,
+               Matrix<T2, General, RowMajor, Allocator2>& Y)
+  {
+    SolveLU(SeldonNoTrans, A, P, Y);
+  }
+
+
+  //! Solves linear systems whose matrices are the slices of a 3D array.
+  /*!
+    It solves \f$ A_i X_i = Y_i \f$ or \f$ A_i^T X_i = Y_i \f$ for every
+    slice \f$ A_i = A(i, :, :) \f$, where \f$ Y_i \f$ is the row i of \a Y,
+    and where the LU factorizations of the slices have been computed by
+    GetLU(A, P).
+    \param[in] TransA status of the slices: SeldonNoTrans or SeldonTrans.
+    \param[in] A LU factorizations of the slices.
+    \param[in] P pivot indices (starting from 1), one row per slice.
+    \param[in,out] Y on entry, the right-hand sides, one row per slice; on
+    exit, the solutions.
+  */
+  template <class T0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const SeldonTranspose& TransA,
+               const Array3D<T0, Allocator0>& A,
+               const Matrix<int, General, RowMajor, Allocator1>& P,
+               Matrix<T2, General, RowMajor, Allocator2>& Y)
+  {
+    int nb_slice = A.GetLength1();
+    int n = A.GetLength2();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetLength3() != n || P.GetM() != nb_slice || P.GetN() != n
+        || Y.GetM() != nb_slice || Y.GetN() != n)
+      throw WrongDim("SolveLU(A, P, Y)",
+                     string("The array A is ") + to_str(nb_slice) + " x "
+                     + to_str(n) + " x " + to_str(A.GetLength3())
+                     + ", the pivots are " + to_str(P.GetM()) + " x "
+                     + to_str(P.GetN()) + " and the right-hand sides are "
+                     + to_str(Y.GetM()) + " x " + to_str(Y.GetN()) + ".");
+#endif
+
+    if (TransA.ConjTrans())
+      throw WrongArgument("SolveLU(TransA, A, P, Y)",
+                          "Complex conjugation not supported.");
+
+    if (nb_slice == 0 || n == 0)
+      return;
+
+    // As for a row-major matrix, the slices hold the factorizations of
+    // their transposes.
+    SeldonTranspose trans = SeldonNoTrans;
+    if (TransA.NoTrans())
+      trans = SeldonTrans;
+
+    const int nb = SELDON_BATCH_SIZE;
+    int nb_group = (nb_slice + nb - 1) / nb;
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(nb_slice) * n * n);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int group, group_begin, group_end, first, count, g, i;
+      GetThreadRange(nb_group, group_begin, group_end);
+
+      Vector<T0> a(long(n) * n * nb);
+      Vector<int> ipiv(n * nb);
+      Vector<T2> b(n * nb);
+      b.Zero();
+
+      for (group = group_begin; group < group_end; group++)
+        {
+          first = group * nb;
+          count = min(nb, nb_slice - first);
+          GatherBatch(count, n * n, A.GetData() + long(first) * n * n,
+                      a.GetData());
+          FillIdentityBatch(count, n, a.GetData());
+          GatherBatch(count, n, P.GetData() + long(first) * n,
+                      ipiv.GetData());
+          for (g = count; g < nb; g++)
+            for (i = 0; i < n; i++)
+              ipiv(i * nb + g) = i + 1;
+          GatherBatch(count, n, Y.GetData() + long(first) * n,
+                      b.GetData());
+
+          SolveLUBatchKernel(trans, n, a.GetData(), ipiv.GetData(),
+                             b.GetData());
+
+          ScatterBatch(count, n, b.GetData(),
+                       Y.GetData() + long(first) * n);
+        }
+    }
+  }
+
+
+  //! Replaces the slices of a 3D array by their inverses.
+  /*!
+    Each slice is factorized as by GetLU, then its inverse is computed
+    column by column. The slices are processed by groups of
+    SELDON_BATCH_SIZE, and the groups are split among the threads.
+    \param[in,out] A on entry, the 3D array whose slices are the matrices to
+    be inverted; on exit, their inverses.
+  */
+  template <class T, class Allocator>
+  void GetInverse(Array3D<T, Allocator>& A)
+  {
+    int nb_slice = A.GetLength1();
+    int n = A.GetLength2();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetLength3() != n)
+      throw WrongDim("GetInverse(A)", "The slices must be squared.");
+#endif
+
+    if (nb_slice == 0 || n == 0)
+      return;
+
+    const int nb = SELDON_BATCH_SIZE;
+    int nb_group = (nb_slice + nb - 1) / nb;
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(nb_slice) * n * n * n);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int group, group_begin, group_end, first, count, g, i, j;
+      GetThreadRange(nb_group, group_begin, group_end);
+
+      Vector<T> a(long(n) * n * nb), inv(long(n) * n * nb);
+      Vector<int> ipiv(n * nb);
+      Vector<T> b(n * nb);
+
+      for (group = group_begin; group < group_end; group++)
+        {
+          first = group * nb;
+          count = min(nb, nb_slice - first);
+          GatherBatch(count, n * n, A.GetData() + long(first) * n * n,
+                      a.GetData());
+          FillIdentityBatch(count, n, a.GetData());
+
+          // The slices are factorized as the transposes of the row-major
+          // matrices, so that the column j of the inverse is the solution
+          // of a transposed system with the column j of the identity.
+          GetLUBatchKernel(n, a.GetData(), ipiv.GetData());
+          for (j = 0; j < n; j++)
+            {
+              b.Zero();
+              for (g = 0; g < nb; g++)
+                b(j * nb + g) = T(1);
+
+              SolveLUBatchKernel(SeldonTrans, n, a.GetData(),
+                                 ipiv.GetData(), b.GetData());
+
+              for (i = 0; i < n; i++)
+                for (g = 0; g < nb; g++)
+                  inv(long(i * n + j) * nb + g) = b(i * nb + g);
+            }
+
+          ScatterBatch(count, n * n, inv.GetData(),
+                       A.GetData() + long(first) * n * n);
+        }
+    }
+  }
+
+
+  // GETLU //
+  ///////////
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_FUNCTIONS_ARRAY3D_CXX
+#endif
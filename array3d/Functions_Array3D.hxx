@@ -0,0 +1,105 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_FUNCTIONS_ARRAY3D_HXX
+
+/*
+  Functions defined in this file:
+
+  The slice i of a 3D array A is the row-major matrix A(i, :, :). The
+  functions below apply the same operation to all slices.
+
+  alpha A B + beta C -> C
+  MltAdd(alpha, A, B, beta, C)
+
+  A B -> C
+  Mlt(A, B, C)
+
+  LU factorization of the slices
+  GetLU(A, P)
+
+  solution of A(i, :, :) X = Y(i, :) for each slice
+  SolveLU(A, P, Y)
+  SolveLU(TransA, A, P, Y)
+
+  A(i, :, :)^-1 -> A(i, :, :)
+  GetInverse(A)
+*/
+
+// Number of slices processed together by the batched kernels. The slices of
+// a group are interleaved so that the innermost loops run over the slices,
+// which lets the compiler vectorize them whatever the size of the slices.
+#ifndef SELDON_BATCH_SIZE
+#define SELDON_BATCH_SIZE 8
+#endif
+
+namespace Seldon
+{
+
+
+  template <class T0, class T1>
+  void GatherBatch(int count, int size, const T0* x, T1* buf);
+  template <class T0, class T1>
+  void ScatterBatch(int count, int size, const T0* buf, T1* x);
+  template <class T>
+  void FillIdentityBatch(int count, int n, T* buf);
+
+  template <class T0, class T1, class T2, class T3, class T4>
+  void MltAddBatchKernel(const T0& alpha, int m, int n, int k, const T1* a,
+                         const T2* b, const T3& beta, T4* c);
+  template <class T>
+  void GetLUBatchKernel(int n, T* a, int* ipiv);
+  template <class T0, class T1>
+  void SolveLUBatchKernel(const SeldonTranspose& TransA, int n, const T0* a,
+                          const int* ipiv, T1* b);
+
+  template <class T0, class T1, class Allocator1, class T2, class Allocator2,
+            class T3, class T4, class Allocator4>
+  void MltAdd(const T0& alpha, const Array3D<T1, Allocator1>& A,
+              const Array3D<T2, Allocator2>& B, const T3& beta,
+              Array3D<T4, Allocator4>& C);
+  template <class T1, class Allocator1, class T2, class Allocator2,
+            class T4, class Allocator4>
+  void Mlt(const Array3D<T1, Allocator1>& A,
+           const Array3D<T2, Allocator2>& B, Array3D<T4, Allocator4>& C);
+
+  template <class T, class Allocator, class Allocator1>
+  void GetLU(Array3D<T, Allocator>& A,
+             Matrix<int, General, RowMajor, Allocator1>& P);
+  template <class T0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const Array3D<T0, Allocator0>& A,
+               const Matrix<int, General, RowMajor, Allocator1>& P,
+               Matrix<T2, General, RowMajor, Allocator2>& Y);
+  template <class T0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const SeldonTranspose& TransA,
+               const Array3D<T0, Allocator0>& A,
+               const Matrix<int, General, RowMajor, Allocator1>& P,
+               Matrix<T2, General, RowMajor, Allocator2>& Y);
+  template <class T, class Allocator>
+  void GetInverse(Array3D<T, Allocator>& A);
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_FUNCTIONS_ARRAY3D_HXX
+#endif
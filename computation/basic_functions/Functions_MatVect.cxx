@@ -40,6 +40,14 @@
   alpha M X + beta Y -> Y
   MltAdd(alpha, M, X, beta, Y)
 
+  M X -> Y and X.Y
+  MltDotProd(M, X, Y)
+  MltDotProdConj(M, X, Y)
+
+  M X -> Y and Z.Y
+  MltDotProd(Z, M, X, Y)
+  MltDotProdConj(Z, M, X, Y)
+
   Gauss(M, X)
 
   GaussSeidel(M, X, Y, iter)
@@ -48,6 +56,8 @@
 
   SolveLU(M, Y)
 
+  SolveLU(M, P, Y)
+
   Solve(M, Y)
 */
 
@@ -401,23 +411,39 @@ namespace Seldon
     CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
 #endif
 
-    Mlt(beta, Y);
-
     T4 zero(0);
-    T4 temp;
 
     int* ptr = M.GetPtr();
     int* ind = M.GetInd();
     typename Matrix<T1, Prop1, RowSparse, Allocator1>::pointer
       data = M.GetData();
 
-    for (int i = 0; i < ma; i++)
-      {
-	temp = zero;
-	for (int j = ptr[i]; j < ptr[i+1]; j++)
-	  temp += data[j] * X(ind[j]);
-	Y(i) += alpha * temp;
-      }
+    // The rows are split among the threads so that each thread processes
+    // about the same number of non-zero entries. Every row is computed
+    // exactly as in the sequential product.
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(ma) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, j, i_begin, i_end;
+      T4 temp;
+      GetThreadRange(ptr, ma, i_begin, i_end);
+
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp = zero;
+          for (j = ptr[i]; j < ptr[i + 1]; j++)
+            temp += data[j] * X(ind[j]);
+          if (beta == T3(0))
+            Y(i) = alpha * temp;
+          else
+            {
+              Y(i) *= beta;
+              Y(i) += alpha * temp;
+            }
+        }
+    }
   }
 
 
@@ -523,34 +549,12 @@ namespace Seldon
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    int ma = M.GetM();
-
 #ifdef SELDON_CHECK_DIMENSIONS
     CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
 #endif
 
-    Mlt(beta, Y);
-
-    int i, j;
-    T4 zero(0);
-    T4 temp;
-
-    int* ptr = M.GetPtr();
-    int* ind = M.GetInd();
-    typename Matrix<T1, Prop1, RowSymSparse, Allocator1>::pointer
-      data = M.GetData();
-
-    for (i = 0; i < ma; i++)
-      {
-	temp = zero;
-	for (j = ptr[i]; j < ptr[i + 1]; j++)
-	  temp += data[j] * X(ind[j]);
-	Y(i) += alpha * temp;
-      }
-    for (i = 0; i < ma-1; i++)
-      for (j = ptr[i]; j < ptr[i + 1]; j++)
-	if (ind[j] != i)
-	  Y(ind[j]) += alpha * data[j] * X(i);
+    MltSymAdd(alpha, M.GetM(), M.GetPtr(), M.GetInd(), M.GetData(),
+              X, beta, Y);
   }
 
 
@@ -696,6 +700,244 @@ namespace Seldon
   }
 
 
+  /*** Sparse matrices, scattered products ***/
+
+
+  /*! \brief Performs the product of a transposed compressed sparse matrix
+    with a vector, and adds the result to another vector. */
+  /*! It performs the operation \f$ Y = \alpha B^T X + \beta Y \f$ where \f$
+    B \f$ is a \f$ m \times n \f$ matrix stored in compressed rows. This is
+    the product of a transposed 'RowSparse' matrix or of a 'ColSparse'
+    matrix. The contributions of each row are scattered into \a Y. When
+    several threads are used, each thread scatters the contributions of a
+    block of rows into its own buffer, which only spans the columns touched by
+    these rows, so that no write conflicts occur. The buffers are then
+    summed, for each entry of \a Y, in the order of the threads: for a given
+    number of threads, the result does not depend on the scheduling.
+    \param[in] alpha scalar.
+    \param[in] m number of compressed rows.
+    \param[in] n number of columns, i.e., length of \a Y.
+    \param[in] ptr start indices of the rows (of length \a m + 1), stored
+    as 'int' or 'long' integers.
+    \param[in] ind column indices of the non-zero entries.
+    \param[in] data values of the non-zero entries.
+    \param[in] X vector of length \a m.
+    \param[in] beta scalar.
+    \param[in,out] Y vector of length \a n, result of the product of \a B^T
+    by \a X, times \a alpha, plus \a Y (on entry) times \a beta.
+  */
+  template <class T0, class Tint, class T1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltScatterAdd(const T0 alpha, int m, int n,
+                     const Tint* ptr, const int* ind, const T1* data,
+                     const Vector<T2, Storage2, Allocator2>& X,
+                     const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    int nb_thread = GetNumberThreads(long(m) + ptr[m]);
+
+    if (nb_thread == 1)
+      {
+        Mlt(beta, Y);
+        for (int i = 0; i < m; i++)
+          for (Tint k = ptr[i]; k < ptr[i + 1]; k++)
+            Y(ind[k]) += alpha * data[k] * X(i);
+        return;
+      }
+
+    T4 zero(0);
+    vector<Vector<T4> > buffer(nb_thread);
+    // Range of columns [first(t), last(t)) covered by the buffer of thread
+    // 't'. It remains empty for the threads that do not run.
+    Vector<int> first(nb_thread), last(nb_thread);
+    first.Zero();
+    last.Zero();
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread)
+#endif
+    {
+      int i, j, t, i_begin, i_end, j_begin, j_end;
+      Tint k;
+      int col_min = n, col_max = -1;
+      int thread = GetThreadNumber();
+      T2 x;
+      T4 temp;
+
+      GetThreadRange(ptr, m, i_begin, i_end);
+      for (k = ptr[i_begin]; k < ptr[i_end]; k++)
+        {
+          col_min = min(col_min, ind[k]);
+          col_max = max(col_max, ind[k]);
+        }
+      if (col_max >= col_min)
+        {
+          first(thread) = col_min;
+          last(thread) = col_max + 1;
+        }
+
+      Vector<T4>& Z = buffer[thread];
+      Z.Reallocate(last(thread) - first(thread));
+      Z.Fill(zero);
+      for (i = i_begin; i < i_end; i++)
+        {
+          x = X(i);
+          for (k = ptr[i]; k < ptr[i + 1]; k++)
+            Z(ind[k] - col_min) += data[k] * x;
+        }
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp barrier
+#endif
+
+      GetThreadRange(n, j_begin, j_end);
+      for (j = j_begin; j < j_end; j++)
+        {
+          temp = zero;
+          for (t = 0; t < nb_thread; t++)
+            if (j >= first(t) && j < last(t))
+              temp += buffer[t](j - first(t));
+          if (beta == T3(0))
+            Y(j) = alpha * temp;
+          else
+            {
+              Y(j) *= beta;
+              Y(j) += alpha * temp;
+            }
+        }
+    }
+  }
+
+
+  /*! \brief Performs the product of a symmetric sparse matrix, of which
+    only one triangular part is stored, with a vector, and adds the result to
+    another vector. */
+  /*! It performs the operation \f$ Y = \alpha A X + \beta Y \f$ where \f$ A
+    \f$ is a symmetric \f$ m \times m \f$ matrix. One triangular part of \f$
+    A \f$ is given in compressed rows: the upper part of a 'RowSymSparse'
+    matrix, or the lower part for a 'ColSymSparse' matrix. The matrix is read
+    only once: each stored entry \f$ a_{ij} \f$ contributes to \f$ Y_i \f$
+    and, if \f$ i \neq j \f$, to \f$ Y_j \f$. When several threads are
+    used, each thread processes a block of rows and accumulates all its
+    contributions into its own buffer, which spans the rows of the block and
+    the columns they touch. The buffers are then summed, for each entry of \a
+    Y, in the order of the threads: for a given number of threads, the result
+    does not depend on the scheduling.
+    \param[in] alpha scalar.
+    \param[in] m number of rows (and columns) of \f$ A \f$.
+    \param[in] ptr start indices of the rows (of length \a m + 1).
+    \param[in] ind column indices of the non-zero entries.
+    \param[in] data values of the non-zero entries.
+    \param[in] X vector of length \a m.
+    \param[in] beta scalar.
+    \param[in,out] Y vector of length \a m, result of the product of \a A by
+    \a X, times \a alpha, plus \a Y (on entry) times \a beta.
+  */
+  template <class T0, class T1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltSymAdd(const T0 alpha, int m,
+                 const int* ptr, const int* ind, const T1* data,
+                 const Vector<T2, Storage2, Allocator2>& X,
+                 const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    T4 zero(0);
+
+    // Off-diagonal entries are used twice.
+    int nb_thread = GetNumberThreads(long(m) + 2 * long(ptr[m]));
+
+    if (nb_thread == 1)
+      {
+        int i, j;
+        T2 x;
+        T4 temp;
+
+        Mlt(beta, Y);
+        for (i = 0; i < m; i++)
+          {
+            temp = zero;
+            x = X(i);
+            for (j = ptr[i]; j < ptr[i + 1]; j++)
+              {
+                temp += data[j] * X(ind[j]);
+                if (ind[j] != i)
+                  Y(ind[j]) += alpha * data[j] * x;
+              }
+            Y(i) += alpha * temp;
+          }
+        return;
+      }
+
+    vector<Vector<T4> > buffer(nb_thread);
+    // Range of rows [first(t), last(t)) covered by the buffer of thread 't'.
+    // It remains empty for the threads that do not run.
+    Vector<int> first(nb_thread), last(nb_thread);
+    first.Zero();
+    last.Zero();
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread)
+#endif
+    {
+      int i, j, t, i_begin, i_end, j_begin, j_end;
+      int thread = GetThreadNumber();
+      T2 x;
+      T4 temp;
+
+      GetThreadRange(ptr, m, i_begin, i_end);
+      int row_min = i_begin, row_max = i_end - 1;
+      for (j = ptr[i_begin]; j < ptr[i_end]; j++)
+        {
+          row_min = min(row_min, ind[j]);
+          row_max = max(row_max, ind[j]);
+        }
+      if (row_max >= row_min)
+        {
+          first(thread) = row_min;
+          last(thread) = row_max + 1;
+        }
+
+      Vector<T4>& Z = buffer[thread];
+      Z.Reallocate(last(thread) - first(thread));
+      Z.Fill(zero);
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp = zero;
+          x = X(i);
+          for (j = ptr[i]; j < ptr[i + 1]; j++)
+            {
+              temp += data[j] * X(ind[j]);
+              if (ind[j] != i)
+                Z(ind[j] - row_min) += data[j] * x;
+            }
+          Z(i - row_min) += temp;
+        }
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp barrier
+#endif
+
+      GetThreadRange(m, j_begin, j_end);
+      for (j = j_begin; j < j_end; j++)
+        {
+          temp = zero;
+          for (t = 0; t < nb_thread; t++)
+            if (j >= first(t) && j < last(t))
+              temp += buffer[t](j - first(t));
+          if (beta == T3(0))
+            Y(j) = alpha * temp;
+          else
+            {
+              Y(j) *= beta;
+              Y(j) += alpha * temp;
+            }
+        }
+    }
+  }
+
+
   /*** Sparse matrices, *Trans ***/
 
 
@@ -727,24 +969,12 @@ namespace Seldon
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    int i, j;
-
-    int ma = M.GetM();
-
 #ifdef SELDON_CHECK_DIMENSIONS
     CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
 #endif
 
-    Mlt(beta, Y);
-
-    int* ptr = M.GetPtr();
-    int* ind = M.GetInd();
-    typename Matrix<T1, Prop1, RowSparse, Allocator1>::pointer
-      data = M.GetData();
-
-    for (i = 0; i < ma; i++)
-      for (j = ptr[i]; j < ptr[i + 1]; j++)
-	Y(ind[j]) += alpha * data[j] * X(i);
+    MltScatterAdd(alpha, M.GetM(), M.GetN(), M.GetPtr(), M.GetInd(),
+                  M.GetData(), X, beta, Y);
   }
 
 
@@ -781,7 +1011,48 @@ namespace Seldon
   }
 
 
-  /*** Complex sparse matrices, *Trans ***/
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    if (Trans.NoTrans())
+      MltAdd(alpha, SeldonNoTrans, M, X, beta, Y);
+    else if (Trans.Trans())
+      MltAdd(alpha, SeldonTrans, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  /*** Column-major sparse matrices ***/
+
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
+#endif
+
+    MltScatterAdd(alpha, M.GetN(), M.GetM(), M.GetPtr(), M.GetInd(),
+                  M.GetData(), X, beta, Y);
+  }
 
 
   // NoTrans.
@@ -792,7 +1063,7 @@ namespace Seldon
 	    class T4, class Storage4, class Allocator4>
   void MltAdd(const T0 alpha,
 	      const class_SeldonNoTrans& Trans,
-	      const Matrix<T1, Prop1, RowComplexSparse, Allocator1>& M,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
@@ -808,36 +1079,48 @@ namespace Seldon
 	    class T4, class Storage4, class Allocator4>
   void MltAdd(const T0 alpha,
 	      const class_SeldonTrans& Trans,
-	      const Matrix<T1, Prop1, RowComplexSparse, Allocator1>& M,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    int i, j;
-
-    int ma = M.GetM();
+    int na = M.GetN();
 
 #ifdef SELDON_CHECK_DIMENSIONS
     CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
 #endif
 
-    Mlt(beta, Y);
+    T4 zero(0);
 
-    int* real_ptr = M.GetRealPtr();
-    int* imag_ptr = M.GetImagPtr();
-    int* real_ind = M.GetRealInd();
-    int* imag_ind = M.GetImagInd();
-    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
-      real_data = M.GetRealData();
-    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
-      imag_data = M.GetImagData();
+    int* ptr = M.GetPtr();
+    int* ind = M.GetInd();
+    typename Matrix<T1, Prop1, ColSparse, Allocator1>::pointer
+      data = M.GetData();
 
-    for (i = 0; i < ma; i++)
-      for (j = real_ptr[i]; j < real_ptr[i + 1]; j++)
-	Y(real_ind[j]) += alpha * real_data[j] * X(i);
+    // The columns are split among the threads so that each thread processes
+    // about the same number of non-zero entries.
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(na) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, j, j_begin, j_end;
+      T4 temp;
+      GetThreadRange(ptr, na, j_begin, j_end);
 
-    for (i = 0; i < ma; i++)
-      for (j = imag_ptr[i]; j < imag_ptr[i + 1]; j++)
-	Y(imag_ind[j]) += alpha * complex<T1>(T1(0), imag_data[j]) * X(i);
+      for (j = j_begin; j < j_end; j++)
+        {
+          temp = zero;
+          for (i = ptr[j]; i < ptr[j + 1]; i++)
+            temp += data[i] * X(ind[i]);
+          if (beta == T3(0))
+            Y(j) = alpha * temp;
+          else
+            {
+              Y(j) *= beta;
+              Y(j) += alpha * temp;
+            }
+        }
+    }
   }
 
 
@@ -849,87 +1132,844 @@ namespace Seldon
 	    class T4, class Storage4, class Allocator4>
   void MltAdd(const T0 alpha,
 	      const class_SeldonConjTrans& Trans,
-	      const Matrix<T1, Prop1, RowComplexSparse, Allocator1>& M,
+	      const Matrix<complex<T1>, Prop1, ColSparse, Allocator1>& M,
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    int i, j;
-
-    int ma = M.GetM();
+    int na = M.GetN();
 
 #ifdef SELDON_CHECK_DIMENSIONS
     CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonConjTrans, M, X, beta, Y)");
 #endif
 
-    Mlt(beta, Y);
+    T4 zero(0);
 
-    int* real_ptr = M.GetRealPtr();
-    int* imag_ptr = M.GetImagPtr();
-    int* real_ind = M.GetRealInd();
-    int* imag_ind = M.GetImagInd();
-    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
-      real_data = M.GetRealData();
-    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
-      imag_data = M.GetImagData();
+    int* ptr = M.GetPtr();
+    int* ind = M.GetInd();
+    typename Matrix<complex<T1>, Prop1, ColSparse, Allocator1>::pointer
+      data = M.GetData();
 
-    for (i = 0; i < ma; i++)
-      for (j = real_ptr[i]; j < real_ptr[i + 1]; j++)
-	Y(real_ind[j]) += alpha * real_data[j] * X(i);
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(na) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, j, j_begin, j_end;
+      T4 temp;
+      GetThreadRange(ptr, na, j_begin, j_end);
 
-    for (i = 0; i < ma; i++)
-      for (j = imag_ptr[i]; j < imag_ptr[i + 1]; j++)
-	Y(imag_ind[j]) += alpha * complex<T1>(T1(0), - imag_data[j]) * X(i);
+      for (j = j_begin; j < j_end; j++)
+        {
+          temp = zero;
+          for (i = ptr[j]; i < ptr[j + 1]; i++)
+            temp += conj(data[i]) * X(ind[i]);
+          if (beta == T3(0))
+            Y(j) = alpha * temp;
+          else
+            {
+              Y(j) *= beta;
+              Y(j) += alpha * temp;
+            }
+        }
+    }
   }
 
 
-  /*** Symmetric sparse matrices, *Trans ***/
-
-
-  // NoTrans.
+  // Transposition status known at run time.
   template <class T0,
 	    class T1, class Prop1, class Allocator1,
 	    class T2, class Storage2, class Allocator2,
 	    class T3,
 	    class T4, class Storage4, class Allocator4>
   void MltAdd(const T0 alpha,
-	      const class_SeldonNoTrans& Trans,
-	      const Matrix<T1, Prop1, RowSymSparse, Allocator1>& M,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    MltAdd(alpha, M, X, beta, Y);
+    if (Trans.NoTrans())
+      MltAdd(alpha, SeldonNoTrans, M, X, beta, Y);
+    else if (Trans.Trans())
+      MltAdd(alpha, SeldonTrans, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  /*** Sparse matrices with 64-bit start indices ***/
+
+
+  /*! \brief Performs the product of a compressed sparse matrix with a
+    vector, and adds the result to another vector. */
+  /*! It performs the operation \f$ Y = \alpha B X + \beta Y \f$ where \f$
+    B \f$ is a \f$ m \times n \f$ matrix stored in compressed rows. This is
+    the product of a 'RowLongSparse' matrix or of a transposed
+    'ColLongSparse' matrix. The rows are split among the threads so that
+    each thread processes about the same number of non-zero entries.
+    \param[in] alpha scalar.
+    \param[in] m number of compressed rows, i.e., length of \a Y.
+    \param[in] ptr start indices of the rows (of length \a m + 1), stored
+    as 'int' or 'long' integers.
+    \param[in] ind column indices of the non-zero entries.
+    \param[in] data values of the non-zero entries.
+    \param[in] X vector.
+    \param[in] beta scalar.
+    \param[in,out] Y vector of length \a m, result of the product of \a B by
+    \a X, times \a alpha, plus \a Y (on entry) times \a beta.
+  */
+  template <class T0, class Tint, class T1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltGatherAdd(const T0 alpha, int m,
+                    const Tint* ptr, const int* ind, const T1* data,
+                    const Vector<T2, Storage2, Allocator2>& X,
+                    const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    T4 zero(0);
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(m) + long(ptr[m]));
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, i_begin, i_end;
+      Tint k;
+      T4 temp;
+      GetThreadRange(ptr, m, i_begin, i_end);
+
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp = zero;
+          for (k = ptr[i]; k < ptr[i + 1]; k++)
+            temp += data[k] * X(ind[k]);
+          if (beta == T3(0))
+            Y(i) = alpha * temp;
+          else
+            {
+              Y(i) *= beta;
+              Y(i) += alpha * temp;
+            }
+        }
+    }
   }
 
 
-  // Trans.
   template <class T0,
 	    class T1, class Prop1, class Allocator1,
 	    class T2, class Storage2, class Allocator2,
 	    class T3,
 	    class T4, class Storage4, class Allocator4>
   void MltAdd(const T0 alpha,
-	      const class_SeldonTrans& Trans,
-	      const Matrix<T1, Prop1, RowSymSparse, Allocator1>& M,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    MltAdd(alpha, M, X, beta, Y);
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
+#endif
+
+    if (M.GetPtr() == NULL)
+      {
+        Mlt(beta, Y);
+        return;
+      }
+
+    MltGatherAdd(alpha, M.GetM(), M.GetPtr(), M.GetInd(), M.GetData(),
+                 X, beta, Y);
   }
 
 
-  // ConjTrans.
+  // NoTrans.
   template <class T0,
 	    class T1, class Prop1, class Allocator1,
 	    class T2, class Storage2, class Allocator2,
 	    class T3,
 	    class T4, class Storage4, class Allocator4>
   void MltAdd(const T0 alpha,
-	      const class_SeldonConjTrans& Trans,
-	      const Matrix<complex<T1>, Prop1, RowSymSparse, Allocator1>& M,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
   {
-    int ma = M.GetM();
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
+#endif
+
+    if (M.GetPtr() == NULL)
+      {
+        Mlt(beta, Y);
+        return;
+      }
+
+    MltScatterAdd(alpha, M.GetM(), M.GetN(), M.GetPtr(), M.GetInd(),
+                  M.GetData(), X, beta, Y);
+  }
+
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    if (Trans.NoTrans())
+      MltAdd(alpha, SeldonNoTrans, M, X, beta, Y);
+    else if (Trans.Trans())
+      MltAdd(alpha, SeldonTrans, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
+#endif
+
+    if (M.GetPtr() == NULL)
+      {
+        Mlt(beta, Y);
+        return;
+      }
+
+    MltScatterAdd(alpha, M.GetN(), M.GetM(), M.GetPtr(), M.GetInd(),
+                  M.GetData(), X, beta, Y);
+  }
+
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
+#endif
+
+    if (M.GetPtr() == NULL)
+      {
+        Mlt(beta, Y);
+        return;
+      }
+
+    MltGatherAdd(alpha, M.GetN(), M.GetPtr(), M.GetInd(), M.GetData(),
+                 X, beta, Y);
+  }
+
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    if (Trans.NoTrans())
+      MltAdd(alpha, SeldonNoTrans, M, X, beta, Y);
+    else if (Trans.Trans())
+      MltAdd(alpha, SeldonTrans, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  /*** Sparse matrices in SELL-C-sigma format ***/
+
+
+  //! Performs the product of chunks of a SELL-C-sigma matrix with a vector.
+  /*! It performs the operation \f$ Y = \alpha M X + \beta Y \f$ for the
+    rows of \f$ M \f$ stored in chunks \a chunk_begin to \a chunk_end
+    (excluded), where the chunks contain \a C rows. As \a C is known at
+    compile time, the loops over the rows of a chunk have a fixed length and
+    are turned by the compiler into vector instructions (with gathers of \a
+    X), for any instruction set.
+    \param[in] alpha scalar.
+    \param[in] m number of rows of \f$ M \f$.
+    \param[in] chunk_begin first chunk.
+    \param[in] chunk_end last chunk (excluded).
+    \param[in] chunk_ptr start indices of the chunks.
+    \param[in] ind column indices of the stored entries.
+    \param[in] data values of the stored entries.
+    \param[in] perm row (in the matrix) of each stored row.
+    \param[in] x data of vector \f$ X \f$.
+    \param[in] beta scalar.
+    \param[in,out] y data of vector \f$ Y \f$.
+  */
+  template <int C, class T0, class T1, class T2, class T3, class T4>
+  void MltAddSellChunks(const T0 alpha, int m, int chunk_begin, int chunk_end,
+                        const int* chunk_ptr, const int* ind, const T1* data,
+                        const int* perm, const T2* x, const T3 beta, T4* y)
+  {
+    int k, r, row;
+    T4 temp[C];
+
+    for (int s = chunk_begin; s < chunk_end; s++)
+      {
+        for (r = 0; r < C; r++)
+          temp[r] = T4(0);
+        for (k = chunk_ptr[s]; k < chunk_ptr[s + 1]; k += C)
+          for (r = 0; r < C; r++)
+            temp[r] += data[k + r] * x[ind[k + r]];
+
+        for (r = 0; r < C && s * C + r < m; r++)
+          {
+            row = perm[s * C + r];
+            if (beta == T3(0))
+              y[row] = alpha * temp[r];
+            else
+              {
+                y[row] *= beta;
+                y[row] += alpha * temp[r];
+              }
+          }
+      }
+  }
+
+
+  //! Performs the product of chunks of a SELL-C-sigma matrix with a vector.
+  /*! This is the version for a chunk size \a C only known at run time.
+    \param[in] C number of rows in a chunk.
+    \param[in] alpha scalar.
+    \param[in] m number of rows of \f$ M \f$.
+    \param[in] chunk_begin first chunk.
+    \param[in] chunk_end last chunk (excluded).
+    \param[in] chunk_ptr start indices of the chunks.
+    \param[in] ind column indices of the stored entries.
+    \param[in] data values of the stored entries.
+    \param[in] perm row (in the matrix) of each stored row.
+    \param[in] x data of vector \f$ X \f$.
+    \param[in] beta scalar.
+    \param[in,out] y data of vector \f$ Y \f$.
+  */
+  template <class T0, class T1, class T2, class T3, class T4>
+  void MltAddSellChunks(int C, const T0 alpha, int m,
+                        int chunk_begin, int chunk_end,
+                        const int* chunk_ptr, const int* ind, const T1* data,
+                        const int* perm, const T2* x, const T3 beta, T4* y)
+  {
+    int k, r, row;
+    Vector<T4> temp(C);
+
+    for (int s = chunk_begin; s < chunk_end; s++)
+      {
+        temp.Fill(T4(0));
+        for (k = chunk_ptr[s]; k < chunk_ptr[s + 1]; k += C)
+          for (r = 0; r < C; r++)
+            temp(r) += data[k + r] * x[ind[k + r]];
+
+        for (r = 0; r < C && s * C + r < m; r++)
+          {
+            row = perm[s * C + r];
+            if (beta == T3(0))
+              y[row] = alpha * temp(r);
+            else
+              {
+                y[row] *= beta;
+                y[row] += alpha * temp(r);
+              }
+          }
+      }
+  }
+
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
+#endif
+
+    int ma = M.GetM();
+    int chunk_size = M.GetChunkSize();
+    int nb_chunk = M.GetNbChunks();
+    int* chunk_ptr = M.GetChunkPtr();
+    int* ind = M.GetInd();
+    int* perm = M.GetPermutation();
+    T1* data = M.GetData();
+    T2* x = X.GetData();
+    T4* y = Y.GetData();
+
+    // The chunks are split among the threads so that each thread processes
+    // about the same number of stored entries. Every row is computed exactly
+    // as in the sequential product.
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(ma) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int s_begin, s_end;
+      GetThreadRange(chunk_ptr, nb_chunk, s_begin, s_end);
+
+      switch (chunk_size)
+        {
+        case 4:
+          MltAddSellChunks<4>(alpha, ma, s_begin, s_end, chunk_ptr, ind,
+                              data, perm, x, beta, y);
+          break;
+        case 8:
+          MltAddSellChunks<8>(alpha, ma, s_begin, s_end, chunk_ptr, ind,
+                              data, perm, x, beta, y);
+          break;
+        case 16:
+          MltAddSellChunks<16>(alpha, ma, s_begin, s_end, chunk_ptr, ind,
+                               data, perm, x, beta, y);
+          break;
+        default:
+          MltAddSellChunks(chunk_size, alpha, ma, s_begin, s_end, chunk_ptr,
+                           ind, data, perm, x, beta, y);
+        }
+    }
+  }
+
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
+#endif
+
+    int ma = M.GetM();
+    int chunk_size = M.GetChunkSize();
+    int nb_chunk = M.GetNbChunks();
+    int* chunk_ptr = M.GetChunkPtr();
+    int* ind = M.GetInd();
+    int* perm = M.GetPermutation();
+    T1* data = M.GetData();
+
+    Mlt(beta, Y);
+
+    // Padding entries are zeros and may be scattered as well.
+    int k, r, row;
+    for (int s = 0; s < nb_chunk; s++)
+      for (r = 0; r < chunk_size && s * chunk_size + r < ma; r++)
+        {
+          row = perm[s * chunk_size + r];
+          for (k = chunk_ptr[s] + r; k < chunk_ptr[s + 1]; k += chunk_size)
+            Y(ind[k]) += alpha * data[k] * X(row);
+        }
+  }
+
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+    if (Trans.NoTrans())
+      MltAdd(alpha, SeldonNoTrans, M, X, beta, Y);
+    else if (Trans.Trans())
+      MltAdd(alpha, SeldonTrans, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  /*** Block sparse matrices ***/
+
+
+  /*! \brief Performs the product of a block sparse matrix with a vector, and
+    adds the result to another vector. */
+  /*! It performs the operation \f$ Y = \alpha M X + \beta Y \f$. The size
+    B of the blocks is known at compile time, so that the product of a block
+    with a part of \a X is fully unrolled by the compiler. The rows of blocks
+    are split among the threads so that each thread processes about the same
+    number of blocks.
+    \param[in] alpha scalar.
+    \param[in] M block sparse matrix.
+    \param[in] X vector.
+    \param[in] beta scalar.
+    \param[in,out] Y vector, result of the product of \a M by \a X, times \a
+    alpha, plus \a Y (on entry) times \a beta.
+  */
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
+#endif
+
+    int mb = M.GetM() / B;
+    int* ptr = M.GetPtr();
+    int* ind = M.GetInd();
+    T1* data = M.GetData();
+    T2* x = X.GetData();
+    T4* y = Y.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(M.GetM()) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int I, k, r, c, I_begin, I_end;
+      T4 temp[B];
+      const T1* a;
+      const T2* x_block;
+
+      GetThreadRange(ptr, mb, I_begin, I_end);
+      for (I = I_begin; I < I_end; I++)
+        {
+          for (r = 0; r < B; r++)
+            temp[r] = T4(0);
+          for (k = ptr[I]; k < ptr[I + 1]; k++)
+            {
+              a = data + B * B * k;
+              x_block = x + B * ind[k];
+              for (r = 0; r < B; r++)
+                for (c = 0; c < B; c++)
+                  temp[r] += a[B * r + c] * x_block[c];
+            }
+
+          for (r = 0; r < B; r++)
+            if (beta == T3(0))
+              y[B * I + r] = alpha * temp[r];
+            else
+              {
+                y[B * I + r] *= beta;
+                y[B * I + r] += alpha * temp[r];
+              }
+        }
+    }
+  }
+
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
+#endif
+
+    int mb = M.GetM() / B;
+    int* ptr = M.GetPtr();
+    int* ind = M.GetInd();
+    T1* data = M.GetData();
+    T2* x = X.GetData();
+    T4* y = Y.GetData();
+
+    Mlt(beta, Y);
+
+    int I, k, r, c;
+    const T1* a;
+    T4* y_block;
+    for (I = 0; I < mb; I++)
+      for (k = ptr[I]; k < ptr[I + 1]; k++)
+        {
+          a = data + B * B * k;
+          y_block = y + B * ind[k];
+          for (r = 0; r < B; r++)
+            for (c = 0; c < B; c++)
+              y_block[c] += alpha * a[B * r + c] * x[B * I + r];
+        }
+  }
+
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y)
+  {
+    if (Trans.NoTrans())
+      MltAdd(alpha, SeldonNoTrans, M, X, beta, Y);
+    else if (Trans.Trans())
+      MltAdd(alpha, SeldonTrans, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  /*** Complex sparse matrices, *Trans ***/
+
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowComplexSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowComplexSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    int i, j;
+
+    int ma = M.GetM();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonTrans, M, X, beta, Y)");
+#endif
+
+    Mlt(beta, Y);
+
+    int* real_ptr = M.GetRealPtr();
+    int* imag_ptr = M.GetImagPtr();
+    int* real_ind = M.GetRealInd();
+    int* imag_ind = M.GetImagInd();
+    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
+      real_data = M.GetRealData();
+    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
+      imag_data = M.GetImagData();
+
+    for (i = 0; i < ma; i++)
+      for (j = real_ptr[i]; j < real_ptr[i + 1]; j++)
+	Y(real_ind[j]) += alpha * real_data[j] * X(i);
+
+    for (i = 0; i < ma; i++)
+      for (j = imag_ptr[i]; j < imag_ptr[i + 1]; j++)
+	Y(imag_ind[j]) += alpha * complex<T1>(T1(0), imag_data[j]) * X(i);
+  }
+
+
+  // ConjTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonConjTrans& Trans,
+	      const Matrix<T1, Prop1, RowComplexSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    int i, j;
+
+    int ma = M.GetM();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonConjTrans, M, X, beta, Y)");
+#endif
+
+    Mlt(beta, Y);
+
+    int* real_ptr = M.GetRealPtr();
+    int* imag_ptr = M.GetImagPtr();
+    int* real_ind = M.GetRealInd();
+    int* imag_ind = M.GetImagInd();
+    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
+      real_data = M.GetRealData();
+    typename Matrix<T1, Prop1, RowComplexSparse, Allocator1>::pointer
+      imag_data = M.GetImagData();
+
+    for (i = 0; i < ma; i++)
+      for (j = real_ptr[i]; j < real_ptr[i + 1]; j++)
+	Y(real_ind[j]) += alpha * real_data[j] * X(i);
+
+    for (i = 0; i < ma; i++)
+      for (j = imag_ptr[i]; j < imag_ptr[i + 1]; j++)
+	Y(imag_ind[j]) += alpha * complex<T1>(T1(0), - imag_data[j]) * X(i);
+  }
+
+
+  /*** Symmetric sparse matrices, *Trans ***/
+
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // ConjTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonConjTrans& Trans,
+	      const Matrix<complex<T1>, Prop1, RowSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    int ma = M.GetM();
 
 #ifdef SELDON_CHECK_DIMENSIONS
     CheckDim(Trans, M, X, Y, "MltAdd(alpha, SeldonConjTrans, M, X, beta, Y)");
@@ -960,6 +2000,101 @@ namespace Seldon
   }
 
 
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    if (Trans.NoTrans() || Trans.Trans())
+      MltAdd(alpha, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
+  /*** Column-major symmetric sparse matrices ***/
+
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltAdd(alpha, M, X, beta, Y)");
+#endif
+
+    // The upper part stored in columns is the lower part stored in rows.
+    MltSymAdd(alpha, M.GetM(), M.GetPtr(), M.GetInd(), M.GetData(),
+              X, beta, Y);
+  }
+
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    MltAdd(alpha, M, X, beta, Y);
+  }
+
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y)
+  {
+    if (Trans.NoTrans() || Trans.Trans())
+      MltAdd(alpha, M, X, beta, Y);
+    else
+      throw WrongArgument("MltAdd(alpha, trans, M, X, beta, Y)",
+                          "Complex conjugation not supported.");
+  }
+
+
   /*** Symmetric complex sparse matrices, *Trans ***/
 
 
@@ -1312,6 +2447,256 @@ namespace Seldon
   ////////////
 
 
+  ////////////////
+  // MLTDOTPROD //
+
+
+  //! Computes Y = M X and returns the scalar product Z.Y.
+  /*!
+    The matrix \a M may be of any type for which Mlt(M, X, Y) is defined.
+    \param[in] Z vector.
+    \param[in] M matrix.
+    \param[in] X vector.
+    \param[out] Y vector, equal to M X on exit. It must not be \a X.
+    \return The scalar product between \a Z and M X (without conjugation).
+  */
+  template <class T0, class Storage0, class Allocator0, class Matrix1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T0 MltDotProd(const Vector<T0, Storage0, Allocator0>& Z, const Matrix1& M,
+		const Vector<T2, Storage2, Allocator2>& X,
+		Vector<T3, Storage3, Allocator3>& Y)
+  {
+    Mlt(M, X, Y);
+    return DotProd(Z, Y);
+  }
+
+
+  /*! \brief Computes Y = M X and returns the scalar product between the
+    conjugate of Z and Y. */
+  template <class T0, class Storage0, class Allocator0, class Matrix1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T0 MltDotProdConj(const Vector<T0, Storage0, Allocator0>& Z,
+		    const Matrix1& M,
+		    const Vector<T2, Storage2, Allocator2>& X,
+		    Vector<T3, Storage3, Allocator3>& Y)
+  {
+    Mlt(M, X, Y);
+    return DotProdConj(Z, Y);
+  }
+
+
+  /*! \brief Computes Y = M X and returns the scalar product between the
+    conjugate of Z and Y. */
+  template <class T0, class Storage0, class Allocator0, class Matrix1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  complex<T0>
+  MltDotProdConj(const Vector<complex<T0>, Storage0, Allocator0>& Z,
+		 const Matrix1& M,
+		 const Vector<T2, Storage2, Allocator2>& X,
+		 Vector<T3, Storage3, Allocator3>& Y)
+  {
+    Mlt(M, X, Y);
+    return DotProdConj(Z, Y);
+  }
+
+
+  //! Computes Y = M X and returns the scalar product Z.Y.
+  /*!
+    The scalar product is accumulated while the rows of \a Y are computed,
+    so that \a Y is not read again. The rows are split among the threads as
+    in MltAdd, and the partial sums of the threads are added in the order of
+    the threads.
+    \param[in] Z vector.
+    \param[in] M matrix.
+    \param[in] X vector.
+    \param[out] Y vector, equal to M X on exit. It must not be \a X.
+    \return The scalar product between \a Z and M X (without conjugation).
+  */
+  template <class T0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  T0 MltDotProd(const Vector<T0, VectFull, Allocator0>& Z,
+		const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+		const Vector<T2, VectFull, Allocator2>& X,
+		Vector<T3, VectFull, Allocator3>& Y)
+  {
+    int ma = M.GetM();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltDotProd(Z, M, X, Y)");
+    CheckDim(Z, Y, "MltDotProd(Z, M, X, Y)");
+#endif
+
+    T0 value;
+    SetComplexZero(value);
+
+    int* ptr = M.GetPtr();
+    int* ind = M.GetInd();
+    typename Matrix<T1, Prop1, RowSparse, Allocator1>::pointer
+      data = M.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(ma) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, j, i_begin, i_end;
+      T3 temp, zero;
+      T0 sum;
+      SetComplexZero(zero);
+      SetComplexZero(sum);
+      GetThreadRange(ptr, ma, i_begin, i_end);
+
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp = zero;
+          for (j = ptr[i]; j < ptr[i + 1]; j++)
+            temp += data[j] * X(ind[j]);
+          Y(i) = temp;
+          sum += Z(i) * temp;
+        }
+
+#ifdef SELDON_WITH_OPENMP
+      int nb_team = omp_get_num_threads();
+#pragma omp for ordered schedule(static, 1)
+      for (int t = 0; t < nb_team; t++)
+        {
+#pragma omp ordered
+          value += sum;
+        }
+#else
+      value += sum;
+#endif
+    }
+
+    return value;
+  }
+
+
+  /*! \brief Computes Y = M X and returns the scalar product between the
+    conjugate of Z and Y. */
+  /*! \a Z is real, so that no conjugation is needed.
+   */
+  template <class T0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  T0 MltDotProdConj(const Vector<T0, VectFull, Allocator0>& Z,
+		    const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+		    const Vector<T2, VectFull, Allocator2>& X,
+		    Vector<T3, VectFull, Allocator3>& Y)
+  {
+    return MltDotProd(Z, M, X, Y);
+  }
+
+
+  /*! \brief Computes Y = M X and returns the scalar product between the
+    conjugate of Z and Y. */
+  /*!
+    The scalar product is accumulated while the rows of \a Y are computed,
+    so that \a Y is not read again. See MltDotProd(Z, M, X, Y).
+  */
+  template <class T0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  complex<T0>
+  MltDotProdConj(const Vector<complex<T0>, VectFull, Allocator0>& Z,
+		 const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+		 const Vector<T2, VectFull, Allocator2>& X,
+		 Vector<T3, VectFull, Allocator3>& Y)
+  {
+    int ma = M.GetM();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(M, X, Y, "MltDotProdConj(Z, M, X, Y)");
+    CheckDim(Z, Y, "MltDotProdConj(Z, M, X, Y)");
+#endif
+
+    complex<T0> value;
+    SetComplexZero(value);
+
+    int* ptr = M.GetPtr();
+    int* ind = M.GetInd();
+    typename Matrix<T1, Prop1, RowSparse, Allocator1>::pointer
+      data = M.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(ma) + M.GetDataSize());
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, j, i_begin, i_end;
+      T3 temp, zero;
+      complex<T0> sum;
+      SetComplexZero(zero);
+      SetComplexZero(sum);
+      GetThreadRange(ptr, ma, i_begin, i_end);
+
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp = zero;
+          for (j = ptr[i]; j < ptr[i + 1]; j++)
+            temp += data[j] * X(ind[j]);
+          Y(i) = temp;
+          sum += conj(Z(i)) * temp;
+        }
+
+#ifdef SELDON_WITH_OPENMP
+      int nb_team = omp_get_num_threads();
+#pragma omp for ordered schedule(static, 1)
+      for (int t = 0; t < nb_team; t++)
+        {
+#pragma omp ordered
+          value += sum;
+        }
+#else
+      value += sum;
+#endif
+    }
+
+    return value;
+  }
+
+
+  //! Computes Y = M X and returns the scalar product X.Y.
+  /*!
+    In the conjugate gradient, it gives the product of the matrix with the
+    direction of descent and its denominator in a single pass.
+    \param[in] M matrix.
+    \param[in] X vector.
+    \param[out] Y vector, equal to M X on exit. It must not be \a X.
+    \return The scalar product between \a X and M X (without conjugation).
+  */
+  template <class Matrix1, class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T2 MltDotProd(const Matrix1& M, const Vector<T2, Storage2, Allocator2>& X,
+		Vector<T3, Storage3, Allocator3>& Y)
+  {
+    return MltDotProd(X, M, X, Y);
+  }
+
+
+  /*! \brief Computes Y = M X and returns the scalar product between the
+    conjugate of X and Y. */
+  template <class Matrix1, class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T2 MltDotProdConj(const Matrix1& M,
+		    const Vector<T2, Storage2, Allocator2>& X,
+		    Vector<T3, Storage3, Allocator3>& Y)
+  {
+    return MltDotProdConj(X, M, X, Y);
+  }
+
+
+  // MLTDOTPROD //
+  ////////////////
+
+
   ///////////
   // GAUSS //
 
@@ -1507,6 +2892,192 @@ namespace Seldon
   }
 
 
+  //! Solves a linear system whose matrix has been factorized by
+  //! GetLUBlocked.
+  /*! This function solves \f$ A X = B \f$ or \f$ A^T X = B \f$, where the LU
+    factorization of the n x n matrix \a A, stored by columns, and the pivot
+    indices have been computed by GetLUBlocked, as the Lapack routine xGETRS
+    does.
+    \param[in] TransA status of A: SeldonNoTrans or SeldonTrans.
+    \param[in] n order of the matrix.
+    \param[in] a LU factorization of \a A.
+    \param[in] ipiv pivot indices (starting from 1).
+    \param[in,out] b on entry, the right-hand side \f$ B \f$; on exit, the
+    solution \f$ X \f$ of the system.
+  */
+  template <class T0, class T1>
+  void SolveLUBlocked(const SeldonTranspose& TransA, int n, const T0* a,
+                      const int* ipiv, T1* b)
+  {
+    if (TransA.ConjTrans())
+      throw WrongArgument("SolveLU(TransA, A, P, Y)",
+                          "Complex conjugation not supported.");
+
+    int i, r;
+    long lda = n;
+    T1 temp;
+
+    if (TransA.NoTrans())
+      {
+        for (i = 0; i < n; i++)
+          if (ipiv[i] - 1 != i)
+            swap(b[i], b[ipiv[i] - 1]);
+
+        // Forward substitution with L, column by column.
+        for (i = 0; i < n; i++)
+          {
+            const T0* a_i = a + i * lda;
+            temp = b[i];
+            if (temp != T1(0))
+              for (r = i + 1; r < n; r++)
+                b[r] -= a_i[r] * temp;
+          }
+
+        // Back substitution with U, column by column.
+        for (i = n - 1; i >= 0; i--)
+          {
+            const T0* a_i = a + i * lda;
+            b[i] /= a_i[i];
+            temp = b[i];
+            if (temp != T1(0))
+              for (r = 0; r < i; r++)
+                b[r] -= a_i[r] * temp;
+          }
+      }
+    else
+      {
+        // Forward substitution with U^T: the columns of U are contiguous.
+        for (i = 0; i < n; i++)
+          {
+            const T0* a_i = a + i * lda;
+            temp = b[i];
+            for (r = 0; r < i; r++)
+              temp -= a_i[r] * b[r];
+            b[i] = temp / a_i[i];
+          }
+
+        // Back substitution with L^T.
+        for (i = n - 1; i >= 0; i--)
+          {
+            const T0* a_i = a + i * lda;
+            temp = b[i];
+            for (r = i + 1; r < n; r++)
+              temp -= a_i[r] * b[r];
+            b[i] = temp;
+          }
+
+        for (i = n - 1; i >= 0; i--)
+          if (ipiv[i] - 1 != i)
+            swap(b[i], b[ipiv[i] - 1]);
+      }
+  }
+
+
+  //! Solves a linear system whose matrix has been LU-factorized.
+  /*! This function solves \f$ A X = Y \f$ where the LU factorization of \a
+    A, with partial pivoting, has been computed by GetLU(A, P). This function
+    is called when Lapack is not used, or when the type of the entries is not
+    supported by Lapack.
+    \param[in] A LU factorization of the matrix of the linear system.
+    \param[in] P pivot indices (starting from 1).
+    \param[in,out] Y on entry, the right-hand side \f$ Y \f$; on exit, the
+    solution \f$ X \f$ of the system.
+    \sa Seldon::GetLU(Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+    Vector<int, VectFull, Allocator1>& P) to factorize a matrix before using
+    this function.
+  */
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y)
+  {
+    SolveLU(SeldonNoTrans, A, P, Y);
+  }
+
+
+  //! Solves a linear system whose matrix has been LU-factorized.
+  /*! This function solves \f$ A X = Y \f$ where the LU factorization of \a
+    A, with partial pivoting, has been computed by GetLU(A, P). This function
+    is called when Lapack is not used, or when the type of the entries is not
+    supported by Lapack.
+    \param[in] A LU factorization of the matrix of the linear system.
+    \param[in] P pivot indices (starting from 1).
+    \param[in,out] Y on entry, the right-hand side \f$ Y \f$; on exit, the
+    solution \f$ X \f$ of the system.
+    \sa Seldon::GetLU(Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+    Vector<int, VectFull, Allocator1>& P) to factorize a matrix before using
+    this function.
+  */
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y)
+  {
+    SolveLU(SeldonNoTrans, A, P, Y);
+  }
+
+
+  //! Solves a linear system whose matrix has been LU-factorized.
+  /*! This function solves \f$ A X = Y \f$ or \f$ A^T X = Y \f$, where the LU
+    factorization of \a A, with partial pivoting, has been computed by
+    GetLU(A, P).
+    \param[in] TransA status of A: SeldonNoTrans or SeldonTrans.
+    \param[in] A LU factorization of the matrix of the linear system.
+    \param[in] P pivot indices (starting from 1).
+    \param[in,out] Y on entry, the right-hand side \f$ Y \f$; on exit, the
+    solution \f$ X \f$ of the system.
+  */
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const SeldonTranspose& TransA,
+               const Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, Y, "SolveLU(A, P, Y)");
+#endif
+
+    SolveLUBlocked(TransA, A.GetM(), A.GetData(), P.GetData(), Y.GetData());
+  }
+
+
+  //! Solves a linear system whose matrix has been LU-factorized.
+  /*! This function solves \f$ A X = Y \f$ or \f$ A^T X = Y \f$, where the LU
+    factorization of \a A, with partial pivoting, has been computed by
+    GetLU(A, P). Since \a A actually contains the factorization of \f$ A^T
+    \f$, the opposite system is solved by SolveLUBlocked.
+    \param[in] TransA status of A: SeldonNoTrans or SeldonTrans.
+    \param[in] A LU factorization of the matrix of the linear system.
+    \param[in] P pivot indices (starting from 1).
+    \param[in,out] Y on entry, the right-hand side \f$ Y \f$; on exit, the
+    solution \f$ X \f$ of the system.
+  */
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const SeldonTranspose& TransA,
+               const Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, Y, "SolveLU(A, P, Y)");
+#endif
+
+    if (TransA.NoTrans())
+      SolveLUBlocked(SeldonTrans, A.GetM(), A.GetData(), P.GetData(),
+                     Y.GetData());
+    else if (TransA.Trans())
+      SolveLUBlocked(SeldonNoTrans, A.GetM(), A.GetData(), P.GetData(),
+                     Y.GetData());
+    else
+      SolveLUBlocked(TransA, A.GetM(), A.GetData(), P.GetData(),
+                     Y.GetData());
+  }
+
+
   // SOLVELU //
   /////////////
 
@@ -1539,6 +3110,44 @@ namespace Seldon
   }
 
 
+  //! Solves a linear system using LU factorization with partial pivoting.
+  /*! This function solves \f$ M X = Y \f$ where \f$ M \f$ is a dense
+    matrix, and \f$ X \f$ and \f$ Y \f$ are vectors.
+    \param[in] M the matrix of the linear system, to be factorized in LU
+    form. On exit, \a M contains its LU factorization.
+    \param[in,out] Y on entry, the right-hand side \f$ Y \f$; on exit, the
+    solution \f$ X \f$ of the system.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Allocator1>
+  void GetAndSolveLU(Matrix<T0, Prop0, ColMajor, Allocator0>& M,
+                     Vector<T1, VectFull, Allocator1>& Y)
+  {
+    Vector<int> P;
+    GetLU(M, P);
+    SolveLU(M, P, Y);
+  }
+
+
+  //! Solves a linear system using LU factorization with partial pivoting.
+  /*! This function solves \f$ M X = Y \f$ where \f$ M \f$ is a dense
+    matrix, and \f$ X \f$ and \f$ Y \f$ are vectors.
+    \param[in] M the matrix of the linear system, to be factorized in LU
+    form. On exit, \a M contains its LU factorization.
+    \param[in,out] Y on entry, the right-hand side \f$ Y \f$; on exit, the
+    solution \f$ X \f$ of the system.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Allocator1>
+  void GetAndSolveLU(Matrix<T0, Prop0, RowMajor, Allocator0>& M,
+                     Vector<T1, VectFull, Allocator1>& Y)
+  {
+    Vector<int> P;
+    GetLU(M, P);
+    SolveLU(M, P, Y);
+  }
+
+
   // SOLVE //
   ///////////
 
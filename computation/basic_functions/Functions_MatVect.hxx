@@ -37,6 +37,14 @@
   alpha M X + beta Y -> Y
   MltAdd(alpha, M, X, beta, Y)
 
+  M X -> Y and X.Y
+  MltDotProd(M, X, Y)
+  MltDotProdConj(M, X, Y)
+
+  M X -> Y and Z.Y
+  MltDotProd(Z, M, X, Y)
+  MltDotProdConj(Z, M, X, Y)
+
   Gauss(M, X)
 
   GaussSeidel(M, X, Y, iter)
@@ -45,6 +53,8 @@
 
   SolveLU(M, Y)
 
+  SolveLU(M, P, Y)
+
   Solve(M, Y)
 */
 
@@ -218,6 +228,26 @@ namespace Seldon
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
 
+  /*** Sparse matrices, scattered products ***/
+
+  template <class T0, class Tint, class T1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltScatterAdd(const T0 alpha, int m, int n,
+                     const Tint* ptr, const int* ind, const T1* data,
+                     const Vector<T2, Storage2, Allocator2>& X,
+                     const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  template <class T0, class T1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltSymAdd(const T0 alpha, int m,
+                 const int* ptr, const int* ind, const T1* data,
+                 const Vector<T2, Storage2, Allocator2>& X,
+                 const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
   /*** Sparse matrices, *Trans ***/
 
   // NoTrans.
@@ -256,6 +286,288 @@ namespace Seldon
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
 
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  /*** Column-major sparse matrices ***/
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // ConjTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonConjTrans& Trans,
+	      const Matrix<complex<T1>, Prop1, ColSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, ColSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  /*** Sparse matrices with 64-bit start indices ***/
+
+  template <class T0, class Tint, class T1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltGatherAdd(const T0 alpha, int m,
+                    const Tint* ptr, const int* ind, const T1* data,
+                    const Vector<T2, Storage2, Allocator2>& X,
+                    const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, ColLongSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  /*** Sparse matrices in SELL-C-sigma format ***/
+
+  template <int C, class T0, class T1, class T2, class T3, class T4>
+  void MltAddSellChunks(const T0 alpha, int m, int chunk_begin, int chunk_end,
+                        const int* chunk_ptr, const int* ind, const T1* data,
+                        const int* perm, const T2* x, const T3 beta, T4* y);
+
+  template <class T0, class T1, class T2, class T3, class T4>
+  void MltAddSellChunks(int C, const T0 alpha, int m,
+                        int chunk_begin, int chunk_end,
+                        const int* chunk_ptr, const int* ind, const T1* data,
+                        const int* perm, const T2* x, const T3 beta, T4* y);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowSellSparse, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  /*** Block sparse matrices ***/
+
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, int B, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3,
+	    class T4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M,
+	      const Vector<T2, VectFull, Allocator2>& X,
+	      const T3 beta, Vector<T4, VectFull, Allocator4>& Y);
+
   /*** Complex sparse matrices, *Trans ***/
 
   // NoTrans.
@@ -332,6 +644,66 @@ namespace Seldon
 	      const Vector<T2, Storage2, Allocator2>& X,
 	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
 
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, RowSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  /*** Column-major symmetric sparse matrices ***/
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // NoTrans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonNoTrans& Trans,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Trans.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const class_SeldonTrans& Trans,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
+  // Transposition status known at run time.
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& Trans,
+	      const Matrix<T1, Prop1, ColSymSparse, Allocator1>& M,
+	      const Vector<T2, Storage2, Allocator2>& X,
+	      const T3 beta, Vector<T4, Storage4, Allocator4>& Y);
+
   /*** Symmetric complex sparse matrices, *Trans ***/
 
   // NoTrans.
@@ -440,6 +812,78 @@ namespace Seldon
   ////////////
 
 
+  ////////////////
+  // MLTDOTPROD //
+
+
+  template <class T0, class Storage0, class Allocator0, class Matrix1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T0 MltDotProd(const Vector<T0, Storage0, Allocator0>& Z, const Matrix1& M,
+		const Vector<T2, Storage2, Allocator2>& X,
+		Vector<T3, Storage3, Allocator3>& Y);
+
+  template <class T0, class Storage0, class Allocator0, class Matrix1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T0 MltDotProdConj(const Vector<T0, Storage0, Allocator0>& Z,
+		    const Matrix1& M,
+		    const Vector<T2, Storage2, Allocator2>& X,
+		    Vector<T3, Storage3, Allocator3>& Y);
+
+  template <class T0, class Storage0, class Allocator0, class Matrix1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  complex<T0>
+  MltDotProdConj(const Vector<complex<T0>, Storage0, Allocator0>& Z,
+		 const Matrix1& M,
+		 const Vector<T2, Storage2, Allocator2>& X,
+		 Vector<T3, Storage3, Allocator3>& Y);
+
+  template <class T0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  T0 MltDotProd(const Vector<T0, VectFull, Allocator0>& Z,
+		const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+		const Vector<T2, VectFull, Allocator2>& X,
+		Vector<T3, VectFull, Allocator3>& Y);
+
+  template <class T0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  T0 MltDotProdConj(const Vector<T0, VectFull, Allocator0>& Z,
+		    const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+		    const Vector<T2, VectFull, Allocator2>& X,
+		    Vector<T3, VectFull, Allocator3>& Y);
+
+  template <class T0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  complex<T0>
+  MltDotProdConj(const Vector<complex<T0>, VectFull, Allocator0>& Z,
+		 const Matrix<T1, Prop1, RowSparse, Allocator1>& M,
+		 const Vector<T2, VectFull, Allocator2>& X,
+		 Vector<T3, VectFull, Allocator3>& Y);
+
+  template <class Matrix1, class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T2 MltDotProd(const Matrix1& M, const Vector<T2, Storage2, Allocator2>& X,
+		Vector<T3, Storage3, Allocator3>& Y);
+
+  template <class Matrix1, class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  T2 MltDotProdConj(const Matrix1& M,
+		    const Vector<T2, Storage2, Allocator2>& X,
+		    Vector<T3, Storage3, Allocator3>& Y);
+
+
+  // MLTDOTPROD //
+  ////////////////
+
+
   ///////////
   // GAUSS //
 
@@ -500,6 +944,36 @@ namespace Seldon
   void SolveLU(const Matrix<T0, Prop0, Storage0, Allocator0>& M,
 	       Vector<T1, Storage1, Allocator1>& Y);
 
+  template <class T0, class T1>
+  void SolveLUBlocked(const SeldonTranspose& TransA, int n, const T0* a,
+                      const int* ipiv, T1* b);
+
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y);
+
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y);
+
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const SeldonTranspose& TransA,
+               const Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y);
+
+  template <class T0, class Prop0, class Allocator0, class Allocator1,
+            class T2, class Allocator2>
+  void SolveLU(const SeldonTranspose& TransA,
+               const Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+               const Vector<int, VectFull, Allocator1>& P,
+               Vector<T2, VectFull, Allocator2>& Y);
+
   // SOLVELU //
   /////////////
 
@@ -513,6 +987,16 @@ namespace Seldon
   void GetAndSolveLU(Matrix<T0, Prop0, Storage0, Allocator0>& M,
                      Vector<T1, Storage1, Allocator1>& Y);
 
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Allocator1>
+  void GetAndSolveLU(Matrix<T0, Prop0, ColMajor, Allocator0>& M,
+                     Vector<T1, VectFull, Allocator1>& Y);
+
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Allocator1>
+  void GetAndSolveLU(Matrix<T0, Prop0, RowMajor, Allocator0>& M,
+                     Vector<T1, VectFull, Allocator1>& Y);
+
   // SOLVE //
   ///////////
 
@@ -48,6 +48,9 @@
   LU factorization of matrix A without pivoting.
   GetLU(A)
 
+  LU factorization of matrix A with partial pivoting.
+  GetLU(A, P)
+
   Highest absolute value of A.
   MaxAbs(A)
 
@@ -221,150 +224,581 @@ namespace Seldon
   }
 
 
-  //! Multiplies two row-major sparse matrices in Harwell-Boeing format.
-  /*! It performs the operation \f$ C = A B \f$ where \f$ A \f$, \f$ B \f$ and
-    \f$ C \f$ are row-major sparse matrices in Harwell-Boeing format.
+  //! Main constructor.
+  /*!
     \param[in] A row-major sparse matrix in Harwell-Boeing format.
     \param[in] B row-major sparse matrix in Harwell-Boeing format.
-    \param[out] C row-major sparse matrix in Harwell-Boeing format, result of
-    the product of \a A with \a B. It does not need to have the right non-zero
-    entries.
   */
-  template <class T0, class Prop0, class Allocator0,
-	    class T1, class Prop1, class Allocator1,
-	    class T2, class Prop2, class Allocator2>
-  void Mlt(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
-	   const Matrix<T1, Prop1, RowSparse, Allocator1>& B,
-	   Matrix<T2, Prop2, RowSparse, Allocator2>& C)
+  template <class T0, class T1>
+  template <class Prop0, class Allocator0, class Prop1, class Allocator1>
+  inline RowSparseProduct<T0, T1>
+  ::RowSparseProduct(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+		     const Matrix<T1, Prop1, RowSparse, Allocator1>& B)
   {
-#ifdef SELDON_CHECK_DIMENSIONS
-    CheckDim(A, B, "Mlt(const Matrix<RowSparse>& A, const "
-             "Matrix<RowSparse>& B, Matrix<RowSparse>& C)");
-#endif
+    a_ptr_ = A.GetPtr();
+    a_ind_ = A.GetInd();
+    a_val_ = A.GetData();
+    b_ptr_ = B.GetPtr();
+    b_ind_ = B.GetInd();
+    b_val_ = B.GetData();
+  }
 
-    int h, i, k, l, col;
-    int Nnonzero, Nnonzero_row, Nnonzero_row_max;
-    IVect column_index;
-    Vector<T2> row_value;
-    T1 value;
-    int m = A.GetM();
 
-    int* c_ptr = NULL;
-    int* c_ind = NULL;
-    T2* c_data = NULL;
-    C.Clear();
+  //! Adds the column numbers of the products of a row to a marker.
+  /*!
+    \param[in] i row number.
+    \param[in,out] mark marker of the columns of row \a i.
+  */
+  template <class T0, class T1> template <class Marker>
+  inline void RowSparseProduct<T0, T1>::AddColumns(int i, Marker& mark) const
+  {
+    for (int k = a_ptr_[i]; k < a_ptr_[i + 1]; k++)
+      for (int l = b_ptr_[a_ind_[k]]; l < b_ptr_[a_ind_[k] + 1]; l++)
+	mark.Add(b_ind_[l]);
+  }
 
-#ifdef SELDON_CHECK_MEMORY
-    try
+
+  //! Adds the products of a row to an accumulator.
+  /*!
+    \param[in] i row number.
+    \param[in,out] acc accumulator of the values of row \a i.
+  */
+  template <class T0, class T1> template <class Accumulator>
+  inline void RowSparseProduct<T0, T1>
+  ::AddValues(int i, Accumulator& acc) const
+  {
+    for (int k = a_ptr_[i]; k < a_ptr_[i + 1]; k++)
       {
-#endif
+	T0 value = a_val_[k];
+	for (int l = b_ptr_[a_ind_[k]]; l < b_ptr_[a_ind_[k] + 1]; l++)
+	  acc.Add(b_ind_[l], value * b_val_[l]);
+      }
+  }
 
-	c_ptr = reinterpret_cast<int*>(calloc(m + 1, sizeof(int)));
 
-#ifdef SELDON_CHECK_MEMORY
+  //! Main constructor.
+  /*!
+    \param[in] R row-major sparse matrix in Harwell-Boeing format.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] P row-major sparse matrix in Harwell-Boeing format.
+  */
+  template <class T0, class T1, class T2, class T3>
+  template <class Prop0, class Allocator0, class Prop1, class Allocator1,
+	    class Prop2, class Allocator2>
+  inline RowSparseTripleProduct<T0, T1, T2, T3>
+  ::RowSparseTripleProduct(const Matrix<T0, Prop0, RowSparse, Allocator0>& R,
+			   const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+			   const Matrix<T2, Prop2, RowSparse, Allocator2>& P)
+  {
+    r_ptr_ = R.GetPtr();
+    r_ind_ = R.GetInd();
+    r_val_ = R.GetData();
+    a_ptr_ = A.GetPtr();
+    a_ind_ = A.GetInd();
+    a_val_ = A.GetData();
+    p_ptr_ = P.GetPtr();
+    p_ind_ = P.GetInd();
+    p_val_ = P.GetData();
+  }
+
+
+  //! Adds the column numbers of the products of a row to a marker.
+  /*!
+    \param[in] i row number.
+    \param[in,out] mark marker of the columns of row \a i.
+  */
+  template <class T0, class T1, class T2, class T3> template <class Marker>
+  inline void RowSparseTripleProduct<T0, T1, T2, T3>
+  ::AddColumns(int i, Marker& mark) const
+  {
+    for (int k = r_ptr_[i]; k < r_ptr_[i + 1]; k++)
+      for (int q = a_ptr_[r_ind_[k]]; q < a_ptr_[r_ind_[k] + 1]; q++)
+	for (int l = p_ptr_[a_ind_[q]]; l < p_ptr_[a_ind_[q] + 1]; l++)
+	  mark.Add(p_ind_[l]);
+  }
+
+
+  //! Adds the products of a row to an accumulator.
+  /*!
+    \param[in] i row number.
+    \param[in,out] acc accumulator of the values of row \a i.
+  */
+  template <class T0, class T1, class T2, class T3>
+  template <class Accumulator>
+  inline void RowSparseTripleProduct<T0, T1, T2, T3>
+  ::AddValues(int i, Accumulator& acc) const
+  {
+    for (int k = r_ptr_[i]; k < r_ptr_[i + 1]; k++)
+      for (int q = a_ptr_[r_ind_[k]]; q < a_ptr_[r_ind_[k] + 1]; q++)
+	{
+	  T3 value = r_val_[k] * a_val_[q];
+	  for (int l = p_ptr_[a_ind_[q]]; l < p_ptr_[a_ind_[q] + 1]; l++)
+	    acc.Add(p_ind_[l], value * p_val_[l]);
+	}
+  }
+
+
+  //! Main constructor.
+  /*!
+    \param[in] n number of columns.
+  */
+  inline SparseRowMarker::SparseRowMarker(int n)
+  {
+    mark_.Reallocate(n);
+    mark_.Fill(-1);
+    row_ = -1;
+    nb_ = 0;
+    ind_ = NULL;
+  }
+
+
+  //! Forgets the rows already processed.
+  /*! It is needed before a row is processed again.
+  */
+  inline void SparseRowMarker::Reset()
+  {
+    mark_.Fill(-1);
+    row_ = -1;
+    nb_ = 0;
+    ind_ = NULL;
+  }
+
+
+  //! Starts a new row.
+  /*!
+    \param[in] i row number, different from the previous rows.
+    \param[out] ind array where the column numbers are stored, or NULL if
+    they are only counted.
+  */
+  inline void SparseRowMarker::Init(int i, int* ind)
+  {
+    row_ = i;
+    nb_ = 0;
+    ind_ = ind;
+  }
+
+
+  //! Adds a column to the current row, unless it is already there.
+  /*!
+    \param[in] j column number.
+  */
+  inline void SparseRowMarker::Add(int j)
+  {
+    if (mark_(j) != row_)
+      {
+	mark_(j) = row_;
+	if (ind_ != NULL)
+	  ind_[nb_] = j;
+	nb_++;
       }
-    catch (...)
+  }
+
+
+  //! Returns the number of columns of the current row.
+  /*!
+    \return The number of distinct columns added since Init.
+  */
+  inline int SparseRowMarker::GetNb() const
+  {
+    return nb_;
+  }
+
+
+  //! Main constructor.
+  /*!
+    \param[in] n number of columns.
+    \param[in,out] val values of the sparse matrix where the products are
+    accumulated.
+  */
+  template <class T>
+  inline SparseRowAccumulator<T>::SparseRowAccumulator(int n, T* val)
+  {
+    position_.Reallocate(n);
+    position_.Fill(-1);
+    val_ = val;
+    nb_missing_ = 0;
+  }
+
+
+  //! Starts a new row, whose values are set to zero.
+  /*!
+    \param[in] begin position of the first entry of the row.
+    \param[in] end position after the last entry of the row.
+    \param[in] ind column numbers of the sparse matrix.
+  */
+  template <class T>
+  inline void SparseRowAccumulator<T>::Init(int begin, int end,
+					    const int* ind)
+  {
+    for (int p = begin; p < end; p++)
       {
-        c_ptr = NULL;
+	position_(ind[p]) = p;
+	val_[p] = T(0);
       }
+  }
 
-    if (c_ptr == NULL)
-      throw NoMemory("Mlt(const Matrix<RowSparse>& A, const "
-                     "Matrix<RowSparse>& B, Matrix<RowSparse>& C)",
-		     "Unable to allocate memory for an array of "
-		     + to_str(m + 1) + " integers.");
+
+  //! Adds a value to an entry of the current row.
+  /*! If the entry is not in the row, the value is not added, and it is
+    counted in GetNbMissing.
+    \param[in] j column number.
+    \param[in] x value to be added.
+  */
+  template <class T> template <class T0>
+  inline void SparseRowAccumulator<T>::Add(int j, const T0& x)
+  {
+    int p = position_(j);
+    if (p < 0)
+      nb_missing_++;
+    else
+      val_[p] += x;
+  }
+
+
+  //! Ends the current row.
+  /*!
+    \param[in] begin position of the first entry of the row.
+    \param[in] end position after the last entry of the row.
+    \param[in] ind column numbers of the sparse matrix.
+  */
+  template <class T>
+  inline void SparseRowAccumulator<T>::Reset(int begin, int end,
+					     const int* ind)
+  {
+    for (int p = begin; p < end; p++)
+      position_(ind[p]) = -1;
+  }
+
+
+  //! Returns the number of values not added.
+  /*!
+    \return The number of values whose entries were not in their row.
+  */
+  template <class T>
+  inline int SparseRowAccumulator<T>::GetNbMissing() const
+  {
+    return nb_missing_;
+  }
+
+
+  //! Computes the pattern of a product of row-major sparse matrices.
+  /*! The rows of the product are processed in parallel; every thread marks
+    the columns already found in a dense array (see SparseRowMarker). The
+    rows are first counted, so that the arrays of \a C are allocated once,
+    and then filled and sorted.
+    \param[in] product rows of the product (RowSparseProduct or
+    RowSparseTripleProduct).
+    \param[in] m number of rows of the product.
+    \param[in] n number of columns of the product.
+    \param[in] weight start indices used to split the rows among the threads
+    (see GetThreadRange).
+    \param[in] work estimate of the work, for the number of threads.
+    \param[out] C row-major sparse matrix in Harwell-Boeing format, with the
+    pattern of the product, and zero values.
+  */
+  template <class Product, class T, class Prop, class Allocator>
+  void MltSymbolicRows(const Product& product, int m, int n,
+		       const int* weight, long work,
+		       Matrix<T, Prop, RowSparse, Allocator>& C)
+  {
+    Vector<int, VectFull, CallocAlloc<int> > ptr(m + 1), ind;
+    ptr.Zero();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(work);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
 #endif
+    {
+      int begin, end, i, j, k;
+      GetThreadRange(weight, m, begin, end);
+      SparseRowMarker mark(n);
 
-    c_ptr[0] = 0;
+      // Number of non-zero entries of each row.
+      for (i = begin; i < end; i++)
+	{
+	  mark.Init(i, NULL);
+	  product.AddColumns(i, mark);
+	  ptr(i + 1) = mark.GetNb();
+	}
 
-    // Number of non-zero elements in C.
-    Nnonzero = 0;
-    for (i = 0; i < m; i++)
+#ifdef SELDON_WITH_OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
       {
-        c_ptr[i + 1] = c_ptr[i];
+	for (i = 0; i < m; i++)
+	  ptr(i + 1) += ptr(i);
+	ind.Reallocate(ptr(m));
+      }
 
-        if (A.GetPtr()[i + 1] != A.GetPtr()[i])
-          // There are elements in the i-th row of A, so there can be non-zero
-          // entries in C as well. Checks whether any column in B has an
-          // element whose row index matches a column index of a non-zero in
-          // the i-th row of A.
-          {
-            // Maximum number of non-zero entry on the i-th row of C.
-            Nnonzero_row_max = 0;
-            // For every element in the i-th row.
-            for (k = A.GetPtr()[i]; k < A.GetPtr()[i + 1]; k++)
-              {
-                col = A.GetInd()[k];
-                Nnonzero_row_max += B.GetPtr()[col + 1] - B.GetPtr()[col];
-              }
-            // Now gets the column indexes.
-            column_index.Reallocate(Nnonzero_row_max);
-            row_value.Reallocate(Nnonzero_row_max);
-            h = 0;
-            // For every element in the i-th row.
-            for (k = A.GetPtr()[i]; k < A.GetPtr()[i + 1]; k++)
-              {
-                // The k-th column index (among the nonzero entries) on the
-                // i-th row, and the corresponding value.
-                col = A.GetInd()[k];
-                value = A.GetData()[k];
-                // Loop on all elements in the col-th row in B. These elements
-                // are multiplied with the element (i, col) of A.
-                for (l = B.GetPtr()[col]; l < B.GetPtr()[col + 1]; l++)
-                  {
-                    column_index(h) = B.GetInd()[l];
-                    row_value(h) = value * B.GetData()[l];
-                    h++;
-                  }
-              }
-            // Now gathers and sorts all elements on the i-th row of C.
-            Nnonzero_row = column_index.GetLength();
-            Assemble(Nnonzero_row, column_index, row_value);
+      // Column indices of each row, sorted.
+      mark.Reset();
+      for (i = begin; i < end; i++)
+	{
+	  mark.Init(i, ind.GetData() + ptr(i));
+	  product.AddColumns(i, mark);
+
+	  if (ptr(i + 1) - ptr(i) > 16)
+	    Sort(ptr(i), ptr(i + 1) - 1, ind);
+	  else
+	    for (k = ptr(i) + 1; k < ptr(i + 1); k++)
+	      {
+		int ind_k = ind(k);
+		for (j = k; j > ptr(i) && ind(j - 1) > ind_k; j--)
+		  ind(j) = ind(j - 1);
+		ind(j) = ind_k;
+	      }
+	}
+    }
 
-#ifdef SELDON_CHECK_MEMORY
-            try
-              {
+    Vector<T, VectFull, Allocator> val(ptr(m));
+    val.Zero();
+    C.SetData(m, n, val, ptr, ind);
+  }
+
+
+  //! Computes the values of a product of row-major sparse matrices.
+  /*! The rows of the product are processed in parallel; every thread stores
+    the position in \a C of each column of the current row in a dense array
+    (see SparseRowAccumulator), so that the products are added directly to
+    the values of \a C.
+    \param[in] product rows of the product (RowSparseProduct or
+    RowSparseTripleProduct).
+    \param[in] weight start indices used to split the rows among the threads
+    (see GetThreadRange).
+    \param[in] work estimate of the work, for the number of threads.
+    \param[in,out] C row-major sparse matrix in Harwell-Boeing format. On
+    entry, its pattern must contain the pattern of the product. On exit, its
+    values are those of the product.
+    \return The number of products that are not in the pattern of \a C.
+  */
+  template <class Product, class T, class Prop, class Allocator>
+  int MltNumericRows(const Product& product, const int* weight, long work,
+		     Matrix<T, Prop, RowSparse, Allocator>& C)
+  {
+    int m = C.GetM();
+    int n = C.GetN();
+    const int* c_ptr = C.GetPtr();
+    const int* c_ind = C.GetInd();
+    T* c_val = C.GetData();
+
+    int nb_missing = 0;
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(work);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1) \
+  reduction(+:nb_missing)
 #endif
+    {
+      int begin, end;
+      GetThreadRange(weight, m, begin, end);
+      SparseRowAccumulator<T> acc(n, c_val);
 
-                // Reallocates 'c_ind' and 'c_data' in order to append the
-                // elements of the i-th row of C.
-                c_ind = reinterpret_cast<int*>
-                  (realloc(reinterpret_cast<void*>(c_ind),
-                           (Nnonzero + Nnonzero_row) * sizeof(int)));
-                c_data = reinterpret_cast<T2*>
-                  (C.GetAllocator().reallocate(c_data,
-                                               Nnonzero + Nnonzero_row));
+      for (int i = begin; i < end; i++)
+	{
+	  acc.Init(c_ptr[i], c_ptr[i + 1], c_ind);
+	  product.AddValues(i, acc);
+	  acc.Reset(c_ptr[i], c_ptr[i + 1], c_ind);
+	}
 
-#ifdef SELDON_CHECK_MEMORY
-              }
-            catch (...)
-              {
-                c_ind = NULL;
-                c_data = NULL;
-              }
+      nb_missing += acc.GetNbMissing();
+    }
 
-            if ((c_ind == NULL || c_data == NULL)
-                && Nnonzero + Nnonzero_row != 0)
-              throw NoMemory("Mlt(const Matrix<RowSparse>& A, const "
-                             "Matrix<RowSparse>& B, Matrix<RowSparse>& C)",
-                             "Unable to allocate memory for an array of "
-                             + to_str(Nnonzero + Nnonzero_row) + " integers "
-                             "and for an array of "
-                             + to_str(sizeof(T2) * (Nnonzero + Nnonzero_row))
-                             + " bytes.");
+    return nb_missing;
+  }
+
+
+  //! Computes the pattern of the product of two row-major sparse matrices.
+  /*! This is the symbolic pass of the product \f$ C = A B \f$: the non-zero
+    entries of \f$ C \f$ are found, and its values are set to zero. The
+    values are then computed by MltNumeric, which can be called again as
+    long as the patterns of \a A and \a B do not change.
+
+    Each row of \f$ C \f$ is the union of the rows of \f$ B \f$ selected by
+    the non-zero entries of the same row of \f$ A \f$. The rows are processed
+    in parallel by MltSymbolicRows.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] B row-major sparse matrix in Harwell-Boeing format.
+    \param[out] C row-major sparse matrix in Harwell-Boeing format, with the
+    pattern of the product of \a A with \a B, and zero values.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2>
+  void MltSymbolic(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+		   const Matrix<T1, Prop1, RowSparse, Allocator1>& B,
+		   Matrix<T2, Prop2, RowSparse, Allocator2>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, B, "MltSymbolic(const Matrix<RowSparse>& A, const "
+             "Matrix<RowSparse>& B, Matrix<RowSparse>& C)");
 #endif
 
-            c_ptr[i + 1] += Nnonzero_row;
-            for (h = 0; h < Nnonzero_row; h++)
-              {
-                c_ind[Nnonzero + h] = column_index(h);
-                c_data[Nnonzero + h] = row_value(h);
-              }
-            Nnonzero += Nnonzero_row;
-          }
-      }
+    // The work is estimated by the number of products.
+    const int* a_ind = A.GetInd();
+    const int* b_ptr = B.GetPtr();
+    long nb_product = 0;
+    for (int k = 0; k < A.GetNonZeros(); k++)
+      nb_product += b_ptr[a_ind[k] + 1] - b_ptr[a_ind[k]];
+
+    MltSymbolicRows(RowSparseProduct<T0, T1>(A, B), A.GetM(), B.GetN(),
+		    A.GetPtr(), nb_product + long(A.GetM()), C);
+  }
+
+
+  //! Computes the values of the product of two row-major sparse matrices.
+  /*! This is the numeric pass of the product \f$ C = A B \f$: the pattern of
+    \f$ C \f$ is given, usually computed by MltSymbolic, and only its values
+    are computed, in parallel, by MltNumericRows. It may be called again,
+    without any allocation, whenever the values of \a A or \a B change but
+    not their patterns.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] B row-major sparse matrix in Harwell-Boeing format.
+    \param[in,out] C row-major sparse matrix in Harwell-Boeing format. On
+    entry, its pattern must contain the pattern of the product of \a A with
+    \a B, and its column indices must be sorted in each row. On exit, its
+    values are those of the product.
+    \throw WrongArgument if the pattern of \a C does not contain the pattern
+    of the product.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2>
+  void MltNumeric(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+		  const Matrix<T1, Prop1, RowSparse, Allocator1>& B,
+		  Matrix<T2, Prop2, RowSparse, Allocator2>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, B, C, "MltNumeric(const Matrix<RowSparse>& A, const "
+             "Matrix<RowSparse>& B, Matrix<RowSparse>& C)");
+#endif
+
+    int nb_missing
+      = MltNumericRows(RowSparseProduct<T0, T1>(A, B), C.GetPtr(),
+		       long(A.GetNonZeros()) + long(C.GetNonZeros())
+		       + long(A.GetM()), C);
+
+    if (nb_missing > 0)
+      throw WrongArgument("MltNumeric(const Matrix<RowSparse>& A, const "
+			  "Matrix<RowSparse>& B, Matrix<RowSparse>& C)",
+			  to_str(nb_missing) + " products are not in the "
+			  "pattern of C.");
+  }
+
+
+  //! Multiplies two row-major sparse matrices in Harwell-Boeing format.
+  /*! It performs the operation \f$ C = A B \f$ where \f$ A \f$, \f$ B \f$ and
+    \f$ C \f$ are row-major sparse matrices in Harwell-Boeing format. The
+    pattern of \f$ C \f$ is computed by MltSymbolic, and its values by
+    MltNumeric.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] B row-major sparse matrix in Harwell-Boeing format.
+    \param[out] C row-major sparse matrix in Harwell-Boeing format, result of
+    the product of \a A with \a B. It does not need to have the right non-zero
+    entries.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2>
+  void Mlt(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	   const Matrix<T1, Prop1, RowSparse, Allocator1>& B,
+	   Matrix<T2, Prop2, RowSparse, Allocator2>& C)
+  {
+    MltSymbolic(A, B, C);
+    MltNumeric(A, B, C);
+  }
+
+
+  //! Computes the pattern of the Galerkin product of row-major sparse matrices.
+  /*! This is the symbolic pass of the product \f$ C = R A P \f$, e.g. the
+    coarse operator of a multigrid method: the non-zero entries of \f$ C \f$
+    are found, and its values are set to zero. The values are then computed
+    by MltNumeric(R, A, P, C), which can be called again as long as the
+    patterns of \a R, \a A and \a P do not change.
+
+    The product is fused: each row of \f$ C \f$ is obtained from the rows of
+    \f$ A \f$ selected by the row of \f$ R \f$, and from the rows of \f$ P
+    \f$ selected by these rows of \f$ A \f$, so that neither \f$ R A \f$ nor
+    \f$ A P \f$ is stored. The rows of \f$ C \f$ are processed in parallel by
+    MltSymbolicRows, and every thread only needs a dense array of the size
+    of the number of columns of \f$ C \f$.
+    \param[in] R row-major sparse matrix in Harwell-Boeing format.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] P row-major sparse matrix in Harwell-Boeing format.
+    \param[out] C row-major sparse matrix in Harwell-Boeing format, with the
+    pattern of the product \a R \a A \a P, and zero values.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3, class Prop3, class Allocator3>
+  void MltSymbolic(const Matrix<T0, Prop0, RowSparse, Allocator0>& R,
+		   const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+		   const Matrix<T2, Prop2, RowSparse, Allocator2>& P,
+		   Matrix<T3, Prop3, RowSparse, Allocator3>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(R, A, "MltSymbolic(const Matrix<RowSparse>& R, const "
+             "Matrix<RowSparse>& A, const Matrix<RowSparse>& P, "
+	     "Matrix<RowSparse>& C)");
+    CheckDim(A, P, "MltSymbolic(const Matrix<RowSparse>& R, const "
+             "Matrix<RowSparse>& A, const Matrix<RowSparse>& P, "
+	     "Matrix<RowSparse>& C)");
+#endif
+
+    MltSymbolicRows(RowSparseTripleProduct<T0, T1, T2, T3>(R, A, P), R.GetM(),
+		    P.GetN(), R.GetPtr(), long(R.GetNonZeros())
+		    + long(A.GetNonZeros()) + long(R.GetM()), C);
+  }
+
+
+  //! Computes the values of the Galerkin product of row-major sparse matrices.
+  /*! This is the numeric pass of the product \f$ C = R A P \f$: the pattern
+    of \f$ C \f$ is given, usually computed by MltSymbolic(R, A, P, C), and
+    only its values are computed. It may be called again, without any
+    allocation, whenever the values of \a R, \a A or \a P change but not
+    their patterns.
+
+    As in MltSymbolic(R, A, P, C), the product is fused and neither \f$ R A
+    \f$ nor \f$ A P \f$ is stored: for each row i of \f$ C \f$, the products
+    \f$ R_{ik} A_{kj} P_{jl} \f$ are added directly to the values of \f$ C
+    \f$ by MltNumericRows.
+    \param[in] R row-major sparse matrix in Harwell-Boeing format.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] P row-major sparse matrix in Harwell-Boeing format.
+    \param[in,out] C row-major sparse matrix in Harwell-Boeing format. On
+    entry, its pattern must contain the pattern of the product \a R \a A \a
+    P. On exit, its values are those of the product.
+    \throw WrongArgument if the pattern of \a C does not contain the pattern
+    of the product.
+  */
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3, class Prop3, class Allocator3>
+  void MltNumeric(const Matrix<T0, Prop0, RowSparse, Allocator0>& R,
+		  const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+		  const Matrix<T2, Prop2, RowSparse, Allocator2>& P,
+		  Matrix<T3, Prop3, RowSparse, Allocator3>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(R, A, P, C, "MltNumeric(const Matrix<RowSparse>& R, const "
+	     "Matrix<RowSparse>& A, const Matrix<RowSparse>& P, "
+	     "Matrix<RowSparse>& C)");
+#endif
 
-    C.SetData(A.GetM(), B.GetN(), Nnonzero, c_data, c_ptr, c_ind);
+    int nb_missing
+      = MltNumericRows(RowSparseTripleProduct<T0, T1, T2, T3>(R, A, P),
+		       R.GetPtr(), long(R.GetNonZeros())
+		       + long(A.GetNonZeros()) + long(C.GetNonZeros())
+		       + long(R.GetM()), C);
+
+    if (nb_missing > 0)
+      throw WrongArgument("MltNumeric(const Matrix<RowSparse>& R, const "
+			  "Matrix<RowSparse>& A, const Matrix<RowSparse>& P, "
+			  "Matrix<RowSparse>& C)",
+			  to_str(nb_missing) + " products are not in the "
+			  "pattern of C.");
   }
 
 
@@ -449,6 +883,10 @@ namespace Seldon
   //! Multiplies two row-major sparse matrices in Harwell-Boeing format.
   /*! It performs the operation \f$ C = A B^T \f$ where \f$ A \f$, \f$ B \f$
     and \f$ C \f$ are row-major sparse matrices in Harwell-Boeing format.
+    \f$ B^T \f$ is first built in the row-major sparse format, and the
+    product is computed by Mlt. In order to compute the product again with
+    new values but the same patterns, MltNumeric may be called directly with
+    \f$ B^T \f$.
     \param[in] A row-major sparse matrix in Harwell-Boeing format.
     \param[in] B row-major sparse matrix in Harwell-Boeing format.
     \param[out] C row-major sparse matrix in Harwell-Boeing format, result of
@@ -468,139 +906,295 @@ namespace Seldon
              "const Matrix<RowSparse>& B, Matrix<RowSparse>& C)");
 #endif
 
-    int h, i, k, col;
-    int ib, kb;
-    int Nnonzero_row;
-    int Nnonzero;
+    // Transposition of B, with a counting sort of its entries by column.
+    int m = B.GetM();
+    int n = B.GetN();
+    int nnz = B.GetNonZeros();
+    Vector<int, VectFull, CallocAlloc<int> > ptr(n + 1), ind(nnz);
+    Vector<T1, VectFull, Allocator1> val(nnz);
+    ptr.Zero();
+    for (int k = 0; k < nnz; k++)
+      ptr(B.GetInd()[k] + 1)++;
+    for (int j = 0; j < n; j++)
+      ptr(j + 1) += ptr(j);
+    for (int i = 0; i < m; i++)
+      for (int k = B.GetPtr()[i]; k < B.GetPtr()[i + 1]; k++)
+	{
+	  int p = ptr(B.GetInd()[k])++;
+	  ind(p) = i;
+	  val(p) = B.GetData()[k];
+	}
+    for (int j = n; j > 0; j--)
+      ptr(j) = ptr(j - 1);
+    ptr(0) = 0;
 
-    // 'MallocAlloc' is specified so that reallocations may be efficient.
-    // There will be no need for 'Resize': 'Reallocate' will do the job.
-    Vector<int, VectFull, MallocAlloc<int> > column_index;
-    Vector<T2, VectFull, MallocAlloc<T2> > row_value;
-    T2 value = 0;
+    Matrix<T1, General, RowSparse, Allocator1> Bt;
+    Bt.SetData(n, m, val, ptr, ind);
 
-    int m = A.GetM();
-    int n = B.GetM();
+    Mlt(A, Bt, C);
+  }
 
-    int* c_ptr = NULL;
-    int* c_ind = NULL;
-    T2* c_data = NULL;
 
-#ifdef SELDON_CHECK_MEMORY
-    try
-      {
-#endif
+  // MLT //
+  /////////
 
-	c_ptr = reinterpret_cast<int*>(calloc(m + 1, sizeof(int)));
 
-#ifdef SELDON_CHECK_MEMORY
-      }
-    catch (...)
+  ////////////
+  // MLTADD //
+
+
+  //! Multiplies two packed panels, and adds the result to a block of C.
+  /*! It computes the product of a panel of \a MR rows of A with a panel of \a
+    NR columns of B, over \a kc columns of A. The product is accumulated in a
+    local array of MR x NR entries, which the compiler can keep in registers,
+    and is then added (times \a alpha) to the block of C. Since the panels
+    are padded with zeros, only the first \a mr rows and \a nr columns of the
+    accumulated block are written.
+    \param[in] kc number of columns of the panel of A.
+    \param[in] alpha scalar.
+    \param[in] a panel of A, packed column by column (MR entries per column).
+    \param[in] b panel of B, packed row by row (NR entries per row).
+    \param[in] mr number of rows of the block of C.
+    \param[in] nr number of columns of the block of C.
+    \param[in,out] c first entry of the block of C.
+    \param[in] rsc distance between two rows of C.
+    \param[in] csc distance between two columns of C.
+  */
+  template <int MR, int NR, class T0, class T>
+  void MltAddBlockedKernel(int kc, const T0& alpha,
+                           const T* a, const T* b, int mr, int nr,
+                           T* c, long rsc, long csc)
+  {
+    int i, j, l;
+    T ab[MR][NR];
+    for (i = 0; i < MR; i++)
+      for (j = 0; j < NR; j++)
+        ab[i][j] = T(0);
+
+    for (l = 0; l < kc; l++)
       {
-        c_ptr = NULL;
+        for (i = 0; i < MR; i++)
+          {
+            T a_i = a[i];
+            for (j = 0; j < NR; j++)
+              ab[i][j] += a_i * b[j];
+          }
+        a += MR;
+        b += NR;
       }
 
-    if (c_ptr == NULL)
-      throw NoMemory("MltNoTransTrans(const Matrix<RowSparse>& A, "
-                     "const Matrix<RowSparse>& B, Matrix<RowSparse>& C)",
-		     "Unable to allocate memory for an array of "
-		     + to_str(m + 1) + " integers.");
-#endif
-
-    c_ptr[0] = 0;
+    for (i = 0; i < mr; i++)
+      for (j = 0; j < nr; j++)
+        c[i * rsc + j * csc] += alpha * ab[i][j];
+  }
 
-    // Number of non-zero elements in C.
-    Nnonzero = 0;
 
-    for (i = 0; i < m; i++)
+  //! Multiplies two packed complex panels, and adds the result to a block
+  //! of C.
+  /*! The real and imaginary parts of the product are accumulated in two
+    separate arrays, so that the inner loop only involves real
+    multiplications and additions, which the compiler vectorizes. This also
+    avoids the special treatment of infinite values in the complex
+    multiplication.
+    \param[in] kc number of columns of the panel of A.
+    \param[in] alpha scalar.
+    \param[in] a panel of A, packed column by column (MR entries per column).
+    \param[in] b panel of B, packed row by row (NR entries per row).
+    \param[in] mr number of rows of the block of C.
+    \param[in] nr number of columns of the block of C.
+    \param[in,out] c first entry of the block of C.
+    \param[in] rsc distance between two rows of C.
+    \param[in] csc distance between two columns of C.
+  */
+  template <int MR, int NR, class T0, class T>
+  void MltAddBlockedKernel(int kc, const T0& alpha,
+                           const complex<T>* a, const complex<T>* b,
+                           int mr, int nr,
+                           complex<T>* c, long rsc, long csc)
+  {
+    int i, j, l;
+    T ab_real[MR][NR], ab_imag[MR][NR], b_real[NR], b_imag[NR];
+    for (i = 0; i < MR; i++)
+      for (j = 0; j < NR; j++)
+        {
+          ab_real[i][j] = T(0);
+          ab_imag[i][j] = T(0);
+        }
+
+    for (l = 0; l < kc; l++)
       {
-        c_ptr[i + 1] = c_ptr[i];
-
-        if (A.GetPtr()[i + 1] != A.GetPtr()[i])
-          // There are elements in the i-th row of A, so there can be non-zero
-          // entries in C as well. It is checked below whether any row in B
-          // has an element whose row index matches a column index of a
-          // non-zero in the i-th row of A.
+        for (j = 0; j < NR; j++)
+          {
+            b_real[j] = real(b[j]);
+            b_imag[j] = imag(b[j]);
+          }
+        for (i = 0; i < MR; i++)
           {
-            // For every element in the i-th row.
-            for (k = A.GetPtr()[i]; k < A.GetPtr()[i + 1]; k++)
+            T a_real = real(a[i]);
+            T a_imag = imag(a[i]);
+            for (j = 0; j < NR; j++)
               {
-                col = A.GetInd()[k];
-                // For every row in B.
-                for (ib = 0; ib < n; ib++)
-                  {
-                    for (kb = B.GetPtr()[ib]; kb < B.GetPtr()[ib + 1]; kb++)
-                      if (col == B.GetInd()[kb])
-                        value += A.GetData()[k] * B.GetData()[kb];
-                    if (value != T2(0))
-                      {
-                        row_value.Append(value);
-                        column_index.Append(ib);
-                        value = T2(0);
-                      }
-                  }
+                ab_real[i][j] += a_real * b_real[j] - a_imag * b_imag[j];
+                ab_imag[i][j] += a_real * b_imag[j] + a_imag * b_real[j];
               }
+          }
+        a += MR;
+        b += NR;
+      }
 
-            Nnonzero_row = column_index.GetLength();
-            Assemble(Nnonzero_row, column_index, row_value);
+    for (i = 0; i < mr; i++)
+      for (j = 0; j < nr; j++)
+        c[i * rsc + j * csc] += alpha * complex<T>(ab_real[i][j],
+                                                   ab_imag[i][j]);
+  }
 
-#ifdef SELDON_CHECK_MEMORY
-            try
-              {
-#endif
 
-                // Reallocates 'c_ind' and 'c_data' in order to append the
-                // elements of the i-th row of C.
-                c_ind = reinterpret_cast<int*>
-                  (realloc(reinterpret_cast<void*>(c_ind),
-                           (Nnonzero + Nnonzero_row) * sizeof(int)));
-                c_data = reinterpret_cast<T2*>
-                  (C.GetAllocator().reallocate(c_data,
-                                               Nnonzero + Nnonzero_row));
+  //! Multiplies two dense matrices, and adds the result to a third matrix.
+  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$ on matrices
+    given by their arrays of values and their strides, so that row-major,
+    column-major and transposed matrices are all handled. The entry (i, j) of
+    A is a[i * rsa + j * csa], and similarly for B and C.
 
-#ifdef SELDON_CHECK_MEMORY
-              }
-            catch (...)
-              {
-                c_ind = NULL;
-                c_data = NULL;
-              }
+    The product is blocked as in optimized BLAS implementations: blocks of
+    \a KC rows and \a NC columns of B are packed into a buffer shared by all
+    threads, blocks of \a MC rows and \a KC columns of A are packed into a
+    buffer owned by each thread, and the products of the packed panels are
+    computed by MltAddBlockedKernel. The block sizes are given by
+    GemmBlockSize<T4>. The blocks of rows of C are split among the threads.
+    \param[in] alpha scalar.
+    \param[in] m number of rows of A and C.
+    \param[in] n number of columns of B and C.
+    \param[in] k number of columns of A and rows of B.
+    \param[in] a values of A.
+    \param[in] rsa distance between two rows of A.
+    \param[in] csa distance between two columns of A.
+    \param[in] b values of B.
+    \param[in] rsb distance between two rows of B.
+    \param[in] csb distance between two columns of B.
+    \param[in] beta scalar.
+    \param[in,out] c values of C.
+    \param[in] rsc distance between two rows of C.
+    \param[in] csc distance between two columns of C.
+  */
+  template <class T0, class T1, class T2, class T3, class T4>
+  void MltAddBlocked(const T0 alpha, int m, int n, int k,
+                     const T1* a, long rsa, long csa,
+                     const T2* b, long rsb, long csb,
+                     const T3 beta, T4* c, long rsc, long csc)
+  {
+    const int MR = GemmBlockSize<T4>::MR;
+    const int NR = GemmBlockSize<T4>::NR;
+    const int KC = GemmBlockSize<T4>::KC;
+    const int MC = GemmBlockSize<T4>::MC;
+    const int NC = GemmBlockSize<T4>::NC;
 
-            if ((c_ind == NULL || c_data == NULL)
-                && Nnonzero_row != 0)
-              throw NoMemory("MltNoTransTrans(const Matrix<RowSparse>& A, "
-                             "const Matrix<RowSparse>& B, "
-                             "Matrix<RowSparse>& C)",
-                             "Unable to allocate memory for an array of "
-                             + to_str(Nnonzero + Nnonzero_row) + " integers "
-                             "and for an array of "
-                             + to_str(sizeof(T2) * (Nnonzero + Nnonzero_row))
-                             + " bytes.");
-#endif
+    T4 alpha_(alpha);
+    T4 beta_(beta);
 
-            c_ptr[i + 1] += Nnonzero_row;
-            for (h = 0; h < Nnonzero_row; h++)
-              {
-                c_ind[Nnonzero + h] = column_index(h);
-                c_data[Nnonzero + h] = row_value(h);
-              }
-            Nnonzero += Nnonzero_row;
-          }
+    if (beta_ == T4(0))
+      for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+          c[i * rsc + j * csc] = T4(0);
+    else if (beta_ != T4(1))
+      for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+          c[i * rsc + j * csc] *= beta_;
 
-        column_index.Clear();
-        row_value.Clear();
-      }
+    if (m == 0 || n == 0 || k == 0 || alpha_ == T4(0))
+      return;
 
-    C.SetData(A.GetM(), B.GetM(), Nnonzero, c_data, c_ptr, c_ind);
-  }
+    int nb_thread = GetNumberThreads(long(m) * long(n) * long(k));
 
+    // The rows of C are split into blocks of at most MC rows, with enough
+    // blocks to keep all threads busy.
+    int mc_block = (m + nb_thread - 1) / nb_thread;
+    mc_block = min(MC, ((mc_block + MR - 1) / MR) * MR);
+    int nb_block = (m + mc_block - 1) / mc_block;
 
-  // MLT //
-  /////////
+    int nc_max = min(NC, ((n + NR - 1) / NR) * NR);
+    Vector<T4> buffer_b(long(min(KC, k)) * nc_max);
+    T4* b_pack = buffer_b.GetData();
 
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, j, l, ic, jc, pc, ir, jr, mc, nc, kc, p, p_begin, p_end;
+      Vector<T4> buffer_a(long(min(KC, k)) * mc_block);
+      T4* a_pack = buffer_a.GetData();
+
+      for (jc = 0; jc < n; jc += NC)
+        {
+          nc = min(NC, n - jc);
+          int nb_panel_b = (nc + NR - 1) / NR;
+          for (pc = 0; pc < k; pc += KC)
+            {
+              kc = min(KC, k - pc);
+
+              // Packs the block of B into panels of NR columns, padded with
+              // zeros.
+              GetThreadRange(nb_panel_b, p_begin, p_end);
+              for (p = p_begin; p < p_end; p++)
+                {
+                  T4* dest = b_pack + long(p) * NR * kc;
+                  int nr = min(NR, nc - p * NR);
+                  const T2* src = b + pc * rsb + (jc + p * NR) * csb;
+                  for (l = 0; l < kc; l++)
+                    {
+                      for (j = 0; j < nr; j++)
+                        dest[j] = T4(src[j * csb]);
+                      for (j = nr; j < NR; j++)
+                        dest[j] = T4(0);
+                      src += rsb;
+                      dest += NR;
+                    }
+                }
+#ifdef SELDON_WITH_OPENMP
+#pragma omp barrier
+#endif
 
-  ////////////
-  // MLTADD //
+              int b_begin, b_end;
+              GetThreadRange(nb_block, b_begin, b_end);
+              for (int block = b_begin; block < b_end; block++)
+                {
+                  ic = block * mc_block;
+                  mc = min(mc_block, m - ic);
+
+                  // Packs the block of A into panels of MR rows, padded with
+                  // zeros.
+                  for (p = 0; p < (mc + MR - 1) / MR; p++)
+                    {
+                      T4* dest = a_pack + long(p) * MR * kc;
+                      int mr = min(MR, mc - p * MR);
+                      const T1* src = a + (ic + p * MR) * rsa + pc * csa;
+                      for (l = 0; l < kc; l++)
+                        {
+                          for (i = 0; i < mr; i++)
+                            dest[i] = T4(src[i * rsa]);
+                          for (i = mr; i < MR; i++)
+                            dest[i] = T4(0);
+                          src += csa;
+                          dest += MR;
+                        }
+                    }
+
+                  for (jr = 0; jr < nc; jr += NR)
+                    for (ir = 0; ir < mc; ir += MR)
+                      MltAddBlockedKernel<MR, NR>
+                        (kc, alpha_, a_pack + long(ir) * kc,
+                         b_pack + long(jr) * kc,
+                         min(MR, mc - ir), min(NR, nc - jr),
+                         c + (ic + ir) * rsc + (jc + jr) * csc, rsc, csc);
+                }
+
+              // The buffer of B is overwritten at the next iteration.
+#ifdef SELDON_WITH_OPENMP
+#pragma omp barrier
+#endif
+            }
+        }
+    }
+  }
 
 
   //! Multiplies two matrices, and adds the result to a third matrix.
@@ -660,91 +1254,260 @@ namespace Seldon
   }
 
 
-  //! Multiplies two matrices, and adds the result to a third matrix.
-  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$
-    or \f$C = \alpha A B^T + \beta C \f$, where \f$
-    \alpha \f$ and \f$ \beta \f$ are scalars, and \f$ A \f$, \f$ B \f$ and \f$
-    C \f$ are matrices.
+  //! Multiplies two matrices, and adds the result to a third matrix.
+  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$
+    or \f$C = \alpha A B^T + \beta C \f$, where \f$
+    \alpha \f$ and \f$ \beta \f$ are scalars, and \f$ A \f$, \f$ B \f$ and \f$
+    C \f$ are matrices.
+    \param[in] alpha scalar.
+    \param[in] TransA status of A: it must be SeldonNoTrans. This argument
+    is required for consistency with the interface for full matrices.
+    \param[in] A matrix.
+    \param[in] TransB status of B: SeldonNoTrans or SeldonTrans.
+    \param[in] B matrix.
+    \param[in] beta scalar.
+    \param[in,out] C matrix, result of the product of \a A with \a B or \a
+    B^T, times \a alpha, plus \a beta times \a C.
+  */
+  template <class T0,
+	    class T1, class Prop1, class Storage1, class Allocator1,
+	    class T2, class Prop2, class Storage2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Storage4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& TransA,
+	      const Matrix<T1, Prop1, Storage1, Allocator1>& A,
+	      const SeldonTranspose& TransB,
+	      const Matrix<T2, Prop2, Storage2, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, Storage4, Allocator4>& C)
+  {
+    if (!TransA.NoTrans())
+      throw WrongArgument("MltAdd(const T0 alpha, SeldonTranspose TransA, "
+                          "const Matrix<T1, Prop1, Storage1, Allocator1>& A"
+                          "SeldonTranspose TransB,"
+                          "const Matrix<T2, Prop2, Storage2, Allocator2>& B,"
+                          "const T3 beta,"
+                          "Matrix<T4, Prop4, Storage4, Allocator4>& C)",
+                          "'TransA' must be equal to 'SeldonNoTrans'.");
+    if (!TransB.NoTrans() && !TransB.Trans())
+      throw WrongArgument("MltAdd(const T0 alpha, SeldonTranspose TransA, "
+                          "const Matrix<T1, Prop1, Storage1, Allocator1>& A"
+                          "SeldonTranspose TransB,"
+                          "const Matrix<T2, Prop2, Storage2, Allocator2>& B,"
+                          "const T3 beta,"
+                          "Matrix<T4, Prop4, Storage4, Allocator4>& C)",
+                          "'TransB' must be equal to 'SeldonNoTrans' or "
+                          "'SeldonTrans'.");
+
+    if (!TransB.Trans())
+      MltAdd(alpha, A, B, beta, C);
+    else
+      {
+
+        int na = A.GetN();
+        int mc = C.GetM();
+        int nc = C.GetN();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+        CheckDim(SeldonNoTrans, A, SeldonTrans, B, C,
+                 "MltAdd(alpha, TransA, A, TransB, B, beta, C)");
+#endif
+
+        T4 temp;
+        T4 alpha_(alpha);
+        T4 beta_(beta);
+
+        if (beta_ != T4(0))
+          for (int i = 0; i < Storage4::GetFirst(mc, nc); i++)
+            for (int j = 0; j < Storage4::GetSecond(mc, nc); j++)
+              C(Storage4::GetFirst(i, j), Storage4::GetSecond(i, j))
+                *= beta_;
+        else
+          for (int i = 0; i < Storage4::GetFirst(mc, nc); i++)
+            for (int j = 0; j < Storage4::GetSecond(mc, nc); j++)
+              C(Storage4::GetFirst(i, j), Storage4::GetSecond(i, j)) = T4(0);
+
+        for (int i = 0; i < Storage4::GetFirst(mc, nc); i++)
+          for (int j = 0; j < Storage4::GetSecond(mc, nc); j++)
+            {
+              temp = T4(0);
+              for (int k = 0; k < na; k++)
+                temp += A(Storage4::GetFirst(i, j), k)
+                  * B(Storage4::GetSecond(i, j), k);
+              C(Storage4::GetFirst(i, j), Storage4::GetSecond(i, j))
+                += alpha_ * temp;
+            }
+      }
+  }
+
+
+  //! Multiplies two row-major matrices, and adds the result to a third one.
+  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$ where \f$
+    \alpha \f$ and \f$ \beta \f$ are scalars, and \f$ A \f$, \f$ B \f$ and \f$
+    C \f$ are row-major matrices. The product is computed by MltAddBlocked.
+    \param[in] alpha scalar.
+    \param[in] A matrix.
+    \param[in] B matrix.
+    \param[in] beta scalar.
+    \param[in,out] C matrix, result of the product of \a A with \a B, times \a
+    alpha, plus \a beta times \a C.
+  */
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowMajor, Allocator1>& A,
+	      const Matrix<T2, Prop2, RowMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, RowMajor, Allocator4>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, B, C, "MltAdd(alpha, A, B, beta, C)");
+#endif
+
+    MltAddBlocked(alpha, C.GetM(), C.GetN(), A.GetN(),
+                  A.GetData(), long(A.GetN()), 1L,
+                  B.GetData(), long(B.GetN()), 1L,
+                  beta, C.GetData(), long(C.GetN()), 1L);
+  }
+
+
+  //! Multiplies two column-major matrices, and adds the result to a third
+  //! one.
+  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$ where \f$
+    \alpha \f$ and \f$ \beta \f$ are scalars, and \f$ A \f$, \f$ B \f$ and \f$
+    C \f$ are column-major matrices. The product is computed by
+    MltAddBlocked.
+    \param[in] alpha scalar.
+    \param[in] A matrix.
+    \param[in] B matrix.
+    \param[in] beta scalar.
+    \param[in,out] C matrix, result of the product of \a A with \a B, times \a
+    alpha, plus \a beta times \a C.
+  */
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColMajor, Allocator1>& A,
+	      const Matrix<T2, Prop2, ColMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, ColMajor, Allocator4>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, B, C, "MltAdd(alpha, A, B, beta, C)");
+#endif
+
+    MltAddBlocked(alpha, C.GetM(), C.GetN(), A.GetN(),
+                  A.GetData(), 1L, long(A.GetM()),
+                  B.GetData(), 1L, long(B.GetM()),
+                  beta, C.GetData(), 1L, long(C.GetM()));
+  }
+
+
+  //! Multiplies two row-major matrices, and adds the result to a third one.
+  /*! It performs the operation \f$ C = \alpha op(A) op(B) + \beta C \f$,
+    where \f$ op(X) \f$ is \f$ X \f$ or \f$ X^T \f$, \f$ \alpha \f$ and \f$
+    \beta \f$ are scalars, and \f$ A \f$, \f$ B \f$ and \f$ C \f$ are
+    row-major matrices. The transposition only swaps the strides given to
+    MltAddBlocked, so that no matrix is copied.
+    \param[in] alpha scalar.
+    \param[in] TransA status of A: SeldonNoTrans or SeldonTrans.
+    \param[in] A matrix.
+    \param[in] TransB status of B: SeldonNoTrans or SeldonTrans.
+    \param[in] B matrix.
+    \param[in] beta scalar.
+    \param[in,out] C matrix, result of the product of \a op(A) with \a
+    op(B), times \a alpha, plus \a beta times \a C.
+  */
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& TransA,
+	      const Matrix<T1, Prop1, RowMajor, Allocator1>& A,
+	      const SeldonTranspose& TransB,
+	      const Matrix<T2, Prop2, RowMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, RowMajor, Allocator4>& C)
+  {
+    if (TransA.ConjTrans() || TransB.ConjTrans())
+      throw WrongArgument("MltAdd(alpha, TransA, A, TransB, B, beta, C)",
+                          "Complex conjugation not supported.");
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(TransA, A, TransB, B, C,
+             "MltAdd(alpha, TransA, A, TransB, B, beta, C)");
+#endif
+
+    long rsa = A.GetN(), csa = 1L, rsb = B.GetN(), csb = 1L;
+    if (TransA.Trans())
+      swap(rsa, csa);
+    if (TransB.Trans())
+      swap(rsb, csb);
+
+    MltAddBlocked(alpha, C.GetM(), C.GetN(),
+                  TransA.Trans() ? A.GetM() : A.GetN(),
+                  A.GetData(), rsa, csa, B.GetData(), rsb, csb,
+                  beta, C.GetData(), long(C.GetN()), 1L);
+  }
+
+
+  //! Multiplies two column-major matrices, and adds the result to a third
+  //! one.
+  /*! It performs the operation \f$ C = \alpha op(A) op(B) + \beta C \f$,
+    where \f$ op(X) \f$ is \f$ X \f$ or \f$ X^T \f$, \f$ \alpha \f$ and \f$
+    \beta \f$ are scalars, and \f$ A \f$, \f$ B \f$ and \f$ C \f$ are
+    column-major matrices. The transposition only swaps the strides given to
+    MltAddBlocked, so that no matrix is copied.
     \param[in] alpha scalar.
-    \param[in] TransA status of A: it must be SeldonNoTrans. This argument
-    is required for consistency with the interface for full matrices.
+    \param[in] TransA status of A: SeldonNoTrans or SeldonTrans.
     \param[in] A matrix.
     \param[in] TransB status of B: SeldonNoTrans or SeldonTrans.
     \param[in] B matrix.
     \param[in] beta scalar.
-    \param[in,out] C matrix, result of the product of \a A with \a B or \a
-    B^T, times \a alpha, plus \a beta times \a C.
+    \param[in,out] C matrix, result of the product of \a op(A) with \a
+    op(B), times \a alpha, plus \a beta times \a C.
   */
   template <class T0,
-	    class T1, class Prop1, class Storage1, class Allocator1,
-	    class T2, class Prop2, class Storage2, class Allocator2,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
 	    class T3,
-	    class T4, class Prop4, class Storage4, class Allocator4>
+	    class T4, class Prop4, class Allocator4>
   void MltAdd(const T0 alpha,
 	      const SeldonTranspose& TransA,
-	      const Matrix<T1, Prop1, Storage1, Allocator1>& A,
+	      const Matrix<T1, Prop1, ColMajor, Allocator1>& A,
 	      const SeldonTranspose& TransB,
-	      const Matrix<T2, Prop2, Storage2, Allocator2>& B,
+	      const Matrix<T2, Prop2, ColMajor, Allocator2>& B,
 	      const T3 beta,
-	      Matrix<T4, Prop4, Storage4, Allocator4>& C)
+	      Matrix<T4, Prop4, ColMajor, Allocator4>& C)
   {
-    if (!TransA.NoTrans())
-      throw WrongArgument("MltAdd(const T0 alpha, SeldonTranspose TransA, "
-                          "const Matrix<T1, Prop1, Storage1, Allocator1>& A"
-                          "SeldonTranspose TransB,"
-                          "const Matrix<T2, Prop2, Storage2, Allocator2>& B,"
-                          "const T3 beta,"
-                          "Matrix<T4, Prop4, Storage4, Allocator4>& C)",
-                          "'TransA' must be equal to 'SeldonNoTrans'.");
-    if (!TransB.NoTrans() && !TransB.Trans())
-      throw WrongArgument("MltAdd(const T0 alpha, SeldonTranspose TransA, "
-                          "const Matrix<T1, Prop1, Storage1, Allocator1>& A"
-                          "SeldonTranspose TransB,"
-                          "const Matrix<T2, Prop2, Storage2, Allocator2>& B,"
-                          "const T3 beta,"
-                          "Matrix<T4, Prop4, Storage4, Allocator4>& C)",
-                          "'TransB' must be equal to 'SeldonNoTrans' or "
-                          "'SeldonTrans'.");
-
-    if (!TransB.Trans())
-      MltAdd(alpha, A, B, beta, C);
-    else
-      {
-
-        int na = A.GetN();
-        int mc = C.GetM();
-        int nc = C.GetN();
+    if (TransA.ConjTrans() || TransB.ConjTrans())
+      throw WrongArgument("MltAdd(alpha, TransA, A, TransB, B, beta, C)",
+                          "Complex conjugation not supported.");
 
 #ifdef SELDON_CHECK_DIMENSIONS
-        CheckDim(SeldonNoTrans, A, SeldonTrans, B, C,
-                 "MltAdd(alpha, TransA, A, TransB, B, beta, C)");
+    CheckDim(TransA, A, TransB, B, C,
+             "MltAdd(alpha, TransA, A, TransB, B, beta, C)");
 #endif
 
-        T4 temp;
-        T4 alpha_(alpha);
-        T4 beta_(beta);
-
-        if (beta_ != T4(0))
-          for (int i = 0; i < Storage4::GetFirst(mc, nc); i++)
-            for (int j = 0; j < Storage4::GetSecond(mc, nc); j++)
-              C(Storage4::GetFirst(i, j), Storage4::GetSecond(i, j))
-                *= beta_;
-        else
-          for (int i = 0; i < Storage4::GetFirst(mc, nc); i++)
-            for (int j = 0; j < Storage4::GetSecond(mc, nc); j++)
-              C(Storage4::GetFirst(i, j), Storage4::GetSecond(i, j)) = T4(0);
+    long rsa = 1L, csa = A.GetM(), rsb = 1L, csb = B.GetM();
+    if (TransA.Trans())
+      swap(rsa, csa);
+    if (TransB.Trans())
+      swap(rsb, csb);
 
-        for (int i = 0; i < Storage4::GetFirst(mc, nc); i++)
-          for (int j = 0; j < Storage4::GetSecond(mc, nc); j++)
-            {
-              temp = T4(0);
-              for (int k = 0; k < na; k++)
-                temp += A(Storage4::GetFirst(i, j), k)
-                  * B(Storage4::GetSecond(i, j), k);
-              C(Storage4::GetFirst(i, j), Storage4::GetSecond(i, j))
-                += alpha_ * temp;
-            }
-      }
+    MltAddBlocked(alpha, C.GetM(), C.GetN(),
+                  TransA.Trans() ? A.GetM() : A.GetN(),
+                  A.GetData(), rsa, csa, B.GetData(), rsb, csb,
+                  beta, C.GetData(), 1L, long(C.GetM()));
   }
 
 
@@ -1344,6 +2107,166 @@ namespace Seldon
   }
 
 
+  /*! \brief Multiplies a row-major sparse matrix with a row-major matrix and
+    adds the result to a third. */
+  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$ where \f$ A
+    \f$ is a row-major sparse matrix in Harwell-Boeing format, and \f$ B \f$
+    and \f$ C \f$ are row-major dense matrices (e.g. several right-hand sides
+    stored row by row). The sparse matrix is read only once for all the
+    columns of \a B: each non-zero entry of \a A multiplies a whole row of \a
+    B, which is contiguous in memory so that the loop over the columns is
+    vectorized. The rows of \a A are split among the threads so that each
+    thread processes about the same number of non-zero entries. Every column
+    of \a C is computed exactly as in the sparse matrix-vector product.
+    \param[in] alpha scalar.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] B row-major dense matrix.
+    \param[in] beta scalar.
+    \param[in,out] C row-major dense matrix. On exit, it is equal to \f$
+    \alpha A B + \beta C \f$.
+  */
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+            class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+              const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+              const Matrix<T2, Prop2, RowMajor, Allocator2>& B,
+              const T3 beta,
+              Matrix<T4, Prop4, RowMajor, Allocator4>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, B, C, "MltAdd(alpha, A, B, beta, C)");
+#endif
+
+    int ma = A.GetM();
+    int nrhs = B.GetN();
+    int* ptr = A.GetPtr();
+    int* ind = A.GetInd();
+    T1* data = A.GetData();
+    T2* b = B.GetData();
+    T4* c = C.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(ma) * nrhs
+                                     + long(A.GetDataSize()) * nrhs);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, k, r, i_begin, i_end;
+      Vector<T4> temp_vector(nrhs);
+      T4* temp = temp_vector.GetData();
+      T1 a;
+      const T2* b_row;
+      T4* c_row;
+
+      GetThreadRange(ptr, ma, i_begin, i_end);
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp_vector.Zero();
+          for (k = ptr[i]; k < ptr[i + 1]; k++)
+            {
+              a = data[k];
+              b_row = b + long(ind[k]) * nrhs;
+              for (r = 0; r < nrhs; r++)
+                temp[r] += a * b_row[r];
+            }
+
+          c_row = c + long(i) * nrhs;
+          if (beta == T3(0))
+            for (r = 0; r < nrhs; r++)
+              c_row[r] = alpha * temp[r];
+          else
+            for (r = 0; r < nrhs; r++)
+              {
+                c_row[r] *= beta;
+                c_row[r] += alpha * temp[r];
+              }
+        }
+    }
+  }
+
+
+  /*! \brief Multiplies a row-major sparse matrix with a column-major matrix
+    and adds the result to a third. */
+  /*! It performs the operation \f$ C = \alpha A B + \beta C \f$ where \f$ A
+    \f$ is a row-major sparse matrix in Harwell-Boeing format, and \f$ B \f$
+    and \f$ C \f$ are column-major dense matrices (e.g. several right-hand
+    sides stored one after the other). The sparse matrix is read only once
+    for all the columns of \a B, and the rows of \a A are split among the
+    threads as in the sparse matrix-vector product. Since the entries of a row
+    of \a B are not contiguous, row-major matrices should be preferred when
+    the number of columns is large.
+    \param[in] alpha scalar.
+    \param[in] A row-major sparse matrix in Harwell-Boeing format.
+    \param[in] B column-major dense matrix.
+    \param[in] beta scalar.
+    \param[in,out] C column-major dense matrix. On exit, it is equal to \f$
+    \alpha A B + \beta C \f$.
+  */
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+            class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+              const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+              const Matrix<T2, Prop2, ColMajor, Allocator2>& B,
+              const T3 beta,
+              Matrix<T4, Prop4, ColMajor, Allocator4>& C)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(A, B, C, "MltAdd(alpha, A, B, beta, C)");
+#endif
+
+    int ma = A.GetM();
+    int mb = B.GetM();
+    int nrhs = B.GetN();
+    int* ptr = A.GetPtr();
+    int* ind = A.GetInd();
+    T1* data = A.GetData();
+    T2* b = B.GetData();
+    T4* c = C.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(ma) * nrhs
+                                     + long(A.GetDataSize()) * nrhs);
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int i, k, r, i_begin, i_end;
+      Vector<T4> temp_vector(nrhs);
+      T4* temp = temp_vector.GetData();
+      T1 a;
+      const T2* b_row;
+
+      GetThreadRange(ptr, ma, i_begin, i_end);
+      for (i = i_begin; i < i_end; i++)
+        {
+          temp_vector.Zero();
+          for (k = ptr[i]; k < ptr[i + 1]; k++)
+            {
+              a = data[k];
+              b_row = b + ind[k];
+              for (r = 0; r < nrhs; r++)
+                temp[r] += a * b_row[long(r) * mb];
+            }
+
+          if (beta == T3(0))
+            for (r = 0; r < nrhs; r++)
+              c[i + long(r) * ma] = alpha * temp[r];
+          else
+            for (r = 0; r < nrhs; r++)
+              {
+                c[i + long(r) * ma] *= beta;
+                c[i + long(r) * ma] += alpha * temp[r];
+              }
+        }
+    }
+  }
+
+
   // MLTADD //
   ////////////
 
@@ -1851,6 +2774,152 @@ namespace Seldon
   }
 
 
+  //! Returns the LU factorization of a column-major matrix.
+  /*! It factorizes the n x n matrix \a a, stored by columns, into \f$ P L U
+    \f$ with partial pivoting, as the Lapack routine xGETRF does: on exit,
+    \a a contains \a L (with ones on the diagonal, not stored) in its strict
+    lower part and \a U in its upper part, and row i was interchanged with
+    row ipiv[i] - 1.
+
+    The factorization is blocked: the columns are processed by panels of
+    SELDON_LU_BLOCK_SIZE columns. Each panel is factorized with the unblocked
+    algorithm, the rows of \a U on the right of the panel are computed by a
+    triangular solve, and the trailing submatrix is updated with
+    MltAddBlocked, which performs almost all operations when n is large.
+    \param[in] n order of the matrix.
+    \param[in,out] a on entry, the matrix to be factorized; on exit, the LU
+    factorization.
+    \param[out] ipiv pivot indices (starting from 1), of length \a n.
+    \note If a pivot is zero, the corresponding column is not scaled and the
+    factorization goes on, so that \a U is singular.
+  */
+  template <class T>
+  void GetLUBlocked(int n, T* a, int* ipiv)
+  {
+    const int nb = SELDON_LU_BLOCK_SIZE;
+    long lda = n;
+    int j, jb, c, p, r, k, col;
+
+    for (j = 0; j < n; j += nb)
+      {
+        jb = min(nb, n - j);
+
+        // Factorizes the panel made of the columns j to j + jb - 1.
+        for (c = j; c < j + jb; c++)
+          {
+            T* a_c = a + c * lda;
+            p = c;
+            for (r = c + 1; r < n; r++)
+              if (abs(a_c[r]) > abs(a_c[p]))
+                p = r;
+            ipiv[c] = p + 1;
+
+            // Interchanges whole rows, as the rows of L on the left of the
+            // panel have to be permuted as well.
+            if (p != c)
+              for (col = 0; col < n; col++)
+                swap(a[c + col * lda], a[p + col * lda]);
+
+            T pivot = a_c[c];
+            if (pivot == T(0))
+              continue;
+            for (r = c + 1; r < n; r++)
+              a_c[r] /= pivot;
+
+            for (col = c + 1; col < j + jb; col++)
+              {
+                T* a_col = a + col * lda;
+                T u = a_col[c];
+                if (u != T(0))
+                  for (r = c + 1; r < n; r++)
+                    a_col[r] -= a_c[r] * u;
+              }
+          }
+
+        if (j + jb == n)
+          break;
+
+        // Rows of U: U12 = L11^{-1} A12.
+        for (col = j + jb; col < n; col++)
+          {
+            T* a_col = a + col * lda;
+            for (k = j; k < j + jb; k++)
+              {
+                T u = a_col[k];
+                const T* l_k = a + k * lda;
+                if (u != T(0))
+                  for (r = k + 1; r < j + jb; r++)
+                    a_col[r] -= l_k[r] * u;
+              }
+          }
+
+        // Trailing submatrix: A22 = A22 - L21 U12.
+        MltAddBlocked(T(-1), n - j - jb, n - j - jb, jb,
+                      a + (j + jb) + j * lda, 1L, lda,
+                      a + j + (j + jb) * lda, 1L, lda,
+                      T(1), a + (j + jb) + (j + jb) * lda, 1L, lda);
+      }
+  }
+
+
+  //! Returns the LU factorization of a matrix, with partial pivoting.
+  /*! It factorizes the matrix \a A into \f$ A = P L U \f$, where \a P is a
+    permutation matrix, \a L is a lower triangular matrix with ones on the
+    diagonal, and \a U is an upper triangular matrix. On exit, \a L (except
+    its diagonal) and \a U are stored in \a A, and \a P is described by the
+    row interchanges stored in \a P, exactly as with Lapack. This function is
+    called when Lapack is not used, or when the type of the entries is not
+    supported by Lapack. The factorization is computed by GetLUBlocked.
+    \param[in,out] A on entry, the matrix to be factorized; on exit, the LU
+    factorization.
+    \param[out] P pivot indices (starting from 1).
+    \sa Seldon::SolveLU(const Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+    const Vector<int, VectFull, Allocator1>& P, Vector<T2, VectFull,
+    Allocator2>& Y)
+  */
+  template <class T0, class Prop0, class Allocator0, class Allocator1>
+  void GetLU(Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+             Vector<int, VectFull, Allocator1>& P)
+  {
+    int n = A.GetM();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetN() != n)
+      throw WrongDim("GetLU(A, P)", "The matrix must be squared.");
+#endif
+
+    P.Reallocate(n);
+    GetLUBlocked(n, A.GetData(), P.GetData());
+  }
+
+
+  //! Returns the LU factorization of a matrix, with partial pivoting.
+  /*! As with Lapack, the row-major matrix \a A is seen as the column-major
+    matrix \f$ A^T \f$, whose factorization \f$ A^T = P L U \f$ is computed
+    by GetLUBlocked and stored in \a A.
+    \param[in,out] A on entry, the matrix to be factorized; on exit, the LU
+    factorization of \f$ A^T \f$.
+    \param[out] P pivot indices (starting from 1).
+    \sa Seldon::SolveLU(const Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+    const Vector<int, VectFull, Allocator1>& P, Vector<T2, VectFull,
+    Allocator2>& Y)
+  */
+  template <class T0, class Prop0, class Allocator0, class Allocator1>
+  void GetLU(Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+             Vector<int, VectFull, Allocator1>& P)
+  {
+    int n = A.GetM();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetN() != n)
+      throw WrongDim("GetLU(A, P)", "The matrix must be squared.");
+#endif
+
+    P.Reallocate(n);
+    GetLUBlocked(n, A.GetData(), P.GetData());
+  }
+
+
   // GETLU //
   ///////////
 
@@ -1889,6 +2958,43 @@ namespace Seldon
   }
 
 
+  //! Checks the compatibility of the dimensions.
+  /*! Checks that R A P + C -> C is possible according to the dimensions of
+    the matrices R, A, P and C. If the dimensions are incompatible, an
+    exception is raised (a WrongDim object is thrown).
+    \param R matrix.
+    \param A matrix.
+    \param P matrix.
+    \param C matrix.
+    \param function (optional) function in which the compatibility is checked.
+    Default: "".
+  */
+  template <class T0, class Prop0, class Storage0, class Allocator0,
+	    class T1, class Prop1, class Storage1, class Allocator1,
+	    class T2, class Prop2, class Storage2, class Allocator2,
+	    class T3, class Prop3, class Storage3, class Allocator3>
+  void CheckDim(const Matrix<T0, Prop0, Storage0, Allocator0>& R,
+		const Matrix<T1, Prop1, Storage1, Allocator1>& A,
+		const Matrix<T2, Prop2, Storage2, Allocator2>& P,
+		const Matrix<T3, Prop3, Storage3, Allocator3>& C,
+		string function)
+  {
+    if (A.GetM() != R.GetN() || P.GetM() != A.GetN()
+	|| C.GetM() != R.GetM() || C.GetN() != P.GetN())
+      throw WrongDim(function, string("Operation R A P + C -> C not ")
+		     + string("permitted:\n     R (") + to_str(&R)
+		     + string(") is a ") + to_str(R.GetM()) + string(" x ")
+		     + to_str(R.GetN()) + string(" matrix;\n     A (")
+		     + to_str(&A) + string(") is a ") + to_str(A.GetM())
+		     + string(" x ") + to_str(A.GetN())
+		     + string(" matrix;\n     P (") + to_str(&P)
+		     + string(") is a ") + to_str(P.GetM()) + string(" x ")
+		     + to_str(P.GetN()) + string(" matrix;\n     C (")
+		     + to_str(&C) + string(") is a ") + to_str(C.GetM())
+		     + string(" x ") + to_str(C.GetN()) + string(" matrix."));
+  }
+
+
   //! Checks the compatibility of the dimensions.
   /*! Checks that A B + C -> C or B A + C -> C is possible according to the
     dimensions of the matrices A, B and C. If the dimensions are incompatible,
@@ -2365,6 +3471,121 @@ namespace Seldon
   ///////////////////////
 
 
+  //////////
+  // SWAP //
+
+
+  //! Swaps two matrices by copy, or by move when C++11 is available.
+  /*!
+    This is the fallback of Swap(A, B) for the storages that do not provide
+    their own method 'Swap'. The last argument, a pointer to \a A, only
+    selects the overload: the overloads below, for the base classes that
+    provide 'Swap', are closer to the matrix class and take precedence.
+  */
+  template <class M, class T, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Base<T, Allocator>*)
+  {
+#ifdef SELDON_WITH_CXX11
+    M C(std::move(A));
+    A = std::move(B);
+    B = std::move(C);
+#else
+    M C(A);
+    A = B;
+    B = C;
+#endif
+  }
+
+
+  //! Swaps two matrices, without copying their elements.
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Pointers<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Triangular<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Symmetric<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Hermitian<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_SymPacked<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_HermPacked<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_TriangPacked<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Sparse<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_SymSparse<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_LongSparse<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
+  //! Swaps two matrices.
+  /*!
+    The matrices are exchanged without copying their elements if their
+    storage provides a method 'Swap', and by copy (or by move when C++11 is
+    available) otherwise.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Swap(Matrix<T, Prop, Storage, Allocator>& A,
+	    Matrix<T, Prop, Storage, Allocator>& B)
+  {
+    SwapMatrix(A, B, &A);
+  }
+
+
+  // SWAP //
+  //////////
+
+
 } // namespace Seldon.
 
 
@@ -33,6 +33,14 @@
   A B -> C
   Mlt(A, B, C)
 
+  pattern of A B -> C, and values of A B -> C (sparse matrices)
+  MltSymbolic(A, B, C)
+  MltNumeric(A, B, C)
+
+  pattern of R A P -> C, and values of R A P -> C (sparse matrices)
+  MltSymbolic(R, A, P, C)
+  MltNumeric(R, A, P, C)
+
   alpha A B -> C
   Mlt(alpha, A, B, C)
 
@@ -45,6 +53,9 @@
   LU factorization of matrix A without pivoting.
   GetLU(A)
 
+  LU factorization of matrix A with partial pivoting.
+  GetLU(A, P)
+
   Highest absolute value of A.
   MaxAbs(A)
 
@@ -58,6 +69,12 @@
 */
 
 
+// Number of columns of the panels in the blocked LU factorization.
+#ifndef SELDON_LU_BLOCK_SIZE
+#define SELDON_LU_BLOCK_SIZE 64
+#endif
+
+
 namespace Seldon
 {
 
@@ -100,6 +117,158 @@ namespace Seldon
 	   const Matrix<T1, Prop1, Storage1, Allocator1>& B,
            Matrix<T2, Prop2, Storage2, Allocator2>& C);
 
+  //! Rows of the product of two row-major sparse matrices.
+  /*! The row i of \f$ A B \f$ combines the rows of \f$ B \f$ selected by
+    the row i of \f$ A \f$. AddColumns passes the column numbers of these
+    products to a marker (SparseRowMarker), and AddValues passes the
+    products to an accumulator (SparseRowAccumulator), for MltSymbolicRows
+    and MltNumericRows.
+  */
+  template <class T0, class T1>
+  class RowSparseProduct
+  {
+  protected:
+    const int* a_ptr_;
+    const int* a_ind_;
+    const T0* a_val_;
+    const int* b_ptr_;
+    const int* b_ind_;
+    const T1* b_val_;
+
+  public:
+    template <class Prop0, class Allocator0, class Prop1, class Allocator1>
+    RowSparseProduct(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+		     const Matrix<T1, Prop1, RowSparse, Allocator1>& B);
+
+    template <class Marker>
+    void AddColumns(int i, Marker& mark) const;
+    template <class Accumulator>
+    void AddValues(int i, Accumulator& acc) const;
+  };
+
+
+  //! Rows of the product of three row-major sparse matrices.
+  /*! The row i of \f$ R A P \f$ is computed as in RowSparseProduct, from
+    the rows of \f$ A \f$ selected by the row i of \f$ R \f$ and from the
+    rows of \f$ P \f$ selected by these rows of \f$ A \f$, without storing
+    \f$ R A \f$ nor \f$ A P \f$. The products \f$ R_{ik} A_{kj} \f$ are
+    computed in type T3.
+  */
+  template <class T0, class T1, class T2, class T3>
+  class RowSparseTripleProduct
+  {
+  protected:
+    const int* r_ptr_;
+    const int* r_ind_;
+    const T0* r_val_;
+    const int* a_ptr_;
+    const int* a_ind_;
+    const T1* a_val_;
+    const int* p_ptr_;
+    const int* p_ind_;
+    const T2* p_val_;
+
+  public:
+    template <class Prop0, class Allocator0, class Prop1, class Allocator1,
+	      class Prop2, class Allocator2>
+    RowSparseTripleProduct(const Matrix<T0, Prop0, RowSparse, Allocator0>& R,
+			   const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+			   const Matrix<T2, Prop2, RowSparse, Allocator2>& P);
+
+    template <class Marker>
+    void AddColumns(int i, Marker& mark) const;
+    template <class Accumulator>
+    void AddValues(int i, Accumulator& acc) const;
+  };
+
+
+  //! Distinct column numbers of a row of a sparse product.
+  /*! A dense array stores the last row in which each column was found, so
+    that each column is counted (and stored, if requested) once per row.
+  */
+  class SparseRowMarker
+  {
+  protected:
+    Vector<int> mark_;
+    int row_;
+    int nb_;
+    int* ind_;
+
+  public:
+    SparseRowMarker(int n);
+
+    void Reset();
+    void Init(int i, int* ind);
+    void Add(int j);
+    int GetNb() const;
+  };
+
+
+  //! Values of a row of a sparse product, with a given pattern.
+  /*! A dense array stores the position of each column of the current row in
+    the values of the sparse matrix, so that the products are added in
+    place. The products outside the pattern are counted.
+  */
+  template <class T>
+  class SparseRowAccumulator
+  {
+  protected:
+    Vector<int> position_;
+    T* val_;
+    int nb_missing_;
+
+  public:
+    SparseRowAccumulator(int n, T* val);
+
+    void Init(int begin, int end, const int* ind);
+    template <class T0>
+    void Add(int j, const T0& x);
+    void Reset(int begin, int end, const int* ind);
+    int GetNbMissing() const;
+  };
+
+
+  template <class Product, class T, class Prop, class Allocator>
+  void MltSymbolicRows(const Product& product, int m, int n,
+		       const int* weight, long work,
+		       Matrix<T, Prop, RowSparse, Allocator>& C);
+
+  template <class Product, class T, class Prop, class Allocator>
+  int MltNumericRows(const Product& product, const int* weight, long work,
+		     Matrix<T, Prop, RowSparse, Allocator>& C);
+
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2>
+  void MltSymbolic(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+		   const Matrix<T1, Prop1, RowSparse, Allocator1>& B,
+		   Matrix<T2, Prop2, RowSparse, Allocator2>& C);
+
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2>
+  void MltNumeric(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+		  const Matrix<T1, Prop1, RowSparse, Allocator1>& B,
+		  Matrix<T2, Prop2, RowSparse, Allocator2>& C);
+
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3, class Prop3, class Allocator3>
+  void MltSymbolic(const Matrix<T0, Prop0, RowSparse, Allocator0>& R,
+		   const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+		   const Matrix<T2, Prop2, RowSparse, Allocator2>& P,
+		   Matrix<T3, Prop3, RowSparse, Allocator3>& C);
+
+  template <class T0, class Prop0, class Allocator0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3, class Prop3, class Allocator3>
+  void MltNumeric(const Matrix<T0, Prop0, RowSparse, Allocator0>& R,
+		  const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+		  const Matrix<T2, Prop2, RowSparse, Allocator2>& P,
+		  Matrix<T3, Prop3, RowSparse, Allocator3>& C);
+
   template <class T0, class Prop0, class Allocator0,
 	    class T1, class Prop1, class Allocator1,
 	    class T2, class Prop2, class Allocator2>
@@ -122,6 +291,93 @@ namespace Seldon
   // MLTADD //
 
 
+  //! Block sizes of the blocked dense matrix-matrix product.
+  /*! The product computed by MltAddBlocked is split into tiles of MR x NR
+    entries of the result, which are accumulated in registers. The inner
+    dimension is processed by slices of KC, and the blocks of MC x KC entries
+    of the first matrix (in the L2 cache) and of KC x NC entries of the second
+    matrix (in the L3 cache) are packed into contiguous buffers. The default
+    values are suited to any scalar type; they are specialized for float,
+    double and complex numbers. For these types, NR is a multiple of the
+    width of the vector registers so that the compiler vectorizes the inner
+    loop of MltAddBlockedKernel.
+  */
+  template <class T>
+  class GemmBlockSize
+  {
+  public:
+    static const int MR = 4;
+    static const int NR = 4;
+    static const int KC = 128;
+    static const int MC = 64;
+    static const int NC = 1024;
+  };
+
+  template <>
+  class GemmBlockSize<float>
+  {
+  public:
+    static const int MR = 4;
+    static const int NR = 32;
+    static const int KC = 192;
+    static const int MC = 128;
+    static const int NC = 4096;
+  };
+
+  template <>
+  class GemmBlockSize<double>
+  {
+  public:
+    static const int MR = 4;
+    static const int NR = 8;
+    static const int KC = 256;
+    static const int MC = 96;
+    static const int NC = 4096;
+  };
+
+  template <>
+  class GemmBlockSize<complex<float> >
+  {
+  public:
+    static const int MR = 4;
+    static const int NR = 8;
+    static const int KC = 256;
+    static const int MC = 64;
+    static const int NC = 2048;
+  };
+
+  template <>
+  class GemmBlockSize<complex<double> >
+  {
+  public:
+    static const int MR = 4;
+    static const int NR = 8;
+    static const int KC = 128;
+    static const int MC = 64;
+    static const int NC = 2048;
+  };
+
+  template <int MR, int NR, class T0, class T>
+  void MltAddBlockedKernel(int kc, const T0& alpha,
+                           const T* a, const T* b, int mr, int nr,
+                           T* c, long rsc, long csc);
+
+  template <int MR, int NR, class T0, class T>
+  void MltAddBlockedKernel(int kc, const T0& alpha,
+                           const complex<T>* a, const complex<T>* b,
+                           int mr, int nr,
+                           complex<T>* c, long rsc, long csc);
+
+  template <class T0, class T1, class T2, class T3, class T4>
+  void MltAddBlocked(const T0 alpha, int m, int n, int k,
+                     const T1* a, long rsa, long csa,
+                     const T2* b, long rsb, long csb,
+                     const T3 beta, T4* c, long rsc, long csc);
+
+  ////////////
+  // MLTADD //
+
+
   template <class T0,
 	    class T1, class Prop1, class Storage1, class Allocator1,
 	    class T2, class Prop2, class Storage2, class Allocator2,
@@ -133,6 +389,54 @@ namespace Seldon
 	      const T3 beta,
 	      Matrix<T4, Prop4, Storage4, Allocator4>& C);
 
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, RowMajor, Allocator1>& A,
+	      const Matrix<T2, Prop2, RowMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, RowMajor, Allocator4>& C);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const Matrix<T1, Prop1, ColMajor, Allocator1>& A,
+	      const Matrix<T2, Prop2, ColMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, ColMajor, Allocator4>& C);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& TransA,
+	      const Matrix<T1, Prop1, RowMajor, Allocator1>& A,
+	      const SeldonTranspose& TransB,
+	      const Matrix<T2, Prop2, RowMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, RowMajor, Allocator4>& C);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+	    class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+	      const SeldonTranspose& TransA,
+	      const Matrix<T1, Prop1, ColMajor, Allocator1>& A,
+	      const SeldonTranspose& TransB,
+	      const Matrix<T2, Prop2, ColMajor, Allocator2>& B,
+	      const T3 beta,
+	      Matrix<T4, Prop4, ColMajor, Allocator4>& C);
+
   template <class T0,
 	    class T1, class Prop1, class Storage1, class Allocator1,
 	    class T2, class Prop2, class Storage2, class Allocator2,
@@ -288,6 +592,28 @@ namespace Seldon
               const T3 beta,
               Matrix<T4, Prop4, RowSparse, Allocator4>& C);
 
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+            class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+              const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+              const Matrix<T2, Prop2, RowMajor, Allocator2>& B,
+              const T3 beta,
+              Matrix<T4, Prop4, RowMajor, Allocator4>& C);
+
+  template <class T0,
+	    class T1, class Prop1, class Allocator1,
+	    class T2, class Prop2, class Allocator2,
+	    class T3,
+            class T4, class Prop4, class Allocator4>
+  void MltAdd(const T0 alpha,
+              const Matrix<T1, Prop1, RowSparse, Allocator1>& A,
+              const Matrix<T2, Prop2, ColMajor, Allocator2>& B,
+              const T3 beta,
+              Matrix<T4, Prop4, ColMajor, Allocator4>& C);
+
 
   // MLTADD //
   ////////////
@@ -369,6 +695,17 @@ namespace Seldon
   template <class T0, class Prop0, class Storage0, class Allocator0>
   void GetLU(Matrix<T0, Prop0, Storage0, Allocator0>& A);
 
+  template <class T>
+  void GetLUBlocked(int n, T* a, int* ipiv);
+
+  template <class T0, class Prop0, class Allocator0, class Allocator1>
+  void GetLU(Matrix<T0, Prop0, ColMajor, Allocator0>& A,
+             Vector<int, VectFull, Allocator1>& P);
+
+  template <class T0, class Prop0, class Allocator0, class Allocator1>
+  void GetLU(Matrix<T0, Prop0, RowMajor, Allocator0>& A,
+             Vector<int, VectFull, Allocator1>& P);
+
 
   // GETLU //
   ///////////
@@ -386,6 +723,16 @@ namespace Seldon
 		const Matrix<T2, Prop2, Storage2, Allocator2>& C,
 		string function = "");
 
+  template <class T0, class Prop0, class Storage0, class Allocator0,
+	    class T1, class Prop1, class Storage1, class Allocator1,
+	    class T2, class Prop2, class Storage2, class Allocator2,
+	    class T3, class Prop3, class Storage3, class Allocator3>
+  void CheckDim(const Matrix<T0, Prop0, Storage0, Allocator0>& R,
+		const Matrix<T1, Prop1, Storage1, Allocator1>& A,
+		const Matrix<T2, Prop2, Storage2, Allocator2>& P,
+		const Matrix<T3, Prop3, Storage3, Allocator3>& C,
+		string function = "");
+
   template <class T0, class Prop0, class Storage0, class Allocator0,
 	    class T1, class Prop1, class Storage1, class Allocator1,
 	    class T2, class Prop2, class Storage2, class Allocator2>
@@ -491,6 +838,53 @@ namespace Seldon
   ///////////////////////
 
 
+  //////////
+  // SWAP //
+
+
+  template <class M, class T, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Base<T, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Pointers<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Triangular<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Symmetric<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Hermitian<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_SymPacked<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_HermPacked<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B,
+		  Matrix_TriangPacked<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_Sparse<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_SymSparse<T, Prop, Storage, Allocator>*);
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, Matrix_LongSparse<T, Prop, Storage, Allocator>*);
+
+  template <class T, class Prop, class Storage, class Allocator>
+  void Swap(Matrix<T, Prop, Storage, Allocator>& A,
+	    Matrix<T, Prop, Storage, Allocator>& B);
+
+
+  // SWAP //
+  //////////
+
+
 } // namespace Seldon.
 
 
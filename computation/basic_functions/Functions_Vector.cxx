@@ -33,9 +33,21 @@
   alpha X -> X
   Mlt(alpha, X)
 
+  alpha X + beta Y -> Y
+  MltAdd(alpha, X, beta, Y)
+
+  alpha X + beta Y + gamma Z -> Z
+  MltAdd(alpha, X, beta, Y, gamma, Z)
+
   alpha X + Y -> Y
   Add(alpha, X, Y)
 
+  alpha X + Y -> Y and ||Y||
+  AddNorm2(alpha, X, Y)
+
+  alpha X + Y -> Y, beta Z + W -> W and ||W||
+  AddNorm2(alpha, X, Y, beta, Z, W)
+
   X -> Y
   Copy(X, Y)
 
@@ -62,6 +74,152 @@ namespace Seldon
 {
 
 
+  ////////////////////
+  // BLAS-1 KERNELS //
+
+
+  /*
+    The kernels below work on contiguous arrays, and are used by the
+    functions on full vectors when Seldon is not interfaced with Blas. The
+    sums are accumulated in eight independent partial sums, so that the
+    compiler can vectorize the loops (SSE, AVX, ...) according to the target
+    architecture, without having to reorder the floating-point additions:
+    the result therefore does not depend on the instruction set. Complex
+    numbers are processed as pairs of real numbers, which avoids the checks
+    of the complex multiplication.
+  */
+
+
+  //! Returns the sum of x[i] y[i] for i = 0, ..., n - 1.
+  template <class T>
+  T DotProdKernel(int n, const T* x, const T* y)
+  {
+    T sum[8];
+    for (int k = 0; k < 8; k++)
+      sum[k] = T(0);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+      for (int k = 0; k < 8; k++)
+	sum[k] += x[i + k] * y[i + k];
+    for (; i < n; i++)
+      sum[0] += x[i] * y[i];
+
+    return ((sum[0] + sum[4]) + (sum[2] + sum[6]))
+      + ((sum[1] + sum[5]) + (sum[3] + sum[7]));
+  }
+
+
+  //! Computes the sums needed by the scalar products of complex arrays.
+  /*!
+    \param[in] n length of the arrays.
+    \param[in] x first array.
+    \param[in] y second array.
+    \param[out] rr sum of real(x[i]) real(y[i]).
+    \param[out] ii sum of imag(x[i]) imag(y[i]).
+    \param[out] ri sum of real(x[i]) imag(y[i]).
+    \param[out] ir sum of imag(x[i]) real(y[i]).
+  */
+  template <class T>
+  void DotProdKernel(int n, const complex<T>* x, const complex<T>* y,
+		     T& rr, T& ii, T& ri, T& ir)
+  {
+    const T* u = reinterpret_cast<const T*>(x);
+    const T* v = reinterpret_cast<const T*>(y);
+
+    // Even entries of 'p' and 'q' accumulate real(x) real(y) and real(x)
+    // imag(y), odd entries imag(x) imag(y) and imag(x) real(y).
+    T p[8], q[8];
+    for (int k = 0; k < 8; k++)
+      {
+	p[k] = T(0);
+	q[k] = T(0);
+      }
+
+    int i = 0, n2 = 2 * n;
+    for (; i + 8 <= n2; i += 8)
+      for (int k = 0; k < 8; k += 2)
+	{
+	  p[k] += u[i + k] * v[i + k];
+	  p[k + 1] += u[i + k + 1] * v[i + k + 1];
+	  q[k] += u[i + k] * v[i + k + 1];
+	  q[k + 1] += u[i + k + 1] * v[i + k];
+	}
+    for (; i < n2; i += 2)
+      {
+	p[0] += u[i] * v[i];
+	p[1] += u[i + 1] * v[i + 1];
+	q[0] += u[i] * v[i + 1];
+	q[1] += u[i + 1] * v[i];
+      }
+
+    rr = (p[0] + p[4]) + (p[2] + p[6]);
+    ii = (p[1] + p[5]) + (p[3] + p[7]);
+    ri = (q[0] + q[4]) + (q[2] + q[6]);
+    ir = (q[1] + q[5]) + (q[3] + q[7]);
+  }
+
+
+  //! Computes y = y + alpha x on arrays of length n.
+  template <class T>
+  void AddKernel(int n, const T& alpha, const T* x, T* y)
+  {
+    for (int i = 0; i < n; i++)
+      y[i] += alpha * x[i];
+  }
+
+
+  //! Computes y = y + alpha x on complex arrays of length n.
+  template <class T>
+  void AddKernel(int n, const complex<T>& alpha,
+		 const complex<T>* x, complex<T>* y)
+  {
+    T ar = real(alpha), ai = imag(alpha);
+    const T* u = reinterpret_cast<const T*>(x);
+    T* v = reinterpret_cast<T*>(y);
+
+    if (ai == T(0))
+      {
+	AddKernel(2 * n, ar, u, v);
+	return;
+      }
+
+    for (int i = 0; i < 2 * n; i += 2)
+      {
+	T xr = u[i], xi = u[i + 1];
+	v[i] += ar * xr - ai * xi;
+	v[i + 1] += ar * xi + ai * xr;
+      }
+  }
+
+
+  //! Computes x = alpha x on a complex array of length n.
+  template <class T>
+  void MltKernel(int n, const complex<T>& alpha, complex<T>* x)
+  {
+    T ar = real(alpha), ai = imag(alpha);
+    T* u = reinterpret_cast<T*>(x);
+
+    if (ai == T(0))
+      {
+	for (int i = 0; i < 2 * n; i++)
+	  u[i] *= ar;
+	return;
+      }
+
+    for (int i = 0; i < 2 * n; i += 2)
+      {
+	T xr = u[i], xi = u[i + 1];
+	u[i] = ar * xr - ai * xi;
+	u[i + 1] = ar * xi + ai * xr;
+      }
+  }
+
+
+  // BLAS-1 KERNELS //
+  ////////////////////
+
+
   /////////
   // MLT //
 
@@ -74,10 +232,124 @@ namespace Seldon
   }
 
 
+#ifndef SELDON_WITH_BLAS
+  //! Computes X = alpha X for a complex full vector.
+  template <class T0, class T1, class Allocator1>
+  void Mlt(const T0 alpha, Vector<complex<T1>, VectFull, Allocator1>& X)
+  {
+    MltKernel(X.GetM(), complex<T1>(alpha), X.GetData());
+  }
+#endif
+
+
   // MLT //
   /////////
 
 
+  ////////////
+  // MLTADD //
+
+
+  //! Computes Y = alpha X + beta Y.
+  /*! If \a beta is zero, \a Y is not read on entry.
+   */
+  template <class T0,
+	    class T1, class Storage1, class Allocator1,
+	    class T2, class Storage2, class Allocator2>
+  void MltAdd(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+	      const T0 beta, Vector<T2, Storage2, Allocator2>& Y)
+  {
+    if (beta == T0(0))
+      {
+	Copy(X, Y);
+	Mlt(alpha, Y);
+      }
+    else
+      {
+	Mlt(beta, Y);
+	Add(alpha, X, Y);
+      }
+  }
+
+
+  //! Computes Y = alpha X + beta Y in a single pass.
+  /*! If \a beta is zero, \a Y is not read on entry.
+   */
+  template <class T0,
+	    class T1, class Allocator1,
+	    class T2, class Allocator2>
+  void MltAdd(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	      const T0 beta, Vector<T2, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "MltAdd(alpha, X, beta, Y)");
+#endif
+
+    int ma = X.GetM();
+    T2 alpha_ = alpha, beta_ = beta;
+    const T1* x = X.GetData();
+    T2* y = Y.GetData();
+
+    if (beta == T0(0))
+      for (int i = 0; i < ma; i++)
+	y[i] = alpha_ * x[i];
+    else
+      for (int i = 0; i < ma; i++)
+	y[i] = alpha_ * x[i] + beta_ * y[i];
+  }
+
+
+  //! Computes Z = alpha X + beta Y + gamma Z.
+  /*! If \a gamma is zero, \a Z is not read on entry.
+   */
+  template <class T0,
+	    class T1, class Storage1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3>
+  void MltAdd(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+	      const T0 beta, const Vector<T2, Storage2, Allocator2>& Y,
+	      const T0 gamma, Vector<T3, Storage3, Allocator3>& Z)
+  {
+    MltAdd(alpha, X, gamma, Z);
+    Add(beta, Y, Z);
+  }
+
+
+  //! Computes Z = alpha X + beta Y + gamma Z in a single pass.
+  /*! If \a gamma is zero, \a Z is not read on entry.
+   */
+  template <class T0,
+	    class T1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3>
+  void MltAdd(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	      const T0 beta, const Vector<T2, VectFull, Allocator2>& Y,
+	      const T0 gamma, Vector<T3, VectFull, Allocator3>& Z)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Z, "MltAdd(alpha, X, beta, Y, gamma, Z)");
+    CheckDim(Y, Z, "MltAdd(alpha, X, beta, Y, gamma, Z)");
+#endif
+
+    int ma = X.GetM();
+    T3 alpha_ = alpha, beta_ = beta, gamma_ = gamma;
+    const T1* x = X.GetData();
+    const T2* y = Y.GetData();
+    T3* z = Z.GetData();
+
+    if (gamma == T0(0))
+      for (int i = 0; i < ma; i++)
+	z[i] = alpha_ * x[i] + beta_ * y[i];
+    else
+      for (int i = 0; i < ma; i++)
+	z[i] = alpha_ * x[i] + beta_ * y[i] + gamma_ * z[i];
+  }
+
+
+  // MLTADD //
+  ////////////
+
+
   /////////
   // ADD //
 
@@ -105,6 +377,41 @@ namespace Seldon
   }
 
 
+#ifndef SELDON_WITH_BLAS
+  //! Computes Y = Y + alpha X for full vectors.
+  template <class T0, class T1, class Allocator1, class Allocator2>
+  void Add(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	   Vector<T1, VectFull, Allocator2>& Y)
+  {
+    if (alpha != T0(0))
+      {
+#ifdef SELDON_CHECK_DIMENSIONS
+	CheckDim(X, Y, "Add(alpha, X, Y)");
+#endif
+
+	AddKernel(X.GetM(), T1(alpha), X.GetData(), Y.GetData());
+      }
+  }
+
+
+  //! Computes Y = Y + alpha X for complex full vectors.
+  template <class T0, class T1, class Allocator1, class Allocator2>
+  void Add(const T0 alpha,
+	   const Vector<complex<T1>, VectFull, Allocator1>& X,
+	   Vector<complex<T1>, VectFull, Allocator2>& Y)
+  {
+    if (alpha != T0(0))
+      {
+#ifdef SELDON_CHECK_DIMENSIONS
+	CheckDim(X, Y, "Add(alpha, X, Y)");
+#endif
+
+	AddKernel(X.GetM(), complex<T1>(alpha), X.GetData(), Y.GetData());
+      }
+  }
+#endif
+
+
   template <class T0,
             class T1, class Allocator1,
             class T2, class Allocator2>
@@ -233,6 +540,213 @@ namespace Seldon
   /////////
 
 
+  //////////////
+  // ADDNORM2 //
+
+
+  //! Computes Y = alpha X + Y and returns the Euclidean norm of Y.
+  template <class T0,
+	    class T1, class Storage1, class Allocator1,
+	    class T2, class Storage2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+	      Vector<T2, Storage2, Allocator2>& Y)
+  {
+    Add(alpha, X, Y);
+    return Norm2(Y);
+  }
+
+
+  //! Computes Y = alpha X + Y and returns the Euclidean norm of Y.
+  template <class T0,
+	    class T1, class Storage1, class Allocator1,
+	    class T2, class Storage2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+	      Vector<complex<T2>, Storage2, Allocator2>& Y)
+  {
+    Add(alpha, X, Y);
+    return Norm2(Y);
+  }
+
+
+  //! Computes Y = alpha X + Y and returns the Euclidean norm of Y.
+  /*! The norm is computed in the same pass as the update of \a Y.
+   */
+  template <class T0,
+	    class T1, class Allocator1,
+	    class T2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	      Vector<T2, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "AddNorm2(alpha, X, Y)");
+#endif
+
+    int ma = X.GetM();
+    T2 alpha_ = alpha;
+    const T1* x = X.GetData();
+    T2* y = Y.GetData();
+
+    T2 value(0);
+    for (int i = 0; i < ma; i++)
+      {
+	y[i] += alpha_ * x[i];
+	value += y[i] * y[i];
+      }
+
+    return sqrt(value);
+  }
+
+
+  //! Computes Y = alpha X + Y and returns the Euclidean norm of Y.
+  /*! The norm is computed in the same pass as the update of \a Y.
+   */
+  template <class T0,
+	    class T1, class Allocator1,
+	    class T2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	      Vector<complex<T2>, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "AddNorm2(alpha, X, Y)");
+#endif
+
+    int ma = X.GetM();
+    complex<T2> alpha_ = alpha;
+    const T1* x = X.GetData();
+    complex<T2>* y = Y.GetData();
+
+    T2 value(0);
+    for (int i = 0; i < ma; i++)
+      {
+	y[i] += alpha_ * x[i];
+	value += real(y[i] * conj(y[i]));
+      }
+
+    return sqrt(value);
+  }
+
+
+  /*! \brief Computes Y = alpha X + Y and W = beta Z + W, and returns the
+    Euclidean norm of W. */
+  template <class T0,
+	    class T1, class Storage1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3,
+	    class T4, class Storage4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+	      Vector<T2, Storage2, Allocator2>& Y,
+	      const T0 beta, const Vector<T3, Storage3, Allocator3>& Z,
+	      Vector<T4, Storage4, Allocator4>& W)
+  {
+    Add(alpha, X, Y);
+    Add(beta, Z, W);
+    return Norm2(W);
+  }
+
+
+  /*! \brief Computes Y = alpha X + Y and W = beta Z + W, and returns the
+    Euclidean norm of W. */
+  template <class T0,
+	    class T1, class Storage1, class Allocator1,
+	    class T2, class Storage2, class Allocator2,
+	    class T3, class Storage3, class Allocator3,
+	    class T4, class Storage4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+	      Vector<T2, Storage2, Allocator2>& Y,
+	      const T0 beta, const Vector<T3, Storage3, Allocator3>& Z,
+	      Vector<complex<T4>, Storage4, Allocator4>& W)
+  {
+    Add(alpha, X, Y);
+    Add(beta, Z, W);
+    return Norm2(W);
+  }
+
+
+  /*! \brief Computes Y = alpha X + Y and W = beta Z + W, and returns the
+    Euclidean norm of W. */
+  /*! The four vectors are read in a single pass. In the conjugate gradient,
+    it updates the solution and the residual and computes the residual norm.
+   */
+  template <class T0,
+	    class T1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3,
+	    class T4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	      Vector<T2, VectFull, Allocator2>& Y,
+	      const T0 beta, const Vector<T3, VectFull, Allocator3>& Z,
+	      Vector<T4, VectFull, Allocator4>& W)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "AddNorm2(alpha, X, Y, beta, Z, W)");
+    CheckDim(Z, W, "AddNorm2(alpha, X, Y, beta, Z, W)", "Z + W");
+    CheckDim(Y, W, "AddNorm2(alpha, X, Y, beta, Z, W)", "Y + W");
+#endif
+
+    int ma = X.GetM();
+    T2 alpha_ = alpha;
+    T4 beta_ = beta;
+    const T1* x = X.GetData();
+    T2* y = Y.GetData();
+    const T3* z = Z.GetData();
+    T4* w = W.GetData();
+
+    T4 value(0);
+    for (int i = 0; i < ma; i++)
+      {
+	y[i] += alpha_ * x[i];
+	w[i] += beta_ * z[i];
+	value += w[i] * w[i];
+      }
+
+    return sqrt(value);
+  }
+
+
+  /*! \brief Computes Y = alpha X + Y and W = beta Z + W, and returns the
+    Euclidean norm of W. */
+  /*! The four vectors are read in a single pass.
+   */
+  template <class T0,
+	    class T1, class Allocator1,
+	    class T2, class Allocator2,
+	    class T3, class Allocator3,
+	    class T4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+	      Vector<T2, VectFull, Allocator2>& Y,
+	      const T0 beta, const Vector<T3, VectFull, Allocator3>& Z,
+	      Vector<complex<T4>, VectFull, Allocator4>& W)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "AddNorm2(alpha, X, Y, beta, Z, W)");
+    CheckDim(Z, W, "AddNorm2(alpha, X, Y, beta, Z, W)", "Z + W");
+    CheckDim(Y, W, "AddNorm2(alpha, X, Y, beta, Z, W)", "Y + W");
+#endif
+
+    int ma = X.GetM();
+    T2 alpha_ = alpha;
+    complex<T4> beta_ = beta;
+    const T1* x = X.GetData();
+    T2* y = Y.GetData();
+    const T3* z = Z.GetData();
+    complex<T4>* w = W.GetData();
+
+    T4 value(0);
+    for (int i = 0; i < ma; i++)
+      {
+	y[i] += alpha_ * x[i];
+	w[i] += beta_ * z[i];
+	value += real(w[i] * conj(w[i]));
+      }
+
+    return sqrt(value);
+  }
+
+
+  // ADDNORM2 //
+  //////////////
+
+
   //////////
   // COPY //
 
@@ -291,30 +805,52 @@ namespace Seldon
   // SWAP //
 
 
+  //! Swaps two vectors.
+  /*!
+    The vectors are exchanged by copy, or by move when C++11 is available.
+    The storages that provide their own method 'Swap' are exchanged without
+    copying their elements (see the overloads below).
+  */
   template <class T, class Storage, class Allocator>
   void Swap(Vector<T, Storage, Allocator>& X,
 	    Vector<T, Storage, Allocator>& Y)
   {
-    int nx = X.GetM();
-    T* data = X.GetData();
-    X.Nullify();
-    X.SetData(Y.GetM(), Y.GetData());
-    Y.Nullify();
-    Y.SetData(nx, data);
+#ifdef SELDON_WITH_CXX11
+    Vector<T, Storage, Allocator> Z(std::move(X));
+    X = std::move(Y);
+    Y = std::move(Z);
+#else
+    Vector<T, Storage, Allocator> Z(X);
+    X = Y;
+    Y = Z;
+#endif
+  }
+
+
+  //! Swaps two vectors, without copying their elements.
+  template <class T, class Allocator>
+  void Swap(Vector<T, VectFull, Allocator>& X,
+	    Vector<T, VectFull, Allocator>& Y)
+  {
+    X.Swap(Y);
   }
 
 
+  //! Swaps two sparse vectors, without copying their elements.
   template <class T, class Allocator>
   void Swap(Vector<T, VectSparse, Allocator>& X,
 	    Vector<T, VectSparse, Allocator>& Y)
   {
-    int nx = X.GetM();
-    T* data = X.GetData();
-    int* index = X.GetIndex();
-    X.Nullify();
-    X.SetData(Y.GetM(), Y.GetData(), Y.GetIndex());
-    Y.Nullify();
-    Y.SetData(nx, data, index);
+    X.Swap(Y);
+  }
+
+
+  //! Swaps two vector collections, without copying the inner vectors.
+  template <class T, class Allocator>
+  void Swap(Vector<T, Collection, Allocator>& X,
+	    Vector<T, Collection, Allocator>& Y)
+  {
+    X.Swap(Y);
   }
 
 
@@ -473,6 +1009,53 @@ namespace Seldon
   }
 
 
+#ifndef SELDON_WITH_BLAS
+  //! Scalar product between two full vectors.
+  template<class T1, class Allocator1, class Allocator2>
+  T1 DotProd(const Vector<T1, VectFull, Allocator1>& X,
+	     const Vector<T1, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "DotProd(X, Y)");
+#endif
+
+    return DotProdKernel(X.GetM(), X.GetData(), Y.GetData());
+  }
+
+
+  //! Scalar product between two complex full vectors.
+  template<class T1, class Allocator1, class Allocator2>
+  complex<T1> DotProd(const Vector<complex<T1>, VectFull, Allocator1>& X,
+		      const Vector<complex<T1>, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "DotProd(X, Y)");
+#endif
+
+    T1 rr, ii, ri, ir;
+    DotProdKernel(X.GetM(), X.GetData(), Y.GetData(), rr, ii, ri, ir);
+    return complex<T1>(rr - ii, ri + ir);
+  }
+
+
+  //! Scalar product between two complex full vectors.
+  /*! The first vector is conjugated. */
+  template<class T1, class Allocator1, class Allocator2>
+  complex<T1>
+  DotProdConj(const Vector<complex<T1>, VectFull, Allocator1>& X,
+	      const Vector<complex<T1>, VectFull, Allocator2>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    CheckDim(X, Y, "DotProdConj(X, Y)");
+#endif
+
+    T1 rr, ii, ri, ir;
+    DotProdKernel(X.GetM(), X.GetData(), Y.GetData(), rr, ii, ri, ir);
+    return complex<T1>(rr + ii, ri - ir);
+  }
+#endif
+
+
   // DOTPROD //
   /////////////
 
@@ -585,6 +1168,25 @@ namespace Seldon
   }
 
 
+#ifndef SELDON_WITH_BLAS
+  template<class T1, class Allocator1>
+  T1 Norm2(const Vector<T1, VectFull, Allocator1>& X)
+  {
+    return sqrt(DotProdKernel(X.GetM(), X.GetData(), X.GetData()));
+  }
+
+
+  //! Euclidean norm of a complex full vector.
+  /*! The vector is processed as a real vector of twice its length. */
+  template<class T1, class Allocator1>
+  T1 Norm2(const Vector<complex<T1>, VectFull, Allocator1>& X)
+  {
+    const T1* x = reinterpret_cast<const T1*>(X.GetData());
+    return sqrt(DotProdKernel(2 * X.GetM(), x, x));
+  }
+#endif
+
+
   // NORM2 //
   ///////////
 
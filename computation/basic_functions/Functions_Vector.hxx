@@ -30,9 +30,21 @@
   alpha X -> X
   Mlt(alpha, X)
 
+  alpha X + beta Y -> Y
+  MltAdd(alpha, X, beta, Y)
+
+  alpha X + beta Y + gamma Z -> Z
+  MltAdd(alpha, X, beta, Y, gamma, Z)
+
   alpha X + Y -> Y
   Add(alpha, X, Y)
 
+  alpha X + Y -> Y and ||Y||
+  AddNorm2(alpha, X, Y)
+
+  alpha X + Y -> Y, beta Z + W -> W and ||W||
+  AddNorm2(alpha, X, Y, beta, Z, W)
+
   X -> Y
   Copy(X, Y)
 
@@ -59,6 +71,32 @@ namespace Seldon
 {
 
 
+  ////////////////////
+  // BLAS-1 KERNELS //
+
+
+  template <class T>
+  T DotProdKernel(int n, const T* x, const T* y);
+
+  template <class T>
+  void DotProdKernel(int n, const complex<T>* x, const complex<T>* y,
+                     T& rr, T& ii, T& ri, T& ir);
+
+  template <class T>
+  void AddKernel(int n, const T& alpha, const T* x, T* y);
+
+  template <class T>
+  void AddKernel(int n, const complex<T>& alpha,
+                 const complex<T>* x, complex<T>* y);
+
+  template <class T>
+  void MltKernel(int n, const complex<T>& alpha, complex<T>* x);
+
+
+  // BLAS-1 KERNELS //
+  ////////////////////
+
+
 /////////
 // MLT //
 
@@ -67,11 +105,53 @@ template <class T0,
           class T1, class Storage1, class Allocator1>
 void Mlt(const T0 alpha, Vector<T1, Storage1, Allocator1>& X);
 
+#ifndef SELDON_WITH_BLAS
+  template <class T0, class T1, class Allocator1>
+  void Mlt(const T0 alpha, Vector<complex<T1>, VectFull, Allocator1>& X);
+#endif
+
 
 // MLT //
 /////////
 
 
+////////////
+// MLTADD //
+
+
+  template <class T0,
+            class T1, class Storage1, class Allocator1,
+            class T2, class Storage2, class Allocator2>
+  void MltAdd(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+              const T0 beta, Vector<T2, Storage2, Allocator2>& Y);
+
+  template <class T0,
+            class T1, class Allocator1,
+            class T2, class Allocator2>
+  void MltAdd(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+              const T0 beta, Vector<T2, VectFull, Allocator2>& Y);
+
+  template <class T0,
+            class T1, class Storage1, class Allocator1,
+            class T2, class Storage2, class Allocator2,
+            class T3, class Storage3, class Allocator3>
+  void MltAdd(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+              const T0 beta, const Vector<T2, Storage2, Allocator2>& Y,
+              const T0 gamma, Vector<T3, Storage3, Allocator3>& Z);
+
+  template <class T0,
+            class T1, class Allocator1,
+            class T2, class Allocator2,
+            class T3, class Allocator3>
+  void MltAdd(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+              const T0 beta, const Vector<T2, VectFull, Allocator2>& Y,
+              const T0 gamma, Vector<T3, VectFull, Allocator3>& Z);
+
+
+// MLTADD //
+////////////
+
+
 /////////
 // ADD //
 
@@ -83,6 +163,17 @@ void Add(const T0 alpha,
 	   const Vector<T1, Storage1, Allocator1>& X,
            Vector<T2, Storage2, Allocator2>& Y);
 
+#ifndef SELDON_WITH_BLAS
+  template <class T0, class T1, class Allocator1, class Allocator2>
+  void Add(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+           Vector<T1, VectFull, Allocator2>& Y);
+
+  template <class T0, class T1, class Allocator1, class Allocator2>
+  void Add(const T0 alpha,
+           const Vector<complex<T1>, VectFull, Allocator1>& X,
+           Vector<complex<T1>, VectFull, Allocator2>& Y);
+#endif
+
   template <class T0,
             class T1, class Allocator1,
             class T2, class Allocator2>
@@ -132,6 +223,79 @@ void Add(const T0 alpha,
 /////////
 
 
+//////////////
+// ADDNORM2 //
+
+
+  template <class T0,
+            class T1, class Storage1, class Allocator1,
+            class T2, class Storage2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+              Vector<T2, Storage2, Allocator2>& Y);
+
+  template <class T0,
+            class T1, class Storage1, class Allocator1,
+            class T2, class Storage2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+              Vector<complex<T2>, Storage2, Allocator2>& Y);
+
+  template <class T0,
+            class T1, class Allocator1,
+            class T2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+              Vector<T2, VectFull, Allocator2>& Y);
+
+  template <class T0,
+            class T1, class Allocator1,
+            class T2, class Allocator2>
+  T2 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+              Vector<complex<T2>, VectFull, Allocator2>& Y);
+
+  template <class T0,
+            class T1, class Storage1, class Allocator1,
+            class T2, class Storage2, class Allocator2,
+            class T3, class Storage3, class Allocator3,
+            class T4, class Storage4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+              Vector<T2, Storage2, Allocator2>& Y,
+              const T0 beta, const Vector<T3, Storage3, Allocator3>& Z,
+              Vector<T4, Storage4, Allocator4>& W);
+
+  template <class T0,
+            class T1, class Storage1, class Allocator1,
+            class T2, class Storage2, class Allocator2,
+            class T3, class Storage3, class Allocator3,
+            class T4, class Storage4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, Storage1, Allocator1>& X,
+              Vector<T2, Storage2, Allocator2>& Y,
+              const T0 beta, const Vector<T3, Storage3, Allocator3>& Z,
+              Vector<complex<T4>, Storage4, Allocator4>& W);
+
+  template <class T0,
+            class T1, class Allocator1,
+            class T2, class Allocator2,
+            class T3, class Allocator3,
+            class T4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+              Vector<T2, VectFull, Allocator2>& Y,
+              const T0 beta, const Vector<T3, VectFull, Allocator3>& Z,
+              Vector<T4, VectFull, Allocator4>& W);
+
+  template <class T0,
+            class T1, class Allocator1,
+            class T2, class Allocator2,
+            class T3, class Allocator3,
+            class T4, class Allocator4>
+  T4 AddNorm2(const T0 alpha, const Vector<T1, VectFull, Allocator1>& X,
+              Vector<T2, VectFull, Allocator2>& Y,
+              const T0 beta, const Vector<T3, VectFull, Allocator3>& Z,
+              Vector<complex<T4>, VectFull, Allocator4>& W);
+
+
+// ADDNORM2 //
+//////////////
+
+
 //////////
 // COPY //
 
@@ -159,10 +323,18 @@ template <class T, class Storage, class Allocator>
 void Swap(Vector<T, Storage, Allocator>& X,
             Vector<T, Storage, Allocator>& Y);
 
+template <class T, class Allocator>
+void Swap(Vector<T, VectFull, Allocator>& X,
+            Vector<T, VectFull, Allocator>& Y);
+
 template <class T, class Allocator>
 void Swap(Vector<T, VectSparse, Allocator>& X,
             Vector<T, VectSparse, Allocator>& Y);
 
+template <class T, class Allocator>
+void Swap(Vector<T, Collection, Allocator>& X,
+            Vector<T, Collection, Allocator>& Y);
+
 
 // SWAP //
 //////////
@@ -212,6 +384,21 @@ T1 DotProd(const Vector<T1, VectSparse, Allocator1>& X,
   DotProdConj(const Vector<complex<T1>, VectSparse, Allocator1>& X,
 	      const Vector<T2, VectSparse, Allocator2>& Y);
 
+#ifndef SELDON_WITH_BLAS
+  template<class T1, class Allocator1, class Allocator2>
+  T1 DotProd(const Vector<T1, VectFull, Allocator1>& X,
+             const Vector<T1, VectFull, Allocator2>& Y);
+
+  template<class T1, class Allocator1, class Allocator2>
+  complex<T1> DotProd(const Vector<complex<T1>, VectFull, Allocator1>& X,
+                      const Vector<complex<T1>, VectFull, Allocator2>& Y);
+
+  template<class T1, class Allocator1, class Allocator2>
+  complex<T1>
+  DotProdConj(const Vector<complex<T1>, VectFull, Allocator1>& X,
+              const Vector<complex<T1>, VectFull, Allocator2>& Y);
+#endif
+
 
   // DOTPROD //
   /////////////
@@ -254,6 +441,14 @@ T1 DotProd(const Vector<T1, VectSparse, Allocator1>& X,
   template<class T1, class Allocator1>
   T1 Norm2(const Vector<complex<T1>, VectSparse, Allocator1>& X);
 
+#ifndef SELDON_WITH_BLAS
+  template<class T1, class Allocator1>
+  T1 Norm2(const Vector<T1, VectFull, Allocator1>& X);
+
+  template<class T1, class Allocator1>
+  T1 Norm2(const Vector<complex<T1>, VectFull, Allocator1>& X);
+#endif
+
 
   // NORM2 //
   ///////////
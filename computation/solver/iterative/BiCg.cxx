@@ -42,10 +42,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int BiCg(Matrix1& A, Vector1& x, const Vector1& b,
-	   Preconditioner& M, Iteration<Titer> & iter)
+	   Preconditioner& M, Iteration<Titer> & iter,
+	   IterativeWorkspace<Titer, Vector1>& work)
   {
     int N = A.GetM();
     if (N <= 0)
@@ -54,8 +56,15 @@ namespace Seldon
     typedef typename Vector1::value_type Complexe;
     Complexe rho_1, rho_2(0), alpha, beta, delta;
 
-    Vector1 r(b), z(b), p(b), q(b);
-    Vector1 r_tilde(b), z_tilde(b), p_tilde(b), q_tilde(b);
+    work.Init(8, b);
+    Vector1& r = work.GetVector(0);
+    Vector1& z = work.GetVector(1);
+    Vector1& p = work.GetVector(2);
+    Vector1& q = work.GetVector(3);
+    Vector1& r_tilde = work.GetVector(4);
+    Vector1& z_tilde = work.GetVector(5);
+    Vector1& p_tilde = work.GetVector(6);
+    Vector1& q_tilde = work.GetVector(7);
 
     // we initialize iter
     int success_init = iter.Init(b);
@@ -132,6 +141,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using BiConjugate Gradient (BICG)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int BiCg(Matrix1& A, Vector1& x, const Vector1& b,
+	   Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return BiCg(A, x, b, M, iter, work);
+  }
+
 }
 
 #define SELDON_FILE_ITERATIVE_BICG_CXX
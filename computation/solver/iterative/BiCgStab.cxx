@@ -39,10 +39,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int BiCgStab(Matrix1& A, Vector1& x, const Vector1& b,
-	       Preconditioner& M, Iteration<Titer> & iter)
+	       Preconditioner& M, Iteration<Titer> & iter,
+	       IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -50,7 +52,14 @@ namespace Seldon
 
     typedef typename Vector1::value_type Complexe;
     Complexe rho_1, rho_2(0), alpha(0), beta, omega(0), sigma;
-    Vector1 p(b), phat(b), s(b), shat(b), t(b), v(b), r(b), rtilde(b);
+    work.Init(7, b);
+    Vector1& p = work.GetVector(0);
+    Vector1& phat = work.GetVector(1);
+    Vector1& shat = work.GetVector(2);
+    Vector1& t = work.GetVector(3);
+    Vector1& v = work.GetVector(4);
+    Vector1& r = work.GetVector(5);
+    Vector1& rtilde = work.GetVector(6);
 
     // we initialize iter
     int success_init = iter.Init(b);
@@ -65,10 +74,11 @@ namespace Seldon
       x.Zero();
 
     Copy(r, rtilde);
+    Titer normr = Norm2(r);
 
     iter.SetNumberIteration(0);
     // Loop until the stopping criteria are satisfied
-    while (! iter.Finished(r))
+    while (! iter.Finished(normr))
       {
 
 	rho_1 = DotProdConj(rtilde, r);
@@ -90,30 +100,28 @@ namespace Seldon
 	    // p= r + beta*(p-omega*v)
 	    // beta = rho_i/rho_{i-1} * alpha/omega
 	    beta = (rho_1 / rho_2) * (alpha / omega);
-	    Add(-omega, v, p);
-	    Mlt(beta, p);
-	    Add(Complexe(1), r, p);
+	    MltAdd(Complexe(1), r, -beta * omega, v, beta, p);
 	  }
 	// preconditioning phat = M^{-1} p
 	M.Solve(A, p, phat);
 
-	// product matrix vector  v = A*phat
-	Mlt(A, phat, v);
+	// product matrix vector  v = A*phat, and sigma = (v,rtilde) in the
+	// same pass
+	sigma = MltDotProdConj(rtilde, A, phat, v);
 
-	// s=r-alpha*v  where alpha = rho_i / (v,rtilde)
-	sigma = DotProdConj(rtilde, v);
 	if (sigma == Complexe(0))
 	  {
 	    iter.Fail(3, "Bicgstab breakdown #3");
 	    break;
 	  }
+	// s=r-alpha*v  where alpha = rho_i / (v,rtilde)
+	// s is stored in r, and its norm is computed in the same pass
 	alpha = rho_1 / sigma;
-	Copy(r, s);
-	Add(-alpha, v, s);
+	normr = AddNorm2(-alpha, v, r);
 
 	// we increment iter, bicgstab has two products matrix vector
 	++iter;
-	if (iter.Finished(s))
+	if (iter.Finished(normr))
 	  {
 	    // x=x+alpha*phat
 	    Add(alpha, phat, x);
@@ -121,20 +129,18 @@ namespace Seldon
 	  }
 
 	// preconditioning shat = M^{-1} s
-	M.Solve(A, s, shat);
+	M.Solve(A, r, shat);
 
 	// product matrix vector t = A*shat
 	Mlt(A, shat, t);
 
-	omega = DotProdConj(t, s) / DotProdConj(t, t);
+	omega = DotProdConj(t, r) / DotProdConj(t, t);
 
 	// new iterate x=x+alpha*phat+omega*shat
-	Add(alpha, phat, x);
-	Add(omega, shat, x);
+	MltAdd(alpha, phat, omega, shat, Complexe(1), x);
 
 	// new residual r=s-omega*t
-	Copy(s, r);
-	Add(-omega, t, r);
+	normr = AddNorm2(-omega, t, r);
 
 	rho_2 = rho_1;
 
@@ -144,6 +150,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Implements  BiConjugate Gradient Stabilized (BICG-STAB)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int BiCgStab(Matrix1& A, Vector1& x, const Vector1& b,
+	       Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return BiCgStab(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_BICGSTAB_CXX
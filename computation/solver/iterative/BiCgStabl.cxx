@@ -39,10 +39,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int BiCgStabl(Matrix1& A, Vector1& x, const Vector1& b,
-		Preconditioner& M, Iteration<Titer> & iter)
+		Preconditioner& M, Iteration<Titer> & iter,
+		IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -55,11 +57,16 @@ namespace Seldon
     zero = 0.0; unity = 1.0;
 
     // q temporary vector before preconditioning, r0 initial residual
-    Vector1 q(b), r0(b);
-    Vector<Complexe> gamma(l+1), gamma_prime(l+1), gamma_twice(l+1);
-    Matrix<Complexe, General, RowMajor> tau(l+1,l+1);
+    work.Init(2*l+4, b, 3);
+    Vector1& q = work.GetVector(0);
+    Vector1& r0 = work.GetVector(1);
+    Vector<Complexe>& gamma = work.GetScalarVector(0, l+1);
+    Vector<Complexe>& gamma_prime = work.GetScalarVector(1, l+1);
+    Vector<Complexe>& gamma_twice = work.GetScalarVector(2, l+1);
+    Matrix<Complexe, General, RowMajor>& tau = work.GetMatrix(l+1, l+1);
     // history of u and residual r
-    std::vector<Vector1> r(l+1, b), u(l+1, b);
+    Vector1* r = &work.GetVector(2);
+    Vector1* u = &work.GetVector(l+3);
     for (int i = 0; i <= l; i++)
       {
 	r[i].Zero();
@@ -179,6 +186,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Implements BiConjugate Gradient Stabilized (BICG-STAB(l))
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int BiCgStabl(Matrix1& A, Vector1& x, const Vector1& b,
+		Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return BiCgStabl(A, x, b, M, iter, work);
+  }
+
 }
 
 #define SELDON_FILE_ITERATIVE_BICGSTABL_CXX
@@ -40,10 +40,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int BiCgcr(Matrix1& A, Vector1& x, const Vector1& b,
-	     Preconditioner& M, Iteration<Titer> & iter)
+	     Preconditioner& M, Iteration<Titer> & iter,
+	     IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -51,7 +53,13 @@ namespace Seldon
 
     typedef typename Vector1::value_type Complexe;
     Complexe rho, mu, alpha, beta, tau;
-    Vector1 v(b), w(b), s(b), z(b), p(b), a(b);
+    work.Init(6, b);
+    Vector1& v = work.GetVector(0);
+    Vector1& w = work.GetVector(1);
+    Vector1& s = work.GetVector(2);
+    Vector1& z = work.GetVector(3);
+    Vector1& p = work.GetVector(4);
+    Vector1& a = work.GetVector(5);
     v.Zero(); w.Zero(); s.Zero(); z.Zero();  p.Zero(); a.Zero();
 
     // we initialize iter
@@ -117,6 +125,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using BiCgCr
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int BiCgcr(Matrix1& A, Vector1& x, const Vector1& b,
+	     Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return BiCgcr(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_BICGCR_CXX
@@ -41,10 +41,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Cg(Matrix1& A, Vector1& x, const Vector1& b,
-	 Preconditioner& M, Iteration<Titer> & iter)
+	 Preconditioner& M, Iteration<Titer> & iter,
+	 IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -52,7 +54,11 @@ namespace Seldon
 
     typedef typename Vector1::value_type Complexe;
     Complexe rho(1), rho_1(1), alpha, beta,delta;
-    Vector1 p(b), q(b), r(b), z(b);
+    work.Init(4, b);
+    Vector1& p = work.GetVector(0);
+    Vector1& q = work.GetVector(1);
+    Vector1& r = work.GetVector(2);
+    Vector1& z = work.GetVector(3);
 
     // we initialize iter
     int success_init = iter.Init(b);
@@ -66,9 +72,10 @@ namespace Seldon
     else
       x.Zero();
 
+    Titer normr = Norm2(r);
     iter.SetNumberIteration(0);
     // Loop until the stopping criteria are satisfied
-    while (! iter.Finished(r))
+    while (! iter.Finished(normr))
       {
 
 	// Preconditioning z = M^{-1} r
@@ -89,13 +96,12 @@ namespace Seldon
 	  {
 	    // p = beta*p + z  where  beta = rho_i/rho_{i-1}
 	    beta = rho / rho_1;
-	    Mlt(beta, p);
-	    Add(Complexe(1), z, p);
+	    MltAdd(Complexe(1), z, beta, p);
 	  }
 
-	// matrix vector product q = A*p
-	Mlt(A, p, q);
-	delta = DotProdConj(p, q);
+	// matrix vector product q = A*p, and delta = (bar(p),q) in the same
+	// pass
+	delta = MltDotProdConj(A, p, q);
 	if (delta == Complexe(0))
 	  {
 	    iter.Fail(2, "Cg breakdown #2");
@@ -104,8 +110,8 @@ namespace Seldon
 	alpha = rho / delta;
 
 	// x = x + alpha*p  and r = r - alpha*q  where alpha = rho/(bar(p),q)
-	Add(alpha, p, x);
-	Add(-alpha, q, r);
+	// the norm of r is computed in the same pass
+	normr = AddNorm2(alpha, p, x, -alpha, q, r);
 
 	rho_1 = rho;
 
@@ -116,6 +122,20 @@ namespace Seldon
   }
 
 
+  //! Solves a linear system by using Conjugate Gradient (CG)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Cg(Matrix1& A, Vector1& x, const Vector1& b,
+	 Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Cg(A, x, b, M, iter, work);
+  }
+
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_CG_CXX
@@ -36,10 +36,12 @@ namespace Seldon
     \param[in] b  Right hand side of the linear system
     \param[in] M Left preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Cgne(Matrix1& A, Vector1& x, const Vector1& b,
-	   Preconditioner& M, Iteration<Titer> & iter)
+	   Preconditioner& M, Iteration<Titer> & iter,
+	   IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -47,7 +49,11 @@ namespace Seldon
 
     typedef typename Vector1::value_type Complexe;
     Complexe rho(1), rho_1(0), alpha, beta, delta;
-    Vector1 p(b), q(b), r(b), z(b);
+    work.Init(4, b);
+    Vector1& p = work.GetVector(0);
+    Vector1& q = work.GetVector(1);
+    Vector1& r = work.GetVector(2);
+    Vector1& z = work.GetVector(3);
     Titer dp;
 
     // x should be equal to 0
@@ -127,6 +133,20 @@ namespace Seldon
   }
 
 
+  //! Solves a linear system using Conjugate Gradient Normal Equation (CGNE)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Cgne(Matrix1& A, Vector1& x, const Vector1& b,
+	   Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Cgne(A, x, b, M, iter, work);
+  }
+
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_CGNE_CXX
@@ -41,10 +41,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Cgs(Matrix1& A, Vector1& x, const Vector1& b,
-	  Preconditioner& M, Iteration<Titer> & iter)
+	  Preconditioner& M, Iteration<Titer> & iter,
+	  IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -52,8 +54,16 @@ namespace Seldon
 
     typedef typename Vector1::value_type Complexe;
     Complexe rho_1, rho_2(0), alpha, beta, delta;
-    Vector1 p(b), phat(b), q(b), qhat(b), vhat(b), u(b), uhat(b),
-      r(b), rtilde(b);
+    work.Init(9, b);
+    Vector1& p = work.GetVector(0);
+    Vector1& phat = work.GetVector(1);
+    Vector1& q = work.GetVector(2);
+    Vector1& qhat = work.GetVector(3);
+    Vector1& vhat = work.GetVector(4);
+    Vector1& u = work.GetVector(5);
+    Vector1& uhat = work.GetVector(6);
+    Vector1& r = work.GetVector(7);
+    Vector1& rtilde = work.GetVector(8);
 
     // we initialize iter
     int success_init = iter.Init(b);
@@ -131,6 +141,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves linear system using Conjugate Gradient Squared (CGS)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Cgs(Matrix1& A, Vector1& x, const Vector1& b,
+	  Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Cgs(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_CGS_CXX
@@ -40,10 +40,12 @@ namespace Seldon
     \param[in] b  Right hand side of the linear system
     \param[in] M Left preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int CoCg(Matrix1& A, Vector1& x, const Vector1& b,
-	   Preconditioner& M, Iteration<Titer> & iter)
+	   Preconditioner& M, Iteration<Titer> & iter,
+	   IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -54,7 +56,11 @@ namespace Seldon
     zero = b(0)*Titer(0);
     rho = zero+Titer(1);
 
-    Vector1 p(b), q(b), r(b), z(b);
+    work.Init(4, b);
+    Vector1& p = work.GetVector(0);
+    Vector1& q = work.GetVector(1);
+    Vector1& r = work.GetVector(2);
+    Vector1& z = work.GetVector(3);
     p.Fill(zero); q.Fill(zero); r.Fill(zero); z.Fill(zero);
 
     // for implementation see Cg
@@ -116,6 +122,20 @@ namespace Seldon
   }
 
 
+  //! Solves a linear system by using Conjugate Orthogonal Conjugate Gradient
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int CoCg(Matrix1& A, Vector1& x, const Vector1& b,
+	   Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return CoCg(A, x, b, M, iter, work);
+  }
+
+
 } // end namespace
 
 #define ITERATIVE_COCG_CXX
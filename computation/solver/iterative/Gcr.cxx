@@ -41,10 +41,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] outer Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Gcr(Matrix1& A, Vector1& x, const Vector1& b,
-	  Preconditioner& M, Iteration<Titer> & outer)
+	  Preconditioner& M, Iteration<Titer> & outer,
+	  IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -57,11 +59,17 @@ namespace Seldon
     if (success_init != 0)
       return outer.ErrorCode();
 
-    std::vector<Vector1> p(m+1, b), w(m+1, b);
+    // p(i) and w(i) are stored in work.GetVector(i + 3)
+    // and work.GetVector(i + m + 4)
+    work.Init(2*m+5, b, 1);
+    Vector1* p = &work.GetVector(3);
+    Vector1* w = &work.GetVector(m+4);
 
-    Vector<Complexe> beta(m+1);
+    Vector<Complexe>& beta = work.GetScalarVector(0, m+1);
 
-    Vector1 r(b), q(b), u(b);
+    Vector1& r = work.GetVector(0);
+    Vector1& q = work.GetVector(1);
+    Vector1& u = work.GetVector(2);
 
     for (int i = 0; i < (m+1); i++)
       {
@@ -140,6 +148,20 @@ namespace Seldon
     return outer.ErrorCode();
   }
 
+
+  //! Solves a linear system by using Generalized Conjugate Residual (GCR)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Gcr(Matrix1& A, Vector1& x, const Vector1& b,
+	  Preconditioner& M, Iteration<Titer> & outer)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Gcr(A, x, b, M, outer, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_GCR_CXX
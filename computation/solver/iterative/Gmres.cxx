@@ -40,10 +40,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] outer Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class MatrixSparse, class Vector1, class Preconditioner>
   int Gmres(MatrixSparse& A, Vector1& x, const Vector1& b,
-	    Preconditioner& M, Iteration<Titer> & outer)
+	    Preconditioner& M, Iteration<Titer> & outer,
+	    IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -55,27 +57,33 @@ namespace Seldon
     int m = outer.GetRestart();
     // V is the array of orthogonal basis contructed
     // from the Krylov subspace (v0,A*v0,A^2*v0,...,A^m*v0)
-    std::vector<Vector1> V(m+1, b);
+    // V(i) is stored in work.GetVector(i + 3)
+    work.Init(m+4, b, 2);
+    Vector1* V = &work.GetVector(3);
 
     // Upper triangular hessenberg matrix
     // we don't store the sub-diagonal
     // we apply rotations to eliminate this sub-diagonal
-    Matrix<Complexe, General, ColUpTriang> H(m+1,m+1); H.Fill(zero);
+    Matrix<Complexe, General, ColUpTriang>& H
+      = work.GetUpperTriangularMatrix(m+1);
+    H.Fill(zero);
 
     // s is the vector of residual norm for each inner iteration
     // w is used in the Arnoldi algorithm
     // u is a temporary vector which contains the product A*v(i)
     // r is the residual
-    Vector1 w(b), r(b), u(b);
-    Vector<Complexe> s(m+1);
+    Vector1& w = work.GetVector(0);
+    Vector1& r = work.GetVector(1);
+    Vector1& u = work.GetVector(2);
+    Vector<Complexe>& s = work.GetScalarVector(0, m+1);
     s.Fill(zero); w.Fill(zero); r.Fill(zero); u.Fill(zero);
 
     for (int i = 0; i < m+1; i++)
       V[i].Fill(zero);
 
-    Vector<Complexe> rotations_sin(m+1);
+    Vector<Complexe>& rotations_sin = work.GetScalarVector(1, m+1);
     rotations_sin.Fill(zero);
-    Vector<Titer> rotations_cos(m+1);
+    Vector<Titer>& rotations_cos = work.GetRealVector(m+1);
     rotations_cos.Fill(Titer(0));
 
     // we compute residual
@@ -161,9 +169,14 @@ namespace Seldon
 
 	  } while (! inner.Finished(abs(s(i))));
 
-	// Now we solve the triangular system H
-	H.Resize(i, i); s.Resize(i);
-	Solve(H, s); s.Resize(m+1);
+	// Now we solve the triangular system H(0:i, 0:i) y = s(0:i)
+	// by back substitution, y is stored in s
+	for (k = i-1; k >= 0; k--)
+	  {
+	    for (int j = k+1; j < i; j++)
+	      s(k) -= H(k, j) * s(j);
+	    s(k) /= H(k, k);
+	  }
 
 	// new iterate x = x + sum_0^{i-1} s(k)*V(k)
 	for (k = 0; k < i; k++)
@@ -182,6 +195,20 @@ namespace Seldon
 
   }
 
+
+  //! Solves a linear system by using Generalized Minimum Residual (GMRES)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class MatrixSparse, class Vector1, class Preconditioner>
+  int Gmres(MatrixSparse& A, Vector1& x, const Vector1& b,
+	    Preconditioner& M, Iteration<Titer> & outer)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Gmres(A, x, b, M, outer, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_GMRES_CXX
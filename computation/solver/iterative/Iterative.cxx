@@ -353,6 +353,126 @@ namespace Seldon
     return 0;
   }
 
+
+
+  /**********************
+   * IterativeWorkspace *
+   **********************/
+
+
+  //! Initializes the work vectors
+  /*!
+    On exit, the \a nb_vector first work vectors are copies of \a b. The
+    work vectors are only allocated if they do not exist yet or if the size
+    of \a b changed. The references previously returned by GetVector and
+    GetScalarVector are no longer valid.
+    \param[in] nb_vector number of work vectors
+    \param[in] b right-hand side
+    \param[in] nb_scalar number of small vectors
+  */
+  template<class Titer, class Vector1>
+  void IterativeWorkspace<Titer, Vector1>
+  ::Init(int nb_vector, const Vector1& b, int nb_scalar)
+  {
+    int nb_old = vector_.size();
+    if (nb_old < nb_vector)
+      vector_.resize(nb_vector, b);
+
+    for (int i = 0; i < min(nb_old, nb_vector); i++)
+      vector_[i] = b;
+
+    if (int(scalar_.size()) < nb_scalar)
+      scalar_.resize(nb_scalar);
+  }
+
+
+  //! Returns the number of work vectors
+  template<class Titer, class Vector1>
+  inline int IterativeWorkspace<Titer, Vector1>::GetNbVector() const
+  {
+    return vector_.size();
+  }
+
+
+  //! Returns a work vector
+  /*!
+    The work vectors are stored contiguously, so that &GetVector(i) may be
+    used as an array of work vectors.
+    \param[in] i index of the work vector, lower than the number of
+    vectors given to Init
+  */
+  template<class Titer, class Vector1>
+  inline Vector1& IterativeWorkspace<Titer, Vector1>::GetVector(int i)
+  {
+    return vector_[i];
+  }
+
+
+  //! Returns a small vector of length n
+  /*!
+    \param[in] i index of the small vector, lower than the number of small
+    vectors given to Init
+    \param[in] n length of the vector
+    \return The vector, whose values are undefined.
+  */
+  template<class Titer, class Vector1>
+  inline Vector<typename Vector1::value_type>&
+  IterativeWorkspace<Titer, Vector1>::GetScalarVector(int i, int n)
+  {
+    scalar_[i].Reallocate(n);
+    return scalar_[i];
+  }
+
+
+  //! Returns the small real vector of length n
+  /*!
+    \return The vector, whose values are undefined.
+  */
+  template<class Titer, class Vector1>
+  inline Vector<Titer>& IterativeWorkspace<Titer, Vector1>::GetRealVector(int n)
+  {
+    real_.Reallocate(n);
+    return real_;
+  }
+
+
+  //! Returns the small dense matrix, with m rows and n columns
+  /*!
+    \return The matrix, whose values are undefined.
+  */
+  template<class Titer, class Vector1>
+  inline Matrix<typename Vector1::value_type, General, RowMajor>&
+  IterativeWorkspace<Titer, Vector1>::GetMatrix(int m, int n)
+  {
+    matrix_.Reallocate(m, n);
+    return matrix_;
+  }
+
+
+  //! Returns the small upper triangular matrix, of size n
+  /*!
+    \return The matrix, whose values are undefined.
+  */
+  template<class Titer, class Vector1>
+  inline Matrix<typename Vector1::value_type, General, ColUpTriang>&
+  IterativeWorkspace<Titer, Vector1>::GetUpperTriangularMatrix(int n)
+  {
+    triangular_.Reallocate(n, n);
+    return triangular_;
+  }
+
+
+  //! Releases the memory of all work arrays
+  template<class Titer, class Vector1>
+  void IterativeWorkspace<Titer, Vector1>::Clear()
+  {
+    vector_.clear();
+    scalar_.clear();
+    real_.Clear();
+    matrix_.Clear();
+    triangular_.Clear();
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_CXX
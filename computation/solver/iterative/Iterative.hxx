@@ -107,6 +107,48 @@ namespace Seldon
 
   };
 
+
+  //! Work arrays of the iterative solvers, kept from one call to another
+  /*!
+    The iterative solvers need several vectors of the size of the right-hand
+    side, and a few small arrays (e.g. the Hessenberg matrix of Gmres). If
+    the same workspace is given to successive calls, these arrays are only
+    allocated by the first call, as long as the size of the system and the
+    parameters of the solver do not change. A workspace may be used by
+    different solvers, but not by simultaneous calls.
+  */
+  template<class Titer, class Vector1>
+  class IterativeWorkspace
+  {
+  public :
+    typedef typename Vector1::value_type value_type;
+
+  protected :
+    //! work vectors, of the size of the right-hand side
+    std::vector<Vector1> vector_;
+    //! small vectors
+    std::vector<Vector<value_type> > scalar_;
+    //! small real vector
+    Vector<Titer> real_;
+    //! small dense matrix
+    Matrix<value_type, General, RowMajor> matrix_;
+    //! small upper triangular matrix
+    Matrix<value_type, General, ColUpTriang> triangular_;
+
+  public :
+
+    void Init(int nb_vector, const Vector1& b, int nb_scalar = 0);
+    int GetNbVector() const;
+    Vector1& GetVector(int i);
+    Vector<value_type>& GetScalarVector(int i, int n);
+    Vector<Titer>& GetRealVector(int n);
+    Matrix<value_type, General, RowMajor>& GetMatrix(int m, int n);
+    Matrix<value_type, General, ColUpTriang>&
+    GetUpperTriangularMatrix(int n);
+    void Clear();
+
+  };
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_HXX
@@ -36,10 +36,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Lsqr(Matrix1& A, Vector1& x, const Vector1& b,
-	   Preconditioner& M, Iteration<Titer> & iter)
+	   Preconditioner& M, Iteration<Titer> & iter,
+	   IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -48,7 +50,12 @@ namespace Seldon
     typedef typename Vector1::value_type Complexe;
     Complexe rho, rho_bar, phi, phi_bar, theta, c, s, tmp;
     Titer beta, alpha, rnorm;
-    Vector1 v(b), v1(b), u(b), u1(b), w(b);
+    work.Init(5, b);
+    Vector1& v = work.GetVector(0);
+    Vector1& v1 = work.GetVector(1);
+    Vector1& u = work.GetVector(2);
+    Vector1& u1 = work.GetVector(3);
+    Vector1& w = work.GetVector(4);
 
     int success_init = iter.Init(b);
     if (success_init != 0)
@@ -134,6 +141,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using Least Squares (LSQR)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Lsqr(Matrix1& A, Vector1& x, const Vector1& b,
+	   Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Lsqr(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_LSQR_CXX
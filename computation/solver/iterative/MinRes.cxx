@@ -42,18 +42,30 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int MinRes(Matrix1& A, Vector1& x, const Vector1& b,
-	     Preconditioner& M, Iteration<Titer> & iter)
+	     Preconditioner& M, Iteration<Titer> & iter,
+	     IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
       return 0;
 
     typedef typename Vector1::value_type Complexe;
-    Vector1 u_old(b), u(b), r(b), v_old(b), v(b),
-      w_old(b), w(b), z(b), w_oold(b);
+    // the vectors are handled through pointers, so that they can be
+    // exchanged at the end of each iteration without being copied
+    work.Init(8, b);
+    Vector1* u_old = &work.GetVector(0);
+    Vector1* u = &work.GetVector(1);
+    Vector1* r = &work.GetVector(2);
+    Vector1* v_old = &work.GetVector(3);
+    Vector1* v = &work.GetVector(4);
+    Vector1* w_old = &work.GetVector(5);
+    Vector1* w = &work.GetVector(6);
+    Vector1* z = &work.GetVector(7);
+    Vector1* tmp;
 
     Complexe dp, beta, ibeta, beta_old, alpha, eta, ceta;
     Complexe cold, coold, c, soold, sold, s, rho0, rho1, rho2, rho3;
@@ -62,22 +74,22 @@ namespace Seldon
     if (success_init != 0)
       return iter.ErrorCode();
 
-    Copy(b,r);
+    Copy(b, *r);
     // r = b - A x
     if (!iter.IsInitGuess_Null())
-      MltAdd(Complexe(-1), A, x, Complexe(1), r);
+      MltAdd(Complexe(-1), A, x, Complexe(1), *r);
     else
       x.Zero();
 
-    u_old.Zero(); v_old.Zero(); w_old.Zero(); w.Zero(); w_oold.Zero();
+    u_old->Zero(); v_old->Zero(); w_old->Zero(); w->Zero();
     // preconditioning
-    M.Solve(A, r, z);
-    dp = DotProd(r, z);
+    M.Solve(A, *r, *z);
+    dp = DotProd(*r, *z);
     dp = sqrt(dp); beta = dp; eta = beta;
-    Copy(r, v); Copy(z, u);
+    Copy(*r, *v); Copy(*z, *u);
 
     ibeta = 1.0 / beta;
-    Mlt(ibeta, v); Mlt(ibeta, u);
+    Mlt(ibeta, *v); Mlt(ibeta, *u);
 
     c = 1.0; s = 0.0; cold = 1.0; sold = 0.0;
     Titer np = Norm2(b);
@@ -86,24 +98,19 @@ namespace Seldon
     // Loop until the stopping criteria are satisfied
     while (!iter.Finished(np))
       {
-	// matrix-vector product r = A*u
-	Mlt(A, u, r);
-	alpha = DotProd(r, u);
+	// matrix-vector product r = A*u, and alpha = (r, u) in the same pass
+	alpha = MltDotProd(A, *u, *r);
 	// preconditioning
-	M.Solve(A, r, z);
+	M.Solve(A, *r, *z);
 
-	//  r = r - alpha v
-	//  z = z - alpha u
-	Add(-alpha, v, r);
-	Add(-alpha, u, z);
-	//  r = r - beta v_old
-	//  z = z - beta u_old
-	Add(-beta, v_old, r);
-	Add(-beta, u_old, z);
+	//  r = r - alpha v - beta v_old
+	//  z = z - alpha u - beta u_old
+	MltAdd(-alpha, *v, -beta, *v_old, Complexe(1), *r);
+	MltAdd(-alpha, *u, -beta, *u_old, Complexe(1), *z);
 
 	beta_old = beta;
 
-	dp = DotProd(r, z);
+	dp = DotProd(*r, *z);
 	beta = sqrt(dp);
 
 	// QR factorization
@@ -123,27 +130,26 @@ namespace Seldon
 	c = rho0 / rho1;
 	s = beta / rho1;
 
-	// update
-	Copy(w_old, w_oold); Copy(w, w_old);
-	Copy(u, w);
-
-	Add(-rho2, w_old, w);
-	Add(-rho3, w_oold, w);
-	Mlt(Complexe(1./rho1), w);
+	// update w = (u - rho2 w - rho3 w_old) / rho1
+	// the new w is computed in the place of w_old
+	MltAdd(Complexe(1) / rho1, *u, -rho2 / rho1, *w,
+	       -rho3 / rho1, *w_old);
+	tmp = w_old; w_old = w; w = tmp;
 
 	ceta = c*eta;
-	Add(ceta, w, x);
+	Add(ceta, *w, x);
 	eta = -s*eta;
 
-	Copy(v, v_old); Copy(u, u_old);
-	Copy(r, v); Copy(z, u);
+	// v_old = v, v = r, u_old = u, u = z
+	tmp = v_old; v_old = v; v = r; r = tmp;
+	tmp = u_old; u_old = u; u = z; z = tmp;
 	if (beta == Complexe(0) )
 	  {
 	    iter.Fail(2, "MinRes breakdown #2");
 	    break;
 	  }
 	ibeta = 1.0/beta;
-	Mlt(ibeta, v); Mlt(ibeta, u);
+	Mlt(ibeta, *v); Mlt(ibeta, *u);
 
 	// residual norm
 	np *= abs(s);
@@ -152,6 +158,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using Minimum Residual (MinRes)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int MinRes(Matrix1& A, Vector1& x, const Vector1& b,
+	     Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return MinRes(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_MINRES_CXX
@@ -42,10 +42,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int QCgs(Matrix1& A, Vector1& x, const Vector1& b,
-	   Preconditioner& M, Iteration<Titer> & iter)
+	   Preconditioner& M, Iteration<Titer> & iter,
+	   IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -53,8 +55,16 @@ namespace Seldon
 
     typedef typename Vector1::value_type Complexe;
     Complexe rho_1, rho_2, mu,nu,alpha,beta,sigma,delta;
-    Vector1 p(b), q(b), r(b), rtilde(b), u(b),
-      phat(b), r_qcgs(b), x_qcgs(b), v(b);
+    work.Init(9, b);
+    Vector1& p = work.GetVector(0);
+    Vector1& q = work.GetVector(1);
+    Vector1& r = work.GetVector(2);
+    Vector1& rtilde = work.GetVector(3);
+    Vector1& u = work.GetVector(4);
+    Vector1& phat = work.GetVector(5);
+    Vector1& r_qcgs = work.GetVector(6);
+    Vector1& x_qcgs = work.GetVector(7);
+    Vector1& v = work.GetVector(8);
 
     // we initialize iter
     int success_init = iter.Init(b);
@@ -72,8 +82,8 @@ namespace Seldon
     rho_1 = Complexe(1);
     q.Zero(); p.Zero();
     Copy(r, r_qcgs); Copy(x, x_qcgs);
-    Matrix<Complexe, Symmetric, RowSymPacked> bt_b(2,2),bt_b_m1(2,2);
-    Vector<Complexe> bt_rn(2);
+    TinyMatrix<Complexe, 2, 2> bt_b, bt_b_m1;
+    TinyVector<Complexe, 2> bt_rn;
 
     iter.SetNumberIteration(0);
     // Loop until the stopping criteria are reached
@@ -130,6 +140,7 @@ namespace Seldon
 	bt_b(0,0) = DotProd(u,u);
 	bt_b(1,1) = DotProd(v,v);
 	bt_b(1,0) = DotProd(u,v);
+	bt_b(0,1) = bt_b(1,0);
 
 	// we compute inverse of bt_b
 	delta = bt_b(0,0)*bt_b(1,1) - bt_b(1,0)*bt_b(0,1);
@@ -141,6 +152,7 @@ namespace Seldon
 	bt_b_m1(0,0) = bt_b(1,1)/delta;
 	bt_b_m1(1,1) = bt_b(0,0)/delta;
 	bt_b_m1(1,0) = -bt_b(1,0)/delta;
+	bt_b_m1(0,1) = bt_b_m1(1,0);
 
 	bt_rn(0) = -DotProd(u, r); bt_rn(1) = -DotProd(v, r);
 	mu = bt_b_m1(0,0)*bt_rn(0)+bt_b_m1(0,1)*bt_rn(1);
@@ -164,6 +176,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves linear system using Quasi-minimized Conjugate Gradient Squared
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int QCgs(Matrix1& A, Vector1& x, const Vector1& b,
+	   Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return QCgs(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_QCGS_CXX
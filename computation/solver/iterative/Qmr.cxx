@@ -37,10 +37,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Qmr(Matrix1& A, Vector1& x, const Vector1& b,
-	  Preconditioner& M, Iteration<Titer> & iter)
+	  Preconditioner& M, Iteration<Titer> & iter,
+	  IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -52,9 +54,18 @@ namespace Seldon
     Complexe theta_1, gamma_1;
     Complexe theta(0), gamma(1), eta(-1);
 
-    Vector1 r(b), y(b), z_tld(b); r.Zero();
-    Vector1 v(b), w(b), p_tld(b);
-    Vector1 p(b), q(b), d(b), s(b);
+    work.Init(10, b);
+    Vector1& r = work.GetVector(0);
+    Vector1& y = work.GetVector(1);
+    Vector1& z_tld = work.GetVector(2);
+    r.Zero();
+    Vector1& v = work.GetVector(3);
+    Vector1& w = work.GetVector(4);
+    Vector1& p_tld = work.GetVector(5);
+    Vector1& p = work.GetVector(6);
+    Vector1& q = work.GetVector(7);
+    Vector1& d = work.GetVector(8);
+    Vector1& s = work.GetVector(9);
 
     // we initialize iter
     int success_init = iter.Init(b);
@@ -194,6 +205,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using Quasi-Minimal Residual (QMR)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Qmr(Matrix1& A, Vector1& x, const Vector1& b,
+	  Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Qmr(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_QMR_CXX
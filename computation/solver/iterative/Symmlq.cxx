@@ -41,10 +41,12 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int Symmlq(Matrix1& A, Vector1& x, const Vector1& b,
-	     Preconditioner& M, Iteration<Titer> & iter)
+	     Preconditioner& M, Iteration<Titer> & iter,
+	     IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
@@ -55,7 +57,15 @@ namespace Seldon
       ceta(0), ceta_oold, ceta_old, ceta_bar;
     Complexe c, cold, s, sold, coold, soold, rho0, rho1, rho2, rho3, dp;
 
-    Vector1 r(b), z(b), u(b), v(b), w(b), u_old(b), v_old(b), w_bar(b);
+    work.Init(8, b);
+    Vector1& r = work.GetVector(0);
+    Vector1& z = work.GetVector(1);
+    Vector1& u = work.GetVector(2);
+    Vector1& v = work.GetVector(3);
+    Vector1& w = work.GetVector(4);
+    Vector1& u_old = work.GetVector(5);
+    Vector1& v_old = work.GetVector(6);
+    Vector1& w_bar = work.GetVector(7);
 
     Titer np, s_prod;
     u_old.Zero(); v_old.Zero(); w.Zero(); w_bar.Zero();
@@ -162,6 +172,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using Symmetric LQ (SymmLQ)
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int Symmlq(Matrix1& A, Vector1& x, const Vector1& b,
+	     Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return Symmlq(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_SYMMLQ_CXX
@@ -40,17 +40,28 @@ namespace Seldon
     \param[in] b  Vector right hand side of the linear system
     \param[in] M Right preconditioner
     \param[in] iter Iteration parameters
+    \param[in,out] work work arrays, kept from one call to another
   */
   template <class Titer, class Matrix1, class Vector1, class Preconditioner>
   int TfQmr(Matrix1& A, Vector1& x, const Vector1& b,
-	    Preconditioner& M, Iteration<Titer> & iter)
+	    Preconditioner& M, Iteration<Titer> & iter,
+	    IterativeWorkspace<Titer, Vector1>& work)
   {
     const int N = A.GetM();
     if (N <= 0)
       return 0;
 
-    Vector1 tmp(b), r0(b), v(b), h(b), w(b),
-      y1(b), g(b), y0(b), rtilde(b), d(b);
+    work.Init(10, b);
+    Vector1& tmp = work.GetVector(0);
+    Vector1& r0 = work.GetVector(1);
+    Vector1& v = work.GetVector(2);
+    Vector1& h = work.GetVector(3);
+    Vector1& w = work.GetVector(4);
+    Vector1& y1 = work.GetVector(5);
+    Vector1& g = work.GetVector(6);
+    Vector1& y0 = work.GetVector(7);
+    Vector1& rtilde = work.GetVector(8);
+    Vector1& d = work.GetVector(9);
 
     typedef typename Vector1::value_type Complexe;
     Complexe sigma, alpha, beta, eta, rho, rho0;
@@ -242,6 +253,20 @@ namespace Seldon
     return iter.ErrorCode();
   }
 
+
+  //! Solves a linear system by using Transpose Free Quasi-Minimal Residual
+  /*!
+    The work vectors are allocated at each call, see the overload with an
+    IterativeWorkspace argument to keep them from one call to another.
+  */
+  template <class Titer, class Matrix1, class Vector1, class Preconditioner>
+  int TfQmr(Matrix1& A, Vector1& x, const Vector1& b,
+	    Preconditioner& M, Iteration<Titer> & iter)
+  {
+    IterativeWorkspace<Titer, Vector1> work;
+    return TfQmr(A, x, b, M, iter, work);
+  }
+
 } // end namespace
 
 #define SELDON_FILE_ITERATIVE_TFQMR_CXX
@@ -86,6 +86,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The underlying matrices of \a A are taken over, without any copy.
+    \param[in,out] A matrix collection to be moved. On exit, it is empty.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline MatrixCollection<T, Prop, Storage, Allocator>
+  ::MatrixCollection(MatrixCollection<T, Prop, Storage, Allocator>&& A) noexcept
+    : Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    Mmatrix_ = 0;
+    Nmatrix_ = 0;
+    Swap(A);
+  }
+#endif
+
+
   /**************
    * DESTRUCTOR *
    **************/
@@ -145,6 +163,28 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix collection with another matrix collection.
+  /*! No element is copied: only the underlying matrices and their
+    dimensions are exchanged.
+    \param[in,out] A matrix collection to be swapped with the current
+    instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void MatrixCollection<T, Prop, Storage, Allocator>
+  ::Swap(MatrixCollection<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+    swap(nz_, A.nz_);
+    swap(Mmatrix_, A.Mmatrix_);
+    swap(Nmatrix_, A.Nmatrix_);
+    Mlocal_.Swap(A.Mlocal_);
+    Mlocal_sum_.Swap(A.Mlocal_sum_);
+    Nlocal_.Swap(A.Nlocal_);
+    Nlocal_sum_.Swap(A.Nlocal_sum_);
+    matrix_.Swap(A.matrix_);
+  }
+
+
   //! Clears a given underlying matrix.
   /*!
     \param[in] i row of the underlying matrix to be nullified.
@@ -549,6 +589,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the matrices of a collection (move assignment operator).
+  /*!
+    \param[in,out] A matrix collection to be moved. No element is copied:
+    the underlying matrices of \a A and of the current instance are
+    exchanged.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline MatrixCollection<T, Prop, Storage, Allocator>&
+  MatrixCollection<T, Prop, Storage, Allocator>
+  ::operator= (MatrixCollection<T, Prop, Storage, Allocator>&& A) noexcept
+  {
+    Swap(A);
+    return *this;
+  }
+#endif
+
+
   //! Duplicates a matrix collection.
   /*!
     \param[in] A matrix collection to be copied.
@@ -978,6 +1036,15 @@ namespace Seldon
   }
 
 
+  //! Swaps two matrix collections (see Swap).
+  /*! The underlying matrices are exchanged without being copied. */
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, MatrixCollection<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
 } // namespace Seldon.
 
 
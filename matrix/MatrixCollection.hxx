@@ -83,12 +83,17 @@ namespace Seldon
     MatrixCollection();
     MatrixCollection(int i, int j);
     MatrixCollection(const MatrixCollection<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    MatrixCollection(MatrixCollection<T, Prop, Storage, Allocator>&& A)
+      noexcept;
+#endif
 
     // Destructor.
     ~MatrixCollection();
     void Clear();
     void Nullify();
     void Nullify(int i, int j);
+    void Swap(MatrixCollection<T, Prop, Storage, Allocator>& A);
 
     void Deallocate();
 
@@ -121,6 +126,10 @@ namespace Seldon
 
     MatrixCollection<T, Prop, Storage, Allocator>&
     operator= (const MatrixCollection<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    MatrixCollection<T, Prop, Storage, Allocator>&
+    operator= (MatrixCollection<T, Prop, Storage, Allocator>&& A) noexcept;
+#endif
     void Copy(const MatrixCollection<T, Prop, Storage, Allocator>& A);
 
     // Convenient functions.
@@ -210,6 +219,9 @@ namespace Seldon
   };
 
 
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B, MatrixCollection<T, Prop, Storage, Allocator>*);
+
 
 } // namespace Seldon.
 
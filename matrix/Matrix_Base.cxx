@@ -263,6 +263,21 @@ namespace Seldon
   }
 
 
+  //! Swaps the dimensions and the data of two matrices.
+  /*!
+    No element is copied. Derived classes exchange their own attributes in
+    addition.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Allocator>
+  inline void Matrix_Base<T, Allocator>::Swap(Matrix_Base<T, Allocator>& A)
+  {
+    swap(m_, A.m_);
+    swap(n_, A.n_);
+    swap(data_, A.data_);
+  }
+
+
   // operator<< overloaded for matrices.
   /*!
     \param out output stream.
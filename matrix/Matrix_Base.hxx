@@ -87,6 +87,9 @@ namespace Seldon
 
     Allocator& GetAllocator();
 
+  protected:
+    void Swap(Matrix_Base<T, Allocator>& A);
+
   };
 
 
@@ -261,6 +261,19 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the arrays are exchanged.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_HermPacked<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_HermPacked<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+  }
+
+
   /**********************************
    * ELEMENT ACCESS AND AFFECTATION *
    **********************************/
@@ -430,6 +430,20 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the arrays are exchanged.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Hermitian<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_Hermitian<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+    swap(me_, A.me_);
+  }
+
+
   //! Reallocates memory to resize the matrix and keeps previous entries.
   /*!
     On exit, the matrix is a i x j matrix.
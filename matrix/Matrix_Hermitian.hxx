@@ -70,6 +70,7 @@ namespace Seldon
     void Reallocate(int i, int j);
     void SetData(int i, int j, pointer data);
     void Nullify();
+    void Swap(Matrix_Hermitian<T, Prop, Storage, Allocator>& A);
     void Resize(int i, int j);
 
     // Element access and affectation.
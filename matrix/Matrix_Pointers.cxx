@@ -421,6 +421,20 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the arrays are exchanged.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Pointers<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_Pointers<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+    swap(me_, A.me_);
+  }
+
+
   //! Reallocates memory to resize the matrix and keeps previous entries.
   /*!
     On exit, the matrix is a i x j matrix.
@@ -1218,6 +1232,21 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The data of \a A are taken over, without any copy.
+    \param A matrix to be moved. On exit, it is empty.
+  */
+  template <class T, class Prop, class Allocator>
+  Matrix<T, Prop, ColMajor, Allocator>
+  ::Matrix(Matrix<T, Prop, ColMajor, Allocator>&& A) noexcept:
+    Matrix_Pointers<T, Prop, ColMajor, Allocator>()
+  {
+    this->Swap(A);
+  }
+#endif
+
+
   /*****************
    * OTHER METHODS *
    *****************/
@@ -1255,6 +1284,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a matrix (move assignment operator).
+  /*!
+    \param A matrix to be moved. No element is copied: the arrays of \a A
+    and of the current instance are exchanged.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, ColMajor, Allocator>&
+  Matrix<T, Prop, ColMajor, Allocator>
+  ::operator= (Matrix<T, Prop, ColMajor, Allocator>&& A) noexcept
+  {
+    this->Swap(A);
+
+    return *this;
+  }
+#endif
+
+
   //! Multiplies the matrix by a scalar.
   /*!
     \param alpha scalar.
@@ -1312,6 +1359,21 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The data of \a A are taken over, without any copy.
+    \param A matrix to be moved. On exit, it is empty.
+  */
+  template <class T, class Prop, class Allocator>
+  Matrix<T, Prop, RowMajor, Allocator>
+  ::Matrix(Matrix<T, Prop, RowMajor, Allocator>&& A) noexcept:
+    Matrix_Pointers<T, Prop, RowMajor, Allocator>()
+  {
+    this->Swap(A);
+  }
+#endif
+
+
   /*****************
    * OTHER METHODS *
    *****************/
@@ -1349,6 +1411,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a matrix (move assignment operator).
+  /*!
+    \param A matrix to be moved. No element is copied: the arrays of \a A
+    and of the current instance are exchanged.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, RowMajor, Allocator>&
+  Matrix<T, Prop, RowMajor, Allocator>
+  ::operator= (Matrix<T, Prop, RowMajor, Allocator>&& A) noexcept
+  {
+    this->Swap(A);
+
+    return *this;
+  }
+#endif
+
+
   //! Multiplies the matrix by a scalar.
   /*!
     \param alpha scalar.
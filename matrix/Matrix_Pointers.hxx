@@ -70,6 +70,7 @@ namespace Seldon
     void Reallocate(int i, int j);
     void SetData(int i, int j, pointer data);
     void Nullify();
+    void Swap(Matrix_Pointers<T, Prop, Storage, Allocator>& A);
     void Resize(int i, int j);
 
     // Element access and affectation.
@@ -140,12 +141,19 @@ namespace Seldon
     Matrix();
     Matrix(int i, int j);
     Matrix(const Matrix<T, Prop, ColMajor, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix(Matrix<T, Prop, ColMajor, Allocator>&& A) noexcept;
+#endif
 
 #ifndef SWIG
     template <class T0>
     Matrix<T, Prop, ColMajor, Allocator>& operator= (const T0& x);
     Matrix<T, Prop, ColMajor, Allocator>& operator=(const Matrix<T, Prop,
                                                     ColMajor, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix<T, Prop, ColMajor, Allocator>&
+    operator=(Matrix<T, Prop, ColMajor, Allocator>&& A) noexcept;
+#endif
 #endif
     template<class T0>
     Matrix<T, Prop, ColMajor, Allocator>& operator*= (const T0& x);
@@ -168,6 +176,9 @@ namespace Seldon
     Matrix();
     Matrix(int i, int j);
     Matrix(const Matrix<T, Prop, RowMajor, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix(Matrix<T, Prop, RowMajor, Allocator>&& A) noexcept;
+#endif
 
 #ifndef SWIG
 
@@ -175,6 +186,10 @@ namespace Seldon
     Matrix<T, Prop, RowMajor, Allocator>& operator= (const T0& x);
     Matrix<T, Prop, RowMajor, Allocator>& operator=(const Matrix<T, Prop,
                                                     RowMajor, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix<T, Prop, RowMajor, Allocator>&
+    operator=(Matrix<T, Prop, RowMajor, Allocator>&& A) noexcept;
+#endif
 #endif
     template<class T0>
     Matrix<T, Prop, RowMajor, Allocator>& operator*= (const T0& x);
@@ -68,6 +68,7 @@ namespace Seldon
     void Reallocate(int i, int j);
     void SetData(int i, int j, pointer data);
     void Nullify();
+    void Swap(Matrix_SymPacked<T, Prop, Storage, Allocator>& A);
 
     // Element access and affectation.
     reference operator() (int i, int j);
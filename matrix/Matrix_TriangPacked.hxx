@@ -70,6 +70,7 @@ namespace Seldon
     void Reallocate(int i, int j);
     void SetData(int i, int j, pointer data);
     void Nullify();
+    void Swap(Matrix_TriangPacked<T, Prop, Storage, Allocator>& A);
 
     // Element access and affectation.
     value_type operator() (int i, int j) const;
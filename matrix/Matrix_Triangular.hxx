@@ -72,6 +72,7 @@ namespace Seldon
     void Resize(int i, int j);
     void SetData(int i, int j, pointer data);
     void Nullify();
+    void Swap(Matrix_Triangular<T, Prop, Storage, Allocator>& A);
 
     // Element access and affectation.
     value_type operator() (int i, int j) const;
@@ -0,0 +1,768 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_TINY_MATRIX_CXX
+
+#include "TinyMatrix.hxx"
+
+
+namespace Seldon
+{
+
+
+  /***************
+   * CONSTRUCTOR *
+   ***************/
+
+
+  //! Default constructor.
+  /*!
+    All entries are set to zero.
+  */
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n>::TinyMatrix()
+  {
+    TinyLoop<m * n>::Fill(data_, T(0));
+  }
+
+
+  /*****************
+   * BASIC METHODS *
+   *****************/
+
+
+  //! Returns the number of rows.
+  template <class T, int m, int n>
+  inline int TinyMatrix<T, m, n>::GetM() const
+  {
+    return m;
+  }
+
+
+  //! Returns the number of columns.
+  template <class T, int m, int n>
+  inline int TinyMatrix<T, m, n>::GetN() const
+  {
+    return n;
+  }
+
+
+  //! Returns the number of elements stored.
+  template <class T, int m, int n>
+  inline int TinyMatrix<T, m, n>::GetSize() const
+  {
+    return m * n;
+  }
+
+
+  //! Returns a pointer to the array of entries (row-major order).
+  template <class T, int m, int n>
+  inline typename TinyMatrix<T, m, n>::pointer TinyMatrix<T, m, n>::GetData()
+  {
+    return data_;
+  }
+
+
+  //! Returns a pointer to the array of entries (row-major order).
+  template <class T, int m, int n>
+  inline typename TinyMatrix<T, m, n>::const_pointer
+  TinyMatrix<T, m, n>::GetData() const
+  {
+    return data_;
+  }
+
+
+  /**********************************
+   * ELEMENT ACCESS AND AFFECTATION *
+   **********************************/
+
+
+  //! Access operator.
+  /*!
+    \param i row index.
+    \param j column index.
+    \return Element (i, j) of the matrix.
+  */
+  template <class T, int m, int n>
+  inline typename TinyMatrix<T, m, n>::reference
+  TinyMatrix<T, m, n>::operator() (int i, int j)
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= m)
+      throw WrongRow("TinyMatrix::operator()",
+		     string("Index should be in [0, ") + to_str(m - 1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= n)
+      throw WrongCol("TinyMatrix::operator()",
+		     string("Index should be in [0, ") + to_str(n - 1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    return data_[i * n + j];
+  }
+
+
+  //! Access operator.
+  /*!
+    \param i row index.
+    \param j column index.
+    \return Element (i, j) of the matrix.
+  */
+  template <class T, int m, int n>
+  inline typename TinyMatrix<T, m, n>::const_reference
+  TinyMatrix<T, m, n>::operator() (int i, int j) const
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= m)
+      throw WrongRow("TinyMatrix::operator() const",
+		     string("Index should be in [0, ") + to_str(m - 1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= n)
+      throw WrongCol("TinyMatrix::operator() const",
+		     string("Index should be in [0, ") + to_str(n - 1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    return data_[i * n + j];
+  }
+
+
+  //! Adds a matrix to the current matrix.
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n>&
+  TinyMatrix<T, m, n>::operator+= (const TinyMatrix<T, m, n>& A)
+  {
+    TinyLoop<m * n>::Add(T(1), A.GetData(), data_);
+    return *this;
+  }
+
+
+  //! Subtracts a matrix from the current matrix.
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n>&
+  TinyMatrix<T, m, n>::operator-= (const TinyMatrix<T, m, n>& A)
+  {
+    TinyLoop<m * n>::Add(T(-1), A.GetData(), data_);
+    return *this;
+  }
+
+
+  //! Multiplies the current matrix by a scalar.
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n>&
+  TinyMatrix<T, m, n>::operator*= (const T& alpha)
+  {
+    TinyLoop<m * n>::Mlt(alpha, data_);
+    return *this;
+  }
+
+
+  /************************
+   * CONVENIENT FUNCTIONS *
+   ************************/
+
+
+  //! Sets all elements to zero.
+  template <class T, int m, int n>
+  inline void TinyMatrix<T, m, n>::Zero()
+  {
+    TinyLoop<m * n>::Fill(data_, T(0));
+  }
+
+
+  //! Sets the matrix to the identity.
+  template <class T, int m, int n>
+  inline void TinyMatrix<T, m, n>::SetIdentity()
+  {
+    TinyLoop<m * n>::Fill(data_, T(0));
+    for (int i = 0; i < min(m, n); i++)
+      data_[i * n + i] = T(1);
+  }
+
+
+  //! Fills the matrix with 0, 1, 2, ...
+  /*!
+    The matrix is filled row by row.
+  */
+  template <class T, int m, int n>
+  inline void TinyMatrix<T, m, n>::Fill()
+  {
+    for (int i = 0; i < m * n; i++)
+      data_[i] = i;
+  }
+
+
+  //! Fills the matrix with a given value.
+  /*!
+    \param x value to fill the matrix with.
+  */
+  template <class T, int m, int n> template <class T0>
+  inline void TinyMatrix<T, m, n>::Fill(const T0& x)
+  {
+    TinyLoop<m * n>::Fill(data_, T(x));
+  }
+
+
+  //! Fills the matrix randomly.
+  template <class T, int m, int n>
+  inline void TinyMatrix<T, m, n>::FillRand()
+  {
+    for (int i = 0; i < m * n; i++)
+      data_[i] = rand();
+  }
+
+
+  //! Displays the matrix on the standard output.
+  /*!
+    Displays elements on the standard output, in text format.
+    Each row is displayed on a single line and elements of
+    a row are delimited by tabulations.
+  */
+  template <class T, int m, int n>
+  void TinyMatrix<T, m, n>::Print() const
+  {
+    for (int i = 0; i < m; i++)
+      {
+	for (int j = 0; j < n; j++)
+	  cout << data_[i * n + j] << "\t";
+	cout << endl;
+      }
+  }
+
+
+  /*************
+   * FUNCTIONS *
+   *************/
+
+
+  //! Returns the sum of two matrices.
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n> operator+ (const TinyMatrix<T, m, n>& A,
+                                        const TinyMatrix<T, m, n>& B)
+  {
+    TinyMatrix<T, m, n> C(A);
+    C += B;
+    return C;
+  }
+
+
+  //! Returns the difference of two matrices.
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n> operator- (const TinyMatrix<T, m, n>& A,
+                                        const TinyMatrix<T, m, n>& B)
+  {
+    TinyMatrix<T, m, n> C(A);
+    C -= B;
+    return C;
+  }
+
+
+  //! Returns the product of a matrix by a scalar.
+  template <class T, int m, int n>
+  inline TinyMatrix<T, m, n> operator* (const T& alpha,
+                                        const TinyMatrix<T, m, n>& A)
+  {
+    TinyMatrix<T, m, n> C(A);
+    C *= alpha;
+    return C;
+  }
+
+
+  //! Returns the product of a matrix with a vector.
+  template <class T, int m, int n>
+  inline TinyVector<T, m> operator* (const TinyMatrix<T, m, n>& A,
+                                     const TinyVector<T, n>& X)
+  {
+    TinyVector<T, m> Y;
+    Mlt(A, X, Y);
+    return Y;
+  }
+
+
+  //! Returns the product of two matrices.
+  template <class T, int m, int n, int k>
+  inline TinyMatrix<T, m, n> operator* (const TinyMatrix<T, m, k>& A,
+                                        const TinyMatrix<T, k, n>& B)
+  {
+    TinyMatrix<T, m, n> C;
+    Mlt(A, B, C);
+    return C;
+  }
+
+
+  //! Multiplies a matrix by a scalar.
+  /*!
+    \param[in] alpha scalar.
+    \param[in,out] A matrix to be multiplied.
+  */
+  template <class T0, class T1, int m, int n>
+  inline void Mlt(const T0 alpha, TinyMatrix<T1, m, n>& A)
+  {
+    TinyLoop<m * n>::Mlt(alpha, A.GetData());
+  }
+
+
+  //! Performs the multiplication of a matrix with a vector.
+  /*!
+    It performs \f$ Y = A X \f$.
+    \param[in] A matrix.
+    \param[in] X vector.
+    \param[out] Y result.
+  */
+  template <class T0, class T1, class T2, int m, int n>
+  inline void Mlt(const TinyMatrix<T0, m, n>& A, const TinyVector<T1, n>& X,
+                  TinyVector<T2, m>& Y)
+  {
+    TinyLoop<m>::template MltVect<n>(A.GetData(), X.GetData(), Y.GetData());
+  }
+
+
+  //! Performs the multiplication of a transposed matrix with a vector.
+  /*!
+    It performs \f$ Y = A^T X \f$.
+    \param[in] A matrix.
+    \param[in] X vector.
+    \param[out] Y result.
+  */
+  template <class T0, class T1, class T2, int m, int n>
+  inline void Mlt(const class_SeldonTrans&, const TinyMatrix<T0, m, n>& A,
+                  const TinyVector<T1, m>& X, TinyVector<T2, n>& Y)
+  {
+    TinyLoop<n>::template MltTransVect<m, n>(A.GetData(), X.GetData(),
+                                             Y.GetData());
+  }
+
+
+  //! Performs the multiplication of two matrices.
+  /*!
+    It performs \f$ C = A B \f$.
+    \param[in] A matrix.
+    \param[in] B matrix.
+    \param[out] C result.
+  */
+  template <class T0, class T1, class T2, int m, int n, int k>
+  inline void Mlt(const TinyMatrix<T0, m, k>& A,
+                  const TinyMatrix<T1, k, n>& B, TinyMatrix<T2, m, n>& C)
+  {
+    TinyLoop<m * n>::template MltMatrix<n, k>(A.GetData(), B.GetData(),
+                                              C.GetData());
+  }
+
+
+  //! Adds two matrices.
+  /*!
+    It performs \f$ B = \alpha A + B \f$.
+    \param[in] alpha scalar.
+    \param[in] A matrix.
+    \param[in,out] B matrix.
+  */
+  template <class T0, class T1, class T2, int m, int n>
+  inline void Add(const T0 alpha, const TinyMatrix<T1, m, n>& A,
+                  TinyMatrix<T2, m, n>& B)
+  {
+    TinyLoop<m * n>::Add(alpha, A.GetData(), B.GetData());
+  }
+
+
+  //! Computes the transpose of a matrix.
+  /*!
+    \param[in] A matrix.
+    \param[out] B transpose of \a A.
+  */
+  template <class T, int m, int n>
+  inline void Transpose(const TinyMatrix<T, m, n>& A, TinyMatrix<T, n, m>& B)
+  {
+    for (int i = 0; i < m; i++)
+      for (int j = 0; j < n; j++)
+        B(j, i) = A(i, j);
+  }
+
+
+  //! Returns the determinant of a square matrix.
+  /*!
+    The determinant is computed by Gaussian elimination with partial
+    pivoting, on a copy of \a A.
+    \param[in] A matrix.
+    \return The determinant of \a A.
+  */
+  template <class T, int m>
+  T Det(const TinyMatrix<T, m, m>& A)
+  {
+    T a[m * m];
+    TinyLoop<m * m>::Copy(A.GetData(), a);
+
+    T det(1);
+    for (int k = 0; k < m; k++)
+      {
+        // Searches for the pivot.
+        int p = k;
+        for (int i = k + 1; i < m; i++)
+          if (abs(a[i * m + k]) > abs(a[p * m + k]))
+            p = i;
+
+        if (a[p * m + k] == T(0))
+          return T(0);
+
+        if (p != k)
+          {
+            for (int j = k; j < m; j++)
+              {
+                T tmp = a[k * m + j];
+                a[k * m + j] = a[p * m + j];
+                a[p * m + j] = tmp;
+              }
+            det = -det;
+          }
+
+        det *= a[k * m + k];
+        T inv_pivot = T(1) / a[k * m + k];
+        for (int i = k + 1; i < m; i++)
+          {
+            T coef = a[i * m + k] * inv_pivot;
+            for (int j = k + 1; j < m; j++)
+              a[i * m + j] -= coef * a[k * m + j];
+          }
+      }
+
+    return det;
+  }
+
+
+  //! Returns the determinant of a 1 x 1 matrix.
+  template <class T>
+  inline T Det(const TinyMatrix<T, 1, 1>& A)
+  {
+    return A(0, 0);
+  }
+
+
+  //! Returns the determinant of a 2 x 2 matrix.
+  template <class T>
+  inline T Det(const TinyMatrix<T, 2, 2>& A)
+  {
+    return A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+  }
+
+
+  //! Returns the determinant of a 3 x 3 matrix.
+  template <class T>
+  inline T Det(const TinyMatrix<T, 3, 3>& A)
+  {
+    return A(0, 0) * (A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1))
+      - A(0, 1) * (A(1, 0) * A(2, 2) - A(1, 2) * A(2, 0))
+      + A(0, 2) * (A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0));
+  }
+
+
+  //! Replaces a square matrix by its inverse.
+  /*!
+    The inverse is computed in place by Gauss-Jordan elimination with
+    partial pivoting.
+    \param[in,out] A on entry, the matrix to be inverted; on exit, its
+    inverse.
+  */
+  template <class T, int m>
+  void GetInverse(TinyMatrix<T, m, m>& A)
+  {
+    T* a = A.GetData();
+    int perm[m];
+
+    for (int k = 0; k < m; k++)
+      {
+        // Searches for the pivot.
+        int p = k;
+        for (int i = k + 1; i < m; i++)
+          if (abs(a[i * m + k]) > abs(a[p * m + k]))
+            p = i;
+
+        if (a[p * m + k] == T(0))
+          throw WrongArgument("GetInverse(TinyMatrix)",
+                              "The matrix is singular.");
+
+        perm[k] = p;
+        if (p != k)
+          for (int j = 0; j < m; j++)
+            {
+              T tmp = a[k * m + j];
+              a[k * m + j] = a[p * m + j];
+              a[p * m + j] = tmp;
+            }
+
+        T inv_pivot = T(1) / a[k * m + k];
+        a[k * m + k] = T(1);
+        for (int j = 0; j < m; j++)
+          a[k * m + j] *= inv_pivot;
+
+        for (int i = 0; i < m; i++)
+          if (i != k)
+            {
+              T coef = a[i * m + k];
+              a[i * m + k] = T(0);
+              for (int j = 0; j < m; j++)
+                a[i * m + j] -= coef * a[k * m + j];
+            }
+      }
+
+    // The row interchanges are undone on the columns of the inverse.
+    for (int k = m - 1; k >= 0; k--)
+      if (perm[k] != k)
+        for (int i = 0; i < m; i++)
+          {
+            T tmp = a[i * m + k];
+            a[i * m + k] = a[i * m + perm[k]];
+            a[i * m + perm[k]] = tmp;
+          }
+  }
+
+
+  //! Replaces a 1 x 1 matrix by its inverse.
+  template <class T>
+  inline void GetInverse(TinyMatrix<T, 1, 1>& A)
+  {
+    if (A(0, 0) == T(0))
+      throw WrongArgument("GetInverse(TinyMatrix)",
+                          "The matrix is singular.");
+
+    A(0, 0) = T(1) / A(0, 0);
+  }
+
+
+  //! Replaces a 2 x 2 matrix by its inverse.
+  template <class T>
+  inline void GetInverse(TinyMatrix<T, 2, 2>& A)
+  {
+    T det = Det(A);
+    if (det == T(0))
+      throw WrongArgument("GetInverse(TinyMatrix)",
+                          "The matrix is singular.");
+
+    T inv_det = T(1) / det;
+    T a00 = A(0, 0);
+    A(0, 0) = A(1, 1) * inv_det;
+    A(1, 1) = a00 * inv_det;
+    A(0, 1) = -A(0, 1) * inv_det;
+    A(1, 0) = -A(1, 0) * inv_det;
+  }
+
+
+  //! Replaces a 3 x 3 matrix by its inverse.
+  /*!
+    The inverse is the transposed matrix of cofactors divided by the
+    determinant.
+  */
+  template <class T>
+  inline void GetInverse(TinyMatrix<T, 3, 3>& A)
+  {
+    TinyMatrix<T, 3, 3> B;
+    B(0, 0) = A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1);
+    B(1, 0) = A(1, 2) * A(2, 0) - A(1, 0) * A(2, 2);
+    B(2, 0) = A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0);
+    T det = A(0, 0) * B(0, 0) + A(0, 1) * B(1, 0) + A(0, 2) * B(2, 0);
+    if (det == T(0))
+      throw WrongArgument("GetInverse(TinyMatrix)",
+                          "The matrix is singular.");
+
+    B(0, 1) = A(0, 2) * A(2, 1) - A(0, 1) * A(2, 2);
+    B(1, 1) = A(0, 0) * A(2, 2) - A(0, 2) * A(2, 0);
+    B(2, 1) = A(0, 1) * A(2, 0) - A(0, 0) * A(2, 1);
+    B(0, 2) = A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1);
+    B(1, 2) = A(0, 2) * A(1, 0) - A(0, 0) * A(1, 2);
+    B(2, 2) = A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+
+    TinyLoop<9>::Copy(B.GetData(), A.GetData());
+    Mlt(T(1) / det, A);
+  }
+
+
+  //! Copies a tiny matrix into a row-major matrix.
+  /*!
+    \param[in] A matrix to be copied.
+    \param[out] B matrix with \a m rows and \a n columns, copy of \a A.
+  */
+  template <class T0, int m, int n, class T1, class Allocator1>
+  inline void Copy(const TinyMatrix<T0, m, n>& A,
+                   Matrix<T1, General, RowMajor, Allocator1>& B)
+  {
+    B.Reallocate(m, n);
+    TinyLoop<m * n>::Copy(A.GetData(), B.GetData());
+  }
+
+
+  //! Copies a row-major matrix into a tiny matrix.
+  /*!
+    \param[in] A matrix with \a m rows and \a n columns.
+    \param[out] B copy of \a A.
+  */
+  template <class T0, class Allocator0, class T1, int m, int n>
+  inline void Copy(const Matrix<T0, General, RowMajor, Allocator0>& A,
+                   TinyMatrix<T1, m, n>& B)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetM() != m || A.GetN() != n)
+      throw WrongDim("Copy(A, B)", string("The matrix A should be ")
+                     + to_str(m) + " x " + to_str(n) + ", but it is "
+                     + to_str(A.GetM()) + " x " + to_str(A.GetN()) + ".");
+#endif
+
+    TinyLoop<m * n>::Copy(A.GetData(), B.GetData());
+  }
+
+
+  //! Copies a tiny matrix into a column-major matrix.
+  /*!
+    \param[in] A matrix to be copied.
+    \param[out] B matrix with \a m rows and \a n columns, copy of \a A.
+  */
+  template <class T0, int m, int n, class T1, class Allocator1>
+  inline void Copy(const TinyMatrix<T0, m, n>& A,
+                   Matrix<T1, General, ColMajor, Allocator1>& B)
+  {
+    B.Reallocate(m, n);
+    for (int i = 0; i < m; i++)
+      for (int j = 0; j < n; j++)
+        B(i, j) = A(i, j);
+  }
+
+
+  //! Copies a column-major matrix into a tiny matrix.
+  /*!
+    \param[in] A matrix with \a m rows and \a n columns.
+    \param[out] B copy of \a A.
+  */
+  template <class T0, class Allocator0, class T1, int m, int n>
+  inline void Copy(const Matrix<T0, General, ColMajor, Allocator0>& A,
+                   TinyMatrix<T1, m, n>& B)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (A.GetM() != m || A.GetN() != n)
+      throw WrongDim("Copy(A, B)", string("The matrix A should be ")
+                     + to_str(m) + " x " + to_str(n) + ", but it is "
+                     + to_str(A.GetM()) + " x " + to_str(A.GetN()) + ".");
+#endif
+
+    for (int i = 0; i < m; i++)
+      for (int j = 0; j < n; j++)
+        B(i, j) = A(i, j);
+  }
+
+
+  //! Adds a local matrix to a global sparse matrix.
+  /*!
+    It performs \f$ B_{row(i), col(j)} = B_{row(i), col(j)} + A_{i, j} \f$
+    for every \a i and \a j, e.g. to assemble an elementary matrix in a
+    finite element code. The interactions are added with
+    B.AddInteraction(row(i), col(j), A(i, j)), so that \a B may be any
+    sparse matrix with this method (e.g. in assembly mode, or with an array
+    storage). The entries whose row or column index is negative are skipped.
+    \param[in] row global row indices of the rows of \a A.
+    \param[in] col global column indices of the columns of \a A.
+    \param[in] A local matrix.
+    \param[in,out] B global matrix.
+  */
+  template <int m, int n, class T0, class T1, class Prop1, class Storage1,
+            class Allocator1>
+  void AddInteraction(const TinyVector<int, m>& row,
+                      const TinyVector<int, n>& col,
+                      const TinyMatrix<T0, m, n>& A,
+                      Matrix<T1, Prop1, Storage1, Allocator1>& B)
+  {
+    for (int i = 0; i < m; i++)
+      if (row(i) >= 0)
+        for (int j = 0; j < n; j++)
+          if (col(j) >= 0)
+            B.AddInteraction(row(i), col(j), A(i, j));
+  }
+
+
+  //! Adds a local matrix to a global row-major matrix.
+  /*!
+    It performs \f$ B_{row(i), col(j)} = B_{row(i), col(j)} + A_{i, j} \f$
+    for every \a i and \a j. The entries whose row or column index is
+    negative are skipped.
+    \param[in] row global row indices of the rows of \a A.
+    \param[in] col global column indices of the columns of \a A.
+    \param[in] A local matrix.
+    \param[in,out] B global matrix.
+  */
+  template <int m, int n, class T0, class T1, class Allocator1>
+  void AddInteraction(const TinyVector<int, m>& row,
+                      const TinyVector<int, n>& col,
+                      const TinyMatrix<T0, m, n>& A,
+                      Matrix<T1, General, RowMajor, Allocator1>& B)
+  {
+    for (int i = 0; i < m; i++)
+      if (row(i) >= 0)
+        for (int j = 0; j < n; j++)
+          if (col(j) >= 0)
+            B(row(i), col(j)) += A(i, j);
+  }
+
+
+  //! Adds a local matrix to a global column-major matrix.
+  /*!
+    It performs \f$ B_{row(i), col(j)} = B_{row(i), col(j)} + A_{i, j} \f$
+    for every \a i and \a j. The entries whose row or column index is
+    negative are skipped.
+    \param[in] row global row indices of the rows of \a A.
+    \param[in] col global column indices of the columns of \a A.
+    \param[in] A local matrix.
+    \param[in,out] B global matrix.
+  */
+  template <int m, int n, class T0, class T1, class Allocator1>
+  void AddInteraction(const TinyVector<int, m>& row,
+                      const TinyVector<int, n>& col,
+                      const TinyMatrix<T0, m, n>& A,
+                      Matrix<T1, General, ColMajor, Allocator1>& B)
+  {
+    for (int j = 0; j < n; j++)
+      if (col(j) >= 0)
+        for (int i = 0; i < m; i++)
+          if (row(i) >= 0)
+            B(row(i), col(j)) += A(i, j);
+  }
+
+
+  //! Writes a tiny matrix in an output stream.
+  /*!
+    Each row is written on a single line and the elements of a row are
+    separated by tabulations.
+    \param out output stream.
+    \param A matrix to be written.
+    \return The updated stream.
+  */
+  template <class T, int m, int n>
+  ostream& operator << (ostream& out, const TinyMatrix<T, m, n>& A)
+  {
+    for (int i = 0; i < m; i++)
+      {
+	for (int j = 0; j < n; j++)
+	  out << A(i, j) << '\t';
+	out << endl;
+      }
+
+    return out;
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_TINY_MATRIX_CXX
+#endif
@@ -0,0 +1,169 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_TINY_MATRIX_HXX
+
+namespace Seldon
+{
+
+
+  //! Dense matrix of fixed size, allocated on the stack.
+  /*!
+    The dimensions \a m and \a n are known at compile time, so that the
+    entries are stored in an array member (row-major order) and the
+    operations are unrolled by TinyLoop. This class is meant for many small
+    matrices, e.g. the elementary matrices in a finite element code, which
+    are then added to a global matrix with AddInteraction. The entries are
+    set to zero by the default constructor.
+  */
+  template <class T, int m, int n>
+  class TinyMatrix
+  {
+    // typedef declaration.
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    // Attributes.
+  protected:
+    T data_[m * n];
+
+    // Methods.
+  public:
+    // Constructor.
+    TinyMatrix();
+
+    // Basic methods.
+    int GetM() const;
+    int GetN() const;
+    int GetSize() const;
+    pointer GetData();
+    const_pointer GetData() const;
+
+    // Element access and affectation.
+    reference operator() (int i, int j);
+    const_reference operator() (int i, int j) const;
+    TinyMatrix<T, m, n>& operator+= (const TinyMatrix<T, m, n>& A);
+    TinyMatrix<T, m, n>& operator-= (const TinyMatrix<T, m, n>& A);
+    TinyMatrix<T, m, n>& operator*= (const T& alpha);
+
+    // Convenient functions.
+    void Zero();
+    void SetIdentity();
+    void Fill();
+    template <class T0>
+    void Fill(const T0& x);
+    void FillRand();
+    void Print() const;
+  };
+
+
+  template <class T, int m, int n>
+  TinyMatrix<T, m, n> operator+ (const TinyMatrix<T, m, n>& A,
+                                 const TinyMatrix<T, m, n>& B);
+  template <class T, int m, int n>
+  TinyMatrix<T, m, n> operator- (const TinyMatrix<T, m, n>& A,
+                                 const TinyMatrix<T, m, n>& B);
+  template <class T, int m, int n>
+  TinyMatrix<T, m, n> operator* (const T& alpha,
+                                 const TinyMatrix<T, m, n>& A);
+  template <class T, int m, int n>
+  TinyVector<T, m> operator* (const TinyMatrix<T, m, n>& A,
+                              const TinyVector<T, n>& X);
+  template <class T, int m, int n, int k>
+  TinyMatrix<T, m, n> operator* (const TinyMatrix<T, m, k>& A,
+                                 const TinyMatrix<T, k, n>& B);
+
+  template <class T0, class T1, int m, int n>
+  void Mlt(const T0 alpha, TinyMatrix<T1, m, n>& A);
+  template <class T0, class T1, class T2, int m, int n>
+  void Mlt(const TinyMatrix<T0, m, n>& A, const TinyVector<T1, n>& X,
+           TinyVector<T2, m>& Y);
+  template <class T0, class T1, class T2, int m, int n>
+  void Mlt(const class_SeldonTrans&, const TinyMatrix<T0, m, n>& A,
+           const TinyVector<T1, m>& X, TinyVector<T2, n>& Y);
+  template <class T0, class T1, class T2, int m, int n, int k>
+  void Mlt(const TinyMatrix<T0, m, k>& A, const TinyMatrix<T1, k, n>& B,
+           TinyMatrix<T2, m, n>& C);
+  template <class T0, class T1, class T2, int m, int n>
+  void Add(const T0 alpha, const TinyMatrix<T1, m, n>& A,
+           TinyMatrix<T2, m, n>& B);
+  template <class T, int m, int n>
+  void Transpose(const TinyMatrix<T, m, n>& A, TinyMatrix<T, n, m>& B);
+
+  template <class T, int m>
+  T Det(const TinyMatrix<T, m, m>& A);
+  template <class T>
+  T Det(const TinyMatrix<T, 1, 1>& A);
+  template <class T>
+  T Det(const TinyMatrix<T, 2, 2>& A);
+  template <class T>
+  T Det(const TinyMatrix<T, 3, 3>& A);
+  template <class T, int m>
+  void GetInverse(TinyMatrix<T, m, m>& A);
+  template <class T>
+  void GetInverse(TinyMatrix<T, 1, 1>& A);
+  template <class T>
+  void GetInverse(TinyMatrix<T, 2, 2>& A);
+  template <class T>
+  void GetInverse(TinyMatrix<T, 3, 3>& A);
+
+  template <class T0, int m, int n, class T1, class Allocator1>
+  void Copy(const TinyMatrix<T0, m, n>& A,
+            Matrix<T1, General, RowMajor, Allocator1>& B);
+  template <class T0, class Allocator0, class T1, int m, int n>
+  void Copy(const Matrix<T0, General, RowMajor, Allocator0>& A,
+            TinyMatrix<T1, m, n>& B);
+  template <class T0, int m, int n, class T1, class Allocator1>
+  void Copy(const TinyMatrix<T0, m, n>& A,
+            Matrix<T1, General, ColMajor, Allocator1>& B);
+  template <class T0, class Allocator0, class T1, int m, int n>
+  void Copy(const Matrix<T0, General, ColMajor, Allocator0>& A,
+            TinyMatrix<T1, m, n>& B);
+
+  template <int m, int n, class T0, class T1, class Prop1, class Storage1,
+            class Allocator1>
+  void AddInteraction(const TinyVector<int, m>& row,
+                      const TinyVector<int, n>& col,
+                      const TinyMatrix<T0, m, n>& A,
+                      Matrix<T1, Prop1, Storage1, Allocator1>& B);
+  template <int m, int n, class T0, class T1, class Allocator1>
+  void AddInteraction(const TinyVector<int, m>& row,
+                      const TinyVector<int, n>& col,
+                      const TinyMatrix<T0, m, n>& A,
+                      Matrix<T1, General, RowMajor, Allocator1>& B);
+  template <int m, int n, class T0, class T1, class Allocator1>
+  void AddInteraction(const TinyVector<int, m>& row,
+                      const TinyVector<int, n>& col,
+                      const TinyMatrix<T0, m, n>& A,
+                      Matrix<T1, General, ColMajor, Allocator1>& B);
+
+  template <class T, int m, int n>
+  ostream& operator << (ostream& out, const TinyMatrix<T, m, n>& A);
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_TINY_MATRIX_HXX
+#endif
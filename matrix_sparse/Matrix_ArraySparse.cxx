@@ -53,6 +53,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The rows (or columns) of \a A are taken over, without any copy.
+    \param A matrix to be moved. On exit, it is empty.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_ArraySparse<T, Prop, Storage, Allocator>::
+  Matrix_ArraySparse(Matrix_ArraySparse<T, Prop, Storage, Allocator>&& A)
+    noexcept :
+    val_()
+  {
+    this->m_ = 0;
+    this->n_ = 0;
+    Swap(A);
+  }
+#endif
+
+
   //! Destructor.
   template <class T, class Prop, class Storage, class Allocat>
   inline Matrix_ArraySparse<T, Prop, Storage, Allocat>::~Matrix_ArraySparse()
@@ -120,7 +138,7 @@ namespace Seldon
 	new_val.Reallocate(new_n);
 
 	for (int k = 0 ; k < min(n, new_n) ; k++)
-	  Swap(new_val(k), this->val_(k));
+	  Seldon::Swap(new_val(k), this->val_(k));
 
 	val_.SetData(new_n, new_val.GetData());
 	new_val.Nullify();
@@ -587,6 +605,40 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the array of rows (or
+    columns) are exchanged.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_ArraySparse<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_ArraySparse<T, Prop, Storage, Allocator>& A)
+  {
+    swap(m_, A.m_);
+    swap(n_, A.n_);
+    val_.Swap(A.val_);
+  }
+
+
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a matrix (move assignment operator).
+  /*!
+    \param A matrix to be moved. No element is copied: the arrays of rows
+    (or columns) of \a A and of the current instance are exchanged.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_ArraySparse<T, Prop, Storage, Allocator>&
+  Matrix_ArraySparse<T, Prop, Storage, Allocator>
+  ::operator= (Matrix_ArraySparse<T, Prop, Storage, Allocator>&& A) noexcept
+  {
+    Swap(A);
+
+    return *this;
+  }
+#endif
+
+
   /************************
    * CONVENIENT FUNCTIONS *
    ************************/
@@ -1023,7 +1075,7 @@ namespace Seldon
   template <class T, class Prop, class Allocator> inline
   void Matrix<T, Prop, ArrayColSparse, Allocator>::SwapColumn(int i,int j)
   {
-    Swap(this->val_(i), this->val_(j));
+    Seldon::Swap(this->val_(i), this->val_(j));
   }
 
 
@@ -1236,7 +1288,7 @@ namespace Seldon
   template <class T, class Prop, class Allocator>
   inline void Matrix<T, Prop, ArrayRowSparse, Allocator>::SwapRow(int i,int j)
   {
-    Swap(this->val_(i), this->val_(j));
+    Seldon::Swap(this->val_(i), this->val_(j));
   }
 
 
@@ -1618,7 +1670,7 @@ namespace Seldon
   inline void Matrix<T, Prop, ArrayColSymSparse, Allocator>::
   SwapColumn(int i, int j)
   {
-    Swap(this->val_(i), this->val_(j));
+    Seldon::Swap(this->val_(i), this->val_(j));
   }
 
 
@@ -2021,7 +2073,7 @@ namespace Seldon
   inline void Matrix<T, Prop, ArrayRowSymSparse, Allocator>::
   SwapRow(int i,int j)
   {
-    Swap(this->val_(i), this->val_(j));
+    Seldon::Swap(this->val_(i), this->val_(j));
   }
 
 
@@ -2216,6 +2268,15 @@ namespace Seldon
   }
 
 
+  //! Swaps two sparse matrices, without copying their elements.
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B,
+		  Matrix_ArraySparse<T, Prop, Storage, Allocator>*)
+  {
+    A.Swap(B);
+  }
+
+
 } // namespace Seldon
 
 #define SELDON_FILE_MATRIX_ARRAY_SPARSE_CXX
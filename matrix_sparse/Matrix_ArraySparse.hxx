@@ -62,6 +62,12 @@ namespace Seldon
     // Constructors.
     Matrix_ArraySparse();
     Matrix_ArraySparse(int i, int j);
+#ifdef SELDON_WITH_CXX11
+    Matrix_ArraySparse(const Matrix_ArraySparse<T, Prop, Storage,
+		       Allocator>& A) = default;
+    Matrix_ArraySparse(Matrix_ArraySparse<T, Prop, Storage, Allocator>&& A)
+      noexcept;
+#endif
 
     // Destructor.
     ~Matrix_ArraySparse();
@@ -100,6 +106,7 @@ namespace Seldon
     void SetData(int, int, T*, int*);
     void Nullify(int i);
     void Nullify();
+    void Swap(Matrix_ArraySparse<T, Prop, Storage, Allocator>& A);
 
     // Convenient functions.
     void Print() const;
@@ -114,6 +121,13 @@ namespace Seldon
     void Fill(const T0& x);
     template <class T0>
     Matrix_ArraySparse<T, Prop, Storage, Allocator>& operator= (const T0& x);
+#ifdef SELDON_WITH_CXX11
+    Matrix_ArraySparse<T, Prop, Storage, Allocator>&
+    operator= (const Matrix_ArraySparse<T, Prop, Storage, Allocator>& A)
+      = default;
+    Matrix_ArraySparse<T, Prop, Storage, Allocator>&
+    operator= (Matrix_ArraySparse<T, Prop, Storage, Allocator>&& A) noexcept;
+#endif
     void FillRand();
 
     // Input/output functions.
@@ -305,6 +319,11 @@ namespace Seldon
 			      const Vector<T, VectFull, Alloc1>& val);
   };
 
+
+  template <class M, class T, class Prop, class Storage, class Allocator>
+  void SwapMatrix(M& A, M& B,
+		  Matrix_ArraySparse<T, Prop, Storage, Allocator>*);
+
 } // namespace Seldon
 
 #define SELDON_FILE_MATRIX_ARRAY_SPARSE_HXX
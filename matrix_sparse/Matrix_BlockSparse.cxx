@@ -0,0 +1,377 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_MATRIX_BLOCK_SPARSE_CXX
+
+#include "Matrix_BlockSparse.hxx"
+
+
+namespace Seldon
+{
+
+
+  /****************
+   * CONSTRUCTORS *
+   ****************/
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::Matrix_BlockSparse():
+    Matrix_Base<T, Allocator>()
+  {
+  }
+
+
+  //! Constructor.
+  /*!
+    Builds a i by j sparse matrix without non-zero blocks.
+    \param i number of rows (a multiple of the block size).
+    \param j number of columns (a multiple of the block size).
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::Matrix_BlockSparse(int i, int j):
+    Matrix_Base<T, Allocator>()
+  {
+    Reallocate(i, j);
+  }
+
+
+  //! Copy constructor.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_BlockSparse<T, Prop, Storage, Allocator>::
+  Matrix_BlockSparse(const Matrix_BlockSparse<T, Prop, Storage,
+		     Allocator>& A):
+    Matrix_Base<T, Allocator>()
+  {
+    Copy(A);
+  }
+
+
+  /**************
+   * DESTRUCTOR *
+   **************/
+
+
+  //! Destructor.
+  /*! The arrays are released by their own destructors. */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::~Matrix_BlockSparse()
+  {
+    this->m_ = 0;
+    this->n_ = 0;
+    this->data_ = NULL;
+  }
+
+
+  //! Clears the matrix.
+  /*! On exit, the matrix is empty (0x0). */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_BlockSparse<T, Prop, Storage, Allocator>::Clear()
+  {
+    this->m_ = 0;
+    this->n_ = 0;
+    this->data_ = NULL;
+    ptr_.Clear();
+    ind_.Clear();
+    val_.Clear();
+  }
+
+
+  /*********************
+   * MEMORY MANAGEMENT *
+   *********************/
+
+
+  //! Redefines the matrix.
+  /*! It clears the matrix and sets it to a new matrix defined by 'values'
+    (values of the blocks, each block being stored by rows), 'ptr' (start
+    indices of the rows of blocks) and 'ind' (column indices of the blocks,
+    counted in blocks). Input vectors are released and are empty on exit.
+    \param i number of rows (a multiple of the block size).
+    \param j number of columns (a multiple of the block size).
+    \param values values of the blocks.
+    \param ptr start indices of the rows of blocks.
+    \param ind column indices of the blocks.
+    \warning Input vectors 'values', 'ptr' and 'ind' are empty on exit.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_BlockSparse<T, Prop, Storage, Allocator>::
+  SetData(int i, int j, Vector<T, VectFull, Allocator>& values,
+	  Vector<int>& ptr, Vector<int>& ind)
+  {
+    const int B = Storage::block_size;
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (i % B != 0 || j % B != 0)
+      throw WrongDim(string("Matrix_BlockSparse::SetData(int, int, ")
+		     + "Vector&, Vector&, Vector&)",
+		     string("The dimensions of the matrix (") + to_str(i)
+		     + " by " + to_str(j) + ") should be multiples of "
+		     + "the block size (" + to_str(B) + ").");
+
+    if (ptr.GetM() != i / B + 1)
+      throw WrongDim(string("Matrix_BlockSparse::SetData(int, int, ")
+		     + "Vector&, Vector&, Vector&)",
+		     string("The vector of start indices contains ")
+		     + to_str(ptr.GetM()) + " indices, but there are "
+		     + to_str(i / B) + " rows of blocks (plus the number "
+		     + "of blocks).");
+
+    if (ind.GetM() != ptr(i / B) || values.GetM() != B * B * ind.GetM())
+      throw WrongDim(string("Matrix_BlockSparse::SetData(int, int, ")
+		     + "Vector&, Vector&, Vector&)",
+		     string("There are ") + to_str(ind.GetM())
+		     + " column indices and " + to_str(values.GetM())
+		     + " values, but there are " + to_str(ptr(i / B))
+		     + " blocks of size " + to_str(B) + ".");
+#endif
+
+    Clear();
+    this->m_ = i;
+    this->n_ = j;
+
+    val_.SetData(values.GetM(), values.GetData());
+    values.Nullify();
+    ptr_.SetData(ptr.GetM(), ptr.GetData());
+    ptr.Nullify();
+    ind_.SetData(ind.GetM(), ind.GetData());
+    ind.Nullify();
+
+    this->data_ = val_.GetData();
+  }
+
+
+  //! Reallocates memory to resize the matrix.
+  /*!
+    On exit, the matrix is a i x j matrix without non-zero blocks.
+    \param i new number of rows (a multiple of the block size).
+    \param j new number of columns (a multiple of the block size).
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_BlockSparse<T, Prop, Storage, Allocator>::
+  Reallocate(int i, int j)
+  {
+    Vector<T, VectFull, Allocator> values;
+    Vector<int> ptr(i / Storage::block_size + 1), ind;
+    ptr.Zero();
+
+    SetData(i, j, values, ptr, ind);
+  }
+
+
+  //! Copies a matrix.
+  /*!
+    \param[in] A matrix to be copied.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_BlockSparse<T, Prop, Storage, Allocator>::
+  Copy(const Matrix_BlockSparse<T, Prop, Storage, Allocator>& A)
+  {
+    this->m_ = A.m_;
+    this->n_ = A.n_;
+    ptr_ = A.ptr_;
+    ind_ = A.ind_;
+    val_ = A.val_;
+    this->data_ = val_.GetData();
+  }
+
+
+  /*******************
+   * BASIC FUNCTIONS *
+   *******************/
+
+
+  //! Returns the size of the blocks.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_BlockSparse<T, Prop, Storage, Allocator>::GetBlockSize()
+  {
+    return Storage::block_size;
+  }
+
+
+  //! Returns the number of non-zero entries.
+  /*!
+    \return The number of entries of the non-zero blocks.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::GetNonZeros() const
+  {
+    return val_.GetM();
+  }
+
+
+  //! Returns the number of elements stored in memory.
+  /*!
+    \return The number of entries of the non-zero blocks.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::GetDataSize() const
+  {
+    return val_.GetM();
+  }
+
+
+  //! Returns the number of non-zero blocks.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::GetNbBlocks() const
+  {
+    return ind_.GetM();
+  }
+
+
+  //! Returns (a pointer to) the start indices of the rows of blocks.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int* Matrix_BlockSparse<T, Prop, Storage, Allocator>::GetPtr() const
+  {
+    return ptr_.GetData();
+  }
+
+
+  //! Returns (a pointer to) the column indices (in blocks) of the blocks.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int* Matrix_BlockSparse<T, Prop, Storage, Allocator>::GetInd() const
+  {
+    return ind_.GetData();
+  }
+
+
+  /**********************************
+   * ELEMENT ACCESS AND AFFECTATION *
+   **********************************/
+
+
+  //! Access operator.
+  /*!
+    Returns the value of element (i, j).
+    \param i row index.
+    \param j column index.
+    \return Element (i, j) of the matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline typename Matrix_BlockSparse<T, Prop, Storage, Allocator>::value_type
+  Matrix_BlockSparse<T, Prop, Storage, Allocator>::operator() (int i,
+								int j) const
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= this->m_)
+      throw WrongRow("Matrix_BlockSparse::operator()",
+		     string("Index should be in [0, ") + to_str(this->m_-1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= this->n_)
+      throw WrongCol("Matrix_BlockSparse::operator()",
+		     string("Index should be in [0, ") + to_str(this->n_-1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    const int B = Storage::block_size;
+    int a = ptr_(i / B), b = ptr_(i / B + 1);
+
+    // Column indices of the blocks are sorted.
+    int k = lower_bound(ind_.GetData() + a, ind_.GetData() + b, j / B)
+      - ind_.GetData();
+    if (k < b && ind_(k) == j / B)
+      return val_(B * B * k + B * (i % B) + j % B);
+    else
+      return T(0);
+  }
+
+
+  //! Duplicates a matrix (assignment operator).
+  /*!
+    \param A matrix to be copied.
+    \note Memory is duplicated: 'A' is therefore independent from the current
+    instance after the copy.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_BlockSparse<T, Prop, Storage, Allocator>&
+  Matrix_BlockSparse<T, Prop, Storage, Allocator>
+  ::operator= (const Matrix_BlockSparse<T, Prop, Storage, Allocator>& A)
+  {
+    this->Copy(A);
+
+    return *this;
+  }
+
+
+  /************************
+   * CONVENIENT FUNCTIONS *
+   ************************/
+
+
+  //! Displays the matrix on the standard output.
+  /*!
+    Displays elements on the standard output, in text format.
+    Each row is displayed on a single line and elements of
+    a row are delimited by tabulations.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_BlockSparse<T, Prop, Storage, Allocator>::Print() const
+  {
+    for (int i = 0; i < this->m_; i++)
+      {
+	for (int j = 0; j < this->n_; j++)
+	  cout << (*this)(i, j) << "\t";
+	cout << endl;
+      }
+  }
+
+
+  ////////////////////////////
+  // MATRIX<ROWBLOCKSPARSE> //
+  ////////////////////////////
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix.
+  */
+  template <class T, class Prop, int B, class Allocator>
+  inline Matrix<T, Prop, RowBlockSparse<B>, Allocator>::Matrix():
+    Matrix_BlockSparse<T, Prop, RowBlockSparse<B>, Allocator>()
+  {
+  }
+
+
+  //! Constructor.
+  /*! Builds a i by j matrix without non-zero blocks.
+    \param i number of rows (a multiple of the block size).
+    \param j number of columns (a multiple of the block size).
+  */
+  template <class T, class Prop, int B, class Allocator>
+  inline Matrix<T, Prop, RowBlockSparse<B>, Allocator>::Matrix(int i, int j):
+    Matrix_BlockSparse<T, Prop, RowBlockSparse<B>, Allocator>(i, j)
+  {
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_MATRIX_BLOCK_SPARSE_CXX
+#endif
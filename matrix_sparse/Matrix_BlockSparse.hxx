@@ -0,0 +1,125 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_MATRIX_BLOCK_SPARSE_HXX
+
+namespace Seldon
+{
+
+
+  //! Block sparse-matrix class (block compressed rows).
+  /*!
+    The matrix is split into dense blocks of size B x B, where B is given by
+    the storage, and only the non-zero blocks are stored, in compressed rows
+    of blocks. It is suited to matrices with several unknowns per node (e.g.
+    finite elements for vector fields): only one column index is stored per
+    block, instead of one per entry.
+
+    Block sparse matrices are defined by: (1) the number of rows and columns,
+    which are multiples of B; (2) the number of non-zero blocks; (3) an array
+    'ptr_' of start indices (i.e. indices of the first block of each row of
+    blocks); (4) an array 'ind_' of column indices of each non-zero block
+    (in blocks); (5) values of the blocks, each block being stored by rows.
+  */
+  template <class T, class Prop, class Storage,
+	    class Allocator = SELDON_DEFAULT_ALLOCATOR<T> >
+  class Matrix_BlockSparse: public Matrix_Base<T, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef typename Allocator::pointer pointer;
+    typedef typename Allocator::const_pointer const_pointer;
+    typedef typename Allocator::reference reference;
+    typedef typename Allocator::const_reference const_reference;
+    typedef value_type entry_type;
+    typedef value_type access_type;
+    typedef value_type const_access_type;
+
+    // Attributes.
+  protected:
+    // Index (in blocks) of first block stored for each row of blocks.
+    Vector<int> ptr_;
+    // Column index (in blocks) of each block.
+    Vector<int> ind_;
+    // Values of the blocks.
+    Vector<T, VectFull, Allocator> val_;
+
+    // Methods.
+  public:
+    // Constructors.
+    Matrix_BlockSparse();
+    Matrix_BlockSparse(int i, int j);
+    Matrix_BlockSparse(const Matrix_BlockSparse<T, Prop, Storage,
+		       Allocator>& A);
+
+    // Destructor.
+    ~Matrix_BlockSparse();
+    void Clear();
+
+    // Memory management.
+    void SetData(int i, int j, Vector<T, VectFull, Allocator>& values,
+		 Vector<int>& ptr, Vector<int>& ind);
+    void Reallocate(int i, int j);
+    void Copy(const Matrix_BlockSparse<T, Prop, Storage, Allocator>& A);
+
+    // Basic methods.
+    static int GetBlockSize();
+    int GetNonZeros() const;
+    int GetDataSize() const;
+    int GetNbBlocks() const;
+    int* GetPtr() const;
+    int* GetInd() const;
+
+    // Element access.
+    value_type operator() (int i, int j) const;
+#ifndef SWIG
+    Matrix_BlockSparse<T, Prop, Storage, Allocator>&
+    operator= (const Matrix_BlockSparse<T, Prop, Storage, Allocator>& A);
+#endif
+
+    // Convenient functions.
+    void Print() const;
+  };
+
+
+  //! Row-major block sparse-matrix class.
+  template <class T, class Prop, int B, class Allocator>
+  class Matrix<T, Prop, RowBlockSparse<B>, Allocator>:
+    public Matrix_BlockSparse<T, Prop, RowBlockSparse<B>, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef Prop property;
+    typedef RowBlockSparse<B> storage;
+    typedef Allocator allocator;
+
+  public:
+    Matrix();
+    Matrix(int i, int j);
+  };
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_MATRIX_BLOCK_SPARSE_HXX
+#endif
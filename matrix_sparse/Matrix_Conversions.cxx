@@ -1276,9 +1276,381 @@ namespace Seldon
   */
 
 
+  //! Compares two values, NaNs being greater than any other value.
+  /*! This is a total order (all NaNs being equivalent), contrary to
+    operator< on floating-point values.
+    \param[in] x first value.
+    \param[in] y second value.
+    \return True if \a x is less than \a y, or if \a y is a NaN and \a x is
+    not.
+  */
+  template<class T>
+  inline bool CompareDuplicateValue(const T& x, const T& y)
+  {
+    if (x != x)
+      return false;
+    if (y != y)
+      return true;
+    return x < y;
+  }
+
+
+  //! Sorts the values of duplicate entries before they are added.
+  /*! The values are sorted in increasing order, NaNs last (see
+    CompareDuplicateValue), so that their sum does not depend on the order
+    in which the duplicates were given. The type \a T must provide
+    operator< and operator!=.
+    \param[in] n number of values.
+    \param[in,out] x values.
+  */
+  template<class T>
+  inline void SortDuplicateValues(int n, T* x)
+  {
+    sort(x, x + n, CompareDuplicateValue<T>);
+  }
+
+
+  //! Compares two complex values by real part, then by imaginary part.
+  /*! The parts are compared with CompareDuplicateValue, so that NaNs are
+    greater than any other value.
+  */
+  template<class T>
+  inline bool CompareComplexValue(const complex<T>& x, const complex<T>& y)
+  {
+    if (CompareDuplicateValue(real(x), real(y)))
+      return true;
+    if (CompareDuplicateValue(real(y), real(x)))
+      return false;
+    return CompareDuplicateValue(imag(x), imag(y));
+  }
+
+
+  //! Sorts the values of duplicate entries before they are added.
+  /*! The values are sorted by real part, then by imaginary part, NaNs last,
+    so that their sum does not depend on the order in which the duplicates
+    were given.
+    \param[in] n number of values.
+    \param[in,out] x values.
+  */
+  template<class T>
+  inline void SortDuplicateValues(int n, complex<T>* x)
+  {
+    sort(x, x + n, CompareComplexValue<T>);
+  }
+
+
+  //! Sorts coordinates into compressed rows (or columns), adding duplicates.
+  /*! The entries are sorted according to their first index (row index for a
+    compressed row storage, column index for a compressed column storage),
+    and then according to their second index. Entries with the same indices
+    are added in increasing order of their values (see SortDuplicateValues),
+    so that the result does not depend on the order in which the entries are
+    given. This requires operator< and operator!= on \a T (for complex
+    values, on their real and imaginary parts).
+
+    The sort is a counting sort in two passes. The entries are first
+    distributed into buckets of consecutive first indices (at most 1024
+    buckets), each thread processing a block of entries. Then each bucket is
+    sorted by first index, and every row of the bucket by second index,
+    independently of the other buckets. Both passes are split among the
+    threads. The distribution of the entries does not depend on the number
+    of threads, and neither does the result. Apart from the input and output
+    arrays, the memory needed is one copy of the coordinates and one copy
+    of the values, plus the small count arrays of the threads.
+    \param[in,out] IndFirst first indices (row indices for compressed rows).
+    It is cleared on exit.
+    \param[in,out] IndSecond second indices (column indices for compressed
+    rows). It is cleared on exit.
+    \param[in,out] Val on entry, values of the entries. On exit, values of
+    the compressed storage.
+    \param[in] index index of the first row and of the first column.
+    \param[in,out] m on entry, minimal number of rows (for compressed rows).
+    On exit, it is increased to the largest first index (starting from 0)
+    plus one if needed.
+    \param[in,out] n on entry, minimal number of columns (for compressed
+    rows). On exit, it is increased to the largest second index (starting
+    from 0) plus one if needed.
+    \param[out] Ptr start indices of the rows, of length \a m + 1.
+    \param[out] Ind second indices of the compressed storage.
+  */
+  template<class T, class Allocator1, class Allocator2, class Allocator3>
+  void CompressCoordinates(Vector<int, VectFull, Allocator1>& IndFirst,
+			   Vector<int, VectFull, Allocator2>& IndSecond,
+			   Vector<T, VectFull, Allocator3>& Val, int index,
+			   int& m, int& n,
+			   Vector<int, VectFull, CallocAlloc<int> >& Ptr,
+			   Vector<int, VectFull, CallocAlloc<int> >& Ind)
+  {
+    int nnz = IndFirst.GetM();
+    int nb_thread = GetNumberThreads(long(nnz));
+    const int* first_in = IndFirst.GetData();
+    const int* second_in = IndSecond.GetData();
+
+    // Dimensions.
+    Vector<int> first_max(nb_thread), second_max(nb_thread);
+    first_max.Fill(-1);
+    second_max.Fill(-1);
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int begin, end, thread = GetThreadNumber();
+      int first_max_ = -1, second_max_ = -1;
+      GetThreadRange(nnz, begin, end);
+      for (int k = begin; k < end; k++)
+	{
+	  first_max_ = max(first_max_, first_in[k] - index);
+	  second_max_ = max(second_max_, second_in[k] - index);
+	}
+      first_max(thread) = first_max_;
+      second_max(thread) = second_max_;
+    }
+    for (int t = 0; t < nb_thread; t++)
+      {
+	m = max(m, first_max(t) + 1);
+	n = max(n, second_max(t) + 1);
+      }
+
+    Ptr.Reallocate(m + 1);
+    Ptr.Zero();
+    if (nnz == 0)
+      {
+	IndFirst.Clear();
+	IndSecond.Clear();
+	Val.Clear();
+	Ind.Clear();
+	return;
+      }
+
+    // Buckets of 2^shift consecutive first indices.
+    int shift = 0;
+    while (((m - 1) >> shift) >= 1024)
+      shift++;
+    int nb_bucket = ((m - 1) >> shift) + 1;
+
+    // First pass: the entries are distributed into the buckets. 'count'
+    // contains the number of entries of each thread in each bucket, and then
+    // the position of the next entry of each thread in each bucket.
+    Vector<int> count(nb_thread * nb_bucket), bucket_ptr(nb_bucket + 1);
+    count.Zero();
+    Vector<int> first(nnz), second(nnz);
+    Vector<T, VectFull, Allocator3> value(nnz);
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int begin, end, k, p, row;
+      int* position = count.GetData() + GetThreadNumber() * nb_bucket;
+      GetThreadRange(nnz, begin, end);
+      for (k = begin; k < end; k++)
+	position[(first_in[k] - index) >> shift]++;
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+      {
+	p = 0;
+	for (int b = 0; b < nb_bucket; b++)
+	  {
+	    bucket_ptr(b) = p;
+	    for (int t = 0; t < nb_thread; t++)
+	      {
+		int nb = count(t * nb_bucket + b);
+		count(t * nb_bucket + b) = p;
+		p += nb;
+	      }
+	  }
+	bucket_ptr(nb_bucket) = p;
+      }
+
+      for (k = begin; k < end; k++)
+	{
+	  row = first_in[k] - index;
+	  p = position[row >> shift]++;
+	  first(p) = row;
+	  second(p) = second_in[k] - index;
+	  value(p) = Val(k);
+	}
+    }
+
+    count.Clear();
+    IndFirst.Clear();
+    IndSecond.Clear();
+    Val.Clear();
+
+    // Second pass: each bucket is sorted, by first index with a counting
+    // sort, and then by second index in each row, where duplicates are
+    // added. The entries of bucket 'b' are left-justified in [bucket_ptr(b),
+    // bucket_ptr(b + 1)), and their number is stored in 'bucket_nnz'.
+    Vector<int> ind(nnz), bucket_nnz(nb_bucket);
+    Vector<T, VectFull, Allocator3> val(nnz);
+    int* ptr = Ptr.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int b_begin, b_end, b, i, i_begin, i_end, j, k, l, p, nb;
+      Vector<int> position(1 << shift);
+      // Work arrays of the merge sorts, grown to the longest row.
+      Vector<int> ind_work;
+      Vector<T, VectFull, Allocator3> val_work;
+      GetThreadRange(bucket_ptr.GetData(), nb_bucket, b_begin, b_end);
+      for (b = b_begin; b < b_end; b++)
+	{
+	  i_begin = b << shift;
+	  i_end = min(m, (b + 1) << shift);
+
+	  // Counting sort by first index. The number of entries of row 'i' is
+	  // stored in Ptr(i + 1).
+	  for (k = bucket_ptr(b); k < bucket_ptr(b + 1); k++)
+	    ptr[first(k) + 1]++;
+	  p = bucket_ptr(b);
+	  for (i = i_begin; i < i_end; i++)
+	    {
+	      position(i - i_begin) = p;
+	      p += ptr[i + 1];
+	    }
+	  for (k = bucket_ptr(b); k < bucket_ptr(b + 1); k++)
+	    {
+	      p = position(first(k) - i_begin)++;
+	      ind(p) = second(k);
+	      val(p) = value(k);
+	    }
+
+	  // Stable sort by second index in each row, and sum of duplicates.
+	  p = bucket_ptr(b);
+	  l = bucket_ptr(b);
+	  for (i = i_begin; i < i_end; i++)
+	    {
+	      nb = ptr[i + 1];
+	      if (nb > 16)
+		{
+		  if (nb > ind_work.GetM())
+		    {
+		      ind_work.Reallocate(nb);
+		      val_work.Reallocate(nb);
+		    }
+		  MergeSort(p, p + nb - 1, ind, val, ind_work, val_work);
+		}
+	      else
+		for (k = p + 1; k < p + nb; k++)
+		  {
+		    int ind_k = ind(k);
+		    T val_k = val(k);
+		    for (j = k; j > p && ind(j - 1) > ind_k; j--)
+		      {
+			ind(j) = ind(j - 1);
+			val(j) = val(j - 1);
+		      }
+		    ind(j) = ind_k;
+		    val(j) = val_k;
+		  }
+
+	      int l_row = l;
+	      for (k = p; k < p + nb; k = j)
+		{
+		  for (j = k + 1; j < p + nb && ind(j) == ind(k); j++);
+		  if (j - k > 1)
+		    SortDuplicateValues(j - k, &val(k));
+		  ind(l) = ind(k);
+		  val(l) = val(k);
+		  for (k++; k < j; k++)
+		    val(l) += val(k);
+		  l++;
+		}
+	      ptr[i + 1] = l - l_row;
+	      p += nb;
+	    }
+	  bucket_nnz(b) = l - bucket_ptr(b);
+	}
+    }
+
+    first.Clear();
+    second.Clear();
+    value.Clear();
+
+    // The buckets are gathered, and the start indices of the rows are
+    // computed.
+    Vector<int> offset(nb_bucket + 1);
+    offset(0) = 0;
+    for (int b = 0; b < nb_bucket; b++)
+      offset(b + 1) = offset(b) + bucket_nnz(b);
+    Ind.Reallocate(offset(nb_bucket));
+    Val.Reallocate(offset(nb_bucket));
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int b_begin, b_end, b, i, k, p;
+      GetThreadRange(offset.GetData(), nb_bucket, b_begin, b_end);
+      for (b = b_begin; b < b_end; b++)
+	{
+	  p = offset(b);
+	  for (k = 0; k < bucket_nnz(b); k++)
+	    {
+	      Ind(p + k) = ind(bucket_ptr(b) + k);
+	      Val(p + k) = val(bucket_ptr(b) + k);
+	    }
+	  for (i = b << shift; i < min(m, (b + 1) << shift); i++)
+	    {
+	      p += ptr[i + 1];
+	      ptr[i + 1] = p;
+	    }
+	}
+    }
+  }
+
+
+  //! Removes the entries of the lower part from coordinates.
+  /*!
+    \param[in,out] IndRow row indices. On exit, the row indices of the
+    entries such that IndRow(i) <= IndCol(i).
+    \param[in,out] IndCol column indices. On exit, the column indices of the
+    entries such that IndRow(i) <= IndCol(i).
+    \param[in,out] Val values. On exit, the values of the entries such that
+    IndRow(i) <= IndCol(i).
+    \param[in] index index of the first row and of the first column.
+    \param[in,out] m on exit, the order of the smallest symmetric matrix
+    that contains all entries given on entry, unless \a m or \a n was
+    larger.
+    \param[in,out] n on exit, equal to \a m.
+  */
+  template<class T, class Allocator1, class Allocator2, class Allocator3>
+  void RemoveLowerCoordinates(Vector<int, VectFull, Allocator1>& IndRow,
+			      Vector<int, VectFull, Allocator2>& IndCol,
+			      Vector<T, VectFull, Allocator3>& Val,
+			      int index, int& m, int& n)
+  {
+    int nb = 0;
+    for (int i = 0; i < IndRow.GetM(); i++)
+      {
+	m = max(m, IndRow(i) - index + 1);
+	n = max(n, IndCol(i) - index + 1);
+	if (IndRow(i) <= IndCol(i))
+	  {
+	    IndRow(nb) = IndRow(i);
+	    IndCol(nb) = IndCol(i);
+	    Val(nb) = Val(i);
+	    nb++;
+	  }
+      }
+
+    m = n = max(m, n);
+
+    IndRow.Resize(nb);
+    IndCol.Resize(nb);
+    Val.Resize(nb);
+  }
+
+
   //! Conversion from coordinate format to RowSparse.
   /*! Contrary to the other conversion functions
-    ConvertMatrix_from_Coordinates, this one accepts duplicates.
+    ConvertMatrix_from_Coordinates, this one accepts duplicates, which are
+    added. The conversion is multithreaded (see CompressCoordinates).
     \param[in] IndRow_ row indexes of the non-zero elements.
     \param[in] IndCol_ column indexes of the non-zero elements.
     \param[in] Val values of the non-zero elements.
@@ -1294,48 +1666,19 @@ namespace Seldon
 				 Matrix<T, Prop, RowSparse, Allocator3>& A,
 				 int index)
   {
-    int Nelement = IndRow_.GetLength();
-
-    Vector<int, VectFull, CallocAlloc<int> > IndRow(Nelement),
-      IndCol(Nelement);
-
-    for (int i = 0; i < Nelement; i++)
-      {
-	IndRow(i) = IndRow_(i) - index;
-	IndCol(i) = IndCol_(i) - index;
-      }
-
-    IndRow_.Clear();
-    IndCol_.Clear();
-
-    int row_max = IndRow.GetNormInf();
-    int col_max = IndCol.GetNormInf();
-
-    int m = row_max + 1;
-    int n = col_max + 1;
-    m = max(m, A.GetM());
-    n = max(n, A.GetN());
-
-    Sort(IndRow, IndCol, Val);
-
-    // Construction of array 'Ptr'.
-    Vector<int, VectFull, CallocAlloc<int> > Ptr(m + 1);
-    Ptr.Zero();
-    for (int i = 0; i < Nelement; i++)
-      Ptr(IndRow(i)+1)++;
-
-    for (int i = 0; i < m; i++)
-      Ptr(i + 1) += Ptr(i);
-
-    // Sorts 'IndCol'
-    for (int i = 0; i < m; i++)
-      Sort(Ptr(i), Ptr(i + 1) - 1, IndCol, Val);
+    int m = A.GetM();
+    int n = A.GetN();
+    Vector<int, VectFull, CallocAlloc<int> > Ptr, IndCol;
+    CompressCoordinates(IndRow_, IndCol_, Val, index, m, n, Ptr, IndCol);
 
     A.SetData(m, n, Val, Ptr, IndCol);
   }
 
 
   //! Conversion from coordinate format to ColSparse.
+  /*! Duplicates are added. The conversion is multithreaded (see
+    CompressCoordinates).
+  */
   template<class T, class Prop, class Allocator1,
 	   class Allocator2, class Allocator3>
   void
@@ -1345,52 +1688,22 @@ namespace Seldon
 				 Matrix<T, Prop, ColSparse, Allocator3>& A,
 				 int index)
   {
-    // Assuming that there is no duplicate value.
     if (IndRow_.GetM() <= 0)
       return;
 
-    int nnz = IndRow_.GetM();
-    Vector<int, VectFull, CallocAlloc<int> > IndRow(nnz), IndCol(nnz);
-    for (int i = 0; i < nnz; i++)
-      {
-	IndRow(i) = IndRow_(i);
-	IndCol(i) = IndCol_(i);
-      }
-    IndRow_.Clear();
-    IndCol_.Clear();
-
-    int row_max = IndRow.GetNormInf();
-    int col_max = IndCol.GetNormInf();
-    int m = row_max - index + 1;
-    int n = col_max - index + 1;
-    m = max(m, A.GetM());
-    n = max(n, A.GetN());
-
-    // Sorts the array 'IndCol'.
-    Sort(IndCol, IndRow, Val);
-
-    // Construction of array 'Ptr'.
-    Vector<int, VectFull, CallocAlloc<int> > Ptr(n + 1);
-    Ptr.Zero();
-    for (int i = 0; i < nnz; i++)
-      {
-	IndRow(i) -= index;
-	IndCol(i) -= index;
-	Ptr(IndCol(i) + 1)++;
-      }
-
-    for (int i = 0; i < n; i++)
-      Ptr(i + 1) += Ptr(i);
-
-    // Sorts 'IndRow'
-    for (int i = 0; i < n; i++)
-      Sort(Ptr(i), Ptr(i + 1) - 1, IndRow, Val);
+    int m = A.GetM();
+    int n = A.GetN();
+    Vector<int, VectFull, CallocAlloc<int> > Ptr, IndRow;
+    CompressCoordinates(IndCol_, IndRow_, Val, index, n, m, Ptr, IndRow);
 
     A.SetData(m, n, Val, Ptr, IndRow);
   }
 
 
   //! Conversion from coordinate format to RowSymSparse.
+  /*! The entries of the lower part are ignored, and duplicates are added.
+    The conversion is multithreaded (see CompressCoordinates).
+  */
   template<class T, class Prop, class Allocator1,
 	   class Allocator2, class Allocator3>
   void
@@ -1400,74 +1713,24 @@ namespace Seldon
 				 Matrix<T, Prop, RowSymSparse, Allocator3>& A,
 				 int index)
   {
-    // Assuming there is no duplicate value.
     if (IndRow_.GetM() <= 0)
       return;
 
-    int nnz = IndRow_.GetM();
-    Vector<int, VectFull, CallocAlloc<int> > IndRow(nnz), IndCol(nnz);
-    for (int i = 0; i < nnz; i++)
-      {
-	IndRow(i) = IndRow_(i);
-	IndCol(i) = IndCol_(i);
-      }
-    IndRow_.Clear();
-    IndCol_.Clear();
-
-    int row_max = IndRow.GetNormInf();
-    int col_max = IndCol.GetNormInf();
-    int m = row_max - index + 1;
-    int n = col_max - index + 1;
-
     // First, removing the lower part of the matrix (if present).
-    int nb_low = 0;
-    for (int i = 0; i < nnz; i++)
-      if (IndRow(i) > IndCol(i))
-	nb_low++;
-
-    if (nb_low > 0)
-      {
-	int nb = 0;
-	for (int i = 0; i < nnz; i++)
-	  if (IndRow(i) <= IndCol(i))
-	    {
-	      IndRow(nb) = IndRow(i);
-	      IndCol(nb) = IndCol(i);
-	      Val(nb) = Val(i);
-	      nb++;
-	    }
-
-	IndRow.Resize(nb);
-	IndCol.Resize(nb);
-	Val.Resize(nb);
-	nnz = nb;
-      }
-
-    // Sorts the array 'IndRow'.
-    Sort(IndRow, IndCol, Val);
-
-    // Construction of array 'Ptr'.
-    Vector<int, VectFull, CallocAlloc<int> > Ptr(m + 1);
-    Ptr.Zero();
-    for (int i = 0; i < nnz; i++)
-      {
-	IndRow(i) -= index;
-	IndCol(i) -= index;
-	Ptr(IndRow(i) + 1)++;
-      }
+    int m = 0, n = 0;
+    RemoveLowerCoordinates(IndRow_, IndCol_, Val, index, m, n);
 
-    for (int i = 0; i < m; i++)
-      Ptr(i + 1) += Ptr(i);
-
-    // Sorts 'IndCol'.
-    for (int i = 0; i < m; i++)
-      Sort(Ptr(i), Ptr(i + 1) - 1, IndCol, Val);
+    Vector<int, VectFull, CallocAlloc<int> > Ptr, IndCol;
+    CompressCoordinates(IndRow_, IndCol_, Val, index, m, n, Ptr, IndCol);
 
     A.SetData(m, n, Val, Ptr, IndCol);
   }
 
 
   //! Conversion from coordinate format to ColSymSparse.
+  /*! The entries of the lower part are ignored, and duplicates are added.
+    The conversion is multithreaded (see CompressCoordinates).
+  */
   template<class T, class Prop, class Allocator1,
 	   class Allocator2, class Allocator3>
   void
@@ -1477,69 +1740,15 @@ namespace Seldon
 				 Matrix<T, Prop, ColSymSparse, Allocator3>& A,
 				 int index)
   {
-    // Assuming there is no duplicate value.
     if (IndRow_.GetM() <= 0)
       return;
 
-    int nnz = IndRow_.GetM();
-    Vector<int, VectFull, CallocAlloc<int> > IndRow(nnz), IndCol(nnz);
-    for (int i = 0; i < nnz; i++)
-      {
-	IndRow(i) = IndRow_(i);
-	IndCol(i) = IndCol_(i);
-      }
-
-    IndRow_.Clear();
-    IndCol_.Clear();
-
-    int row_max = IndRow.GetNormInf();
-    int col_max = IndCol.GetNormInf();
-    int m = row_max - index + 1;
-    int n = col_max - index + 1;
-
     // First, removing the lower part of the matrix (if present).
-    int nb_low = 0;
-    for (int i = 0; i < nnz; i++)
-      if (IndRow(i) > IndCol(i))
-	nb_low++;
-
-    if (nb_low > 0)
-      {
-	int nb = 0;
-	for (int i = 0; i < nnz; i++)
-	  if (IndRow(i) <= IndCol(i))
-	    {
-	      IndRow(nb) = IndRow(i);
-	      IndCol(nb) = IndCol(i);
-	      Val(nb) = Val(i);
-	      nb++;
-	    }
-
-	IndRow.Resize(nb);
-	IndCol.Resize(nb);
-	Val.Resize(nb);
-	nnz = nb;
-      }
+    int m = 0, n = 0;
+    RemoveLowerCoordinates(IndRow_, IndCol_, Val, index, m, n);
 
-    // Sorts the array 'IndCol'.
-    Sort(IndCol, IndRow, Val);
-
-    // Construction of array 'Ptr'.
-    Vector<int, VectFull, CallocAlloc<int> > Ptr(m + 1);
-    Ptr.Zero();
-    for (int i = 0; i < nnz; i++)
-      {
-	IndRow(i) -= index;
-	IndCol(i) -= index;
-	Ptr(IndCol(i) + 1)++;
-      }
-
-    for (int i = 0; i < m; i++)
-      Ptr(i + 1) += Ptr(i);
-
-    // Sorts 'IndRow'.
-    for (int i = 0; i < m; i++)
-      Sort(Ptr(i), Ptr(i + 1) - 1, IndRow, Val);
+    Vector<int, VectFull, CallocAlloc<int> > Ptr, IndRow;
+    CompressCoordinates(IndCol_, IndRow_, Val, index, n, m, Ptr, IndRow);
 
     A.SetData(m, n, Val, Ptr, IndRow);
   }
@@ -4411,6 +4620,386 @@ namespace Seldon
   }
 
 
+  /***********************
+   * SELL-C-sigma format *
+   ***********************/
+
+
+  //! Conversion from RowSparse to RowSellSparse.
+  /*!
+    The chunk size and the sorting scope of \a B are used. Within each window
+    of rows given by the sorting scope, the rows are sorted by decreasing
+    number of non-zero entries (rows with the same length keep their order).
+    The padding entries of a row have the column index of its last non-zero
+    entry, so that they do not access other parts of the vector in
+    matrix-vector products.
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowSellSparse, Allocator1>& B)
+  {
+    int i, k, l, s, row, length, width;
+    int m = A.GetM();
+    int* ptr = A.GetPtr();
+    int* ind = A.GetInd();
+    T0* data = A.GetData();
+    int chunk_size = B.GetChunkSize();
+    int sorting_scope = B.GetSortingScope();
+    int nb_chunk = (m + chunk_size - 1) / chunk_size;
+
+    // Stored rows, sorted by decreasing length within each window.
+    Vector<int> perm(m), opposite_length(m);
+    perm.Fill();
+    for (i = 0; i < m; i++)
+      opposite_length(i) = ptr[i] - ptr[i + 1];
+    if (sorting_scope > 1)
+      for (i = 0; i < m; i += sorting_scope)
+	Sort(i, min(i + sorting_scope, m) - 1, opposite_length, perm);
+
+    // Each chunk is as wide as its longest row.
+    Vector<int> chunk_ptr(nb_chunk + 1);
+    chunk_ptr(0) = 0;
+    for (s = 0; s < nb_chunk; s++)
+      {
+	width = 0;
+	for (row = s * chunk_size; row < min((s + 1) * chunk_size, m); row++)
+	  width = max(width, -opposite_length(row));
+	chunk_ptr(s + 1) = chunk_ptr(s) + chunk_size * width;
+      }
+
+    Vector<int> index(chunk_ptr(nb_chunk));
+    Vector<T1, VectFull, Allocator1> value(chunk_ptr(nb_chunk));
+    for (s = 0; s < nb_chunk; s++)
+      {
+	width = (chunk_ptr(s + 1) - chunk_ptr(s)) / chunk_size;
+	for (row = s * chunk_size; row < (s + 1) * chunk_size; row++)
+	  {
+	    k = chunk_ptr(s) + row - s * chunk_size;
+	    if (row < m)
+	      {
+		i = perm(row);
+		length = ptr[i + 1] - ptr[i];
+	      }
+	    else
+	      length = 0;
+
+	    for (l = 0; l < length; l++, k += chunk_size)
+	      {
+		index(k) = ind[ptr[i] + l];
+		value(k) = data[ptr[i] + l];
+	      }
+	    for (l = length; l < width; l++, k += chunk_size)
+	      {
+		index(k) = length > 0 ? ind[ptr[i + 1] - 1] : 0;
+		value(k) = T1(0);
+	      }
+	  }
+      }
+
+    B.SetData(m, A.GetN(), A.GetNonZeros(), value, chunk_ptr, index, perm);
+  }
+
+
+  //! Conversion from ArrayRowSparse to RowSellSparse.
+  /*!
+    The chunk size and the sorting scope of \a B are used.
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayRowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowSellSparse, Allocator1>& B)
+  {
+    Matrix<T1, Prop1, RowSparse, Allocator1> A_csr;
+    Copy(A, A_csr);
+    Copy(A_csr, B);
+  }
+
+
+  /************************
+   * Block sparse storage *
+   ************************/
+
+
+  //! Conversion from RowSparse to RowBlockSparse.
+  /*!
+    Every block of size B x B that contains a non-zero entry of \a A is
+    stored in \a M, with its zeros.
+    \param[in] A matrix to be converted; its dimensions should be multiples
+    of B.
+    \param[out] M converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, int B, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M)
+  {
+    int m = A.GetM();
+    int n = A.GetN();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (m % B != 0 || n % B != 0)
+      throw WrongDim(string("Copy(const Matrix<RowSparse>&, ")
+		     + "Matrix<RowBlockSparse<B> >&)",
+		     string("The dimensions of the matrix (") + to_str(m)
+		     + " by " + to_str(n) + ") should be multiples of "
+		     + "the block size (" + to_str(B) + ").");
+#endif
+
+    int i, k, l, I, J;
+    int mb = m / B;
+    int nb = n / B;
+    int* ptr = A.GetPtr();
+    int* ind = A.GetInd();
+    T0* data = A.GetData();
+
+    // Counts the blocks of each row of blocks. 'last_row(J)' is the last row
+    // of blocks in which a block of column J has been found.
+    Vector<int> last_row(nb), block_ptr(mb + 1);
+    last_row.Fill(-1);
+    block_ptr(0) = 0;
+    for (I = 0; I < mb; I++)
+      {
+	block_ptr(I + 1) = block_ptr(I);
+	for (k = ptr[B * I]; k < ptr[B * (I + 1)]; k++)
+	  if (last_row(ind[k] / B) != I)
+	    {
+	      last_row(ind[k] / B) = I;
+	      block_ptr(I + 1)++;
+	    }
+      }
+
+    // Sorted column indices of the blocks.
+    Vector<int> block_ind(block_ptr(mb)), position(nb);
+    last_row.Fill(-1);
+    for (I = 0; I < mb; I++)
+      {
+	l = block_ptr(I);
+	for (k = ptr[B * I]; k < ptr[B * (I + 1)]; k++)
+	  if (last_row(ind[k] / B) != I)
+	    {
+	      last_row(ind[k] / B) = I;
+	      block_ind(l++) = ind[k] / B;
+	    }
+	Sort(block_ptr(I), block_ptr(I + 1) - 1, block_ind);
+      }
+
+    // Values of the blocks.
+    Vector<T1, VectFull, Allocator1> value(B * B * block_ptr(mb));
+    value.Fill(T1(0));
+    for (I = 0; I < mb; I++)
+      {
+	for (l = block_ptr(I); l < block_ptr(I + 1); l++)
+	  position(block_ind(l)) = l;
+	for (i = B * I; i < B * (I + 1); i++)
+	  for (k = ptr[i]; k < ptr[i + 1]; k++)
+	    {
+	      J = ind[k] / B;
+	      value(B * B * position(J) + B * (i % B) + ind[k] % B) = data[k];
+	    }
+      }
+
+    M.SetData(m, n, value, block_ptr, block_ind);
+  }
+
+
+  //! Conversion from ArrayRowSparse to RowBlockSparse.
+  /*!
+    \param[in] A matrix to be converted; its dimensions should be multiples
+    of the block size.
+    \param[out] M converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, int B, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayRowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M)
+  {
+    Matrix<T1, Prop1, RowSparse, Allocator1> A_csr;
+    Copy(A, A_csr);
+    Copy(A_csr, M);
+  }
+
+
+  /****************************************
+   * Sparse storages with 64-bit pointers *
+   ****************************************/
+
+
+  //! Copies a compressed sparse matrix into another compressed sparse matrix.
+  /*!
+    The matrices may have different types of start indices: this function
+    converts a Matrix_Sparse to a Matrix_LongSparse, or conversely. Both
+    matrices should be stored in the same direction (by rows or by columns).
+    \param[in] n_first number of rows (for a storage by rows) or columns
+    (for a storage by columns).
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class Matrix0, class Matrix1>
+  void CopyCompressedSparse(int n_first, const Matrix0& A, Matrix1& B)
+  {
+    B.Reallocate(A.GetM(), A.GetN(), A.GetNonZeros());
+    if (A.GetPtr() == NULL)
+      return;
+
+    int i;
+    long k;
+    for (i = 0; i <= n_first; i++)
+      B.GetPtr()[i] = A.GetPtr()[i];
+    for (k = 0; k < long(A.GetNonZeros()); k++)
+      {
+	B.GetInd()[k] = A.GetInd()[k];
+	B.GetData()[k] = A.GetData()[k];
+      }
+  }
+
+
+  //! Converts a sparse matrix stored in arrays to 64-bit compressed storage.
+  /*!
+    The number of non-zero entries is counted in a 'long' integer, so that
+    the conversion is valid for more than 2^31 - 1 non-zero entries.
+    \param[in] n_first number of rows (for ArrayRowSparse) or columns (for
+    ArrayColSparse).
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class Matrix0, class Matrix1>
+  void CopyArrayToLongSparse(int n_first, const Matrix0& A, Matrix1& B)
+  {
+    int i, j;
+    long nz = 0;
+    for (i = 0; i < n_first; i++)
+      nz += A.GetData()[i].GetM();
+
+    B.Reallocate(A.GetM(), A.GetN(), nz);
+    long* ptr = B.GetPtr();
+    int* ind = B.GetInd();
+    typename Matrix1::pointer data = B.GetData();
+
+    ptr[0] = 0;
+    for (i = 0; i < n_first; i++)
+      {
+	int size = A.GetData()[i].GetM();
+	int* index = A.GetData()[i].GetIndex();
+	typename Matrix0::value_type* value = A.GetData()[i].GetData();
+	for (j = 0; j < size; j++)
+	  {
+	    ind[ptr[i] + j] = index[j];
+	    data[ptr[i] + j] = value[j];
+	  }
+	ptr[i + 1] = ptr[i] + size;
+      }
+  }
+
+
+  //! Conversion from RowSparse to RowLongSparse.
+  /*!
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowLongSparse, Allocator1>& B)
+  {
+    CopyCompressedSparse(A.GetM(), A, B);
+  }
+
+
+  //! Conversion from ColSparse to ColLongSparse.
+  /*!
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ColSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, ColLongSparse, Allocator1>& B)
+  {
+    CopyCompressedSparse(A.GetN(), A, B);
+  }
+
+
+  //! Conversion from ArrayRowSparse to RowLongSparse.
+  /*!
+    This conversion does not go through a RowSparse matrix, so that it may
+    be used to build matrices with more than 2^31 - 1 non-zero entries: the
+    matrix is assembled in an ArrayRowSparse matrix, whose rows are
+    independent, and is then converted.
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayRowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowLongSparse, Allocator1>& B)
+  {
+    CopyArrayToLongSparse(A.GetM(), A, B);
+  }
+
+
+  //! Conversion from ArrayColSparse to ColLongSparse.
+  /*!
+    \param[in] A matrix to be converted.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayColSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, ColLongSparse, Allocator1>& B)
+  {
+    CopyArrayToLongSparse(A.GetN(), A, B);
+  }
+
+
+  //! Conversion from RowLongSparse to RowSparse.
+  /*!
+    \param[in] A matrix to be converted; it should have less than 2^31
+    non-zero entries.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowLongSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowSparse, Allocator1>& B)
+  {
+    if (A.GetNonZeros() > long(numeric_limits<int>::max()))
+      throw WrongDim(string("Copy(const Matrix<RowLongSparse>&, ")
+		     + "Matrix<RowSparse>&)",
+		     string("The matrix has ") + to_str(A.GetNonZeros())
+		     + " non-zero entries, which is more than a RowSparse "
+		     + "matrix can store.");
+
+    CopyCompressedSparse(A.GetM(), A, B);
+  }
+
+
+  //! Conversion from ColLongSparse to ColSparse.
+  /*!
+    \param[in] A matrix to be converted; it should have less than 2^31
+    non-zero entries.
+    \param[out] B converted matrix.
+  */
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ColLongSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, ColSparse, Allocator1>& B)
+  {
+    if (A.GetNonZeros() > long(numeric_limits<int>::max()))
+      throw WrongDim(string("Copy(const Matrix<ColLongSparse>&, ")
+		     + "Matrix<ColSparse>&)",
+		     string("The matrix has ") + to_str(A.GetNonZeros())
+		     + " non-zero entries, which is more than a ColSparse "
+		     + "matrix can store.");
+
+    CopyCompressedSparse(A.GetN(), A, B);
+  }
+
+
   /***********************
    * GetSymmetricPattern *
    ***********************/
@@ -205,6 +205,31 @@ namespace Seldon
   */
 
 
+  template<class T>
+  bool CompareDuplicateValue(const T& x, const T& y);
+  template<class T>
+  void SortDuplicateValues(int n, T* x);
+  template<class T>
+  bool CompareComplexValue(const complex<T>& x, const complex<T>& y);
+  template<class T>
+  void SortDuplicateValues(int n, complex<T>* x);
+
+  template<class T, class Allocator1, class Allocator2, class Allocator3>
+  void CompressCoordinates(Vector<int, VectFull, Allocator1>& IndFirst,
+			   Vector<int, VectFull, Allocator2>& IndSecond,
+			   Vector<T, VectFull, Allocator3>& Val, int index,
+			   int& m, int& n,
+			   Vector<int, VectFull, CallocAlloc<int> >& Ptr,
+			   Vector<int, VectFull, CallocAlloc<int> >& Ind);
+
+
+  template<class T, class Allocator1, class Allocator2, class Allocator3>
+  void RemoveLowerCoordinates(Vector<int, VectFull, Allocator1>& IndRow,
+			      Vector<int, VectFull, Allocator2>& IndCol,
+			      Vector<T, VectFull, Allocator3>& Val,
+			      int index, int& m, int& n);
+
+
   template<class T, class Prop, class Allocator1,
 	   class Allocator2, class Allocator3>
   void
@@ -657,6 +682,89 @@ namespace Seldon
        Matrix<T1, Prop1, RowSymComplexSparse, Allocator1>& mat_csr);
 
 
+  /***********************
+   * SELL-C-sigma format *
+   ***********************/
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowSellSparse, Allocator1>& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayRowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowSellSparse, Allocator1>& B);
+
+
+  /************************
+   * Block sparse storage *
+   ************************/
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, int B, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, int B, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayRowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowBlockSparse<B>, Allocator1>& M);
+
+
+  /****************************************
+   * Sparse storages with 64-bit pointers *
+   ****************************************/
+
+
+  template<class Matrix0, class Matrix1>
+  void CopyCompressedSparse(int n_first, const Matrix0& A, Matrix1& B);
+
+
+  template<class Matrix0, class Matrix1>
+  void CopyArrayToLongSparse(int n_first, const Matrix0& A, Matrix1& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowLongSparse, Allocator1>& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ColSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, ColLongSparse, Allocator1>& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayRowSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowLongSparse, Allocator1>& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ArrayColSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, ColLongSparse, Allocator1>& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, RowLongSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, RowSparse, Allocator1>& B);
+
+
+  template<class T0, class Prop0, class Allocator0,
+	   class T1, class Prop1, class Allocator1>
+  void Copy(const Matrix<T0, Prop0, ColLongSparse, Allocator0>& A,
+	    Matrix<T1, Prop1, ColSparse, Allocator1>& B);
+
+
   /***********************
    * GetSymmetricPattern *
    ***********************/
@@ -0,0 +1,599 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_MATRIX_LONG_SPARSE_CXX
+
+#include "Matrix_LongSparse.hxx"
+
+
+namespace Seldon
+{
+
+
+  /****************
+   * CONSTRUCTORS *
+   ****************/
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>::Matrix_LongSparse():
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+  }
+
+
+  //! Constructor.
+  /*!
+    Builds a i by j sparse matrix without non-zero entries.
+    \param i number of rows.
+    \param j number of columns.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::Matrix_LongSparse(int i, int j):
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+
+    Reallocate(i, j);
+  }
+
+
+  //! Constructor.
+  /*!
+    Builds a i by j sparse matrix with nz non-zero elements. Indices and
+    values are not initialized.
+    \param i number of rows.
+    \param j number of columns.
+    \param nz number of non-zero elements.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::Matrix_LongSparse(int i, int j, long nz):
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+
+    Reallocate(i, j, nz);
+  }
+
+
+  //! Copy constructor.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>::
+  Matrix_LongSparse(const Matrix_LongSparse<T, Prop, Storage,
+		    Allocator>& A):
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+
+    Copy(A);
+  }
+
+
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*!
+    The arrays of \a A are taken over, without copy; \a A is empty on exit.
+    \param A matrix to be moved.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>::
+  Matrix_LongSparse(Matrix_LongSparse<T, Prop, Storage, Allocator>&& A)
+    noexcept:
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+
+    Swap(A);
+  }
+#endif
+
+
+  /**************
+   * DESTRUCTOR *
+   **************/
+
+
+  //! Destructor.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>::~Matrix_LongSparse()
+  {
+    Clear();
+  }
+
+
+  //! Clears the matrix.
+  /*! This methods is equivalent to the destructor. On exit, the matrix is
+    empty (0x0).
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_LongSparse<T, Prop, Storage, Allocator>::Clear()
+  {
+    if (ptr_ != NULL)
+      free(ptr_);
+    if (ind_ != NULL)
+      free(ind_);
+    if (this->data_ != NULL)
+      this->allocator_.deallocate(this->data_, nz_);
+
+    this->m_ = 0;
+    this->n_ = 0;
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+    this->data_ = NULL;
+  }
+
+
+  /*********************
+   * MEMORY MANAGEMENT *
+   *********************/
+
+
+  //! Redefines the matrix.
+  /*! It clears the matrix and sets it to a new matrix defined by arrays
+    'values' (values), 'ptr' (pointers) and 'ind' (indices). The arrays are
+    then managed by the matrix: they should have been allocated with 'malloc'
+    for 'ptr' and 'ind', and with the allocator of the matrix for 'values'.
+    \param i number of rows.
+    \param j number of columns.
+    \param nz number of non-zero entries.
+    \param values values of non-zero entries.
+    \param ptr row or column start indices.
+    \param ind row or column indices.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_LongSparse<T, Prop, Storage, Allocator>::
+  SetData(int i, int j, long nz, pointer values, long* ptr, int* ind)
+  {
+    Clear();
+
+    this->m_ = i;
+    this->n_ = j;
+    nz_ = nz;
+    this->data_ = values;
+    ptr_ = ptr;
+    ind_ = ind;
+  }
+
+
+  //! Clears the matrix without releasing memory.
+  /*!
+    On exit, the matrix is empty and the memory has not been released.
+    It is useful for low level manipulations on a Matrix instance.
+    \warning Memory is not released.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_LongSparse<T, Prop, Storage, Allocator>::Nullify()
+  {
+    this->data_ = NULL;
+    this->m_ = 0;
+    this->n_ = 0;
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+  }
+
+
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the arrays are exchanged.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_LongSparse<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+    swap(nz_, A.nz_);
+    swap(ptr_, A.ptr_);
+    swap(ind_, A.ind_);
+  }
+
+
+  //! Reallocates memory to resize the matrix.
+  /*!
+    On exit, the matrix is a i x j matrix without non-zero entries.
+    \param i new number of rows.
+    \param j new number of columns.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_LongSparse<T, Prop, Storage, Allocator>::
+  Reallocate(int i, int j)
+  {
+    Reallocate(i, j, 0L);
+  }
+
+
+  //! Reallocates memory to resize the matrix.
+  /*!
+    On exit, the matrix is a i x j matrix with nz non-zero entries. The start
+    indices are set to zero, the indices and values are not initialized.
+    \param i new number of rows.
+    \param j new number of columns.
+    \param nz number of non-zero entries.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_LongSparse<T, Prop, Storage, Allocator>::
+  Reallocate(int i, int j, long nz)
+  {
+    Clear();
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (nz < 0)
+      throw WrongDim("Matrix_LongSparse::Reallocate(int, int, long)",
+		     "Invalid number of non-zero elements: " + to_str(nz)
+		     + ".");
+    if (nz > 0 && (j == 0 || (nz - 1) / long(j) >= long(i)))
+      throw WrongDim("Matrix_LongSparse::Reallocate(int, int, long)",
+		     string("There are more values (") + to_str(nz)
+		     + " values) than elements in the matrix ("
+		     + to_str(i) + " by " + to_str(j) + ").");
+#endif
+
+    int n_first = Storage::GetFirst(i, j);
+    ptr_ = reinterpret_cast<long*>( calloc(n_first + 1, sizeof(long)) );
+    if (nz > 0)
+      {
+	ind_ = reinterpret_cast<int*>( malloc(nz * sizeof(int)) );
+	this->data_ = this->allocator_.allocate(nz, this);
+      }
+
+    if (ptr_ == NULL || (nz > 0 && (ind_ == NULL || this->data_ == NULL)))
+      {
+	if (this->data_ != NULL)
+	  this->allocator_.deallocate(this->data_, nz);
+	free(ptr_);
+	free(ind_);
+	Nullify();
+#ifdef SELDON_CHECK_MEMORY
+	throw NoMemory("Matrix_LongSparse::Reallocate(int, int, long)",
+		       string("Unable to allocate memory for a ")
+		       + to_str(i) + " by " + to_str(j) + " matrix with "
+		       + to_str(nz) + " non-zero entries.");
+#else
+	return;
+#endif
+      }
+
+    this->m_ = i;
+    this->n_ = j;
+    nz_ = nz;
+  }
+
+
+  //! Copies a matrix.
+  /*!
+    \param[in] A matrix to be copied.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_LongSparse<T, Prop, Storage, Allocator>::
+  Copy(const Matrix_LongSparse<T, Prop, Storage, Allocator>& A)
+  {
+    if (this == &A)
+      return;
+
+    int n_first = Storage::GetFirst(A.m_, A.n_);
+    Reallocate(A.m_, A.n_, A.nz_);
+    if (A.ptr_ == NULL || ptr_ == NULL)
+      return;
+
+    memcpy(ptr_, A.ptr_, (n_first + 1) * sizeof(long));
+    if (nz_ > 0)
+      {
+	memcpy(ind_, A.ind_, nz_ * sizeof(int));
+	this->allocator_.memorycpy(this->data_, A.data_, nz_);
+      }
+  }
+
+
+  /*******************
+   * BASIC FUNCTIONS *
+   *******************/
+
+
+  //! Returns the number of non-zero elements.
+  /*!
+    \return The number of non-zero elements.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline long Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::GetNonZeros() const
+  {
+    return nz_;
+  }
+
+
+  //! Returns the number of elements stored in memory.
+  /*!
+    \return The number of elements stored in memory (the number of non-zero
+    elements).
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline long Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::GetDataSize() const
+  {
+    return nz_;
+  }
+
+
+  //! Returns (row or column) start indices.
+  /*!
+    \return The array of start indices.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline long* Matrix_LongSparse<T, Prop, Storage, Allocator>::GetPtr() const
+  {
+    return ptr_;
+  }
+
+
+  //! Returns (row or column) indices of non-zero entries.
+  /*!
+    \return The array of (row or column) indices of non-zero entries.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int* Matrix_LongSparse<T, Prop, Storage, Allocator>::GetInd() const
+  {
+    return ind_;
+  }
+
+
+  //! Returns the length of the array of start indices.
+  /*!
+    \return The length of the array of start indices.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::GetPtrSize() const
+  {
+    return Storage::GetFirst(this->m_, this->n_) + 1;
+  }
+
+
+  //! Returns the length of the array of (column or row) indices.
+  /*!
+    \return The length of the array of (column or row) indices, i.e. the
+    number of non-zero entries.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline long Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::GetIndSize() const
+  {
+    return nz_;
+  }
+
+
+  /**********************************
+   * ELEMENT ACCESS AND AFFECTATION *
+   **********************************/
+
+
+  //! Access operator.
+  /*!
+    Returns the value of element (i, j).
+    \param i row index.
+    \param j column index.
+    \return Element (i, j) of the matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline typename Matrix_LongSparse<T, Prop, Storage, Allocator>::value_type
+  Matrix_LongSparse<T, Prop, Storage, Allocator>::operator() (int i,
+							       int j) const
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= this->m_)
+      throw WrongRow("Matrix_LongSparse::operator()",
+		     string("Index should be in [0, ") + to_str(this->m_-1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= this->n_)
+      throw WrongCol("Matrix_LongSparse::operator()",
+		     string("Index should be in [0, ") + to_str(this->n_-1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    long a = ptr_[Storage::GetFirst(i, j)];
+    long b = ptr_[Storage::GetFirst(i, j) + 1];
+    int l = Storage::GetSecond(i, j);
+
+    // Indices are sorted.
+    long k = lower_bound(ind_ + a, ind_ + b, l) - ind_;
+    if (k < b && ind_[k] == l)
+      return this->data_[k];
+    else
+      return T(0);
+  }
+
+
+  //! Duplicates a matrix (assignment operator).
+  /*!
+    \param A matrix to be copied.
+    \note Memory is duplicated: 'A' is therefore independent from the current
+    instance after the copy.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>&
+  Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::operator= (const Matrix_LongSparse<T, Prop, Storage, Allocator>& A)
+  {
+    this->Copy(A);
+
+    return *this;
+  }
+
+
+#ifdef SELDON_WITH_CXX11
+  //! Move assignment operator.
+  /*!
+    The arrays of \a A are exchanged with those of the current instance,
+    without copy.
+    \param A matrix to be moved.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_LongSparse<T, Prop, Storage, Allocator>&
+  Matrix_LongSparse<T, Prop, Storage, Allocator>
+  ::operator= (Matrix_LongSparse<T, Prop, Storage, Allocator>&& A) noexcept
+  {
+    Swap(A);
+
+    return *this;
+  }
+#endif
+
+
+  /************************
+   * CONVENIENT FUNCTIONS *
+   ************************/
+
+
+  //! Resets all non-zero entries to 0-value.
+  /*! The sparsity pattern remains unchanged. */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_LongSparse<T, Prop, Storage, Allocator>::Zero()
+  {
+    for (long k = 0; k < nz_; k++)
+      this->data_[k] = T(0);
+  }
+
+
+  //! Displays the matrix on the standard output.
+  /*!
+    Displays elements on the standard output, in text format.
+    Each row is displayed on a single line and elements of
+    a row are delimited by tabulations.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_LongSparse<T, Prop, Storage, Allocator>::Print() const
+  {
+    for (int i = 0; i < this->m_; i++)
+      {
+	for (int j = 0; j < this->n_; j++)
+	  cout << (*this)(i, j) << "\t";
+	cout << endl;
+      }
+  }
+
+
+  ///////////////////////////
+  // MATRIX<COLLONGSPARSE> //
+  ///////////////////////////
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, ColLongSparse, Allocator>::Matrix():
+    Matrix_LongSparse<T, Prop, ColLongSparse, Allocator>()
+  {
+  }
+
+
+  //! Constructor.
+  /*! Builds a i by j matrix without non-zero entries.
+    \param i number of rows.
+    \param j number of columns.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, ColLongSparse, Allocator>::Matrix(int i, int j):
+    Matrix_LongSparse<T, Prop, ColLongSparse, Allocator>(i, j)
+  {
+  }
+
+
+  //! Constructor.
+  /*! Builds a i by j matrix with nz non-zero (stored) elements.
+    \param i number of rows.
+    \param j number of columns.
+    \param nz number of non-zero elements that are stored.
+    \note Matrix values are not initialized.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, ColLongSparse, Allocator>::Matrix(int i, int j,
+							  long nz):
+    Matrix_LongSparse<T, Prop, ColLongSparse, Allocator>(i, j, nz)
+  {
+  }
+
+
+  ///////////////////////////
+  // MATRIX<ROWLONGSPARSE> //
+  ///////////////////////////
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, RowLongSparse, Allocator>::Matrix():
+    Matrix_LongSparse<T, Prop, RowLongSparse, Allocator>()
+  {
+  }
+
+
+  //! Constructor.
+  /*! Builds a i by j matrix without non-zero entries.
+    \param i number of rows.
+    \param j number of columns.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, RowLongSparse, Allocator>::Matrix(int i, int j):
+    Matrix_LongSparse<T, Prop, RowLongSparse, Allocator>(i, j)
+  {
+  }
+
+
+  //! Constructor.
+  /*! Builds a i by j matrix with nz non-zero (stored) elements.
+    \param i number of rows.
+    \param j number of columns.
+    \param nz number of non-zero elements that are stored.
+    \note Matrix values are not initialized.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, RowLongSparse, Allocator>::Matrix(int i, int j,
+							  long nz):
+    Matrix_LongSparse<T, Prop, RowLongSparse, Allocator>(i, j, nz)
+  {
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_MATRIX_LONG_SPARSE_CXX
+#endif
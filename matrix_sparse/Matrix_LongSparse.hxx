@@ -0,0 +1,162 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_MATRIX_LONG_SPARSE_HXX
+
+namespace Seldon
+{
+
+
+  //! Sparse-matrix class with 64-bit start indices.
+  /*!
+    This class is the counterpart of Matrix_Sparse for matrices with more
+    than 2^31 - 1 non-zero entries. The number of non-zero entries and the
+    start indices are stored as 'long' integers, whereas the row and column
+    indices remain 'int' integers, so that the dimensions of the matrix are
+    limited as for the other storages. Only the array of start indices is
+    larger than in Matrix_Sparse, so that the matrix-vector products are
+    nearly as fast.
+
+    Sparse matrices are defined by: (1) the number of rows and columns;
+    (2) the number of non-zero entries; (3) an array 'ptr_' of start indices
+    (i.e. indices of the first element of each row or column, depending
+    on the storage); (4) an array 'ind_' of column or row indices of each
+    non-zero entry; (5) values of non-zero entries.
+
+    \warning The type 'long' has 64 bits on 64-bit Unix systems, but only 32
+    bits under MS Windows.
+  */
+  template <class T, class Prop, class Storage,
+	    class Allocator = SELDON_DEFAULT_ALLOCATOR<T> >
+  class Matrix_LongSparse: public Matrix_Base<T, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef typename Allocator::pointer pointer;
+    typedef typename Allocator::const_pointer const_pointer;
+    typedef typename Allocator::reference reference;
+    typedef typename Allocator::const_reference const_reference;
+    typedef value_type entry_type;
+    typedef value_type access_type;
+    typedef value_type const_access_type;
+
+    // Attributes.
+  protected:
+    // Number of non-zero elements.
+    long nz_;
+    // Index (in data_) of first element stored for each row or column.
+    long* ptr_;
+    // Column or row index (in the matrix) each element.
+    int* ind_;
+
+    // Methods.
+  public:
+    // Constructors.
+    Matrix_LongSparse();
+    Matrix_LongSparse(int i, int j);
+    Matrix_LongSparse(int i, int j, long nz);
+    Matrix_LongSparse(const Matrix_LongSparse<T, Prop, Storage,
+		      Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix_LongSparse(Matrix_LongSparse<T, Prop, Storage, Allocator>&& A)
+      noexcept;
+#endif
+
+    // Destructor.
+    ~Matrix_LongSparse();
+    void Clear();
+
+    // Memory management.
+    void SetData(int i, int j, long nz, pointer values, long* ptr, int* ind);
+    void Nullify();
+    void Swap(Matrix_LongSparse<T, Prop, Storage, Allocator>& A);
+    void Reallocate(int i, int j);
+    void Reallocate(int i, int j, long nz);
+    void Copy(const Matrix_LongSparse<T, Prop, Storage, Allocator>& A);
+
+    // Basic methods.
+    long GetNonZeros() const;
+    long GetDataSize() const;
+    long* GetPtr() const;
+    int* GetInd() const;
+    int GetPtrSize() const;
+    long GetIndSize() const;
+
+    // Element access and affectation.
+    value_type operator() (int i, int j) const;
+#ifndef SWIG
+    Matrix_LongSparse<T, Prop, Storage, Allocator>&
+    operator= (const Matrix_LongSparse<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix_LongSparse<T, Prop, Storage, Allocator>&
+    operator= (Matrix_LongSparse<T, Prop, Storage, Allocator>&& A) noexcept;
+#endif
+#endif
+
+    // Convenient functions.
+    void Zero();
+    void Print() const;
+  };
+
+
+  //! Column-major sparse-matrix class with 64-bit start indices.
+  template <class T, class Prop, class Allocator>
+  class Matrix<T, Prop, ColLongSparse, Allocator>:
+    public Matrix_LongSparse<T, Prop, ColLongSparse, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef Prop property;
+    typedef ColLongSparse storage;
+    typedef Allocator allocator;
+
+  public:
+    Matrix();
+    Matrix(int i, int j);
+    Matrix(int i, int j, long nz);
+  };
+
+
+  //! Row-major sparse-matrix class with 64-bit start indices.
+  template <class T, class Prop, class Allocator>
+  class Matrix<T, Prop, RowLongSparse, Allocator>:
+    public Matrix_LongSparse<T, Prop, RowLongSparse, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef Prop property;
+    typedef RowLongSparse storage;
+    typedef Allocator allocator;
+
+  public:
+    Matrix();
+    Matrix(int i, int j);
+    Matrix(int i, int j, long nz);
+  };
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_MATRIX_LONG_SPARSE_HXX
+#endif
@@ -0,0 +1,470 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_MATRIX_SELL_SPARSE_CXX
+
+#include "Matrix_SellSparse.hxx"
+
+
+namespace Seldon
+{
+
+
+  /****************
+   * CONSTRUCTORS *
+   ****************/
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix. The chunks contain 8 rows, which fills the
+    vector registers with AVX-512 in double precision (or with AVX in single
+    precision), and rows are sorted within windows of 256 rows.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SellSparse<T, Prop, Storage, Allocator>::Matrix_SellSparse():
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    chunk_size_ = 8;
+    sorting_scope_ = 256;
+  }
+
+
+  //! Constructor.
+  /*!
+    Builds a i by j sparse matrix without non-zero entries.
+    \param i number of rows.
+    \param j number of columns.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::Matrix_SellSparse(int i, int j):
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    chunk_size_ = 8;
+    sorting_scope_ = 256;
+
+    Reallocate(i, j);
+  }
+
+
+  //! Copy constructor.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SellSparse<T, Prop, Storage, Allocator>::
+  Matrix_SellSparse(const Matrix_SellSparse<T, Prop, Storage, Allocator>& A):
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    chunk_size_ = 8;
+    sorting_scope_ = 256;
+
+    Copy(A);
+  }
+
+
+  /**************
+   * DESTRUCTOR *
+   **************/
+
+
+  //! Destructor.
+  /*! The arrays are released by their own destructors. */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SellSparse<T, Prop, Storage, Allocator>::~Matrix_SellSparse()
+  {
+    this->m_ = 0;
+    this->n_ = 0;
+    this->data_ = NULL;
+    nz_ = 0;
+  }
+
+
+  //! Clears the matrix.
+  /*! On exit, the matrix is empty (0x0). The chunk size and the sorting
+    scope are kept.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_SellSparse<T, Prop, Storage, Allocator>::Clear()
+  {
+    this->m_ = 0;
+    this->n_ = 0;
+    this->data_ = NULL;
+    nz_ = 0;
+    chunk_ptr_.Clear();
+    ind_.Clear();
+    val_.Clear();
+    perm_.Clear();
+    perm_inv_.Clear();
+  }
+
+
+  /*********************
+   * MEMORY MANAGEMENT *
+   *********************/
+
+
+  //! Redefines the matrix.
+  /*! It clears the matrix and sets it to a new matrix defined by the arrays
+    of the SELL-C-sigma format, in which the chunks contain
+    GetChunkSize() rows. Input vectors are released and are empty on exit.
+    \param i number of rows.
+    \param j number of columns.
+    \param nz number of non-zero entries (padding excluded).
+    \param values values of the stored entries, padding included.
+    \param chunk_ptr start indices of the chunks (of length the number of
+    chunks plus one).
+    \param ind column indices of the stored entries.
+    \param perm row (in the matrix) of each stored row.
+    \warning Input vectors 'values', 'chunk_ptr', 'ind' and 'perm' are empty
+    on exit.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_SellSparse<T, Prop, Storage, Allocator>::
+  SetData(int i, int j, int nz, Vector<T, VectFull, Allocator>& values,
+	  Vector<int>& chunk_ptr, Vector<int>& ind, Vector<int>& perm)
+  {
+    int nb_chunk = (i + chunk_size_ - 1) / chunk_size_;
+
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (chunk_ptr.GetM() != nb_chunk + 1)
+      throw WrongDim(string("Matrix_SellSparse::SetData(int, int, int, ")
+		     + "Vector&, Vector&, Vector&, Vector&)",
+		     string("The vector of start indices contains ")
+		     + to_str(chunk_ptr.GetM()) + " indices, but there are "
+		     + to_str(nb_chunk) + " chunks of "
+		     + to_str(chunk_size_) + " rows (plus the number of "
+		     + "stored entries) in a matrix with " + to_str(i)
+		     + " rows.");
+
+    if (values.GetM() != chunk_ptr(nb_chunk) || ind.GetM() != values.GetM())
+      throw WrongDim(string("Matrix_SellSparse::SetData(int, int, int, ")
+		     + "Vector&, Vector&, Vector&, Vector&)",
+		     string("There are ") + to_str(values.GetM())
+		     + " values and " + to_str(ind.GetM())
+		     + " column indices, but the chunks contain "
+		     + to_str(chunk_ptr(nb_chunk)) + " entries.");
+
+    if (perm.GetM() != i)
+      throw WrongDim(string("Matrix_SellSparse::SetData(int, int, int, ")
+		     + "Vector&, Vector&, Vector&, Vector&)",
+		     string("The permutation has ") + to_str(perm.GetM())
+		     + " entries, but the matrix has " + to_str(i)
+		     + " rows.");
+#endif
+
+    Clear();
+    this->m_ = i;
+    this->n_ = j;
+    nz_ = nz;
+
+    val_.SetData(values.GetM(), values.GetData());
+    values.Nullify();
+    chunk_ptr_.SetData(chunk_ptr.GetM(), chunk_ptr.GetData());
+    chunk_ptr.Nullify();
+    ind_.SetData(ind.GetM(), ind.GetData());
+    ind.Nullify();
+    perm_.SetData(perm.GetM(), perm.GetData());
+    perm.Nullify();
+
+    perm_inv_.Reallocate(i);
+    for (int k = 0; k < i; k++)
+      perm_inv_(perm_(k)) = k;
+
+    this->data_ = val_.GetData();
+  }
+
+
+  //! Reallocates memory to resize the matrix.
+  /*!
+    On exit, the matrix is a i x j matrix without non-zero entries.
+    \param i new number of rows.
+    \param j new number of columns.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_SellSparse<T, Prop, Storage, Allocator>::
+  Reallocate(int i, int j)
+  {
+    Vector<T, VectFull, Allocator> values;
+    Vector<int> chunk_ptr((i + chunk_size_ - 1) / chunk_size_ + 1), ind;
+    chunk_ptr.Zero();
+    Vector<int> perm(i);
+    perm.Fill();
+
+    SetData(i, j, 0, values, chunk_ptr, ind, perm);
+  }
+
+
+  //! Copies a matrix.
+  /*!
+    \param[in] A matrix to be copied (with its chunk size and sorting scope).
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_SellSparse<T, Prop, Storage, Allocator>::
+  Copy(const Matrix_SellSparse<T, Prop, Storage, Allocator>& A)
+  {
+    this->m_ = A.m_;
+    this->n_ = A.n_;
+    nz_ = A.nz_;
+    chunk_size_ = A.chunk_size_;
+    sorting_scope_ = A.sorting_scope_;
+    chunk_ptr_ = A.chunk_ptr_;
+    ind_ = A.ind_;
+    val_ = A.val_;
+    perm_ = A.perm_;
+    perm_inv_ = A.perm_inv_;
+    this->data_ = val_.GetData();
+  }
+
+
+  /*******************
+   * BASIC FUNCTIONS *
+   *******************/
+
+
+  //! Returns the number of non-zero entries.
+  /*!
+    \return The number of non-zero entries, padding excluded.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetNonZeros() const
+  {
+    return nz_;
+  }
+
+
+  //! Returns the number of elements stored in memory.
+  /*!
+    \return The number of elements stored in memory, padding included.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetDataSize() const
+  {
+    return val_.GetM();
+  }
+
+
+  //! Returns the number of rows in a chunk.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetChunkSize() const
+  {
+    return chunk_size_;
+  }
+
+
+  //! Returns the number of rows in the windows where rows are sorted.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetSortingScope() const
+  {
+    return sorting_scope_;
+  }
+
+
+  //! Returns the number of chunks.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetNbChunks() const
+  {
+    return chunk_ptr_.GetM() - 1;
+  }
+
+
+  //! Returns (a pointer to) the start indices of the chunks.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int* Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetChunkPtr() const
+  {
+    return chunk_ptr_.GetData();
+  }
+
+
+  //! Returns (a pointer to) the column indices of the stored entries.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int* Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetInd() const
+  {
+    return ind_.GetData();
+  }
+
+
+  //! Returns (a pointer to) the row in the matrix of each stored row.
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int* Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::GetPermutation() const
+  {
+    return perm_.GetData();
+  }
+
+
+  //! Sets the number of rows in a chunk.
+  /*! It is taken into account by the next conversion to this matrix, and
+    should be a multiple of the number of entries in a vector register.
+    \param[in] chunk_size number of rows in a chunk.
+    \warning The matrix is cleared.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::SetChunkSize(int chunk_size)
+  {
+#ifdef SELDON_CHECK_BOUNDS
+    if (chunk_size <= 0)
+      throw WrongArgument("Matrix_SellSparse::SetChunkSize(int)",
+			  string("The chunk size should be positive, but is ")
+			  + "equal to " + to_str(chunk_size) + ".");
+#endif
+
+    Clear();
+    chunk_size_ = chunk_size;
+  }
+
+
+  //! Sets the number of rows in the windows where rows are sorted.
+  /*! It is taken into account by the next conversion to this matrix. A
+    scope of 1 disables the sorting.
+    \param[in] sorting_scope number of rows of the windows where rows are
+    sorted by decreasing length.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::SetSortingScope(int sorting_scope)
+  {
+    sorting_scope_ = sorting_scope;
+  }
+
+
+  /**********************************
+   * ELEMENT ACCESS AND AFFECTATION *
+   **********************************/
+
+
+  //! Access operator.
+  /*!
+    Returns the value of element (i, j).
+    \param i row index.
+    \param j column index.
+    \return Element (i, j) of the matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline typename Matrix_SellSparse<T, Prop, Storage, Allocator>::value_type
+  Matrix_SellSparse<T, Prop, Storage, Allocator>::operator() (int i,
+							       int j) const
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= this->m_)
+      throw WrongRow("Matrix_SellSparse::operator()",
+		     string("Index should be in [0, ") + to_str(this->m_-1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= this->n_)
+      throw WrongCol("Matrix_SellSparse::operator()",
+		     string("Index should be in [0, ") + to_str(this->n_-1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    int row = perm_inv_(i);
+    int chunk = row / chunk_size_;
+
+    // Padded entries are zeros, so that they can be summed too.
+    T value(0);
+    for (int k = chunk_ptr_(chunk) + row % chunk_size_;
+	 k < chunk_ptr_(chunk + 1); k += chunk_size_)
+      if (ind_(k) == j)
+	value += val_(k);
+
+    return value;
+  }
+
+
+  //! Duplicates a matrix (assignment operator).
+  /*!
+    \param A matrix to be copied.
+    \note Memory is duplicated: 'A' is therefore independent from the current
+    instance after the copy.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SellSparse<T, Prop, Storage, Allocator>&
+  Matrix_SellSparse<T, Prop, Storage, Allocator>
+  ::operator= (const Matrix_SellSparse<T, Prop, Storage, Allocator>& A)
+  {
+    this->Copy(A);
+
+    return *this;
+  }
+
+
+  /************************
+   * CONVENIENT FUNCTIONS *
+   ************************/
+
+
+  //! Displays the matrix on the standard output.
+  /*!
+    Displays elements on the standard output, in text format.
+    Each row is displayed on a single line and elements of
+    a row are delimited by tabulations.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_SellSparse<T, Prop, Storage, Allocator>::Print() const
+  {
+    for (int i = 0; i < this->m_; i++)
+      {
+	for (int j = 0; j < this->n_; j++)
+	  cout << (*this)(i, j) << "\t";
+	cout << endl;
+      }
+  }
+
+
+  ///////////////////////////
+  // MATRIX<ROWSELLSPARSE> //
+  ///////////////////////////
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 matrix.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, RowSellSparse, Allocator>::Matrix():
+    Matrix_SellSparse<T, Prop, RowSellSparse, Allocator>()
+  {
+  }
+
+
+  //! Constructor.
+  /*! Builds a i by j matrix without non-zero entries.
+    \param i number of rows.
+    \param j number of columns.
+  */
+  template <class T, class Prop, class Allocator>
+  inline Matrix<T, Prop, RowSellSparse, Allocator>::Matrix(int i, int j):
+    Matrix_SellSparse<T, Prop, RowSellSparse, Allocator>(i, j)
+  {
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_MATRIX_SELL_SPARSE_CXX
+#endif
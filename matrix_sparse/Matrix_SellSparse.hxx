@@ -0,0 +1,145 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_MATRIX_SELL_SPARSE_HXX
+
+namespace Seldon
+{
+
+
+  //! Sparse-matrix class in the sliced ELLPACK format (SELL-C-sigma).
+  /*!
+    The rows are grouped in chunks of C consecutive rows. Within each window
+    of sigma rows, the rows are first sorted by decreasing number of non-zero
+    entries, so that the rows of a chunk have similar lengths. Each chunk is
+    then stored as a dense C by w block, where w is the length of the longest
+    row of the chunk; shorter rows are padded with zeros. The blocks are
+    stored column by column: the k-th entries of the C rows of a chunk are
+    contiguous, which enables the matrix-vector product to process the C rows
+    simultaneously with vector instructions.
+
+    Sparse matrices in this format are defined by: (1) the number of rows and
+    columns; (2) the chunk size C and the sorting scope sigma; (3) an array
+    'chunk_ptr_' of start indices of the chunks; (4) an array 'ind_' of
+    column indices of the stored entries (padding included); (5) values of
+    the stored entries; (6) the permutation 'perm_' which gives the row (in
+    the matrix) of each stored row.
+  */
+  template <class T, class Prop, class Storage,
+	    class Allocator = SELDON_DEFAULT_ALLOCATOR<T> >
+  class Matrix_SellSparse: public Matrix_Base<T, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef typename Allocator::pointer pointer;
+    typedef typename Allocator::const_pointer const_pointer;
+    typedef typename Allocator::reference reference;
+    typedef typename Allocator::const_reference const_reference;
+    typedef value_type entry_type;
+    typedef value_type access_type;
+    typedef value_type const_access_type;
+
+    // Attributes.
+  protected:
+    // Number of non-zero entries (padding excluded).
+    int nz_;
+    // Number of rows in a chunk.
+    int chunk_size_;
+    // Number of rows in the windows where rows are sorted.
+    int sorting_scope_;
+    // Index (in data_) of first element stored for each chunk.
+    Vector<int> chunk_ptr_;
+    // Column index of each stored element.
+    Vector<int> ind_;
+    // Values of the stored elements.
+    Vector<T, VectFull, Allocator> val_;
+    // Row (in the matrix) of each stored row.
+    Vector<int> perm_;
+    // Stored row of each row of the matrix.
+    Vector<int> perm_inv_;
+
+    // Methods.
+  public:
+    // Constructors.
+    Matrix_SellSparse();
+    Matrix_SellSparse(int i, int j);
+    Matrix_SellSparse(const Matrix_SellSparse<T, Prop, Storage,
+		      Allocator>& A);
+
+    // Destructor.
+    ~Matrix_SellSparse();
+    void Clear();
+
+    // Memory management.
+    void SetData(int i, int j, int nz,
+		 Vector<T, VectFull, Allocator>& values,
+		 Vector<int>& chunk_ptr, Vector<int>& ind,
+		 Vector<int>& perm);
+    void Reallocate(int i, int j);
+    void Copy(const Matrix_SellSparse<T, Prop, Storage, Allocator>& A);
+
+    // Basic methods.
+    int GetNonZeros() const;
+    int GetDataSize() const;
+    int GetChunkSize() const;
+    int GetSortingScope() const;
+    int GetNbChunks() const;
+    int* GetChunkPtr() const;
+    int* GetInd() const;
+    int* GetPermutation() const;
+    void SetChunkSize(int chunk_size);
+    void SetSortingScope(int sorting_scope);
+
+    // Element access.
+    value_type operator() (int i, int j) const;
+#ifndef SWIG
+    Matrix_SellSparse<T, Prop, Storage, Allocator>&
+    operator= (const Matrix_SellSparse<T, Prop, Storage, Allocator>& A);
+#endif
+
+    // Convenient functions.
+    void Print() const;
+  };
+
+
+  //! Row-major sparse-matrix class in the SELL-C-sigma format.
+  template <class T, class Prop, class Allocator>
+  class Matrix<T, Prop, RowSellSparse, Allocator>:
+    public Matrix_SellSparse<T, Prop, RowSellSparse, Allocator>
+  {
+    // typedef declaration.
+  public:
+    typedef typename Allocator::value_type value_type;
+    typedef Prop property;
+    typedef RowSellSparse storage;
+    typedef Allocator allocator;
+
+  public:
+    Matrix();
+    Matrix(int i, int j);
+  };
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_MATRIX_SELL_SPARSE_HXX
+#endif
@@ -47,6 +47,8 @@ namespace Seldon
     nz_ = 0;
     ptr_ = NULL;
     ind_ = NULL;
+    assembling_ = false;
+    nb_buffered_ = 0;
   }
 
 
@@ -64,6 +66,8 @@ namespace Seldon
     nz_ = 0;
     ptr_ = NULL;
     ind_ = NULL;
+    assembling_ = false;
+    nb_buffered_ = 0;
 
     Reallocate(i, j);
   }
@@ -85,6 +89,8 @@ namespace Seldon
     this->nz_ = 0;
     ind_ = NULL;
     ptr_ = NULL;
+    assembling_ = false;
+    nb_buffered_ = 0;
 
     Reallocate(i, j, nz);
   }
@@ -114,6 +120,8 @@ namespace Seldon
     Matrix_Base<T, Allocator>(i, j)
   {
     nz_ = values.GetLength();
+    assembling_ = false;
+    nb_buffered_ = 0;
 
 #ifdef SELDON_CHECK_DIMENSIONS
     // Checks whether vector sizes are acceptable.
@@ -192,10 +200,32 @@ namespace Seldon
     this->nz_ = 0;
     ptr_ = NULL;
     ind_ = NULL;
+    assembling_ = false;
+    nb_buffered_ = 0;
     this->Copy(A);
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The arrays of \a A are taken over, without any copy.
+    \param A matrix to be moved. On exit, it is empty.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_Sparse<T, Prop, Storage, Allocator>::
+  Matrix_Sparse(Matrix_Sparse<T, Prop, Storage, Allocator>&& A) noexcept:
+    Matrix_Base<T, Allocator>()
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+    assembling_ = false;
+    nb_buffered_ = 0;
+    Swap(A);
+  }
+#endif
+
+
   /**************
    * DESTRUCTOR *
    **************/
@@ -204,6 +234,17 @@ namespace Seldon
   //! Destructor.
   template <class T, class Prop, class Storage, class Allocator>
   inline Matrix_Sparse<T, Prop, Storage, Allocator>::~Matrix_Sparse()
+  {
+    Clear();
+  }
+
+
+  //! Clears the matrix.
+  /*! This methods is equivalent to the destructor. On exit, the matrix
+    is empty (0x0), and the entries buffered in assembly mode are removed.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Sparse<T, Prop, Storage, Allocator>::Clear()
   {
     this->m_ = 0;
     this->n_ = 0;
@@ -267,17 +308,11 @@ namespace Seldon
 #endif
 
     this->nz_ = 0;
-  }
-
-
-  //! Clears the matrix.
-  /*! This methods is equivalent to the destructor. On exit, the matrix
-    is empty (0x0).
-  */
-  template <class T, class Prop, class Storage, class Allocator>
-  inline void Matrix_Sparse<T, Prop, Storage, Allocator>::Clear()
-  {
-    this->~Matrix_Sparse();
+    assembling_ = false;
+    nb_buffered_ = 0;
+    buffer_first_.Clear();
+    buffer_second_.Clear();
+    buffer_val_.Clear();
   }
 
 
@@ -429,6 +464,28 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the arrays are exchanged,
+    together with the insertion buffers.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Sparse<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_Sparse<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+    swap(nz_, A.nz_);
+    swap(ptr_, A.ptr_);
+    swap(ind_, A.ind_);
+    swap(assembling_, A.assembling_);
+    swap(nb_buffered_, A.nb_buffered_);
+    buffer_first_.Swap(A.buffer_first_);
+    buffer_second_.Swap(A.buffer_second_);
+    buffer_val_.Swap(A.buffer_val_);
+  }
+
+
   //! Initialization of an empty sparse matrix with i rows and j columns
   /*!
     \param i number of rows
@@ -814,6 +871,14 @@ namespace Seldon
     this->nz_ = nz;
     this->m_ = i;
     this->n_ = j;
+    assembling_ = A.assembling_;
+    nb_buffered_ = A.nb_buffered_;
+    if (nb_buffered_ > 0)
+      {
+	buffer_first_ = A.buffer_first_;
+	buffer_second_ = A.buffer_second_;
+	buffer_val_ = A.buffer_val_;
+      }
     if ((i == 0)||(j == 0))
       {
 	this->m_ = 0;
@@ -1269,7 +1334,10 @@ namespace Seldon
   //! Add a value to a non-zero entry.
   /*! This function adds \a val to the element (\a i, \a j), provided that
     this element is already a non-zero entry. Otherwise
-    a non-zero entry is inserted equal to \a val.
+    a non-zero entry is inserted equal to \a val. Inserting an entry shifts
+    all the following entries; in assembly mode (see BeginAssembly), the new
+    entry is appended to the insertion buffer instead, in constant amortized
+    time.
     \param[in] i row index.
     \param[in] j column index.
     \param[in] val value to be added to the element (\a i, \a j).
@@ -1278,7 +1346,49 @@ namespace Seldon
   inline void Matrix_Sparse<T, Prop, Storage, Allocator>
   ::AddInteraction(int i, int j, const T& val)
   {
-    Get(i, j) += val;
+    if (!assembling_)
+      {
+        Get(i, j) += val;
+        return;
+      }
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= this->m_)
+      throw WrongRow("Matrix_Sparse::AddInteraction(int, int, T)",
+		     string("Index should be in [0, ") + to_str(this->m_-1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= this->n_)
+      throw WrongCol("Matrix_Sparse::AddInteraction(int, int, T)",
+		     string("Index should be in [0, ") + to_str(this->n_-1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    int first = Storage::GetFirst(i, j);
+    int second = Storage::GetSecond(i, j);
+
+    // The entry may already be stored in the matrix.
+    int k, b = ptr_[first + 1];
+    for (k = ptr_[first]; (k < b) && (ind_[k] < second); k++);
+    if ((k < b) && (ind_[k] == second))
+      {
+        this->data_[k] += val;
+        return;
+      }
+
+    // Otherwise, it is appended to the insertion buffer, whose size is
+    // doubled when it is full.
+    if (nb_buffered_ == buffer_val_.GetM())
+      {
+        int new_size = max(2 * nb_buffered_, 16);
+        buffer_first_.Resize(new_size);
+        buffer_second_.Resize(new_size);
+        buffer_val_.Resize(new_size);
+      }
+
+    buffer_first_(nb_buffered_) = first;
+    buffer_second_(nb_buffered_) = second;
+    buffer_val_(nb_buffered_) = val;
+    nb_buffered_++;
   }
 
 
@@ -1296,6 +1406,299 @@ namespace Seldon
   }
 
 
+  //! Enters the assembly mode.
+  /*! In assembly mode, the entries added with AddInteraction which are not
+    already non-zero entries are not inserted in the matrix immediately
+    (which would shift all the following entries), but appended to an
+    insertion buffer. The buffer is merged with the matrix by Assemble or
+    EndAssembly, in a time proportional to the number of non-zero entries
+    plus the cost of sorting the buffered entries within each row (or
+    column). The assembly of a matrix entry by entry therefore costs a
+    constant amortized time per entry, instead of a time proportional to the
+    number of non-zero entries.
+    \warning The entries of the insertion buffer are ignored by all other
+    methods and functions, until Assemble or EndAssembly is called.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Sparse<T, Prop, Storage, Allocator>::BeginAssembly()
+  {
+    assembling_ = true;
+  }
+
+
+  //! Merges the insertion buffer with the matrix.
+  /*! The entries of the insertion buffer are inserted in the matrix, and the
+    values of duplicate entries are added. On exit, the insertion buffer is
+    empty, and the matrix remains in assembly mode if it was.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  void Matrix_Sparse<T, Prop, Storage, Allocator>::Assemble()
+  {
+    if (nb_buffered_ == 0)
+      return;
+
+    int m = this->m_;
+    int n = this->n_;
+    int n_first = Storage::GetFirst(m, n);
+
+    // The buffered entries are sorted by row (or column) with a counting
+    // sort, and then by column (or row) within each row (or column).
+    Vector<int> buffer_ptr(n_first + 1);
+    buffer_ptr.Zero();
+    int p, q;
+    for (p = 0; p < nb_buffered_; p++)
+      buffer_ptr(buffer_first_(p) + 1)++;
+    for (q = 0; q < n_first; q++)
+      buffer_ptr(q + 1) += buffer_ptr(q);
+
+    Vector<int> position(buffer_ptr), second(nb_buffered_);
+    Vector<T, VectFull, Allocator> value(nb_buffered_);
+    for (p = 0; p < nb_buffered_; p++)
+      {
+        q = position(buffer_first_(p))++;
+        second(q) = buffer_second_(p);
+        value(q) = buffer_val_(p);
+      }
+    position.Clear();
+
+    nb_buffered_ = 0;
+    buffer_first_.Clear();
+    buffer_second_.Clear();
+    buffer_val_.Clear();
+
+    for (q = 0; q < n_first; q++)
+      if (buffer_ptr(q + 1) - buffer_ptr(q) > 1)
+        Sort(buffer_ptr(q), buffer_ptr(q + 1) - 1, second, value);
+
+    // Merges the buffered entries with the stored entries, row by row (or
+    // column by column).
+    Vector<int, VectFull, CallocAlloc<int> > ptr(n_first + 1),
+      ind(nz_ + second.GetM());
+    Vector<T, VectFull, Allocator> val(nz_ + second.GetM());
+    int k, b, nz = 0;
+    ptr(0) = 0;
+    for (q = 0; q < n_first; q++)
+      {
+        k = ptr_[q];
+        b = ptr_[q + 1];
+        p = buffer_ptr(q);
+        while (k < b || p < buffer_ptr(q + 1))
+          {
+            if (p == buffer_ptr(q + 1) || (k < b && ind_[k] <= second(p)))
+              {
+                ind(nz) = ind_[k];
+                val(nz) = this->data_[k];
+                k++;
+              }
+            else
+              {
+                ind(nz) = second(p);
+                val(nz) = value(p);
+                p++;
+              }
+
+            // Duplicate entries are added.
+            while (p < buffer_ptr(q + 1) && second(p) == ind(nz))
+              val(nz) += value(p++);
+
+            nz++;
+          }
+        ptr(q + 1) = nz;
+      }
+
+    ind.Resize(nz);
+    val.Resize(nz);
+
+    bool assembling = assembling_;
+    SetData(m, n, val, ptr, ind);
+    assembling_ = assembling;
+  }
+
+
+  //! Merges the insertion buffer with the matrix and leaves assembly mode.
+  /*! On exit, new entries are inserted directly in the matrix again.
+    \sa BeginAssembly, Assemble
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Sparse<T, Prop, Storage, Allocator>::EndAssembly()
+  {
+    Assemble();
+    assembling_ = false;
+  }
+
+
+  //! Returns true if the matrix is in assembly mode.
+  /*!
+    \return True if new entries added with AddInteraction are stored in the
+    insertion buffer.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline bool Matrix_Sparse<T, Prop, Storage, Allocator>::IsAssembling() const
+  {
+    return assembling_;
+  }
+
+
+  //! Returns the number of entries in the insertion buffer.
+  /*!
+    \return The number of entries waiting to be merged with the matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline int Matrix_Sparse<T, Prop, Storage, Allocator>::GetBufferSize() const
+  {
+    return nb_buffered_;
+  }
+
+
+  //! Returns the position of an entry in the array of values.
+  /*!
+    \param[in] i row index.
+    \param[in] j column index.
+    \return The index in the array of values (see GetData) of the element
+    (\a i, \a j), or -1 if this element is not stored in the matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  int Matrix_Sparse<T, Prop, Storage, Allocator>
+  ::GetPosition(int i, int j) const
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= this->m_)
+      throw WrongRow("Matrix_Sparse::GetPosition(int, int)",
+		     string("Index should be in [0, ") + to_str(this->m_-1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= this->n_)
+      throw WrongCol("Matrix_Sparse::GetPosition(int, int)",
+		     string("Index should be in [0, ") + to_str(this->n_-1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+    // Binary search among the sorted indices of the row (or column).
+    int l = Storage::GetSecond(i, j);
+    int a = ptr_[Storage::GetFirst(i, j)];
+    int b = ptr_[Storage::GetFirst(i, j) + 1];
+    int k;
+    while (a < b)
+      {
+	k = a + (b - a) / 2;
+	if (ind_[k] < l)
+	  a = k + 1;
+	else
+	  b = k;
+      }
+
+    if (a < ptr_[Storage::GetFirst(i, j) + 1] && ind_[a] == l)
+      return a;
+    return -1;
+  }
+
+
+  //! Computes the positions of the entries of elementary matrices.
+  /*! The elementary matrix of element e is the dense matrix of the entries
+    (dof(e, a), dof(e, b)) of the global matrix, for all local degrees of
+    freedom a and b. Once their positions are computed, the elementary
+    matrices may be added by several threads with AddValueAtomic, without
+    any search.
+    \param[in] dof global degrees of freedom of the elements: dof(e, a) is
+    the row (and column) of the global matrix associated with the local
+    degree of freedom a of element e. A negative number denotes a degree of
+    freedom which is not in the matrix.
+    \param[out] position positions of the entries in the array of values:
+    position(e * nl * nl + a * nl + b), where nl is the number of local
+    degrees of freedom, is the position of the entry (dof(e, a), dof(e, b)),
+    or -1 if dof(e, a) or dof(e, b) is negative.
+    \throw WrongArgument if an entry is not stored in the matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  template <class Allocator0>
+  void Matrix_Sparse<T, Prop, Storage, Allocator>
+  ::GetElementPositions(const Matrix<int, General, RowMajor, Allocator0>& dof,
+			Vector<int>& position) const
+  {
+    int nb_element = dof.GetM();
+    int nl = dof.GetN();
+    position.Reallocate(nb_element * nl * nl);
+
+    int nb_missing = 0;
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(nb_element) * long(nl * nl));
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1) \
+  reduction(+:nb_missing)
+#endif
+    {
+      int begin, end, e, a, b, p;
+      GetThreadRange(nb_element, begin, end);
+      for (e = begin; e < end; e++)
+	for (a = 0; a < nl; a++)
+	  for (b = 0; b < nl; b++)
+	    {
+	      p = (e * nl + a) * nl + b;
+	      if (dof(e, a) < 0 || dof(e, b) < 0)
+		position(p) = -1;
+	      else
+		{
+		  position(p) = GetPosition(dof(e, a), dof(e, b));
+		  if (position(p) < 0)
+		    nb_missing++;
+		}
+	    }
+    }
+
+    if (nb_missing > 0)
+      throw WrongArgument("Matrix_Sparse::GetElementPositions(const Matrix&, "
+			  "Vector&)", to_str(nb_missing) + " entries of the "
+			  "elementary matrices are not stored in the matrix.");
+  }
+
+
+  //! Adds a value to an entry, atomically.
+  /*! The pattern of the matrix is not modified, so that several threads may
+    add values simultaneously. The order of the additions is not specified.
+    \param[in] i row index.
+    \param[in] j column index.
+    \param[in] val value to be added to the element (\a i, \a j).
+    \throw WrongArgument if the element (\a i, \a j) is not stored in the
+    matrix.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Sparse<T, Prop, Storage, Allocator>
+  ::AddInteractionAtomic(int i, int j, const T& val)
+  {
+    int k = GetPosition(i, j);
+    if (k < 0)
+      throw WrongArgument("Matrix_Sparse::AddInteractionAtomic(int, int, T)",
+			  "Element (" + to_str(i) + ", " + to_str(j)
+			  + ") is not stored in the matrix.");
+
+    AddAtomic(val, this->data_[k]);
+  }
+
+
+  //! Adds a value to an entry given by its position, atomically.
+  /*! Several threads may add values simultaneously. The order of the
+    additions is not specified.
+    \param[in] position index of the entry in the array of values (see
+    GetPosition and GetElementPositions). If it is negative, nothing is
+    done.
+    \param[in] val value to be added to the entry.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_Sparse<T, Prop, Storage, Allocator>
+  ::AddValueAtomic(int position, const T& val)
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (position >= nz_)
+      throw WrongIndex("Matrix_Sparse::AddValueAtomic(int, T)",
+		       string("Index should be lower than ") + to_str(nz_)
+		       + ", but is equal to " + to_str(position) + ".");
+#endif
+
+    if (position >= 0)
+      AddAtomic(val, this->data_[position]);
+  }
+
+
   //! Duplicates a matrix (assignment operator).
   /*!
     \param A matrix to be copied.
@@ -1313,6 +1716,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a matrix (move assignment operator).
+  /*!
+    \param A matrix to be moved. No element is copied: the arrays of \a A
+    and of the current instance are exchanged.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_Sparse<T, Prop, Storage, Allocator>&
+  Matrix_Sparse<T, Prop, Storage, Allocator>
+  ::operator= (Matrix_Sparse<T, Prop, Storage, Allocator>&& A) noexcept
+  {
+    Swap(A);
+
+    return *this;
+  }
+#endif
+
+
   /************************
    * CONVENIENT FUNCTIONS *
    ************************/
@@ -1323,8 +1744,16 @@ namespace Seldon
   template <class T, class Prop, class Storage, class Allocator>
   void Matrix_Sparse<T, Prop, Storage, Allocator>::Zero()
   {
-    this->allocator_.memoryset(this->data_, char(0),
-			       this->nz_ * sizeof(value_type));
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(nz_));
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int begin, end;
+      GetThreadRange(nz_, begin, end);
+      this->allocator_.memoryset(this->data_ + begin, char(0),
+				 (end - begin) * sizeof(value_type));
+    }
   }
 
 
@@ -1416,7 +1845,7 @@ namespace Seldon
       return;
 
     Vector<int> i(Nelement), j(Nelement);
-    Vector<T> value(Nelement);
+    Vector<T, VectFull, Allocator> value(Nelement);
 
     set<pair<int, int> > skeleton;
     set<pair<int, int> >::iterator it;
@@ -1463,7 +1892,7 @@ namespace Seldon
       return;
 
     Vector<int> i(Nelement), j(Nelement);
-    Vector<T> value(Nelement);
+    Vector<T, VectFull, Allocator> value(Nelement);
     value.Fill(x);
 
     srand(time(NULL));
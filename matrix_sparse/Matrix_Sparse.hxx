@@ -38,6 +38,16 @@ namespace Seldon
     (i.e. indices of the first element of each row or column, depending
     on the storage); (4) an array 'ind_' of column or row indices of each
     non-zero entry; (5) values of non-zero entries.
+
+    In assembly mode (see BeginAssembly), new entries added with
+    AddInteraction are stored in an insertion buffer, which is merged with
+    the matrix by Assemble or EndAssembly.
+
+    Once the pattern of the matrix is known, the values may be computed
+    again without modifying the pattern: after Zero, several threads may add
+    values simultaneously with AddInteractionAtomic or, faster, with
+    AddValueAtomic at positions computed once by GetPosition or
+    GetElementPositions.
   */
   template <class T, class Prop, class Storage,
 	    class Allocator = SELDON_DEFAULT_ALLOCATOR<T> >
@@ -62,6 +72,16 @@ namespace Seldon
     int* ptr_;
     // Column or row index (in the matrix) each element.
     int* ind_;
+    // Are new entries stored in the insertion buffer?
+    bool assembling_;
+    // Number of entries in the insertion buffer.
+    int nb_buffered_;
+    // Row or column index of each entry of the insertion buffer.
+    Vector<int> buffer_first_;
+    // Column or row index of each entry of the insertion buffer.
+    Vector<int> buffer_second_;
+    // Values of the entries of the insertion buffer.
+    Vector<T, VectFull, Allocator> buffer_val_;
 
     // Methods.
   public:
@@ -76,6 +96,9 @@ namespace Seldon
 		  Vector<int, Storage1, Allocator1>& ptr,
 		  Vector<int, Storage2, Allocator2>& ind);
     Matrix_Sparse(const Matrix_Sparse<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix_Sparse(Matrix_Sparse<T, Prop, Storage, Allocator>&& A) noexcept;
+#endif
 
     // Destructor.
     ~Matrix_Sparse();
@@ -91,6 +114,7 @@ namespace Seldon
 		 Vector<int, Storage2, Allocator2>& ind);
     void SetData(int i, int j, int nz, pointer values, int* ptr, int* ind);
     void Nullify();
+    void Swap(Matrix_Sparse<T, Prop, Storage, Allocator>& A);
     void Reallocate(int i, int j);
     void Reallocate(int i, int j, int nz);
     void Resize(int i, int j);
@@ -115,9 +139,24 @@ namespace Seldon
 #endif
     void AddInteraction(int i, int j, const T& val);
     void Set(int i, int j, const T& x);
+    void BeginAssembly();
+    void Assemble();
+    void EndAssembly();
+    bool IsAssembling() const;
+    int GetBufferSize() const;
+    int GetPosition(int i, int j) const;
+    template <class Allocator0>
+    void GetElementPositions(const Matrix<int, General, RowMajor, Allocator0>&
+			     dof, Vector<int>& position) const;
+    void AddInteractionAtomic(int i, int j, const T& val);
+    void AddValueAtomic(int position, const T& val);
 #ifndef SWIG
     Matrix_Sparse<T, Prop, Storage, Allocator>&
     operator= (const Matrix_Sparse<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix_Sparse<T, Prop, Storage, Allocator>&
+    operator= (Matrix_Sparse<T, Prop, Storage, Allocator>&& A) noexcept;
+#endif
 #endif
 
     // Convenient functions.
@@ -190,6 +190,23 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The arrays of \a A are taken over, without any copy.
+    \param A matrix to be moved. On exit, it is empty.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SymSparse<T, Prop, Storage, Allocator>::
+  Matrix_SymSparse(Matrix_SymSparse<T, Prop, Storage, Allocator>&& A) noexcept
+  {
+    nz_ = 0;
+    ptr_ = NULL;
+    ind_ = NULL;
+    Swap(A);
+  }
+#endif
+
+
   /**************
    * DESTRUCTOR *
    **************/
@@ -423,6 +440,22 @@ namespace Seldon
   }
 
 
+  //! Swaps the current matrix with another matrix.
+  /*!
+    No element is copied: only the dimensions and the arrays are exchanged.
+    \param A matrix to be swapped with the current instance.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline void Matrix_SymSparse<T, Prop, Storage, Allocator>
+  ::Swap(Matrix_SymSparse<T, Prop, Storage, Allocator>& A)
+  {
+    Matrix_Base<T, Allocator>::Swap(A);
+    swap(nz_, A.nz_);
+    swap(ptr_, A.ptr_);
+    swap(ind_, A.ind_);
+  }
+
+
   //! Initialization of an empty sparse matrix with i rows and j columns
   /*!
     \param i number of rows
@@ -1304,6 +1337,24 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a matrix (move assignment operator).
+  /*!
+    \param A matrix to be moved. No element is copied: the arrays of \a A
+    and of the current instance are exchanged.
+  */
+  template <class T, class Prop, class Storage, class Allocator>
+  inline Matrix_SymSparse<T, Prop, Storage, Allocator>&
+  Matrix_SymSparse<T, Prop, Storage, Allocator>
+  ::operator= (Matrix_SymSparse<T, Prop, Storage, Allocator>&& A) noexcept
+  {
+    Swap(A);
+
+    return *this;
+  }
+#endif
+
+
   /************************
    * CONVENIENT FUNCTIONS *
    ************************/
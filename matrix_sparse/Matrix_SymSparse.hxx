@@ -77,6 +77,10 @@ namespace Seldon
 		     Vector<int, Storage1, Allocator1>& ptr,
 		     Vector<int, Storage2, Allocator2>& ind);
     Matrix_SymSparse(const Matrix_SymSparse<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix_SymSparse(Matrix_SymSparse<T, Prop, Storage, Allocator>&& A)
+      noexcept;
+#endif
 
     // Destructor.
     ~Matrix_SymSparse();
@@ -92,6 +96,7 @@ namespace Seldon
 		 Vector<int, Storage2, Allocator2>& ind);
     void SetData(int i, int j, int nz, pointer values, int* ptr, int* ind);
     void Nullify();
+    void Swap(Matrix_SymSparse<T, Prop, Storage, Allocator>& A);
     void Reallocate(int i, int j);
     void Reallocate(int i, int j, int nz);
     void Resize(int i, int j);
@@ -116,6 +121,10 @@ namespace Seldon
     void AddInteraction(int i, int j, const T& x);
     Matrix_SymSparse<T, Prop, Storage, Allocator>&
     operator= (const Matrix_SymSparse<T, Prop, Storage, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Matrix_SymSparse<T, Prop, Storage, Allocator>&
+    operator= (Matrix_SymSparse<T, Prop, Storage, Allocator>&& A) noexcept;
+#endif
 
     // Convenient functions.
     void Zero();
@@ -0,0 +1,413 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_SPARSE_ASSEMBLER_CXX
+
+#include "SparseAssembler.hxx"
+
+
+namespace Seldon
+{
+
+
+  /****************
+   * CONSTRUCTORS *
+   ****************/
+
+
+  //! Default constructor.
+  /*!
+    Builds an empty 0x0 assembler.
+  */
+  template <class T, class Allocator>
+  inline SparseAssembler<T, Allocator>::SparseAssembler()
+  {
+    m_ = 0;
+    n_ = 0;
+  }
+
+
+  //! Main constructor.
+  /*!
+    Builds an assembler for an m x n matrix, with one empty buffer per
+    thread.
+    \param m number of rows.
+    \param n number of columns.
+  */
+  template <class T, class Allocator>
+  inline SparseAssembler<T, Allocator>::SparseAssembler(int m, int n)
+  {
+    Reallocate(m, n);
+  }
+
+
+  /*********************
+   * MEMORY MANAGEMENT *
+   *********************/
+
+
+  //! Reallocates the assembler.
+  /*!
+    The entries added previously are removed, and one empty buffer is
+    allocated for each thread that may add entries, that is, for the number
+    of threads returned by 'GetNumberThreads()' or by the OpenMP function
+    'omp_get_max_threads()', whichever is larger.
+    \param m new number of rows.
+    \param n new number of columns.
+  */
+  template <class T, class Allocator>
+  void SparseAssembler<T, Allocator>::Reallocate(int m, int n)
+  {
+    m_ = m;
+    n_ = n;
+
+    int nb_buffer = GetNumberThreads();
+#ifdef SELDON_WITH_OPENMP
+    nb_buffer = max(nb_buffer, omp_get_max_threads());
+#endif
+    buffer_.Clear();
+    buffer_.Reallocate(nb_buffer);
+    shared_.row_.Clear();
+    shared_.col_.Clear();
+    shared_.val_.Clear();
+  }
+
+
+  //! Clears the assembler.
+  /*!
+    The entries and the buffers are removed, and the assembler is empty
+    (0x0).
+  */
+  template <class T, class Allocator>
+  inline void SparseAssembler<T, Allocator>::Clear()
+  {
+    m_ = 0;
+    n_ = 0;
+    buffer_.Clear();
+    shared_.row_.Clear();
+    shared_.col_.Clear();
+    shared_.val_.Clear();
+  }
+
+
+  //! Reserves memory in the buffers.
+  /*!
+    \param nnz number of entries that each thread is expected to add.
+  */
+  template <class T, class Allocator>
+  void SparseAssembler<T, Allocator>::Reserve(int nnz)
+  {
+    for (int t = 0; t < buffer_.GetM(); t++)
+      {
+	buffer_(t).row_.Reserve(nnz);
+	buffer_(t).col_.Reserve(nnz);
+	buffer_(t).val_.Reserve(nnz);
+      }
+  }
+
+
+  /*****************
+   * BASIC METHODS *
+   *****************/
+
+
+  //! Returns the number of rows.
+  /*!
+    \return The number of rows.
+  */
+  template <class T, class Allocator>
+  inline int SparseAssembler<T, Allocator>::GetM() const
+  {
+    return m_;
+  }
+
+
+  //! Returns the number of columns.
+  /*!
+    \return The number of columns.
+  */
+  template <class T, class Allocator>
+  inline int SparseAssembler<T, Allocator>::GetN() const
+  {
+    return n_;
+  }
+
+
+  //! Returns the number of entries added since the last assembly.
+  /*!
+    \return The number of entries stored in the buffers, duplicates
+    included.
+  */
+  template <class T, class Allocator>
+  int SparseAssembler<T, Allocator>::GetNonZeros() const
+  {
+    int nnz = 0;
+    for (int t = 0; t < buffer_.GetM(); t++)
+      nnz += buffer_(t).val_.GetM();
+    return nnz + shared_.val_.GetM();
+  }
+
+
+  //! Returns the number of buffers.
+  /*!
+    \return The number of buffers, i.e., the maximal number of threads that
+    may add entries simultaneously. The shared buffer is not counted.
+  */
+  template <class T, class Allocator>
+  inline int SparseAssembler<T, Allocator>::GetNbBuffers() const
+  {
+    return buffer_.GetM();
+  }
+
+
+  /*************
+   * INSERTION *
+   *************/
+
+
+  //! Adds an entry.
+  /*!
+    The entry is stored in the buffer of the current thread, or in the
+    shared buffer if the thread has no buffer or if it is in a nested
+    parallel region. It may be called simultaneously by all threads of a
+    parallel region.
+    \param[in] i row number.
+    \param[in] j column number.
+    \param[in] val value to be added to A(i, j).
+  */
+  template <class T, class Allocator>
+  inline void SparseAssembler<T, Allocator>
+  ::AddInteraction(int i, int j, const T& val)
+  {
+    int thread = GetThreadNumber();
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= m_)
+      throw WrongRow("SparseAssembler::AddInteraction(int, int, T)",
+		     string("Index should be in [0, ") + to_str(m_-1)
+		     + "], but is equal to " + to_str(i) + ".");
+    if (j < 0 || j >= n_)
+      throw WrongCol("SparseAssembler::AddInteraction(int, int, T)",
+		     string("Index should be in [0, ") + to_str(n_-1)
+		     + "], but is equal to " + to_str(j) + ".");
+#endif
+
+#ifdef SELDON_WITH_OPENMP
+    if (thread >= buffer_.GetM() || omp_get_active_level() > 1)
+      {
+	AddShared(i, j, val);
+	return;
+      }
+#endif
+
+    SparseAssemblerBuffer<T, Allocator>& buffer = buffer_(thread);
+    buffer.row_.PushBack(i);
+    buffer.col_.PushBack(j);
+    buffer.val_.PushBack(val);
+  }
+
+
+  //! Adds an entry to the shared buffer.
+  /*!
+    The threads add their entries one at a time.
+    \param[in] i row number.
+    \param[in] j column number.
+    \param[in] val value to be added to A(i, j).
+  */
+  template <class T, class Allocator>
+  void SparseAssembler<T, Allocator>::AddShared(int i, int j, const T& val)
+  {
+#ifdef SELDON_WITH_OPENMP
+#pragma omp critical(SeldonSparseAssemblerShared)
+#endif
+    {
+      shared_.row_.PushBack(i);
+      shared_.col_.PushBack(j);
+      shared_.val_.PushBack(val);
+    }
+  }
+
+
+  //! Adds coefficients in a row.
+  /*!
+    The entries are stored in the buffer of the current thread. It may be
+    called simultaneously by all threads of a parallel region.
+    \param[in] i row number.
+    \param[in] nb number of coefficients to add.
+    \param[in] col column numbers of coefficients.
+    \param[in] val values of coefficients.
+  */
+  template <class T, class Allocator> template <class Alloc1>
+  void SparseAssembler<T, Allocator>
+  ::AddInteractionRow(int i, int nb, const Vector<int>& col,
+		      const Vector<T, VectFull, Alloc1>& val)
+  {
+    for (int k = 0; k < nb; k++)
+      AddInteraction(i, col(k), val(k));
+  }
+
+
+  /************
+   * ASSEMBLY *
+   ************/
+
+
+  //! Assembles the entries into a RowSparse matrix.
+  /*!
+    The buffers are merged, and the duplicate entries are added (see
+    CompressCoordinates). The buffers are emptied, but keep their memory, so
+    that the assembler can be used for a new matrix of the same dimensions
+    without reallocation.
+    \param[out] A assembled matrix, of the dimensions of the assembler.
+  */
+  template <class T, class Allocator> template <class Prop>
+  void SparseAssembler<T, Allocator>
+  ::Assemble(Matrix<T, Prop, RowSparse, Allocator>& A)
+  {
+    Vector<int> IndRow, IndCol;
+    Vector<T, VectFull, Allocator> Val;
+    Gather(false, IndRow, IndCol, Val);
+
+    int m = m_, n = n_;
+    Vector<int, VectFull, CallocAlloc<int> > Ptr, Ind;
+    CompressCoordinates(IndRow, IndCol, Val, 0, m, n, Ptr, Ind);
+
+    A.SetData(m, n, Val, Ptr, Ind);
+  }
+
+
+  //! Assembles the entries into a RowSymSparse matrix.
+  /*!
+    The entries of the lower part are ignored. The buffers are merged, and
+    the duplicate entries are added (see CompressCoordinates). The buffers
+    are emptied, but keep their memory, so that the assembler can be used for
+    a new matrix of the same dimensions without reallocation.
+    \param[out] A assembled matrix, of the dimensions of the assembler.
+  */
+  template <class T, class Allocator> template <class Prop>
+  void SparseAssembler<T, Allocator>
+  ::Assemble(Matrix<T, Prop, RowSymSparse, Allocator>& A)
+  {
+    Vector<int> IndRow, IndCol;
+    Vector<T, VectFull, Allocator> Val;
+    Gather(true, IndRow, IndCol, Val);
+
+    int m = m_, n = n_;
+    Vector<int, VectFull, CallocAlloc<int> > Ptr, Ind;
+    CompressCoordinates(IndRow, IndCol, Val, 0, m, n, Ptr, Ind);
+
+    A.SetData(m, n, Val, Ptr, Ind);
+  }
+
+
+  //! Returns a buffer.
+  /*!
+    \param[in] t buffer number, between 0 and GetNbBuffers().
+    \return The buffer of the thread \a t, or the shared buffer if \a t is
+    equal to GetNbBuffers().
+  */
+  template <class T, class Allocator>
+  inline SparseAssemblerBuffer<T, Allocator>&
+  SparseAssembler<T, Allocator>::GetBuffer(int t)
+  {
+    if (t < buffer_.GetM())
+      return buffer_(t);
+    return shared_;
+  }
+
+
+  //! Concatenates the buffers.
+  /*!
+    The buffers (the shared buffer last) are copied one after the other, in
+    parallel, and then emptied. Their memory is kept for the next assembly.
+    \param[in] upper true if only the entries of the upper part are kept.
+    \param[out] IndRow row indices of the entries.
+    \param[out] IndCol column indices of the entries.
+    \param[out] Val values of the entries.
+  */
+  template <class T, class Allocator>
+  void SparseAssembler<T, Allocator>
+  ::Gather(bool upper, Vector<int>& IndRow, Vector<int>& IndCol,
+	   Vector<T, VectFull, Allocator>& Val)
+  {
+    int nb_buffer = buffer_.GetM() + 1;
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(GetNonZeros()));
+#endif
+    Vector<int> offset(nb_buffer + 1);
+    offset.Zero();
+
+    // Number of entries kept in each buffer.
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int begin, end, t, k, nb;
+      GetThreadRange(nb_buffer, begin, end);
+      for (t = begin; t < end; t++)
+	if (upper)
+	  {
+	    const int* row = GetBuffer(t).row_.GetData();
+	    const int* col = GetBuffer(t).col_.GetData();
+	    nb = 0;
+	    for (k = 0; k < GetBuffer(t).row_.GetM(); k++)
+	      if (row[k] <= col[k])
+		nb++;
+	    offset(t + 1) = nb;
+	  }
+	else
+	  offset(t + 1) = GetBuffer(t).row_.GetM();
+    }
+
+    for (int t = 0; t < nb_buffer; t++)
+      offset(t + 1) += offset(t);
+    IndRow.Reallocate(offset(nb_buffer));
+    IndCol.Reallocate(offset(nb_buffer));
+    Val.Reallocate(offset(nb_buffer));
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int begin, end, t, k, p;
+      GetThreadRange(nb_buffer, begin, end);
+      for (t = begin; t < end; t++)
+	{
+	  SparseAssemblerBuffer<T, Allocator>& buffer = GetBuffer(t);
+	  p = offset(t);
+	  for (k = 0; k < buffer.row_.GetM(); k++)
+	    if (!upper || buffer.row_(k) <= buffer.col_(k))
+	      {
+		IndRow(p) = buffer.row_(k);
+		IndCol(p) = buffer.col_(k);
+		Val(p) = buffer.val_(k);
+		p++;
+	      }
+	  buffer.row_.Resize(0);
+	  buffer.col_.Resize(0);
+	  buffer.val_.Resize(0);
+	}
+    }
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_SPARSE_ASSEMBLER_CXX
+#endif
@@ -0,0 +1,125 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_SPARSE_ASSEMBLER_HXX
+
+namespace Seldon
+{
+
+
+  //! Entries added by one thread to a sparse assembler.
+  template <class T, class Allocator>
+  class SparseAssemblerBuffer
+  {
+  public:
+    // Row indices.
+    Vector<int> row_;
+    // Column indices.
+    Vector<int> col_;
+    // Values.
+    Vector<T, VectFull, Allocator> val_;
+    // Padding, so that the buffers of two threads are not in the same cache
+    // line.
+    char padding_[64];
+  };
+
+
+  //! Assembly of a sparse matrix by several threads.
+  /*!
+    Each thread adds its entries (with AddInteraction or AddInteractionRow)
+    to its own buffer of coordinates, so that the threads of a parallel
+    region may add entries simultaneously, without any synchronization. The
+    buffers are then merged into a RowSparse or RowSymSparse matrix by
+    Assemble, in parallel.
+
+    The number of buffers is set by Reallocate. A thread whose number is
+    beyond the buffers (e.g. in a region with more threads than
+    'omp_get_max_threads()' when the assembler was allocated) adds its
+    entries to a shared buffer, one thread at a time. Nested parallel
+    regions are not supported for concurrent insertion: since their thread
+    numbers repeat, the entries added from a nested region also go to the
+    shared buffer, one thread at a time.
+
+    Duplicate entries are added. Since the values of duplicates are added in
+    increasing order (see CompressCoordinates), the assembled matrix does
+    not depend on the number of threads, nor on the way the entries are
+    distributed among the threads.
+  */
+  template <class T, class Allocator = SELDON_DEFAULT_ALLOCATOR<T> >
+  class SparseAssembler
+  {
+    // typedef declaration.
+  public:
+    typedef T value_type;
+
+    // Attributes.
+  protected:
+    // Number of rows.
+    int m_;
+    // Number of columns.
+    int n_;
+    // Buffers of the threads.
+    Vector<SparseAssemblerBuffer<T, Allocator>, VectFull,
+	   NewAlloc<SparseAssemblerBuffer<T, Allocator> > > buffer_;
+    // Buffer shared by the threads that have no buffer of their own.
+    SparseAssemblerBuffer<T, Allocator> shared_;
+
+    // Methods.
+  public:
+    // Constructors.
+    SparseAssembler();
+    SparseAssembler(int m, int n);
+
+    // Memory management.
+    void Reallocate(int m, int n);
+    void Clear();
+    void Reserve(int nnz);
+
+    // Basic methods.
+    int GetM() const;
+    int GetN() const;
+    int GetNonZeros() const;
+    int GetNbBuffers() const;
+
+    // Insertion.
+    void AddInteraction(int i, int j, const T& val);
+    template<class Alloc1>
+    void AddInteractionRow(int i, int nb, const Vector<int>& col,
+			   const Vector<T, VectFull, Alloc1>& val);
+
+    // Assembly.
+    template<class Prop>
+    void Assemble(Matrix<T, Prop, RowSparse, Allocator>& A);
+    template<class Prop>
+    void Assemble(Matrix<T, Prop, RowSymSparse, Allocator>& A);
+
+  protected:
+    void AddShared(int i, int j, const T& val);
+    SparseAssemblerBuffer<T, Allocator>& GetBuffer(int t);
+    void Gather(bool upper, Vector<int>& IndRow, Vector<int>& IndCol,
+		Vector<T, VectFull, Allocator>& Val);
+  };
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_SPARSE_ASSEMBLER_HXX
+#endif
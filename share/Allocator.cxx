@@ -33,19 +33,19 @@ namespace Seldon
 
   template <class T>
   inline typename MallocAlloc<T>::pointer
-  MallocAlloc<T>::allocate(int num, void* h)
+  MallocAlloc<T>::allocate(size_t num, void* h)
   {
     return static_cast<pointer>( malloc(num * sizeof(T)) );
   }
 
   template <class T>
-  inline void MallocAlloc<T>::deallocate(pointer data, int num, void* h)
+  inline void MallocAlloc<T>::deallocate(pointer data, size_t num, void* h)
   {
     free(data);
   }
 
   template <class T>
-  inline void* MallocAlloc<T>::reallocate(pointer data, int num, void* h)
+  inline void* MallocAlloc<T>::reallocate(pointer data, size_t num, void* h)
   {
     return realloc(reinterpret_cast<void*>(data), num * sizeof(T));
   }
@@ -72,19 +72,19 @@ namespace Seldon
 
   template <class T>
   inline typename CallocAlloc<T>::pointer
-  CallocAlloc<T>::allocate(int num, void* h)
+  CallocAlloc<T>::allocate(size_t num, void* h)
   {
     return static_cast<pointer>( calloc(num, sizeof(T)) );
   }
 
   template <class T>
-  inline void CallocAlloc<T>::deallocate(pointer data, int num, void* h)
+  inline void CallocAlloc<T>::deallocate(pointer data, size_t num, void* h)
   {
     free(data);
   }
 
   template <class T>
-  inline void* CallocAlloc<T>::reallocate(pointer data, int num, void* h)
+  inline void* CallocAlloc<T>::reallocate(pointer data, size_t num, void* h)
   {
     return realloc(reinterpret_cast<void*>(data), num * sizeof(T));
   }
@@ -111,17 +111,17 @@ namespace Seldon
 
   template <class T>
   inline typename MallocObject<T>::pointer
-  MallocObject<T>::allocate(int num, void* h)
+  MallocObject<T>::allocate(size_t num, void* h)
   {
     // The cast from char* to T* may lead to a memory shift (because of
     // alignment issues) under MS Windows. It requires that one allocates more
     // memory than necessary for memory_block.
 
-    void* memory_block = malloc(sizeof(int) + sizeof(char*) +
+    void* memory_block = malloc(sizeof(size_t) + sizeof(char*) +
                                 (num + 2) * sizeof(T));
-    memcpy(memory_block, &num, sizeof(int));
+    memcpy(memory_block, &num, sizeof(size_t));
     char* data = static_cast<char*>(memory_block)
-      + sizeof(int) + sizeof(char*) + sizeof(T);
+      + sizeof(size_t) + sizeof(char*) + sizeof(T);
 
     // The memory shift can occur here.
     pointer data_P = reinterpret_cast<pointer>(new(data) T[num]);
@@ -134,19 +134,19 @@ namespace Seldon
 
 
   template <class T>
-  inline void MallocObject<T>::deallocate(pointer data, int num, void* h)
+  inline void MallocObject<T>::deallocate(pointer data, size_t num, void* h)
   {
     void * memory_block;
     memcpy(&memory_block,
            reinterpret_cast<char *>(data) - sizeof(char*), sizeof(char*));
-    for (int i = 0; i < num; i++)
+    for (size_t i = 0; i < num; i++)
       data[i].~T();
     free(memory_block);
   }
 
 
   template <class T>
-  inline void* MallocObject<T>::reallocate(pointer data, int num, void* h)
+  inline void* MallocObject<T>::reallocate(pointer data, size_t num, void* h)
   {
     if (data == NULL)
       return allocate(num, h);
@@ -154,33 +154,33 @@ namespace Seldon
     void * memory_block;
     memcpy(&memory_block,
            reinterpret_cast<char *>(data) - sizeof(char*), sizeof(char*));
-    int initial_num = *reinterpret_cast<int*>(memory_block);
+    size_t initial_num = *reinterpret_cast<size_t*>(memory_block);
 
     if (initial_num < num)
       {
-	memory_block = realloc(memory_block, sizeof(int) + sizeof(char*) +
+	memory_block = realloc(memory_block, sizeof(size_t) + sizeof(char*) +
                                (num + 2) * sizeof(T));
 
-	new(static_cast<char *>(memory_block) + sizeof(int) + sizeof(T) +
+	new(static_cast<char *>(memory_block) + sizeof(size_t) + sizeof(T) +
             sizeof(char*) + initial_num * sizeof(T)) T[num - initial_num];
       }
     else if (initial_num > num)
       {
-	for (int i = num; i < initial_num; i++)
+	for (size_t i = num; i < initial_num; i++)
 	  data[i].~T();
 
-	memory_block = realloc(memory_block, sizeof(int) + sizeof(char*) +
+	memory_block = realloc(memory_block, sizeof(size_t) + sizeof(char*) +
                                (num + 2) * sizeof(T));
 
       }
     else
       return data;
 
-    memcpy(memory_block, &num, sizeof(int));
+    memcpy(memory_block, &num, sizeof(size_t));
 
     pointer data_P =
       reinterpret_cast<pointer>(static_cast<char*>(memory_block) +
-                                sizeof(int) + sizeof(char*) + sizeof(T));
+                                sizeof(size_t) + sizeof(char*) + sizeof(T));
     memcpy(reinterpret_cast<char *>(data_P) - sizeof(char*),
            &memory_block, sizeof(char*));
 
@@ -211,19 +211,19 @@ namespace Seldon
 
   template <class T>
   inline typename NewAlloc<T>::pointer
-  NewAlloc<T>::allocate(int num, void* h)
+  NewAlloc<T>::allocate(size_t num, void* h)
   {
     return static_cast<pointer>(new T[num]);
   }
 
   template <class T>
-  inline void NewAlloc<T>::deallocate(pointer data, int num, void* h)
+  inline void NewAlloc<T>::deallocate(pointer data, size_t num, void* h)
   {
     delete [] data;
   }
 
   template <class T>
-  inline void* NewAlloc<T>::reallocate(pointer data, int num, void* h)
+  inline void* NewAlloc<T>::reallocate(pointer data, size_t num, void* h)
   {
     if (data != NULL)
       delete [] data;
@@ -252,40 +252,40 @@ namespace Seldon
 
   template <class T>
   inline typename NaNAlloc<T>::pointer
-  NaNAlloc<T>::allocate(int num, void* h)
+  NaNAlloc<T>::allocate(size_t num, void* h)
   {
     pointer data = static_cast<pointer>( malloc(num * sizeof(T)) );
     if (numeric_limits<value_type>::has_signaling_NaN)
-      for (int i = 0; i < num; i++)
+      for (size_t i = 0; i < num; i++)
 	data[i] = numeric_limits<value_type>::signaling_NaN();
     else if (numeric_limits<value_type>::has_quiet_NaN)
-      for (int i = 0; i < num; i++)
+      for (size_t i = 0; i < num; i++)
 	data[i] = numeric_limits<value_type>::quiet_NaN();
     else if  (numeric_limits<value_type>::has_infinity)
-      for (int i = 0; i < num; i++)
+      for (size_t i = 0; i < num; i++)
 	data[i] = numeric_limits<value_type>::infinity();
     return data;
   }
 
   template <class T>
-  inline void NaNAlloc<T>::deallocate(pointer data, int num, void* h)
+  inline void NaNAlloc<T>::deallocate(pointer data, size_t num, void* h)
   {
     free(data);
   }
 
   template <class T>
-  inline void* NaNAlloc<T>::reallocate(pointer data, int num, void* h)
+  inline void* NaNAlloc<T>::reallocate(pointer data, size_t num, void* h)
   {
     void* datav = realloc(reinterpret_cast<void*>(data), num * sizeof(T));
     pointer datap = reinterpret_cast<pointer>(datav);
     if (numeric_limits<value_type>::has_signaling_NaN)
-      for (int i = 0; i < num; i++)
+      for (size_t i = 0; i < num; i++)
 	datap[i] = numeric_limits<value_type>::signaling_NaN();
     else if (numeric_limits<value_type>::has_quiet_NaN)
-      for (int i = 0; i < num; i++)
+      for (size_t i = 0; i < num; i++)
 	datap[i] = numeric_limits<value_type>::quiet_NaN();
     else if  (numeric_limits<value_type>::has_infinity)
-      for (int i = 0; i < num; i++)
+      for (size_t i = 0; i < num; i++)
 	datap[i] = numeric_limits<value_type>::infinity();
     return datav;
   }
@@ -305,6 +305,128 @@ namespace Seldon
   }
 
 
+  //////////////////
+  // ALIGNEDALLOC //
+  //////////////////
+
+
+  /*
+    The block allocated with malloc is larger than the array, so that the
+    array can start at an aligned address. The address of the block and the
+    number of elements of the array are stored just before the array.
+  */
+
+
+  template <class T>
+  inline typename AlignedAlloc<T>::pointer
+  AlignedAlloc<T>::allocate(size_t num, void* h)
+  {
+    size_t alignment = GetAlignment(num);
+    size_t header = sizeof(size_t) + sizeof(void*);
+    void* memory_block = malloc(num * sizeof(T) + header + alignment);
+    if (memory_block == NULL)
+      return NULL;
+
+    size_t address = reinterpret_cast<size_t>(memory_block) + header;
+    address = (address + alignment - 1) & ~(alignment - 1);
+    char* data = reinterpret_cast<char*>(address);
+
+    memcpy(data - sizeof(void*), &memory_block, sizeof(void*));
+    memcpy(data - header, &num, sizeof(size_t));
+
+#if defined(SELDON_WITH_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+    if (alignment == size_t(SELDON_HUGE_PAGE_SIZE))
+      madvise(data, num * sizeof(T) - num * sizeof(T) % alignment,
+              MADV_HUGEPAGE);
+#endif
+
+    return reinterpret_cast<pointer>(data);
+  }
+
+  template <class T>
+  inline void AlignedAlloc<T>::deallocate(pointer data, size_t num, void* h)
+  {
+    if (data == NULL)
+      return;
+
+    void* memory_block;
+    memcpy(&memory_block, reinterpret_cast<char*>(data) - sizeof(void*),
+           sizeof(void*));
+    free(memory_block);
+  }
+
+  //! Reallocates an array.
+  /*!
+    A new aligned array is allocated, and the elements of the former array
+    are copied into it, since 'realloc' would not preserve the alignment.
+    \param[in] data array to be reallocated; it may be NULL.
+    \param[in] num new number of elements.
+    \return The new array, or NULL if the allocation failed, in which case
+    \a data is left unchanged.
+  */
+  template <class T>
+  inline void* AlignedAlloc<T>::reallocate(pointer data, size_t num, void* h)
+  {
+    if (data == NULL)
+      return allocate(num, h);
+
+    size_t initial_num = GetSize(data);
+    if (initial_num == num)
+      return data;
+
+    pointer new_data = allocate(num, h);
+    if (new_data == NULL)
+      return NULL;
+
+    memcpy(reinterpret_cast<void*>(new_data), reinterpret_cast<void*>(data),
+           min(num, initial_num) * sizeof(T));
+    deallocate(data, initial_num, h);
+
+    return new_data;
+  }
+
+  template <class T>
+  inline void AlignedAlloc<T>::memoryset(pointer data, char c, size_t num)
+  {
+    memset(reinterpret_cast<void*>(data), c, num);
+  }
+
+  template <class T>
+  inline void
+  AlignedAlloc<T>::memorycpy(pointer datat, pointer datas, size_t num)
+  {
+    memcpy(reinterpret_cast<void*>(datat), reinterpret_cast<void*>(datas),
+	   num * sizeof(T));
+  }
+
+  //! Returns the alignment of an array.
+  /*!
+    \param[in] num number of elements of the array.
+    \return SELDON_ALIGNMENT, or SELDON_HUGE_PAGE_SIZE if huge pages are
+    enabled and if the array is at least that large.
+  */
+  template <class T>
+  inline size_t AlignedAlloc<T>::GetAlignment(size_t num)
+  {
+    size_t alignment = max(size_t(SELDON_ALIGNMENT), sizeof(void*));
+#ifdef SELDON_WITH_HUGE_PAGES
+    if (num * sizeof(T) >= size_t(SELDON_HUGE_PAGE_SIZE))
+      alignment = size_t(SELDON_HUGE_PAGE_SIZE);
+#endif
+    return alignment;
+  }
+
+  //! Returns the number of elements of an array allocated by AlignedAlloc.
+  template <class T>
+  inline size_t AlignedAlloc<T>::GetSize(pointer data)
+  {
+    size_t num;
+    memcpy(&num, reinterpret_cast<char*>(data) - sizeof(size_t)
+           - sizeof(void*), sizeof(size_t));
+    return num;
+  }
+
+
 } // namespace Seldon.
 
 #define SELDON_FILE_ALLOCATOR_CXX
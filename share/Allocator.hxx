@@ -19,6 +19,22 @@
 
 #ifndef SELDON_FILE_ALLOCATOR_HXX
 
+// Alignment, in bytes, of the arrays allocated by AlignedAlloc. It must be a
+// power of two.
+#ifndef SELDON_ALIGNMENT
+#define SELDON_ALIGNMENT 64
+#endif
+
+#ifdef SELDON_WITH_HUGE_PAGES
+#include <sys/mman.h>
+// Size, in bytes, of the huge pages. The arrays allocated by AlignedAlloc
+// which are at least that large are aligned on this size, and the kernel is
+// advised to back them with transparent huge pages.
+#ifndef SELDON_HUGE_PAGE_SIZE
+#define SELDON_HUGE_PAGE_SIZE 2097152
+#endif
+#endif
+
 namespace Seldon
 {
 
@@ -40,9 +56,9 @@ namespace Seldon
 
   public:
 
-    pointer allocate(int num, void* h = 0);
-    void deallocate(pointer data, int num, void* h = 0);
-    void* reallocate(pointer data, int num, void* h = 0);
+    pointer allocate(size_t num, void* h = 0);
+    void deallocate(pointer data, size_t num, void* h = 0);
+    void* reallocate(pointer data, size_t num, void* h = 0);
     void memoryset(pointer data, char c, size_t num);
     void memorycpy(pointer datat, pointer datas, size_t num);
   };
@@ -65,9 +81,9 @@ namespace Seldon
 
   public:
 
-    pointer allocate(int num, void* h = 0);
-    void deallocate(pointer data, int num, void* h = 0);
-    void* reallocate(pointer data, int num, void* h = 0);
+    pointer allocate(size_t num, void* h = 0);
+    void deallocate(pointer data, size_t num, void* h = 0);
+    void* reallocate(pointer data, size_t num, void* h = 0);
     void memoryset(pointer data, char c, size_t num);
     void memorycpy(pointer datat, pointer datas, size_t num);
   };
@@ -90,9 +106,9 @@ namespace Seldon
 
   public:
 
-    pointer allocate(int num, void* h = 0);
-    void deallocate(pointer data, int num, void* h = 0);
-    void* reallocate(pointer data, int num, void* h = 0);
+    pointer allocate(size_t num, void* h = 0);
+    void deallocate(pointer data, size_t num, void* h = 0);
+    void* reallocate(pointer data, size_t num, void* h = 0);
     void memoryset(pointer data, char c, size_t num);
     void memorycpy(pointer datat, pointer datas, size_t num);
   };
@@ -115,9 +131,9 @@ namespace Seldon
     
   public:
 
-    pointer allocate(int num, void* h = 0);
-    void deallocate(pointer data, int num, void* h = 0);
-    void* reallocate(pointer data, int num, void* h = 0);
+    pointer allocate(size_t num, void* h = 0);
+    void deallocate(pointer data, size_t num, void* h = 0);
+    void* reallocate(pointer data, size_t num, void* h = 0);
     void memoryset(pointer data, char c, size_t num);
     void memorycpy(pointer datat, pointer datas, size_t num);
   };
@@ -140,11 +156,40 @@ namespace Seldon
 
   public:
 
-    pointer allocate(int num, void* h = 0);
-    void deallocate(pointer data, int num, void* h = 0);
-    void* reallocate(pointer data, int num, void* h = 0);
+    pointer allocate(size_t num, void* h = 0);
+    void deallocate(pointer data, size_t num, void* h = 0);
+    void* reallocate(pointer data, size_t num, void* h = 0);
+    void memoryset(pointer data, char c, size_t num);
+    void memorycpy(pointer datat, pointer datas, size_t num);
+  };
+
+
+  //////////////////
+  // ALIGNEDALLOC //
+  //////////////////
+
+
+  template <class T>
+  class AlignedAlloc
+  {
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+  public:
+
+    pointer allocate(size_t num, void* h = 0);
+    void deallocate(pointer data, size_t num, void* h = 0);
+    void* reallocate(pointer data, size_t num, void* h = 0);
     void memoryset(pointer data, char c, size_t num);
     void memorycpy(pointer datat, pointer datas, size_t num);
+
+  protected:
+    static size_t GetAlignment(size_t num);
+    static size_t GetSize(pointer data);
   };
 
 
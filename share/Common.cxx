@@ -187,6 +187,204 @@ namespace Seldon
   }
 
 
+  ////////////////////
+  // MULTITHREADING //
+
+
+  //! Returns the number of threads requested by the user.
+  /*!
+    \return A reference to the number of threads set by 'SetNumberThreads'.
+    A value of zero means that the default number of threads of OpenMP is
+    used.
+  */
+  inline int& GetNumberThreadsReference()
+  {
+    static int nb_thread = 0;
+    return nb_thread;
+  }
+
+
+  //! Returns the number of threads used by the multithreaded kernels.
+  /*!
+    \return The number of threads set by 'SetNumberThreads', or the default
+    number of threads of OpenMP if none was set. Without OpenMP (i.e., if
+    SELDON_WITH_OPENMP is not defined), it always returns 1.
+  */
+  inline int GetNumberThreads()
+  {
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreadsReference();
+    if (nb_thread > 0)
+      return nb_thread;
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+
+  //! Returns the number of threads to be used for a given amount of work.
+  /*!
+    \param[in] work amount of work of the kernel, e.g., the number of rows
+    plus the number of non-zero entries for a sparse matrix-vector product.
+    \return 1 if \a work is below SELDON_THREAD_THRESHOLD, the number of
+    threads returned by 'GetNumberThreads()' otherwise.
+  */
+  inline int GetNumberThreads(long work)
+  {
+    if (work < long(SELDON_THREAD_THRESHOLD))
+      return 1;
+    return GetNumberThreads();
+  }
+
+
+  //! Sets the number of threads used by the multithreaded kernels.
+  /*!
+    \param[in] nb_thread number of threads. If it is zero, the default
+    number of threads of OpenMP is used.
+    \note This has no effect if SELDON_WITH_OPENMP is not defined.
+  */
+  inline void SetNumberThreads(int nb_thread)
+  {
+    GetNumberThreadsReference() = max(nb_thread, 0);
+  }
+
+
+  //! Returns the number of the current thread.
+  /*!
+    \return The number of the current thread in the current parallel region,
+    between 0 and the number of threads minus one. Out of a parallel region,
+    or without OpenMP, it returns 0.
+  */
+  inline int GetThreadNumber()
+  {
+#ifdef SELDON_WITH_OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
+
+
+  //! Returns the range of indices processed by the current thread.
+  /*! The range [0, m) is split into contiguous blocks of equal length, one
+    per thread of the current parallel region.
+    \param[in] m number of indices.
+    \param[out] begin first index of the range of the current thread.
+    \param[out] end index following the last index of the range.
+    \note Out of a parallel region, the whole range [0, m) is returned.
+  */
+  inline void GetThreadRange(int m, int& begin, int& end)
+  {
+#ifdef SELDON_WITH_OPENMP
+    long nb_thread = omp_get_num_threads();
+    long thread = omp_get_thread_num();
+    begin = int(thread * m / nb_thread);
+    end = int((thread + 1) * m / nb_thread);
+#else
+    begin = 0;
+    end = m;
+#endif
+  }
+
+
+  /*! \brief Returns the range of rows (or columns) of a compressed sparse
+    matrix processed by the current thread. */
+  /*! The range [0, m) is split into contiguous blocks, one per thread of the
+    current parallel region, so that the blocks have roughly the same number
+    of non-zero entries. Each row counts as one entry in addition to its
+    non-zero entries so that empty rows are distributed as well.
+    \param[in] ptr array of start indices of the rows (of length m + 1).
+    \param[in] m number of rows.
+    \param[out] begin first row of the current thread.
+    \param[out] end row following the last row of the current thread.
+    \note Out of a parallel region, the whole range [0, m) is returned.
+  */
+  template <class Tint>
+  void GetThreadRange(const Tint* ptr, int m, int& begin, int& end)
+  {
+#ifdef SELDON_WITH_OPENMP
+    long nb_thread = omp_get_num_threads();
+    long thread = omp_get_thread_num();
+    if (nb_thread == 1)
+      {
+        begin = 0;
+        end = m;
+        return;
+      }
+
+    // The weight of the first i rows is ptr[i] - ptr[0] + i. The bounds are
+    // searched by bisection.
+    long total = long(ptr[m] - ptr[0]) + m;
+    long target[2] = {thread * total / nb_thread,
+                      (thread + 1) * total / nb_thread};
+    int bound[2];
+    for (int k = 0; k < 2; k++)
+      {
+        int low = 0, high = m, mid;
+        while (low < high)
+          {
+            mid = low + (high - low) / 2;
+            if (long(ptr[mid] - ptr[0]) + mid < target[k])
+              low = mid + 1;
+            else
+              high = mid;
+          }
+        bound[k] = low;
+      }
+    begin = thread == 0 ? 0 : bound[0];
+    end = thread == nb_thread - 1 ? m : bound[1];
+#else
+    begin = 0;
+    end = m;
+#endif
+  }
+
+
+  //! Adds a value to a shared variable, atomically.
+  /*! Several threads may add values to the same variable simultaneously.
+    The order of the additions is not specified, so that the result may vary
+    with rounding errors from one run to another.
+    \param[in] x value to be added.
+    \param[in,out] y variable to which \a x is added.
+  */
+  template <class T>
+  inline void AddAtomic(const T& x, T& y)
+  {
+#ifdef SELDON_WITH_OPENMP
+#pragma omp atomic
+#endif
+    y += x;
+  }
+
+
+  //! Adds a complex value to a shared variable, atomically.
+  /*! The real part and the imaginary part are added separately, each
+    atomically.
+    \param[in] x value to be added.
+    \param[in,out] y variable to which \a x is added.
+  */
+  template <class T>
+  inline void AddAtomic(const complex<T>& x, complex<T>& y)
+  {
+    // A complex number is stored as two consecutive real numbers.
+    T* y_part = reinterpret_cast<T*>(&y);
+    T x_real = real(x), x_imag = imag(x);
+#ifdef SELDON_WITH_OPENMP
+#pragma omp atomic
+#endif
+    y_part[0] += x_real;
+#ifdef SELDON_WITH_OPENMP
+#pragma omp atomic
+#endif
+    y_part[1] += x_imag;
+  }
+
+
+  // MULTITHREADING //
+  ////////////////////
+
+
 #ifdef SELDON_WITH_HDF5
   //! Gives for most C types the corresponding HDF5 memory datatype.
   /*!
@@ -27,6 +27,16 @@
 #include <hdf5.h>
 #endif
 
+#ifdef SELDON_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimal amount of work (e.g., number of rows plus number of non-zero
+// entries) for a kernel to be split among several threads.
+#ifndef SELDON_THREAD_THRESHOLD
+#define SELDON_THREAD_THRESHOLD 20000
+#endif
+
 template <class T>
 void PrintArray(T* v, int lgth);
 
@@ -91,6 +101,22 @@ namespace Seldon
   hid_t GetH5Type(T& input);
 #endif
 
+  int& GetNumberThreadsReference();
+  int GetNumberThreads();
+  int GetNumberThreads(long work);
+  void SetNumberThreads(int nb_thread);
+  int GetThreadNumber();
+
+  void GetThreadRange(int m, int& begin, int& end);
+
+  template <class Tint>
+  void GetThreadRange(const Tint* ptr, int m, int& begin, int& end);
+
+  template <class T>
+  void AddAtomic(const T& x, T& y);
+  template <class T>
+  void AddAtomic(const complex<T>& x, complex<T>& y);
+
 
 }  // namespace Seldon.
 
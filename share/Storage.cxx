@@ -186,6 +186,48 @@ namespace Seldon
   }
 
 
+  inline int ColLongSparse::GetFirst(int i, int j)
+  {
+    return j;
+  }
+  inline int ColLongSparse::GetSecond(int i, int j)
+  {
+    return i;
+  }
+
+
+  inline int RowLongSparse::GetFirst(int i, int j)
+  {
+    return i;
+  }
+  inline int RowLongSparse::GetSecond(int i, int j)
+  {
+    return j;
+  }
+
+
+  inline int RowSellSparse::GetFirst(int i, int j)
+  {
+    return i;
+  }
+  inline int RowSellSparse::GetSecond(int i, int j)
+  {
+    return j;
+  }
+
+
+  template <int B>
+  inline int RowBlockSparse<B>::GetFirst(int i, int j)
+  {
+    return i;
+  }
+  template <int B>
+  inline int RowBlockSparse<B>::GetSecond(int i, int j)
+  {
+    return j;
+  }
+
+
 
   ///////////////
   // SYMMETRIC //
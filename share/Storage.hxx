@@ -135,6 +135,44 @@ namespace Seldon
     static int GetSecond(int i, int j);
   };
 
+
+  //! Sparse storage by columns, with 64-bit start indices.
+  class ColLongSparse
+  {
+  public:
+    static int GetFirst(int i, int j);
+    static int GetSecond(int i, int j);
+  };
+
+
+  //! Sparse storage by rows, with 64-bit start indices.
+  class RowLongSparse
+  {
+  public:
+    static int GetFirst(int i, int j);
+    static int GetSecond(int i, int j);
+  };
+
+
+  class RowSellSparse
+  {
+  public:
+    static int GetFirst(int i, int j);
+    static int GetSecond(int i, int j);
+  };
+
+
+  //! Block sparse storage by rows, with dense blocks of size B x B.
+  template <int B>
+  class RowBlockSparse
+  {
+  public:
+    static const int block_size = B;
+
+    static int GetFirst(int i, int j);
+    static int GetSecond(int i, int j);
+  };
+
   class ArrayRowSparse : public RowSparse
   {
   };
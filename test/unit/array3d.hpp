@@ -28,6 +28,7 @@ class Array3DTest: public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(Array3DTest);
   CPPUNIT_TEST(test_fill);
   CPPUNIT_TEST(test_reallocate);
+  CPPUNIT_TEST(test_batch);
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -78,4 +79,107 @@ public:
     CPPUNIT_ASSERT(A.GetLength2() == 0);
     CPPUNIT_ASSERT(A.GetLength3() == 0);
   }
+
+
+  void test_batch()
+  {
+    batch(19, 6, 4, 3);
+    batch(3, 1, 1, 1);
+    batch(SELDON_BATCH_SIZE, 9, 2, 7);
+    batch(0, 6, 6, 6);
+  }
+
+
+  void batch(int nb_slice, int m, int n, int k)
+  {
+    int s, i, j, l;
+    Array3D<double> A(nb_slice, m, k), B(nb_slice, k, n), C(nb_slice, m, n);
+    for (s = 0; s < nb_slice; s++)
+      for (i = 0; i < m; i++)
+        for (l = 0; l < k; l++)
+          A(s, i, l) = double((s + 2 * i - l) % 7);
+    for (s = 0; s < nb_slice; s++)
+      for (l = 0; l < k; l++)
+        for (j = 0; j < n; j++)
+          B(s, l, j) = double((3 * s - l + j) % 5);
+    C.Fill(1.);
+
+    // Products with integer values, which are exact.
+    MltAdd(2., A, B, -1., C);
+    for (s = 0; s < nb_slice; s++)
+      for (i = 0; i < m; i++)
+        for (j = 0; j < n; j++)
+          {
+            double sum = 0.;
+            for (l = 0; l < k; l++)
+              sum += A(s, i, l) * B(s, l, j);
+            CPPUNIT_ASSERT(C(s, i, j) == 2. * sum - 1.);
+          }
+
+    // LU factorizations of the square slices, compared with those of the
+    // row-major matrices.
+    Array3D<double> D(nb_slice, m, m), D_lu;
+    for (s = 0; s < nb_slice; s++)
+      for (i = 0; i < m; i++)
+        for (j = 0; j < m; j++)
+          D(s, i, j) = (i == j) ? double(2 * m + s % 3)
+            : double((s + i + 2 * j) % 4 + 1) / m;
+    // Forces pivoting in half of the slices.
+    if (m > 1)
+      for (s = 0; s < nb_slice; s += 2)
+        D(s, 0, 0) = 0.;
+    D_lu = D;
+
+    Matrix<int, General, RowMajor> P;
+    GetLU(D_lu, P);
+    CPPUNIT_ASSERT(P.GetM() == nb_slice && P.GetN() == m);
+
+    Matrix<double, General, RowMajor> Y(nb_slice, m), Y_trans(nb_slice, m);
+    for (s = 0; s < nb_slice; s++)
+      for (i = 0; i < m; i++)
+        Y(s, i) = Y_trans(s, i) = double(s - i);
+    SolveLU(D_lu, P, Y);
+    SolveLU(SeldonTrans, D_lu, P, Y_trans);
+
+    Array3D<double> D_inv(D);
+    GetInverse(D_inv);
+
+    Matrix<double, General, RowMajor> M;
+    Vector<int> Q;
+    for (s = 0; s < nb_slice; s++)
+      {
+        M.Reallocate(m, m);
+        for (i = 0; i < m; i++)
+          for (j = 0; j < m; j++)
+            M(i, j) = D(s, i, j);
+        GetLU(M, Q);
+        for (i = 0; i < m; i++)
+          {
+            CPPUNIT_ASSERT(P(s, i) == Q(i));
+            for (j = 0; j < m; j++)
+              CPPUNIT_ASSERT(abs(D_lu(s, i, j) - M(i, j)) < 1.e-12);
+          }
+
+        for (i = 0; i < m; i++)
+          {
+            double sum = 0., sum_trans = 0.;
+            for (j = 0; j < m; j++)
+              {
+                sum += D(s, i, j) * Y(s, j);
+                sum_trans += D(s, j, i) * Y_trans(s, j);
+              }
+            CPPUNIT_ASSERT(abs(sum - double(s - i)) < 1.e-10);
+            CPPUNIT_ASSERT(abs(sum_trans - double(s - i)) < 1.e-10);
+          }
+
+        for (i = 0; i < m; i++)
+          for (j = 0; j < m; j++)
+            {
+              double sum = 0.;
+              for (l = 0; l < m; l++)
+                sum += D(s, i, l) * D_inv(s, l, j);
+              CPPUNIT_ASSERT(abs(sum - (i == j ? 1. : 0.)) < 1.e-12);
+            }
+      }
+  }
 };
@@ -28,11 +28,14 @@ class MatrixFunctionTest: public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(MatrixFunctionTest);
   CPPUNIT_TEST(test_permute);
+  CPPUNIT_TEST(test_mlt_add);
+  CPPUNIT_TEST(test_lu);
   CPPUNIT_TEST_SUITE_END();
 
 protected:
   int m_;
   int n_;
+  int k_;
 
 public:
   void setUp()
@@ -57,6 +60,63 @@ public:
   }
 
 
+  void test_mlt_add()
+  {
+    m_ = 7;
+    n_ = 5;
+    k_ = 3;
+    mlt_add<int, RowMajor>();
+    mlt_add<int, ColMajor>();
+
+    // The blocks of rows and of the inner dimension are split.
+    m_ = 150;
+    n_ = 37;
+    k_ = 300;
+    mlt_add<int, RowMajor>();
+    mlt_add<long double, ColMajor>();
+    mlt_add<complex<long double>, RowMajor>();
+    mlt_add<float, RowMajor>();
+    mlt_add<double, ColMajor>();
+    mlt_add<complex<double>, ColMajor>();
+
+    m_ = 1;
+    n_ = 33;
+    k_ = 1;
+    mlt_add<double, RowMajor>();
+    m_ = 0;
+    mlt_add<double, ColMajor>();
+  }
+
+
+  void test_lu()
+  {
+    // Several panels are factorized.
+    m_ = 150;
+    lu<double, ColMajor>();
+    lu<double, RowMajor>();
+    lu<long double, ColMajor>();
+    lu<long double, RowMajor>();
+    lu<complex<long double>, ColMajor>();
+
+    m_ = 5;
+    lu<long double, RowMajor>();
+
+    // Other storages are factorized without pivoting when Lapack is not
+    // available.
+    Matrix<double, Symmetric, RowSymPacked> S(m_, m_);
+    Vector<double> x(m_);
+    S.Zero();
+    for (int i = 0; i < m_; i++)
+      {
+        S(i, i) = double(i + 1);
+        x(i) = double(i + 1) * double(i - 2);
+      }
+    GetAndSolveLU(S, x);
+    for (int i = 0; i < m_; i++)
+      CPPUNIT_ASSERT(x(i) == double(i - 2));
+  }
+
+
   void permute()
   {
     Matrix<double, General, RowMajor> Ar(m_, n_), Ar_copy;
@@ -107,4 +167,116 @@ public:
           CPPUNIT_ASSERT(Ar(i, j) == Ar_copy(i, j));
         }
   }
+
+
+  template <class T, class Storage>
+  void mlt_add()
+  {
+    int i, j, l;
+    // Small integer values, so that all products are exact.
+    Matrix<T, General, Storage> A(m_, k_), At(k_, m_), B(k_, n_), Bt(n_, k_);
+    for (i = 0; i < m_; i++)
+      for (l = 0; l < k_; l++)
+        {
+          A(i, l) = T(rand() % 9 - 4);
+          At(l, i) = A(i, l);
+        }
+    for (l = 0; l < k_; l++)
+      for (j = 0; j < n_; j++)
+        {
+          B(l, j) = T(rand() % 9 - 4);
+          Bt(j, l) = B(l, j);
+        }
+
+    Matrix<T, General, Storage> C(m_, n_), C_ref(m_, n_), D(m_, n_);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        {
+          C(i, j) = T(rand() % 9 - 4);
+          C_ref(i, j) = T(3) * C(i, j);
+          for (l = 0; l < k_; l++)
+            C_ref(i, j) += T(2) * A(i, l) * B(l, j);
+        }
+
+    D = C;
+    MltAdd(T(2), A, B, T(3), D);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(D(i, j) == C_ref(i, j));
+
+    D = C;
+    MltAdd(T(2), SeldonTrans, At, SeldonTrans, Bt, T(3), D);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(D(i, j) == C_ref(i, j));
+
+    D = C;
+    MltAdd(T(2), SeldonNoTrans, A, SeldonTrans, Bt, T(3), D);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(D(i, j) == C_ref(i, j));
+
+    // With BLAS, the floating-point types are not handled by MltAddBlocked
+    // in MltAdd.
+    D = C;
+    if (Storage::GetFirst(1, 0) == 1)
+      MltAddBlocked(T(2), m_, n_, k_, At.GetData(), 1L, long(m_),
+                    B.GetData(), long(n_), 1L, T(3), D.GetData(), long(n_),
+                    1L);
+    else
+      MltAddBlocked(T(2), m_, n_, k_, At.GetData(), long(k_), 1L,
+                    B.GetData(), 1L, long(k_), T(3), D.GetData(), 1L,
+                    long(m_));
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(D(i, j) == C_ref(i, j));
+
+    // C is overwritten when beta is zero.
+    D.Fill(T(1));
+    MltAdd(T(1), A, B, T(0), D);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(T(2) * D(i, j) == C_ref(i, j) - T(3) * C(i, j));
+  }
+
+
+  template <class T, class Storage>
+  void lu()
+  {
+    int i, j;
+    Matrix<T, General, Storage> A(m_, m_), A_lu;
+    Vector<T> x(m_), y(m_), y_trans(m_), z;
+    // Row i of A is row i + 1 (modulo m_) of a matrix whose diagonal
+    // dominates its rows and columns: the system is well conditioned, and
+    // the factorization has to interchange rows.
+    for (i = 0; i < m_; i++)
+      {
+        for (j = 0; j < m_; j++)
+          A((i + m_ - 1) % m_, j) = T((3 * i + 7 * j) % 9 - 4);
+        A((i + m_ - 1) % m_, i) = T(9 * m_);
+        x(i) = T(i % 9 - 4);
+      }
+    Mlt(A, x, y);
+    Mlt(SeldonTrans, A, x, y_trans);
+
+    A_lu = A;
+    Vector<int> P;
+    GetLU(A_lu, P);
+
+    z = y;
+    SolveLU(A_lu, P, z);
+    for (i = 0; i < m_; i++)
+      CPPUNIT_ASSERT(abs(z(i) - x(i)) < 1.e-10);
+
+    z = y_trans;
+    SolveLU(SeldonTrans, A_lu, P, z);
+    for (i = 0; i < m_; i++)
+      CPPUNIT_ASSERT(abs(z(i) - x(i)) < 1.e-10);
+
+    A_lu = A;
+    z = y;
+    GetAndSolveLU(A_lu, z);
+    for (i = 0; i < m_; i++)
+      CPPUNIT_ASSERT(abs(z(i) - x(i)) < 1.e-10);
+  }
 };
@@ -29,12 +29,14 @@
 #include "lapack.hpp"
 #include "sparse_linear_algebra.hpp"
 #include "sparse_matrix.hpp"
+#include "vector.hpp"
 #include "vector2.hpp"
 #include "vector3.hpp"
 #include "vector_collection.hpp"
 #include "heterogeneous_collection.hpp"
 #include "matrix_collection.hpp"
 #include "heterogeneous_matrix_collection.hpp"
+#include "tiny_matrix.hpp"
 #include <cppunit/TestResult.h>
 #include <cppunit/ui/text/TestRunner.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -47,6 +49,7 @@ CPPUNIT_TEST_SUITE_REGISTRATION(SubMatrixTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(Array3DTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(SparseLinearAlgebraTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(SparseMatrixTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(VectorTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(LapackTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(Vector2Test);
 CPPUNIT_TEST_SUITE_REGISTRATION(Vector3Test);
@@ -54,6 +57,7 @@ CPPUNIT_TEST_SUITE_REGISTRATION(VectorCollectionTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(HeterogeneousCollectionTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(MatrixCollectionTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(HeterogeneousMatrixCollectionTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(TinyMatrixTest);
 
 int main()
 {
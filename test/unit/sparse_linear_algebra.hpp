@@ -34,7 +34,17 @@ class SparseLinearAlgebraTest: public CppUnit::TestFixture
   CPPUNIT_TEST_SUITE(SparseLinearAlgebraTest);
   CPPUNIT_TEST(test_add);
   CPPUNIT_TEST(test_mlt);
+  CPPUNIT_TEST(test_mlt_sparse);
+  CPPUNIT_TEST(test_mlt_galerkin);
   CPPUNIT_TEST(test_mlt_trans);
+  CPPUNIT_TEST(test_mlt_vector);
+  CPPUNIT_TEST(test_mlt_symmetric);
+  CPPUNIT_TEST(test_mlt_sell);
+  CPPUNIT_TEST(test_mlt_block);
+  CPPUNIT_TEST(test_mlt_dense);
+  CPPUNIT_TEST(test_mlt_long);
+  CPPUNIT_TEST(test_iterative_workspace);
+  CPPUNIT_TEST(test_fused_kernels);
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -304,6 +314,115 @@ public:
   }
 
 
+  void test_mlt_sparse()
+  {
+    // Product large enough to be multithreaded. The values are integers, so
+    // that the products are exact.
+    int m = 2000, n = 1500, p = 1800, i, j, k, l;
+    Matrix<double, General, ArrayRowSparse> A_array(m, n), B_array(n, p);
+    for (k = 0; k < 30000; k++)
+      {
+        A_array.AddInteraction(rand() % m, rand() % n, double(rand() % 8));
+        B_array.AddInteraction(rand() % n, rand() % p, double(rand() % 8));
+      }
+    Matrix<double, General, RowSparse> A, B, C;
+    Copy(A_array, A);
+    Copy(B_array, B);
+
+    Matrix<double, General, ArrayRowSparse> C_array(m, p);
+    for (i = 0; i < m; i++)
+      for (k = 0; k < A_array.GetRowSize(i); k++)
+        {
+          j = A_array.Index(i, k);
+          for (l = 0; l < B_array.GetRowSize(j); l++)
+            C_array.AddInteraction(i, B_array.Index(j, l),
+                                   A_array.Value(i, k) * B_array.Value(j, l));
+        }
+    Matrix<double, General, RowSparse> C_ref;
+    Copy(C_array, C_ref);
+
+    MltSymbolic(A, B, C);
+    check_sparse_product(C, C_ref, 0.);
+
+    // The values are computed twice, the second time with new values of A.
+    for (int step = 1; step <= 2; step++)
+      {
+        MltNumeric(A, B, C);
+        check_sparse_product(C, C_ref, double(step));
+        Mlt(2., A);
+      }
+
+    Matrix<double, General, RowSparse> D, E;
+    Mlt(A, B, D);
+    check_sparse_product(D, C_ref, 4.);
+    Transpose(B);
+    MltNoTransTrans(A, B, E);
+    check_sparse_product(E, C_ref, 4.);
+  }
+
+
+  void test_mlt_galerkin()
+  {
+    // Coarse operator of an aggregation with smoothed interpolation. The
+    // values are integers, so that the products are exact.
+    int n = 20000, nc = n / 4, i, k;
+    Matrix<double, General, ArrayRowSparse> A_array(n, n), P_array(n, nc);
+    for (i = 0; i < n; i++)
+      {
+        A_array.AddInteraction(i, i, 4.);
+        A_array.AddInteraction(i, (i + 1) % n, -1.);
+        A_array.AddInteraction(i, rand() % n, double(rand() % 4));
+        P_array.AddInteraction(i, i / 4, 2.);
+        P_array.AddInteraction(i, rand() % nc, double(rand() % 3));
+      }
+    Matrix<double, General, RowSparse> A, P, R, C, D;
+    Copy(A_array, A);
+    Copy(P_array, P);
+    R = P;
+    Transpose(R);
+
+    Matrix<double, General, RowSparse> RA, C_ref;
+    Mlt(R, A, RA);
+    Mlt(RA, P, C_ref);
+
+    MltSymbolic(R, A, P, C);
+    check_sparse_product(C, C_ref, 0.);
+    MltNumeric(R, A, P, C);
+    check_sparse_product(C, C_ref, 1.);
+
+    // Pattern of D larger than the pattern of the product, and new values of
+    // P (but not of R).
+    Matrix<double, General, ArrayRowSparse> D_array(nc, nc);
+    for (i = 0; i < nc; i++)
+      for (k = C.GetPtr()[i]; k < C.GetPtr()[i + 1]; k++)
+        D_array.AddInteraction(i, C.GetInd()[k], 1.);
+    for (i = 0; i < nc; i++)
+      D_array.AddInteraction(i, nc - 1 - i, 1.);
+    Copy(D_array, D);
+    Mlt(-1., P);
+    MltNumeric(R, A, P, D);
+    for (i = 0; i < nc; i++)
+      for (k = D.GetPtr()[i]; k < D.GetPtr()[i + 1]; k++)
+        CPPUNIT_ASSERT(D.GetData()[k] == -C_ref(i, D.GetInd()[k]));
+  }
+
+
+  // Checks that C has the pattern of C_ref, and the values of C_ref
+  // multiplied by alpha.
+  void check_sparse_product(const Matrix<double, General, RowSparse>& C,
+                            const Matrix<double, General, RowSparse>& C_ref,
+                            double alpha)
+  {
+    CPPUNIT_ASSERT(C.GetM() == C_ref.GetM() && C.GetN() == C_ref.GetN());
+    CPPUNIT_ASSERT(C.GetNonZeros() == C_ref.GetNonZeros());
+    for (int i = 0; i <= C.GetM(); i++)
+      CPPUNIT_ASSERT(C.GetPtr()[i] == C_ref.GetPtr()[i]);
+    for (int k = 0; k < C.GetNonZeros(); k++)
+      CPPUNIT_ASSERT(C.GetInd()[k] == C_ref.GetInd()[k]
+                     && C.GetData()[k] == alpha * C_ref.GetData()[k]);
+  }
+
+
   void test_mlt_trans()
   {
     Nloop_ = 1;
@@ -392,4 +511,869 @@ public:
   }
 
 
+  void test_mlt_vector()
+  {
+    Nloop_ = 1;
+
+    m_ = 10;
+    n_ = 25;
+    Nelement_ = 0;
+    mlt_vector();
+
+    Nloop_ = 20;
+
+    m_ = 10;
+    n_ = 25;
+    Nelement_ = 20;
+    mlt_vector();
+
+    m_ = 100;
+    n_ = 250;
+    Nelement_ = 20;
+    mlt_vector();
+
+    // Large enough to be split among several threads.
+    Nloop_ = 2;
+
+    m_ = 2000;
+    n_ = 1500;
+    Nelement_ = 40000;
+    mlt_vector();
+  }
+
+
+  void mlt_vector()
+  {
+    srand(time(NULL));
+
+    int i, j;
+    double value;
+
+    for (int k = 0; k < Nloop_; k++)
+      {
+        Matrix<double> A_full(m_, n_);
+        A_full.Zero();
+
+        Matrix<double, General, ArrayRowSparse> A_array(m_, n_);
+        for (int l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand()) / double(RAND_MAX);
+            A_array.AddInteraction(i, j, value);
+            A_full(i, j) += value;
+          }
+
+        Matrix<double, General, RowSparse> A;
+        Matrix<double, General, ColSparse> A_col;
+        Copy(A_array, A);
+        Copy(A, A_col);
+
+        Vector<double> X(n_), Y(m_), Y_col(m_), Y_full(m_);
+        X.FillRand();
+        Mlt(1. / double(RAND_MAX), X);
+        Y.FillRand();
+        Mlt(1. / double(RAND_MAX), Y);
+        Y_col = Y;
+        Y_full = Y;
+
+        MltAdd(1.5, A, X, -0.5, Y);
+        MltAdd(1.5, A_col, X, -0.5, Y_col);
+        MltAdd(1.5, A_full, X, -0.5, Y_full);
+
+        for (int i = 0; i < m_; i++)
+          {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_full(i), Y(i), 1.e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_full(i), Y_col(i), 1.e-12);
+          }
+
+        // The multithreaded product gives the same result as the sequential
+        // one.
+        Vector<double> Y_seq(m_);
+        SetNumberThreads(1);
+        Mlt(A, X, Y_seq);
+        SetNumberThreads(0);
+        Mlt(A, X, Y);
+        for (int i = 0; i < m_; i++)
+          CPPUNIT_ASSERT(Y_seq(i) == Y(i));
+
+        Vector<double> Z(n_), Z_col(n_), Z_full(n_);
+        Y.FillRand();
+        Mlt(1. / double(RAND_MAX), Y);
+        Z.Fill(1.);
+        Z_col.Fill(1.);
+        Z_full.Fill(1.);
+
+        MltAdd(-2., SeldonTrans, A, Y, 0.5, Z);
+        MltAdd(-2., SeldonTrans, A_col, Y, 0.5, Z_col);
+        MltAdd(-2., SeldonTrans, A_full, Y, 0.5, Z_full);
+
+        for (int i = 0; i < n_; i++)
+          {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_full(i), Z(i), 1.e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_full(i), Z_col(i), 1.e-12);
+          }
+
+        // Transposition status known at run time only, and repeated
+        // products which must return the same result.
+        SeldonTranspose trans(SeldonTrans);
+        Mlt(trans, A, Y, Z);
+        Mlt(SeldonTrans, A, Y, Z_col);
+        Mlt(SeldonTrans, A_full, Y, Z_full);
+        for (int i = 0; i < n_; i++)
+          {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_full(i), Z(i), 1.e-12);
+            CPPUNIT_ASSERT(Z(i) == Z_col(i));
+          }
+      }
+  }
+
+
+
+  void test_mlt_symmetric()
+  {
+    Nloop_ = 20;
+
+    m_ = 10;
+    Nelement_ = 0;
+    mlt_symmetric();
+
+    m_ = 10;
+    Nelement_ = 20;
+    mlt_symmetric();
+
+    m_ = 150;
+    Nelement_ = 500;
+    mlt_symmetric();
+
+    // Large enough to be split among several threads.
+    Nloop_ = 2;
+
+    m_ = 3000;
+    Nelement_ = 20000;
+    mlt_symmetric();
+  }
+
+
+  void mlt_symmetric()
+  {
+    srand(time(NULL));
+
+    int i, j;
+    double value;
+
+    for (int k = 0; k < Nloop_; k++)
+      {
+        Matrix<double, General, RowMajor> A_full(m_, m_);
+        A_full.Zero();
+
+        Matrix<double, Symmetric, ArrayRowSymSparse> A_array(m_, m_);
+        for (i = 0; i < m_; i++)
+          {
+            A_array.AddInteraction(i, i, 1.);
+            A_full(i, i) += 1.;
+          }
+        for (int l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % m_;
+            value = double(rand()) / double(RAND_MAX);
+            A_array.AddInteraction(min(i, j), max(i, j), value);
+            A_full(min(i, j), max(i, j)) += value;
+            if (i != j)
+              A_full(max(i, j), min(i, j)) += value;
+          }
+
+        Matrix<double, Symmetric, RowSymSparse> A;
+        Copy(A_array, A);
+
+        Matrix<double, Symmetric, ColSymSparse> A_col;
+        IVect row, col;
+        Vector<double> val;
+        ConvertMatrix_to_Coordinates(A, row, col, val);
+        ConvertMatrix_from_Coordinates(row, col, val, A_col);
+
+        Vector<double> X(m_), Y(m_), Y_col(m_), Y_full(m_);
+        X.FillRand();
+        Mlt(1. / double(RAND_MAX), X);
+        Y.FillRand();
+        Mlt(1. / double(RAND_MAX), Y);
+        Y_col = Y;
+        Y_full = Y;
+
+        MltAdd(1.5, A, X, -0.5, Y);
+        MltAdd(1.5, SeldonTrans, A_col, X, -0.5, Y_col);
+        MltAdd(1.5, A_full, X, -0.5, Y_full);
+
+        for (i = 0; i < m_; i++)
+          {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_full(i), Y(i), 1.e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_full(i), Y_col(i), 1.e-12);
+          }
+
+        // The multithreaded product is close to the sequential one, and
+        // repeated products return the same result.
+        Vector<double> Y_seq(m_);
+        SetNumberThreads(1);
+        Mlt(A, X, Y_seq);
+        SetNumberThreads(0);
+        Mlt(A, X, Y);
+        SeldonTranspose trans(SeldonNoTrans);
+        Mlt(trans, A, X, Y_col);
+        for (i = 0; i < m_; i++)
+          {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_seq(i), Y(i), 1.e-12);
+            CPPUNIT_ASSERT(Y(i) == Y_col(i));
+          }
+      }
+  }
+
+
+
+  void test_mlt_sell()
+  {
+    Nloop_ = 10;
+
+    m_ = 10;
+    n_ = 25;
+    Nelement_ = 0;
+    mlt_sell();
+
+    m_ = 37;
+    n_ = 25;
+    Nelement_ = 100;
+    mlt_sell();
+
+    m_ = 250;
+    n_ = 100;
+    Nelement_ = 2000;
+    mlt_sell();
+
+    // Large enough to be split among several threads.
+    Nloop_ = 1;
+
+    m_ = 3000;
+    n_ = 2000;
+    Nelement_ = 40000;
+    mlt_sell();
+  }
+
+
+  void mlt_sell()
+  {
+    srand(time(NULL));
+
+    int i, j;
+    double value;
+
+    int chunk_size[4] = {4, 8, 16, 3};
+    int sorting_scope[3] = {1, 16, 64};
+
+    for (int k = 0; k < Nloop_; k++)
+      {
+        Matrix<double, General, ArrayRowSparse> A_array(m_, n_);
+        for (int l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand()) / double(RAND_MAX);
+            A_array.AddInteraction(i, j, value);
+          }
+
+        Matrix<double, General, RowSparse> A;
+        Copy(A_array, A);
+
+        Vector<double> X(n_), Y(m_), Y_ref(m_);
+        X.FillRand();
+        Mlt(1. / double(RAND_MAX), X);
+        Y_ref.FillRand();
+        Mlt(1. / double(RAND_MAX), Y_ref);
+
+        Vector<double> Z(n_), Z_ref(n_);
+        Z_ref.Fill(1.);
+        MltAdd(-2., SeldonTrans, A, Y_ref, 0.5, Z_ref);
+
+        Y = Y_ref;
+        MltAdd(1.5, A, X, -0.5, Y_ref);
+
+        for (int c = 0; c < 4; c++)
+          for (int s = 0; s < 3; s++)
+            {
+              Matrix<double, General, RowSellSparse> A_sell;
+              A_sell.SetChunkSize(chunk_size[c]);
+              A_sell.SetSortingScope(sorting_scope[s]);
+              if (c == 3)
+                Copy(A_array, A_sell);
+              else
+                Copy(A, A_sell);
+
+              CPPUNIT_ASSERT(A_sell.GetM() == m_);
+              CPPUNIT_ASSERT(A_sell.GetN() == n_);
+              CPPUNIT_ASSERT(A_sell.GetNonZeros() == A.GetNonZeros());
+              CPPUNIT_ASSERT(A_sell.GetDataSize() % chunk_size[c] == 0);
+              for (i = 0; i < m_; i++)
+                for (j = 0; j < n_; j++)
+                  CPPUNIT_ASSERT(A_sell(i, j) == A(i, j));
+
+              Vector<double> Y_sell(Y);
+              MltAdd(1.5, A_sell, X, -0.5, Y_sell);
+              for (i = 0; i < m_; i++)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_ref(i), Y_sell(i), 1.e-12);
+
+              Z.Fill(1.);
+              MltAdd(-2., SeldonTrans, A_sell, Y, 0.5, Z);
+              for (j = 0; j < n_; j++)
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_ref(j), Z(j), 1.e-12);
+
+              // The multithreaded product gives the same result as the
+              // sequential one.
+              Vector<double> Y_seq(m_);
+              SetNumberThreads(1);
+              Mlt(A_sell, X, Y_seq);
+              SetNumberThreads(0);
+              Mlt(A_sell, X, Y_sell);
+              for (i = 0; i < m_; i++)
+                CPPUNIT_ASSERT(Y_seq(i) == Y_sell(i));
+            }
+      }
+
+    // The matrix can be used in iterative solvers.
+    int n = 100;
+    Matrix<double, General, ArrayRowSparse> B_array(n, n);
+    for (i = 0; i < n; i++)
+      {
+        B_array.AddInteraction(i, i, 4.);
+        if (i > 0)
+          B_array.AddInteraction(i, i - 1, -1.);
+        if (i < n - 1)
+          B_array.AddInteraction(i, i + 1, -1.);
+      }
+    Matrix<double, General, RowSellSparse> B;
+    Copy(B_array, B);
+
+    Vector<double> x(n), b(n), x_ref(n);
+    x_ref.Fill();
+    Mlt(B, x_ref, b);
+    x.Zero();
+    Iteration<double> iter(1000, 1e-12);
+    iter.HideMessages();
+    Preconditioner_Base prec;
+    Cg(B, x, b, prec, iter);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(x_ref(i), x(i), 1.e-8);
+  }
+
+
+  void test_mlt_block()
+  {
+    Nloop_ = 10;
+
+    m_ = 12;
+    n_ = 24;
+    Nelement_ = 0;
+    mlt_block();
+
+    m_ = 36;
+    n_ = 24;
+    Nelement_ = 100;
+    mlt_block();
+
+    m_ = 240;
+    n_ = 120;
+    Nelement_ = 2000;
+    mlt_block();
+
+    // Large enough to be split among several threads.
+    Nloop_ = 1;
+
+    m_ = 3000;
+    n_ = 2004;
+    Nelement_ = 40000;
+    mlt_block();
+  }
+
+
+  template <int B>
+  void check_mlt_block(Matrix<double, General, ArrayRowSparse>& A_array,
+                       Matrix<double, General, RowSparse>& A,
+                       Vector<double>& X, Vector<double>& Y,
+                       Vector<double>& Y_ref, Vector<double>& Z_ref)
+  {
+    int i, j;
+
+    Matrix<double, General, RowBlockSparse<B> > A_block;
+    if (B == 3)
+      Copy(A_array, A_block);
+    else
+      Copy(A, A_block);
+
+    CPPUNIT_ASSERT(A_block.GetM() == m_);
+    CPPUNIT_ASSERT(A_block.GetN() == n_);
+    CPPUNIT_ASSERT(A_block.GetDataSize() == B * B * A_block.GetNbBlocks());
+    CPPUNIT_ASSERT(A_block.GetNonZeros() >= A.GetNonZeros());
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(A_block(i, j) == A(i, j));
+
+    Vector<double> Y_block(Y);
+    MltAdd(1.5, A_block, X, -0.5, Y_block);
+    for (i = 0; i < m_; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_ref(i), Y_block(i), 1.e-12);
+
+    Vector<double> Z(n_);
+    Z.Fill(1.);
+    MltAdd(-2., SeldonTrans, A_block, Y, 0.5, Z);
+    for (j = 0; j < n_; j++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_ref(j), Z(j), 1.e-12);
+
+    // The multithreaded product gives the same result as the sequential
+    // one.
+    Vector<double> Y_seq(m_);
+    SetNumberThreads(1);
+    Mlt(A_block, X, Y_seq);
+    SetNumberThreads(0);
+    Mlt(A_block, X, Y_block);
+    for (i = 0; i < m_; i++)
+      CPPUNIT_ASSERT(Y_seq(i) == Y_block(i));
+  }
+
+
+  void mlt_block()
+  {
+    srand(time(NULL));
+
+    int i, j;
+    double value;
+
+    for (int k = 0; k < Nloop_; k++)
+      {
+        Matrix<double, General, ArrayRowSparse> A_array(m_, n_);
+        for (int l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand()) / double(RAND_MAX);
+            A_array.AddInteraction(i, j, value);
+          }
+
+        Matrix<double, General, RowSparse> A;
+        Copy(A_array, A);
+
+        Vector<double> X(n_), Y(m_), Y_ref(m_);
+        X.FillRand();
+        Mlt(1. / double(RAND_MAX), X);
+        Y_ref.FillRand();
+        Mlt(1. / double(RAND_MAX), Y_ref);
+
+        Vector<double> Z_ref(n_);
+        Z_ref.Fill(1.);
+        MltAdd(-2., SeldonTrans, A, Y_ref, 0.5, Z_ref);
+
+        Y = Y_ref;
+        MltAdd(1.5, A, X, -0.5, Y_ref);
+
+        check_mlt_block<2>(A_array, A, X, Y, Y_ref, Z_ref);
+        check_mlt_block<3>(A_array, A, X, Y, Y_ref, Z_ref);
+        check_mlt_block<4>(A_array, A, X, Y, Y_ref, Z_ref);
+      }
+
+    // The matrix can be used in iterative solvers.
+    int n = 99;
+    Matrix<double, General, ArrayRowSparse> B_array(n, n);
+    for (i = 0; i < n; i++)
+      {
+        B_array.AddInteraction(i, i, 4.);
+        if (i > 0)
+          B_array.AddInteraction(i, i - 1, -1.);
+        if (i < n - 1)
+          B_array.AddInteraction(i, i + 1, -1.);
+      }
+    Matrix<double, General, RowBlockSparse<3> > B;
+    Copy(B_array, B);
+
+    Vector<double> x(n), b(n), x_ref(n);
+    x_ref.Fill();
+    Mlt(B, x_ref, b);
+    x.Zero();
+    Iteration<double> iter(1000, 1e-12);
+    iter.HideMessages();
+    Preconditioner_Base prec;
+    Cg(B, x, b, prec, iter);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(x_ref(i), x(i), 1.e-8);
+  }
+
+
+  void test_mlt_dense()
+  {
+    Nloop_ = 10;
+
+    m_ = 10;
+    n_ = 25;
+    Nelement_ = 0;
+    mlt_dense();
+
+    m_ = 37;
+    n_ = 25;
+    Nelement_ = 100;
+    mlt_dense();
+
+    // Large enough to be split among several threads.
+    Nloop_ = 1;
+
+    m_ = 2000;
+    n_ = 1500;
+    Nelement_ = 20000;
+    mlt_dense();
+  }
+
+
+  void mlt_dense()
+  {
+    srand(time(NULL));
+
+    int i, j, r;
+    double value;
+
+    int nrhs[3] = {1, 5, 16};
+
+    for (int k = 0; k < Nloop_; k++)
+      {
+        Matrix<double, General, ArrayRowSparse> A_array(m_, n_);
+        for (int l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand()) / double(RAND_MAX);
+            A_array.AddInteraction(i, j, value);
+          }
+
+        Matrix<double, General, RowSparse> A;
+        Copy(A_array, A);
+
+        for (int s = 0; s < 3; s++)
+          {
+            Matrix<double, General, RowMajor> B(n_, nrhs[s]), C(m_, nrhs[s]);
+            Matrix<double, General, ColMajor> B_col(n_, nrhs[s]),
+              C_col(m_, nrhs[s]);
+            B.FillRand();
+            Mlt(1. / double(RAND_MAX), B);
+            C.FillRand();
+            Mlt(1. / double(RAND_MAX), C);
+            for (i = 0; i < n_; i++)
+              for (r = 0; r < nrhs[s]; r++)
+                B_col(i, r) = B(i, r);
+            for (i = 0; i < m_; i++)
+              for (r = 0; r < nrhs[s]; r++)
+                C_col(i, r) = C(i, r);
+
+            // Reference: one sparse matrix-vector product per column.
+            Matrix<double, General, RowMajor> C_ref(m_, nrhs[s]);
+            Vector<double> X(n_), Y(m_);
+            for (r = 0; r < nrhs[s]; r++)
+              {
+                for (j = 0; j < n_; j++)
+                  X(j) = B(j, r);
+                for (i = 0; i < m_; i++)
+                  Y(i) = C(i, r);
+                MltAdd(1.5, A, X, -0.5, Y);
+                for (i = 0; i < m_; i++)
+                  C_ref(i, r) = Y(i);
+              }
+
+            MltAdd(1.5, A, B, -0.5, C);
+            MltAdd(1.5, A, B_col, -0.5, C_col);
+            for (i = 0; i < m_; i++)
+              for (r = 0; r < nrhs[s]; r++)
+                {
+                  CPPUNIT_ASSERT(C(i, r) == C_ref(i, r));
+                  CPPUNIT_ASSERT(C_col(i, r) == C_ref(i, r));
+                }
+
+            // The multithreaded product gives the same result as the
+            // sequential one.
+            Matrix<double, General, RowMajor> C_seq(m_, nrhs[s]);
+            SetNumberThreads(1);
+            Mlt(A, B, C_seq);
+            SetNumberThreads(0);
+            Mlt(A, B, C);
+            Mlt(A, B_col, C_col);
+            for (i = 0; i < m_; i++)
+              for (r = 0; r < nrhs[s]; r++)
+                {
+                  CPPUNIT_ASSERT(C_seq(i, r) == C(i, r));
+                  CPPUNIT_ASSERT(C_seq(i, r) == C_col(i, r));
+                }
+          }
+      }
+  }
+
+
+  void test_mlt_long()
+  {
+    Nloop_ = 10;
+
+    m_ = 10;
+    n_ = 25;
+    Nelement_ = 0;
+    mlt_long();
+
+    m_ = 37;
+    n_ = 25;
+    Nelement_ = 100;
+    mlt_long();
+
+    // Large enough to be split among several threads.
+    Nloop_ = 1;
+
+    m_ = 3000;
+    n_ = 2000;
+    Nelement_ = 40000;
+    mlt_long();
+  }
+
+
+  void mlt_long()
+  {
+    srand(time(NULL));
+
+    int i, j;
+    double value;
+
+    for (int k = 0; k < Nloop_; k++)
+      {
+        Matrix<double, General, ArrayRowSparse> A_array(m_, n_);
+        Matrix<double, General, ArrayColSparse> A_array_col(m_, n_);
+        for (int l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand()) / double(RAND_MAX);
+            A_array.AddInteraction(i, j, value);
+            A_array_col.AddInteraction(i, j, value);
+          }
+
+        Matrix<double, General, RowSparse> A;
+        Matrix<double, General, ColSparse> A_col;
+        Copy(A_array, A);
+        Copy(A_array_col, A_col);
+
+        Matrix<double, General, RowLongSparse> A_long, A_long_array;
+        Matrix<double, General, ColLongSparse> A_col_long, A_col_long_array;
+        Copy(A, A_long);
+        Copy(A_array, A_long_array);
+        Copy(A_col, A_col_long);
+        Copy(A_array_col, A_col_long_array);
+
+        CPPUNIT_ASSERT(A_long.GetM() == m_ && A_long.GetN() == n_);
+        CPPUNIT_ASSERT(A_long.GetNonZeros() == long(A.GetNonZeros()));
+        CPPUNIT_ASSERT(A_long_array.GetNonZeros() == long(A.GetNonZeros()));
+        CPPUNIT_ASSERT(A_col_long.GetNonZeros() == long(A.GetNonZeros()));
+        CPPUNIT_ASSERT(A_col_long_array.GetNonZeros()
+                       == long(A.GetNonZeros()));
+        for (i = 0; i < m_; i++)
+          for (j = 0; j < n_; j++)
+            {
+              CPPUNIT_ASSERT(A_long(i, j) == A(i, j));
+              CPPUNIT_ASSERT(A_long_array(i, j) == A(i, j));
+              CPPUNIT_ASSERT(A_col_long(i, j) == A(i, j));
+              CPPUNIT_ASSERT(A_col_long_array(i, j) == A(i, j));
+            }
+
+        // Conversions back to 32-bit storages.
+        Matrix<double, General, RowSparse> B;
+        Matrix<double, General, ColSparse> B_col;
+        Copy(A_long, B);
+        Copy(A_col_long, B_col);
+        CPPUNIT_ASSERT(B.GetNonZeros() == A.GetNonZeros());
+        for (i = 0; i < m_; i++)
+          for (j = 0; j < n_; j++)
+            CPPUNIT_ASSERT(B(i, j) == A(i, j) && B_col(i, j) == A(i, j));
+
+        Vector<double> X(n_), Y(m_), Y_ref(m_);
+        X.FillRand();
+        Mlt(1. / double(RAND_MAX), X);
+        Y_ref.FillRand();
+        Mlt(1. / double(RAND_MAX), Y_ref);
+
+        Vector<double> Z(n_), Z_ref(n_);
+        Z_ref.Fill(1.);
+        MltAdd(-2., SeldonTrans, A, Y_ref, 0.5, Z_ref);
+
+        Y = Y_ref;
+        MltAdd(1.5, A, X, -0.5, Y_ref);
+
+        Vector<double> Y_long(Y);
+        MltAdd(1.5, A_long, X, -0.5, Y_long);
+        for (i = 0; i < m_; i++)
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_ref(i), Y_long(i), 1.e-12);
+        Y_long = Y;
+        MltAdd(1.5, A_col_long, X, -0.5, Y_long);
+        for (i = 0; i < m_; i++)
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_ref(i), Y_long(i), 1.e-12);
+
+        Z.Fill(1.);
+        MltAdd(-2., SeldonTrans, A_long, Y, 0.5, Z);
+        for (j = 0; j < n_; j++)
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_ref(j), Z(j), 1.e-12);
+        Z.Fill(1.);
+        MltAdd(-2., SeldonTrans, A_col_long, Y, 0.5, Z);
+        for (j = 0; j < n_; j++)
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(Z_ref(j), Z(j), 1.e-12);
+
+        // Copies.
+        Matrix<double, General, RowLongSparse> C(A_long);
+        CPPUNIT_ASSERT(C.GetNonZeros() == A_long.GetNonZeros());
+        CPPUNIT_ASSERT(C.GetData() != A_long.GetData()
+                       || A_long.GetNonZeros() == 0);
+        for (i = 0; i < m_; i++)
+          for (j = 0; j < n_; j++)
+            CPPUNIT_ASSERT(C(i, j) == A(i, j));
+      }
+  }
+
+
+  void test_iterative_workspace()
+  {
+    int i, n = 100;
+    Matrix<double, General, ArrayRowSparse> A_array(n, n);
+    for (i = 0; i < n; i++)
+      {
+        A_array.AddInteraction(i, i, 4.);
+        if (i > 0)
+          A_array.AddInteraction(i, i - 1, -1.);
+        if (i < n - 1)
+          A_array.AddInteraction(i, i + 1, -1.5);
+      }
+    Matrix<double, General, RowSparse> A;
+    Copy(A_array, A);
+
+    // Symmetric positive definite matrix, for Cg and MinRes.
+    Matrix<double, General, RowSparse> A_sym;
+    for (i = 0; i < n - 1; i++)
+      A_array.AddInteraction(i, i + 1, 0.5);
+    Copy(A_array, A_sym);
+
+    Vector<double> x(n), b(n), b_sym(n), x_ref(n);
+    x_ref.Fill();
+    Mlt(A, x_ref, b);
+    Mlt(A_sym, x_ref, b_sym);
+    Preconditioner_Base prec;
+    IterativeWorkspace<double, Vector<double> > work;
+
+    // The work vectors are allocated by the first solve only, and they are
+    // shared by the different solvers.
+    double* data = NULL;
+    for (int k = 0; k < 12; k++)
+      {
+        Iteration<double> iter(1000, 1e-12);
+        iter.HideMessages();
+        iter.SetRestart(8);
+        x.Zero();
+        switch (k % 6)
+          {
+          case 0:
+            Gmres(A, x, b, prec, iter, work);
+            break;
+          case 1:
+            BiCgStab(A, x, b, prec, iter, work);
+            break;
+          case 2:
+            Gcr(A, x, b, prec, iter, work);
+            break;
+          case 3:
+            BiCgStabl(A, x, b, prec, iter, work);
+            break;
+          case 4:
+            Cg(A_sym, x, b_sym, prec, iter, work);
+            break;
+          case 5:
+            MinRes(A_sym, x, b_sym, prec, iter, work);
+            break;
+          }
+        CPPUNIT_ASSERT(iter.ErrorCode() == 0);
+        for (i = 0; i < n; i++)
+          CPPUNIT_ASSERT_DOUBLES_EQUAL(x_ref(i), x(i), 1.e-8);
+
+        if (k == 5)
+          data = work.GetVector(0).GetData();
+        else if (k > 5)
+          CPPUNIT_ASSERT(work.GetVector(0).GetData() == data);
+      }
+  }
+
+
+  void test_fused_kernels()
+  {
+    int i, n = 1000;
+    Matrix<double, General, ArrayRowSparse> A_array(n, n);
+    for (i = 0; i < n; i++)
+      {
+        A_array.AddInteraction(i, i, 3.);
+        A_array.AddInteraction(i, (7 * i + 3) % n, -1.);
+      }
+    Matrix<double, General, RowSparse> A;
+    Copy(A_array, A);
+
+    Vector<double> X(n), Y(n), Z(n), W(n), Y_ref(n), W_ref(n);
+    X.FillRand();
+    Mlt(1. / double(RAND_MAX), X);
+    Z.FillRand();
+    Mlt(1. / double(RAND_MAX), Z);
+
+    // Products with a dot product, for compressed and generic matrices.
+    Mlt(A, X, Y_ref);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(DotProd(X, Y_ref), MltDotProd(A, X, Y),
+                                 1.e-10);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(Y(i) == Y_ref(i));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(DotProd(Z, Y_ref),
+                                 MltDotProdConj(Z, A, X, Y), 1.e-10);
+    Y.Zero();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(DotProd(Z, Y_ref),
+                                 MltDotProd(Z, A_array, X, Y), 1.e-10);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(Y(i) == Y_ref(i));
+
+    Vector<complex<double> > Xc(n), Yc(n), Zc(n), Yc_ref(n);
+    for (i = 0; i < n; i++)
+      {
+        Xc(i) = complex<double>(X(i), Z(i));
+        Zc(i) = complex<double>(Z(i) - 0.5, X(i));
+      }
+    Mlt(A, Xc, Yc_ref);
+    complex<double> dot = MltDotProdConj(Zc, A, Xc, Yc);
+    CPPUNIT_ASSERT(abs(dot - DotProdConj(Zc, Yc_ref)) < 1.e-10);
+    dot = MltDotProdConj(A, Xc, Yc);
+    CPPUNIT_ASSERT(abs(dot - DotProdConj(Xc, Yc_ref)) < 1.e-10);
+
+    // Updates of vectors.
+    Y = Y_ref;
+    MltAdd(2., X, -0.5, Y);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2. * X(i) - 0.5 * Y_ref(i), Y(i), 1.e-12);
+    Y.Fill(numeric_limits<double>::quiet_NaN());
+    MltAdd(2., X, 0., Y);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(Y(i) == 2. * X(i));
+    Y = Y_ref;
+    MltAdd(2., X, -1., Z, 3., Y);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(2. * X(i) - Z(i) + 3. * Y_ref(i), Y(i),
+                                   1.e-12);
+
+    Y = Y_ref;
+    W = Y_ref;
+    double norm = AddNorm2(-0.5, X, Y, 1.5, Z, W);
+    Add(-0.5, X, Y_ref);
+    W_ref = W;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(Norm2(W_ref), norm, 1.e-10);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(Y_ref(i), Y(i), 1.e-12);
+    norm = 1.5 * Norm2(W_ref);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(norm, AddNorm2(0.5, W_ref, W), 1.e-10);
+    Yc = Yc_ref;
+    norm = 2. * Norm2(Yc_ref);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(norm, AddNorm2(1., Yc_ref, Yc), 1.e-10);
+  }
 };
@@ -23,6 +23,10 @@
 #include "SeldonSolver.hxx"
 using namespace Seldon;
 
+#ifdef SELDON_WITH_CXX11
+#include <type_traits>
+#endif
+
 
 class SparseMatrixTest: public CppUnit::TestFixture
 {
@@ -33,6 +37,12 @@ class SparseMatrixTest: public CppUnit::TestFixture
   CPPUNIT_TEST(test_permutation);
   CPPUNIT_TEST(test_transposition);
   CPPUNIT_TEST(test_set_rowcol);
+  CPPUNIT_TEST(test_assembly);
+  CPPUNIT_TEST(test_coordinates);
+  CPPUNIT_TEST(test_assembler);
+  CPPUNIT_TEST(test_fixed_pattern);
+  CPPUNIT_TEST(test_sparse_vector);
+  CPPUNIT_TEST(test_swap);
   CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -246,6 +256,105 @@ public:
   }
 
 
+  void test_assembly()
+  {
+    m_ = 15;
+    n_ = 5;
+    Nelement_ = 20;
+    Nloop_ = 10;
+    assembly();
+
+    m_ = 50;
+    n_ = 60;
+    Nelement_ = 500;
+    Nloop_ = 10;
+    assembly();
+
+    m_ = 100;
+    n_ = 100;
+    Nelement_ = 0;
+    Nloop_ = 1;
+    assembly();
+  }
+
+
+  void test_coordinates()
+  {
+    m_ = 7;
+    n_ = 5;
+    Nelement_ = 40;
+    coordinates(0);
+    coordinates(1);
+
+    // Several buckets, and enough entries for several threads.
+    m_ = 3000;
+    n_ = 2500;
+    Nelement_ = 60000;
+    coordinates(0);
+    coordinates(1);
+
+    m_ = 10;
+    n_ = 10;
+    Nelement_ = 0;
+    coordinates(0);
+
+    // Duplicates with a NaN, which is added last.
+    Vector<int> row(4), col(4);
+    Vector<double> val(4);
+    row.Zero();
+    col.Zero();
+    row(3) = col(3) = 1;
+    val(0) = 2.;
+    val(1) = numeric_limits<double>::quiet_NaN();
+    val(2) = 1.;
+    val(3) = 3.;
+    Matrix<double, General, RowSparse> A;
+    ConvertMatrix_from_Coordinates(row, col, val, A);
+    CPPUNIT_ASSERT(A.GetNonZeros() == 2);
+    CPPUNIT_ASSERT(A.GetData()[0] != A.GetData()[0]
+                   && A.GetData()[1] == 3.);
+  }
+
+
+  void test_assembler()
+  {
+    m_ = 500;
+    n_ = 500;
+    Nelement_ = 50000;
+    assembler();
+  }
+
+
+  void test_fixed_pattern()
+  {
+    fixed_pattern<double>();
+    fixed_pattern<complex<double> >();
+  }
+
+
+  void test_sparse_vector()
+  {
+    n_ = 10;
+    Nelement_ = 5;
+    Nloop_ = 20;
+    sparse_vector();
+
+    n_ = 200;
+    Nelement_ = 500;
+    Nloop_ = 10;
+    sparse_vector();
+  }
+
+
+  void test_swap()
+  {
+    m_ = 20;
+    n_ = 15;
+    Nelement_ = 50;
+    swap_matrix();
+  }
+
+
   void set_identity()
   {
     Matrix<double, General, ColSparse> A_col(m_, n_);
@@ -635,4 +744,472 @@ public:
       }
   }
 
+
+  void assembly()
+  {
+    srand(time(NULL));
+
+    int i, j, k, l;
+    double value;
+
+    for (k = 0; k < Nloop_; k++)
+      {
+        Matrix<double, General, RowSparse> A_row(m_, n_), A_ref(m_, n_);
+        Matrix<double, General, ColSparse> A_col(m_, n_);
+        Matrix<double> A_full(m_, n_);
+        A_full.Zero();
+
+        // A few entries are inserted before the assembly.
+        for (l = 0; l < Nelement_ / 4; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand() % 10);
+            A_row.AddInteraction(i, j, value);
+            A_col.AddInteraction(i, j, value);
+            A_ref.AddInteraction(i, j, value);
+            A_full(i, j) += value;
+          }
+
+        A_row.BeginAssembly();
+        A_col.BeginAssembly();
+        CPPUNIT_ASSERT(A_row.IsAssembling());
+        for (l = 0; l < Nelement_; l++)
+          {
+            i = rand() % m_;
+            j = rand() % n_;
+            value = double(rand() % 10);
+            A_row.AddInteraction(i, j, value);
+            A_col.AddInteraction(i, j, value);
+            A_ref.AddInteraction(i, j, value);
+            A_full(i, j) += value;
+
+            // Intermediate merges, and copies of a matrix being assembled.
+            if (l == Nelement_ / 2)
+              {
+                A_row.Assemble();
+                CPPUNIT_ASSERT(A_row.GetBufferSize() == 0);
+                CPPUNIT_ASSERT(A_row.IsAssembling());
+                Matrix<double, General, ColSparse> A_copy(A_col);
+                A_col = A_copy;
+              }
+          }
+        A_row.EndAssembly();
+        A_col.EndAssembly();
+        CPPUNIT_ASSERT(!A_row.IsAssembling());
+        CPPUNIT_ASSERT(A_row.GetBufferSize() == 0);
+
+        // The assembled matrix is the matrix built by direct insertions.
+        CPPUNIT_ASSERT(A_row.GetNonZeros() == A_ref.GetNonZeros());
+        CPPUNIT_ASSERT(A_col.GetNonZeros() == A_ref.GetNonZeros());
+        for (i = 0; i <= m_; i++)
+          CPPUNIT_ASSERT(A_row.GetPtr()[i] == A_ref.GetPtr()[i]);
+        for (l = 0; l < A_ref.GetNonZeros(); l++)
+          {
+            CPPUNIT_ASSERT(A_row.GetInd()[l] == A_ref.GetInd()[l]);
+            CPPUNIT_ASSERT(A_row.GetData()[l] == A_ref.GetData()[l]);
+          }
+        for (i = 0; i < m_; i++)
+          for (j = 0; j < n_; j++)
+            CPPUNIT_ASSERT(A_col(i, j) == A_full(i, j));
+      }
+  }
+
+
+  void coordinates(int index)
+  {
+    int i, j, k;
+    // Entries with duplicates, in random order.
+    Vector<int> row(Nelement_), col(Nelement_);
+    Vector<double> val(Nelement_);
+    Matrix<double, General, ArrayRowSparse> A_ref(m_, n_);
+    Matrix<double, Symmetric, ArrayRowSymSparse> A_sym_ref(m_, n_);
+    for (k = 0; k < Nelement_; k++)
+      {
+        row(k) = rand() % m_;
+        col(k) = rand() % n_;
+        // Multiples of 1/4, so that the sums are exact in any order.
+        val(k) = double(rand() % 16) / 4.;
+        A_ref.AddInteraction(row(k), col(k), val(k));
+        if (row(k) <= col(k))
+          A_sym_ref.AddInteraction(row(k), col(k), val(k));
+        row(k) += index;
+        col(k) += index;
+      }
+
+    Vector<int> row_tmp, col_tmp;
+    Vector<double> val_tmp;
+    Matrix<double, General, RowSparse> A(m_, n_);
+    row_tmp = row;
+    col_tmp = col;
+    val_tmp = val;
+    ConvertMatrix_from_Coordinates(row_tmp, col_tmp, val_tmp, A, index);
+    CPPUNIT_ASSERT(A.GetM() == m_ && A.GetN() == n_);
+    CPPUNIT_ASSERT(A.GetNonZeros() == A_ref.GetNonZeros());
+    CPPUNIT_ASSERT(row_tmp.GetM() == 0 && col_tmp.GetM() == 0);
+    for (i = 0; i < m_; i++)
+      {
+        CPPUNIT_ASSERT(A.GetPtr()[i + 1] - A.GetPtr()[i]
+                       == A_ref.GetRowSize(i));
+        for (j = 0; j < A_ref.GetRowSize(i); j++)
+          {
+            k = A.GetPtr()[i] + j;
+            CPPUNIT_ASSERT(A.GetInd()[k] == A_ref.Index(i, j));
+            CPPUNIT_ASSERT(A.GetData()[k] == A_ref.Value(i, j));
+          }
+      }
+
+    if (Nelement_ == 0)
+      return;
+
+    Matrix<double, General, ColSparse> B;
+    row_tmp = row;
+    col_tmp = col;
+    val_tmp = val;
+    ConvertMatrix_from_Coordinates(row_tmp, col_tmp, val_tmp, B, index);
+    CPPUNIT_ASSERT(B.GetNonZeros() == A_ref.GetNonZeros());
+    for (j = 0; j < B.GetN(); j++)
+      for (k = B.GetPtr()[j]; k < B.GetPtr()[j + 1]; k++)
+        {
+          if (k > B.GetPtr()[j])
+            CPPUNIT_ASSERT(B.GetInd()[k - 1] < B.GetInd()[k]);
+          CPPUNIT_ASSERT(B.GetData()[k] == A_ref(B.GetInd()[k], j));
+        }
+
+    Matrix<double, Symmetric, RowSymSparse> C;
+    row_tmp = row;
+    col_tmp = col;
+    val_tmp = val;
+    ConvertMatrix_from_Coordinates(row_tmp, col_tmp, val_tmp, C, index);
+    CPPUNIT_ASSERT(C.GetNonZeros() == A_sym_ref.GetNonZeros());
+    for (i = 0; i < C.GetM(); i++)
+      for (k = C.GetPtr()[i]; k < C.GetPtr()[i + 1]; k++)
+        CPPUNIT_ASSERT(C.GetData()[k] == A_sym_ref(i, C.GetInd()[k]));
+
+    Matrix<double, Symmetric, ColSymSparse> D;
+    row_tmp = row;
+    col_tmp = col;
+    val_tmp = val;
+    ConvertMatrix_from_Coordinates(row_tmp, col_tmp, val_tmp, D, index);
+    CPPUNIT_ASSERT(D.GetNonZeros() == A_sym_ref.GetNonZeros());
+    for (j = 0; j < D.GetN(); j++)
+      for (k = D.GetPtr()[j]; k < D.GetPtr()[j + 1]; k++)
+        CPPUNIT_ASSERT(D.GetData()[k] == A_sym_ref(D.GetInd()[k], j));
+  }
+
+
+  void assembler()
+  {
+    int i, j, k;
+    Vector<int> row(Nelement_), col(Nelement_);
+    Vector<double> val(Nelement_);
+    Matrix<double, General, ArrayRowSparse> A_ref(m_, n_);
+    Matrix<double, Symmetric, ArrayRowSymSparse> A_sym_ref(m_, n_);
+    for (k = 0; k < Nelement_; k++)
+      {
+        row(k) = rand() % m_;
+        col(k) = rand() % n_;
+        val(k) = double(rand()) / double(RAND_MAX);
+      }
+
+    // Assembly by the threads of a parallel region, and with a single
+    // thread. The results should be identical.
+    SparseAssembler<double> assembler(m_, n_);
+    Matrix<double, General, RowSparse> A, B;
+    Matrix<double, Symmetric, RowSymSparse> C;
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel for
+#endif
+    for (k = 0; k < Nelement_; k++)
+      assembler.AddInteraction(row(k), col(k), val(k));
+    CPPUNIT_ASSERT(assembler.GetNonZeros() == Nelement_);
+    assembler.Assemble(A);
+    CPPUNIT_ASSERT(assembler.GetNonZeros() == 0);
+
+    // The entries are added in reverse order, by rows of one entry.
+    IVect col_k(1);
+    Vector<double> val_k(1);
+    for (k = Nelement_ - 1; k >= 0; k--)
+      {
+        col_k(0) = col(k);
+        val_k(0) = val(k);
+        assembler.AddInteractionRow(row(k), 1, col_k, val_k);
+      }
+    assembler.Assemble(B);
+
+    CPPUNIT_ASSERT(A.GetM() == m_ && A.GetN() == n_);
+    CPPUNIT_ASSERT(A.GetNonZeros() == B.GetNonZeros());
+    for (i = 0; i <= m_; i++)
+      CPPUNIT_ASSERT(A.GetPtr()[i] == B.GetPtr()[i]);
+    for (k = 0; k < A.GetNonZeros(); k++)
+      CPPUNIT_ASSERT(A.GetInd()[k] == B.GetInd()[k]
+                     && A.GetData()[k] == B.GetData()[k]);
+
+    // More threads than buffers: the other threads use the shared buffer.
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel for num_threads(assembler.GetNbBuffers() + 2)
+#endif
+    for (k = 0; k < Nelement_; k++)
+      assembler.AddInteraction(row(k), col(k), val(k));
+    CPPUNIT_ASSERT(assembler.GetNonZeros() == Nelement_);
+    assembler.Assemble(B);
+    CPPUNIT_ASSERT(A.GetNonZeros() == B.GetNonZeros());
+    for (k = 0; k < A.GetNonZeros(); k++)
+      CPPUNIT_ASSERT(A.GetInd()[k] == B.GetInd()[k]
+                     && A.GetData()[k] == B.GetData()[k]);
+
+    for (k = 0; k < Nelement_; k++)
+      {
+        A_ref.AddInteraction(row(k), col(k), val(k));
+        A_sym_ref.AddInteraction(row(k), col(k), val(k));
+      }
+    CPPUNIT_ASSERT(A.GetNonZeros() == A_ref.GetNonZeros());
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < A_ref.GetRowSize(i); j++)
+        CPPUNIT_ASSERT(abs(A(i, A_ref.Index(i, j)) - A_ref.Value(i, j))
+                       < 1.e-12);
+
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel for
+#endif
+    for (k = 0; k < Nelement_; k++)
+      assembler.AddInteraction(row(k), col(k), val(k));
+    assembler.Assemble(C);
+    CPPUNIT_ASSERT(C.GetNonZeros() == A_sym_ref.GetNonZeros());
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < A_sym_ref.GetRowSize(i); j++)
+        CPPUNIT_ASSERT(abs(C(i, A_sym_ref.Index(i, j))
+                           - A_sym_ref.Value(i, j)) < 1.e-12);
+  }
+
+
+  template <class T>
+  void fixed_pattern()
+  {
+    // One-dimensional mesh of elements with three degrees of freedom. The
+    // first degree of freedom is not in the matrix.
+    int e, a, b, k, nb_element = 3000, n = 2 * nb_element;
+    Matrix<int, General, RowMajor> dof(nb_element, 3);
+    for (e = 0; e < nb_element; e++)
+      for (a = 0; a < 3; a++)
+        dof(e, a) = 2 * e + a - 1;
+
+    // Pattern, and reference matrix.
+    Matrix<T, General, ArrayRowSparse> A_ref(n, n);
+    for (e = 0; e < nb_element; e++)
+      for (a = 0; a < 3; a++)
+        for (b = 0; b < 3; b++)
+          if (dof(e, a) >= 0 && dof(e, b) >= 0)
+            A_ref.AddInteraction(dof(e, a), dof(e, b),
+                                 T(double((e + a * b) % 8) / 4.));
+    Matrix<T, General, RowSparse> A;
+    Copy(A_ref, A);
+    A.FillRand();
+
+    CPPUNIT_ASSERT(A.GetPosition(0, 0) == 0);
+    CPPUNIT_ASSERT(A.GetPosition(0, 1) == 1);
+    CPPUNIT_ASSERT(A.GetPosition(0, 2) == -1);
+    CPPUNIT_ASSERT(A.GetPosition(n - 1, n - 1) == A.GetNonZeros() - 1);
+
+    Vector<int> position;
+    A.GetElementPositions(dof, position);
+    CPPUNIT_ASSERT(position.GetM() == 9 * nb_element);
+    CPPUNIT_ASSERT(position(0) == -1 && position(4) == 0);
+
+    // The matrix is computed twice, with the same pattern.
+    for (int step = 0; step < 2; step++)
+      {
+        A.Zero();
+#ifdef SELDON_WITH_OPENMP
+#pragma omp parallel for private(a, b, k)
+#endif
+        for (e = 0; e < nb_element; e++)
+          for (a = 0, k = 9 * e; a < 3; a++)
+            for (b = 0; b < 3; b++, k++)
+              A.AddValueAtomic(position(k),
+                               T(double((e + a * b) % 8) / 4.));
+
+        CPPUNIT_ASSERT(A.GetNonZeros() == A_ref.GetNonZeros());
+        for (int i = 0; i < n; i++)
+          for (int j = 0; j < A_ref.GetRowSize(i); j++)
+            CPPUNIT_ASSERT(A(i, A_ref.Index(i, j)) == A_ref.Value(i, j));
+      }
+
+    A.AddInteractionAtomic(1, 0, T(1.));
+    CPPUNIT_ASSERT(A(1, 0) == A_ref(1, 0) + T(1.));
+  }
+
+
+  void sparse_vector()
+  {
+    srand(time(NULL));
+
+    int i, j, k, l;
+    double value;
+
+    for (k = 0; k < Nloop_; k++)
+      {
+        Vector<double, VectSparse> X, Y, Z;
+        Vector<double> X_full(n_);
+        X_full.Zero();
+
+        // Insertions one by one, in sorted position.
+        for (l = 0; l < Nelement_; l++)
+          {
+            i = rand() % n_;
+            value = double(rand() % 10 + 1);
+            X.AddInteraction(i, value);
+            X_full(i) += value;
+            // Entries appended without sorting.
+            Y.PushBack(i, value);
+            CPPUNIT_ASSERT(X.GetCapacity() >= X.GetM());
+          }
+        Y.Assemble();
+
+        // Insertions by groups of entries.
+        for (l = 0; l < Nelement_; l += 7)
+          {
+            int nb = min(7, Nelement_ - l);
+            IVect index(nb);
+            Vector<double> values(nb);
+            for (j = 0; j < nb; j++)
+              {
+                index(j) = rand() % n_;
+                values(j) = double(rand() % 10 + 1);
+              }
+            Z.AddInteractionRow(nb, index, values);
+            for (j = 0; j < nb; j++)
+              Z.AddInteraction(index(j), -values(j));
+          }
+
+        CPPUNIT_ASSERT(Y.GetM() == X.GetM());
+        for (l = 0; l < X.GetM(); l++)
+          {
+            if (l > 0)
+              CPPUNIT_ASSERT(X.Index(l - 1) < X.Index(l));
+            CPPUNIT_ASSERT(Y.Index(l) == X.Index(l));
+            CPPUNIT_ASSERT(Y.Value(l) == X.Value(l));
+          }
+        for (i = 0; i < n_; i++)
+          {
+            CPPUNIT_ASSERT(X(i) == X_full(i));
+            CPPUNIT_ASSERT(Z(i) == 0.);
+          }
+        for (l = 1; l < Z.GetM(); l++)
+          CPPUNIT_ASSERT(Z.Index(l - 1) < Z.Index(l));
+
+        // Reserved memory is kept by the copies and the insertions.
+        Vector<double, VectSparse> W(X);
+        W.Reserve(X.GetM() + 10);
+        CPPUNIT_ASSERT(W.GetCapacity() >= X.GetM() + 10);
+        for (l = 0; l < X.GetM(); l++)
+          CPPUNIT_ASSERT(W.Index(l) == X.Index(l)
+                         && W.Value(l) == X.Value(l));
+        W.AddInteraction(n_, 1.);
+        CPPUNIT_ASSERT(W.GetM() == X.GetM() + 1);
+        CPPUNIT_ASSERT(W(n_) == 1.);
+
+        // Rows of a sparse matrix are sparse vectors.
+        Matrix<double, General, ArrayRowSparse> A(3, n_);
+        for (l = 0; l < Nelement_; l++)
+          {
+            i = rand() % n_;
+            A.AddInteraction(l % 3, i, 1.);
+          }
+        int nnz = 0;
+        for (i = 0; i < 3; i++)
+          for (j = 0; j < n_; j++)
+            if (A(i, j) != 0.)
+              nnz++;
+        CPPUNIT_ASSERT(A.GetNonZeros() == nnz);
+      }
+  }
+
+
+  void swap_matrix()
+  {
+    srand(time(NULL));
+
+    int i, j, l;
+    Matrix<double, General, RowSparse> A(m_, n_), B;
+    Matrix<double> A_full(m_, n_);
+    A_full.Zero();
+    for (l = 0; l < Nelement_; l++)
+      {
+        i = rand() % m_;
+        j = rand() % n_;
+        A.AddInteraction(i, j, 1.);
+        A_full(i, j) += 1.;
+      }
+    double* data = A.GetData();
+    int* ptr = A.GetPtr();
+
+    Swap(A, B);
+    CPPUNIT_ASSERT(A.GetM() == 0 && A.GetNonZeros() == 0);
+    CPPUNIT_ASSERT(B.GetM() == m_ && B.GetN() == n_);
+    CPPUNIT_ASSERT(B.GetData() == data && B.GetPtr() == ptr);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(B(i, j) == A_full(i, j));
+
+    Matrix<double, General, ArrayRowSparse> C(m_, n_), D;
+    C.AddInteraction(0, 1, 2.);
+    Swap(C, D);
+    CPPUNIT_ASSERT(C.GetM() == 0 && D.GetM() == m_ && D(0, 1) == 2.);
+
+    Matrix<double> E;
+    double* data_full = A_full.GetData();
+    Swap(A_full, E);
+    CPPUNIT_ASSERT(A_full.GetM() == 0 && E.GetData() == data_full);
+
+    // Storages without their own method 'Swap' are exchanged by copy (or by
+    // move).
+    Matrix<double, General, RowComplexSparse> H(m_, n_), K;
+    H.AddInteraction(0, 1, complex<double>(2., 1.));
+    Swap(H, K);
+    CPPUNIT_ASSERT(H.GetM() == 0 && H.GetRealDataSize() == 0);
+    CPPUNIT_ASSERT(K.GetM() == m_ && K(0, 1) == complex<double>(2., 1.));
+
+#ifdef SELDON_WITH_CXX11
+    // Moves do not copy the arrays.
+    Matrix<double, General, RowSparse> F(std::move(B));
+    CPPUNIT_ASSERT(F.GetData() == data && F.GetPtr() == ptr);
+    CPPUNIT_ASSERT(B.GetM() == 0 && B.GetNonZeros() == 0);
+    B = std::move(F);
+    CPPUNIT_ASSERT(B.GetData() == data && F.GetM() == 0);
+
+    Matrix<double> G(std::move(E));
+    CPPUNIT_ASSERT(G.GetData() == data_full && E.GetM() == 0);
+
+    std::vector<Matrix<double, General, RowSparse> > list;
+    for (l = 0; l < 10; l++)
+      list.push_back(B);
+    for (i = 0; i < m_; i++)
+      for (j = 0; j < n_; j++)
+        CPPUNIT_ASSERT(list[0](i, j) == B(i, j)
+                       && list[9](i, j) == B(i, j));
+
+    // The moves do not throw, so that the standard containers move the
+    // matrices, instead of copying them, when they grow.
+    static_assert(std::is_nothrow_move_constructible<Matrix<double> >::value
+                  && std::is_nothrow_move_assignable<Matrix<double> >::value,
+                  "the moves of dense matrices may throw");
+    static_assert(std::is_nothrow_move_constructible<
+                  Matrix<double, General, RowSparse> >::value
+                  && std::is_nothrow_move_assignable<
+                  Matrix<double, General, RowSparse> >::value,
+                  "the moves of sparse matrices may throw");
+    static_assert(std::is_nothrow_move_constructible<
+                  Matrix<double, Symmetric, RowSymSparse> >::value
+                  && std::is_nothrow_move_constructible<
+                  Matrix<double, General, ArrayRowSparse> >::value
+                  && std::is_nothrow_move_constructible<
+                  Matrix<double, General, RowLongSparse> >::value,
+                  "the moves of sparse matrices may throw");
+    double* data_list = list[0].GetData();
+    list.resize(list.capacity() + 1);
+    CPPUNIT_ASSERT(list[0].GetData() == data_list);
+#endif
+  }
+
 };
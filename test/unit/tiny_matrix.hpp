@@ -0,0 +1,231 @@
+// Copyright (C) 2010 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Seldon.hxx"
+#include "SeldonSolver.hxx"
+using namespace Seldon;
+
+
+class TinyMatrixTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(TinyMatrixTest);
+  CPPUNIT_TEST(test_vector);
+  CPPUNIT_TEST(test_mlt);
+  CPPUNIT_TEST(test_inverse);
+  CPPUNIT_TEST(test_add_interaction);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void setUp()
+  {
+  }
+
+
+  void tearDown()
+  {
+  }
+
+
+  void test_vector()
+  {
+    int i;
+    TinyVector<double, 5> X, Y;
+    X.Fill();
+    Y.Fill(2.);
+    CPPUNIT_ASSERT(DotProd(X, Y) == 20.);
+    CPPUNIT_ASSERT(Norm2(TinyVector<double, 2>(3., 4.)) == 5.);
+
+    Add(-1., X, Y);
+    for (i = 0; i < 5; i++)
+      CPPUNIT_ASSERT(Y(i) == 2. - double(i));
+    Y = 2. * X - X;
+    CPPUNIT_ASSERT(Y == X);
+
+    TinyVector<complex<double>, 2> Z(complex<double>(0., 3.),
+                                     complex<double>(4., 0.));
+    CPPUNIT_ASSERT(Norm2(Z) == 5.);
+
+    Vector<double> U;
+    Copy(X, U);
+    CPPUNIT_ASSERT(U.GetM() == 5);
+    U(2) = -1.;
+    Copy(U, Y);
+    for (i = 0; i < 5; i++)
+      CPPUNIT_ASSERT(Y(i) == U(i));
+
+    // Scatter into a global vector.
+    TinyVector<int, 3> index(4, -1, 0);
+    Vector<double> W(6);
+    W.Fill(1.);
+    AddInteraction(index, TinyVector<double, 3>(1., 2., 3.), W);
+    CPPUNIT_ASSERT(W(0) == 4. && W(1) == 1. && W(4) == 2.);
+  }
+
+
+  void test_mlt()
+  {
+    mlt<3, 3, 3>();
+    mlt<6, 6, 6>();
+    mlt<2, 5, 3>();
+  }
+
+
+  void test_inverse()
+  {
+    inverse<1>();
+    inverse<2>();
+    inverse<3>();
+    inverse<4>();
+    inverse<7>();
+
+    TinyMatrix<double, 3, 3> A;
+    A.Fill();
+    CPPUNIT_ASSERT(Det(A) == 0.);
+  }
+
+
+  void test_add_interaction()
+  {
+    int i, j;
+    TinyMatrix<double, 2, 3> A;
+    A.Fill();
+    TinyVector<int, 2> row(3, 1);
+    TinyVector<int, 3> col(0, -1, 2);
+
+    Matrix<double, General, RowMajor> B(4, 4), B_ref(4, 4);
+    B.Zero();
+    B_ref.Zero();
+    for (i = 0; i < 2; i++)
+      for (j = 0; j < 3; j++)
+        if (col(j) >= 0)
+          B_ref(row(i), col(j)) = A(i, j);
+
+    AddInteraction(row, col, A, B);
+    AddInteraction(row, col, A, B);
+    Matrix<double, General, ColMajor> C(4, 4);
+    C.Zero();
+    AddInteraction(row, col, A, C);
+    Matrix<double, General, ArrayRowSparse> D(4, 4);
+    AddInteraction(row, col, A, D);
+    Matrix<double, General, RowSparse> E(4, 4);
+    E.BeginAssembly();
+    AddInteraction(row, col, A, E);
+    AddInteraction(row, col, A, E);
+    E.EndAssembly();
+
+    for (i = 0; i < 4; i++)
+      for (j = 0; j < 4; j++)
+        {
+          CPPUNIT_ASSERT(B(i, j) == 2. * B_ref(i, j));
+          CPPUNIT_ASSERT(C(i, j) == B_ref(i, j));
+          CPPUNIT_ASSERT(D(i, j) == B_ref(i, j));
+          CPPUNIT_ASSERT(E(i, j) == 2. * B_ref(i, j));
+        }
+    CPPUNIT_ASSERT(E.GetNonZeros() == 4);
+  }
+
+
+  template <int m, int n, int k>
+  void mlt()
+  {
+    int i, j, l;
+    TinyMatrix<double, m, k> A;
+    TinyMatrix<double, k, n> B;
+    for (i = 0; i < m; i++)
+      for (l = 0; l < k; l++)
+        A(i, l) = double(i - 2 * l + 1);
+    for (l = 0; l < k; l++)
+      for (j = 0; j < n; j++)
+        B(l, j) = double(3 * l + j - 4);
+
+    TinyMatrix<double, m, n> C = A * B;
+    for (i = 0; i < m; i++)
+      for (j = 0; j < n; j++)
+        {
+          double sum = 0.;
+          for (l = 0; l < k; l++)
+            sum += A(i, l) * B(l, j);
+          CPPUNIT_ASSERT(C(i, j) == sum);
+        }
+
+    TinyVector<double, k> X;
+    X.Fill();
+    TinyVector<double, m> Y = A * X;
+    for (i = 0; i < m; i++)
+      {
+        double sum = 0.;
+        for (l = 0; l < k; l++)
+          sum += A(i, l) * X(l);
+        CPPUNIT_ASSERT(Y(i) == sum);
+      }
+
+    TinyVector<double, k> Z;
+    Mlt(SeldonTrans, A, Y, Z);
+    TinyMatrix<double, k, m> At;
+    Transpose(A, At);
+    CPPUNIT_ASSERT(Z == At * Y);
+
+    // Conversions with the dense matrices.
+    Matrix<double, General, RowMajor> D;
+    Matrix<double, General, ColMajor> E;
+    Copy(A, D);
+    Copy(A, E);
+    TinyMatrix<double, m, k> F, G;
+    Copy(D, F);
+    Copy(E, G);
+    for (i = 0; i < m; i++)
+      for (l = 0; l < k; l++)
+        CPPUNIT_ASSERT(D(i, l) == A(i, l) && E(i, l) == A(i, l)
+                       && F(i, l) == A(i, l) && G(i, l) == A(i, l));
+  }
+
+
+  template <int m>
+  void inverse()
+  {
+    int i, j;
+    TinyMatrix<double, m, m> A, B, I;
+    // A diagonally dominant matrix, with a zero on the first diagonal entry
+    // to force pivoting when m > 1.
+    for (i = 0; i < m; i++)
+      for (j = 0; j < m; j++)
+        A(i, j) = (i == j) ? double(2 * m + i) : double(i + 2 * j + 1) / m;
+    if (m > 1)
+      A(0, 0) = 0.;
+
+    // Reference determinant, computed by the general function.
+    Matrix<double, General, RowMajor> M;
+    Copy(A, M);
+    Vector<int> P;
+    GetLU(M, P);
+    double det = 1.;
+    for (i = 0; i < m; i++)
+      det *= (P(i) != i + 1) ? -M(i, i) : M(i, i);
+    CPPUNIT_ASSERT(abs(Det(A) - det) < 1.e-10 * abs(det));
+
+    B = A;
+    GetInverse(B);
+    I = A * B;
+    for (i = 0; i < m; i++)
+      for (j = 0; j < m; j++)
+        CPPUNIT_ASSERT(abs(I(i, j) - (i == j ? 1. : 0.)) < 1.e-12);
+  }
+};
@@ -0,0 +1,429 @@
+// Copyright (C) 2010 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "Seldon.hxx"
+using namespace Seldon;
+
+#ifdef SELDON_WITH_CXX11
+#include <type_traits>
+#endif
+
+
+class VectorTest: public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(VectorTest);
+  CPPUNIT_TEST(test_append);
+  CPPUNIT_TEST(test_reserve);
+  CPPUNIT_TEST(test_swap);
+  CPPUNIT_TEST(test_aligned_alloc);
+  CPPUNIT_TEST(test_expression);
+  CPPUNIT_TEST(test_blas1);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  int length1_;
+  int length2_;
+
+public:
+  void setUp()
+  {
+  }
+
+
+  void tearDown()
+  {
+  }
+
+
+  void test_append()
+  {
+    length1_ = 1000;
+    append<MallocAlloc<double> >();
+    append<CallocAlloc<double> >();
+    append<NewAlloc<double> >();
+    append<NaNAlloc<double> >();
+    append<MallocObject<double> >();
+    append<AlignedAlloc<double> >();
+
+    length1_ = 100;
+    length2_ = 5;
+    append_vector();
+  }
+
+
+  void test_reserve()
+  {
+    length1_ = 100;
+    reserve<MallocAlloc<double> >();
+    reserve<NewAlloc<double> >();
+    reserve<MallocObject<double> >();
+    reserve<AlignedAlloc<double> >();
+  }
+
+
+  void test_swap()
+  {
+    length1_ = 10;
+    length2_ = 25;
+    swap_vector();
+  }
+
+
+  void test_aligned_alloc()
+  {
+    int i;
+    size_t alignment = SELDON_ALIGNMENT;
+    Vector<double, VectFull, AlignedAlloc<double> > U(7);
+    U.Fill();
+    CPPUNIT_ASSERT(reinterpret_cast<size_t>(U.GetData()) % alignment == 0);
+
+    // The alignment and the elements are preserved by the reallocations.
+    U.Resize(1000);
+    CPPUNIT_ASSERT(reinterpret_cast<size_t>(U.GetData()) % alignment == 0);
+    for (i = 0; i < 7; i++)
+      CPPUNIT_ASSERT(U(i) == double(i));
+    U.Resize(3);
+    CPPUNIT_ASSERT(reinterpret_cast<size_t>(U.GetData()) % alignment == 0);
+    U.ShrinkToFit();
+    CPPUNIT_ASSERT(reinterpret_cast<size_t>(U.GetData()) % alignment == 0);
+    for (i = 0; i < 3; i++)
+      CPPUNIT_ASSERT(U(i) == double(i));
+
+    Matrix<float, General, RowMajor, AlignedAlloc<float> > A(5, 3);
+    CPPUNIT_ASSERT(reinterpret_cast<size_t>(A.GetData()) % alignment == 0);
+    A.Resize(30, 17);
+    CPPUNIT_ASSERT(reinterpret_cast<size_t>(A.GetData()) % alignment == 0);
+  }
+
+
+  void test_expression()
+  {
+    int i, n = 50000;
+    Vector<double> X(n), Y(n), Z(n), W(n);
+    for (i = 0; i < n; i++)
+      {
+        X(i) = double(i % 17) - 3.;
+        Z(i) = 0.5 * double(i % 5);
+        W(i) = double(i % 3);
+      }
+
+    // Long enough to be split among the threads.
+    Y = 2. * X + Z * 3. - W;
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(Y(i) == 2. * X(i) + Z(i) * 3. - W(i));
+
+    // The result is an operand.
+    Y = -(Y - X) + 2 * (X + W);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(Y(i) == -(2. * X(i) + Z(i) * 3. - W(i) - X(i))
+                     + 2. * (X(i) + W(i)));
+
+    // Reallocation and construction.
+    Vector<double, VectFull, NewAlloc<double> > U(3);
+    U = X - Z;
+    Vector<double> V = Z + X;
+    CPPUNIT_ASSERT(U.GetM() == n && V.GetM() == n);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(U(i) == X(i) - Z(i) && V(i) == Z(i) + X(i));
+
+    Vector<complex<double> > C(3), D(3), E;
+    C.Fill();
+    D.Fill(complex<double>(0., 1.));
+    E = complex<double>(1., 1.) * C - 2. * D;
+    for (i = 0; i < 3; i++)
+      CPPUNIT_ASSERT(E(i) == complex<double>(double(i), double(i) - 2.));
+  }
+
+
+  void test_blas1()
+  {
+    // Lengths around the unrolling of the kernels.
+    for (int n = 0; n < 20; n++)
+      {
+        blas1<float>(n, 1.e-5);
+        blas1<double>(n, 1.e-12);
+        blas1_complex<float>(n, 1.e-5);
+        blas1_complex<double>(n, 1.e-12);
+      }
+    blas1<double>(1001, 1.e-12);
+    blas1_complex<double>(1001, 1.e-12);
+  }
+
+
+  template <class T>
+  void blas1(int n, double epsilon)
+  {
+    int i;
+    Vector<T> X(n), Y(n), Z(n);
+    T dot = 0, norm = 0, alpha = 1.5;
+    for (i = 0; i < n; i++)
+      {
+        X(i) = T(i % 7) - T(2.5);
+        Y(i) = T(1) / T(i + 1);
+        dot += X(i) * Y(i);
+        norm += X(i) * X(i);
+      }
+    norm = sqrt(norm);
+
+    T scale = abs(dot) + 1;
+    CPPUNIT_ASSERT(abs(DotProdKernel(n, X.GetData(), Y.GetData()) - dot)
+                   < epsilon * scale);
+    CPPUNIT_ASSERT(abs(DotProd(X, Y) - dot) < epsilon * scale);
+    CPPUNIT_ASSERT(abs(DotProdConj(X, Y) - dot) < epsilon * scale);
+    CPPUNIT_ASSERT(abs(Norm2(X) - norm) < epsilon * (norm + 1));
+
+    Z = Y;
+    Add(alpha, X, Z);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(abs(Z(i) - (Y(i) + alpha * X(i))) < epsilon);
+    Mlt(alpha, Z);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(abs(Z(i) - alpha * (Y(i) + alpha * X(i))) < epsilon);
+  }
+
+
+  template <class T>
+  void blas1_complex(int n, double epsilon)
+  {
+    int i;
+    typedef complex<T> Complex;
+    Vector<Complex> X(n), Y(n), Z(n);
+    Complex dot(0, 0), dot_conj(0, 0), alpha(T(1.5), T(-0.5));
+    T norm = 0;
+    for (i = 0; i < n; i++)
+      {
+        X(i) = Complex(T(i % 7) - T(2.5), T(i % 3));
+        Y(i) = Complex(T(1) / T(i + 1), T(i % 4) - T(1));
+        dot += X(i) * Y(i);
+        dot_conj += conj(X(i)) * Y(i);
+        norm += real(X(i) * conj(X(i)));
+      }
+    norm = sqrt(norm);
+
+    T rr, ii, ri, ir;
+    DotProdKernel(n, X.GetData(), Y.GetData(), rr, ii, ri, ir);
+    T scale = abs(dot) + abs(dot_conj) + 1;
+    CPPUNIT_ASSERT(abs(Complex(rr - ii, ri + ir) - dot) < epsilon * scale);
+    CPPUNIT_ASSERT(abs(DotProd(X, Y) - dot) < epsilon * scale);
+    CPPUNIT_ASSERT(abs(DotProdConj(X, Y) - dot_conj) < epsilon * scale);
+    CPPUNIT_ASSERT(abs(Norm2(X) - norm) < epsilon * (norm + 1));
+
+    Z = Y;
+    Add(alpha, X, Z);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(abs(Z(i) - (Y(i) + alpha * X(i))) < epsilon);
+    Mlt(alpha, Z);
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(abs(Z(i) - alpha * (Y(i) + alpha * X(i))) < 2 * epsilon);
+
+    // Kernels with a real factor.
+    Z = Y;
+    AddKernel(n, Complex(2, 0), X.GetData(), Z.GetData());
+    MltKernel(n, Complex(-1, 0), Z.GetData());
+    for (i = 0; i < n; i++)
+      CPPUNIT_ASSERT(Z(i) == -(Y(i) + T(2) * X(i)));
+  }
+
+
+  template <class Allocator>
+  void append()
+  {
+    int i, capacity;
+    Vector<double, VectFull, Allocator> U, V, W;
+
+    capacity = 0;
+    int nb_reallocation = 0;
+    for (i = 0; i < length1_; i++)
+      {
+        U.Append(double(i));
+        V.PushBack(double(i));
+        CPPUNIT_ASSERT(U.GetM() == i + 1);
+        CPPUNIT_ASSERT(V.GetM() == i + 1);
+        CPPUNIT_ASSERT(V.GetCapacity() >= V.GetM());
+        if (V.GetCapacity() != capacity)
+          nb_reallocation++;
+        capacity = V.GetCapacity();
+      }
+    // The capacity grows geometrically.
+    CPPUNIT_ASSERT(nb_reallocation < 20);
+
+    for (i = 0; i < length1_; i++)
+      {
+        CPPUNIT_ASSERT(U(i) == double(i));
+        CPPUNIT_ASSERT(V(i) == double(i));
+      }
+
+    // Appends a whole vector.
+    W.PushBack(V);
+    W.PushBack(U);
+    CPPUNIT_ASSERT(W.GetM() == 2 * length1_);
+    for (i = 0; i < length1_; i++)
+      CPPUNIT_ASSERT(W(i) == double(i) && W(length1_ + i) == double(i));
+
+    // The copies only allocate what they need.
+    Vector<double, VectFull, Allocator> X(V);
+    CPPUNIT_ASSERT(X.GetCapacity() == length1_);
+    for (i = 0; i < length1_; i++)
+      CPPUNIT_ASSERT(X(i) == double(i));
+  }
+
+
+  void append_vector()
+  {
+    int i, j;
+    Vector<Vector<double>, VectFull, MallocObject<Vector<double> > > V;
+    Vector<double> U(length2_);
+
+    for (i = 0; i < length1_; i++)
+      {
+        U.Fill(double(i));
+        V.PushBack(U);
+      }
+    for (i = 0; i < length1_; i++)
+      {
+        CPPUNIT_ASSERT(V(i).GetM() == length2_);
+        for (j = 0; j < length2_; j++)
+          CPPUNIT_ASSERT(V(i)(j) == double(i));
+      }
+
+    V.Resize(length1_ / 2);
+    V.ShrinkToFit();
+    CPPUNIT_ASSERT(V.GetM() == length1_ / 2);
+    CPPUNIT_ASSERT(V.GetCapacity() == length1_ / 2);
+    for (i = 0; i < length1_ / 2; i++)
+      for (j = 0; j < length2_; j++)
+        CPPUNIT_ASSERT(V(i)(j) == double(i));
+  }
+
+
+  template <class Allocator>
+  void reserve()
+  {
+    int i;
+    Vector<double, VectFull, Allocator> V;
+
+    V.Reserve(length1_);
+    CPPUNIT_ASSERT(V.GetM() == 0);
+    CPPUNIT_ASSERT(V.GetCapacity() == length1_);
+    double* data = V.GetData();
+    for (i = 0; i < length1_; i++)
+      V.PushBack(double(i));
+    // No reallocation within the capacity.
+    CPPUNIT_ASSERT(V.GetData() == data);
+    CPPUNIT_ASSERT(V.GetCapacity() == length1_);
+
+    V.Resize(length1_ / 2);
+    CPPUNIT_ASSERT(V.GetData() == data);
+    V.Resize(length1_);
+    CPPUNIT_ASSERT(V.GetData() == data);
+    for (i = 0; i < length1_ / 2; i++)
+      CPPUNIT_ASSERT(V(i) == double(i));
+
+    V.Resize(length1_ / 2);
+    V.ShrinkToFit();
+    CPPUNIT_ASSERT(V.GetCapacity() == length1_ / 2);
+    for (i = 0; i < length1_ / 2; i++)
+      CPPUNIT_ASSERT(V(i) == double(i));
+
+    // Only the elements are written.
+    V.Reserve(length1_);
+    V.Write("test.bin");
+    Vector<double, VectFull, Allocator> W;
+    W.Read("test.bin");
+    CPPUNIT_ASSERT(W.GetM() == length1_ / 2);
+    for (i = 0; i < length1_ / 2; i++)
+      CPPUNIT_ASSERT(W(i) == double(i));
+
+    V.Clear();
+    CPPUNIT_ASSERT(V.GetM() == 0 && V.GetCapacity() == 0);
+  }
+
+  void swap_vector()
+  {
+    int i;
+    Vector<double> U(length1_), V(length2_);
+    U.Fill();
+    V.Fill(-1.);
+    V.Reserve(2 * length2_);
+    double* data_U = U.GetData();
+    double* data_V = V.GetData();
+
+    // With Blas, Swap(U, V) exchanges the elements of vectors of the same
+    // length.
+    U.Swap(V);
+    CPPUNIT_ASSERT(U.GetM() == length2_ && V.GetM() == length1_);
+    CPPUNIT_ASSERT(U.GetData() == data_V && V.GetData() == data_U);
+    CPPUNIT_ASSERT(U.GetCapacity() == 2 * length2_);
+    for (i = 0; i < length1_; i++)
+      CPPUNIT_ASSERT(V(i) == double(i));
+
+    Vector<double, VectSparse> X, Y;
+    for (i = 0; i < length1_; i++)
+      X.AddInteraction(2 * i, double(i));
+    int* index_X = X.GetIndex();
+    Swap(X, Y);
+    CPPUNIT_ASSERT(X.GetM() == 0 && Y.GetM() == length1_);
+    CPPUNIT_ASSERT(Y.GetIndex() == index_X);
+    for (i = 0; i < length1_; i++)
+      CPPUNIT_ASSERT(Y(2 * i) == double(i));
+
+#ifdef SELDON_WITH_CXX11
+    // Moves do not copy the elements.
+    Vector<double> W(std::move(U));
+    CPPUNIT_ASSERT(W.GetData() == data_V && W.GetM() == length2_);
+    CPPUNIT_ASSERT(U.GetM() == 0);
+    U = std::move(W);
+    CPPUNIT_ASSERT(U.GetData() == data_V && U.GetM() == length2_);
+
+    Vector<Vector<double>, VectFull, NewAlloc<Vector<double> > > Z;
+    for (i = 0; i < length1_; i++)
+      Z.PushBack(Vector<double>(length2_));
+    double* data_Z = Z(0).GetData();
+    for (i = 0; i < 10 * length1_; i++)
+      Z.PushBack(Vector<double>(length2_));
+    // The inner vectors are moved when the outer vector grows.
+    CPPUNIT_ASSERT(Z(0).GetData() == data_Z);
+
+    Vector<double, VectSparse> S(std::move(Y));
+    CPPUNIT_ASSERT(S.GetIndex() == index_X && Y.GetM() == 0);
+
+    // The moves do not throw, so that the standard containers move the
+    // vectors, instead of copying them, when they grow.
+    static_assert(std::is_nothrow_move_constructible<Vector<double> >::value
+                  && std::is_nothrow_move_assignable<Vector<double> >::value,
+                  "the moves of dense vectors may throw");
+    static_assert(std::is_nothrow_move_constructible<
+                  Vector<double, VectSparse> >::value
+                  && std::is_nothrow_move_assignable<
+                  Vector<double, VectSparse> >::value,
+                  "the moves of sparse vectors may throw");
+    static_assert(std::is_nothrow_move_constructible<
+                  Vector<Vector<double>, Collection> >::value
+                  && std::is_nothrow_move_assignable<
+                  Vector<Vector<double>, Collection> >::value,
+                  "the moves of vector collections may throw");
+    std::vector<Vector<double> > list(1, Vector<double>(length2_));
+    double* data_list = list[0].GetData();
+    list.resize(list.capacity() + 1);
+    CPPUNIT_ASSERT(list[0].GetData() == data_list);
+#endif
+  }
+};
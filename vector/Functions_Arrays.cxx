@@ -340,9 +340,30 @@ namespace Seldon
     if (m >= n)
       return;
 
-    int inc = 1, ind = 0, current, i, j, sup;
     Vector<T1, Storage1, Allocator1> tab1t(n - m + 1);
     Vector<T2, Storage2, Allocator2> tab2t(n - m + 1);
+    MergeSort(m, n, tab1, tab2, tab1t, tab2t);
+  }
+
+
+  //! Vector \a tab1 is sorted by using MergeSort algorithm.
+  /*! Sorts array \a tab1 between position m and n. The sort operation affects
+    \a tab2. The work arrays are provided by the caller, so that they may be
+    reused by successive sorts.
+    \param[in,out] tab1t work array, of at least n - m + 1 elements.
+    \param[in,out] tab2t work array, of at least n - m + 1 elements.
+  */
+  template<class T1, class Storage1, class Allocator1,
+	   class T2, class Storage2, class Allocator2>
+  void MergeSort(int m, int n, Vector<T1, Storage1, Allocator1>& tab1,
+		 Vector<T2, Storage2, Allocator2>& tab2,
+		 Vector<T1, Storage1, Allocator1>& tab1t,
+		 Vector<T2, Storage2, Allocator2>& tab2t)
+  {
+    if (m >= n)
+      return;
+
+    int inc = 1, ind = 0, current, i, j, sup;
 
     while (inc < n - m + 1)
       {
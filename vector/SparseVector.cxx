@@ -40,6 +40,7 @@ namespace Seldon
     Vector<T, VectFull, Allocator>()
   {
     index_ = NULL;
+    this->capacity_ = 0;
   }
 
 
@@ -51,6 +52,7 @@ namespace Seldon
   Vector<T, VectSparse, Allocator>::Vector(int i):
     Vector<T, VectFull, Allocator>(i)
   {
+    this->capacity_ = i;
 
 #ifdef SELDON_CHECK_MEMORY
     try
@@ -64,6 +66,7 @@ namespace Seldon
     catch (...)
       {
 	this->m_ = 0;
+	this->capacity_ = 0;
 	this->index_ = NULL;
 	this->data_ = NULL;
       }
@@ -71,6 +74,7 @@ namespace Seldon
     if (this->index_ == NULL)
       {
 	this->m_ = 0;
+	this->capacity_ = 0;
 	this->data_ = NULL;
       }
 
@@ -94,10 +98,27 @@ namespace Seldon
     Vector<T, VectFull, Allocator>()
   {
     this->index_ = NULL;
+    this->capacity_ = 0;
     Copy(V);
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The arrays of \a V are taken over, without any copy.
+    \param V vector to be moved. On exit, it is empty.
+  */
+  template <class T, class Allocator>
+  Vector<T, VectSparse, Allocator>::
+  Vector(Vector<T, VectSparse, Allocator>&& V) noexcept :
+    Vector<T, VectFull, Allocator>()
+  {
+    this->index_ = NULL;
+    Swap(V);
+  }
+#endif
+
+
   /**************
    * DESTRUCTOR *
    **************/
@@ -107,36 +128,7 @@ namespace Seldon
   template <class T, class Allocator>
   Vector<T, VectSparse, Allocator>::~Vector()
   {
-    // 'data_' is released.
-#ifdef SELDON_CHECK_MEMORY
-    try
-      {
-#endif
-	if (this->data_ != NULL)
-	  {
-	    this->vect_allocator_.deallocate(this->data_, this->m_);
-	    this->data_ = NULL;
-	  }
-
-	if (index_ != NULL)
-	  {
-	    index_allocator_.deallocate(index_, this->m_);
-	    index_ = NULL;
-	  }
-
-	this->m_ = 0;
-
-#ifdef SELDON_CHECK_MEMORY
-      }
-    catch (...)
-      {
-	this->data_ = NULL;
-	index_ = NULL;
-	this->m_ = 0;
-	return;
-      }
-#endif
-
+    Clear();
   }
 
 
@@ -147,13 +139,35 @@ namespace Seldon
 
   //! Clears the vector.
   /*!
-    Destructs the vector.
+    Releases the memory of the vector.
     \warning On exit, the vector is an empty vector.
   */
   template <class T, class Allocator>
   inline void Vector<T, VectSparse, Allocator>::Clear()
   {
-    this->~Vector();
+
+#ifdef SELDON_CHECK_MEMORY
+    try
+      {
+#endif
+
+	if (this->data_ != NULL)
+	  this->vect_allocator_.deallocate(this->data_, this->capacity_);
+
+	if (index_ != NULL)
+	  index_allocator_.deallocate(index_, this->capacity_);
+
+#ifdef SELDON_CHECK_MEMORY
+      }
+    catch (...)
+      {
+      }
+#endif
+
+    this->data_ = NULL;
+    index_ = NULL;
+    this->m_ = 0;
+    this->capacity_ = 0;
   }
 
 
@@ -172,6 +186,7 @@ namespace Seldon
       {
 
 	this->m_ = i;
+	this->capacity_ = i;
 
 #ifdef SELDON_CHECK_MEMORY
 	try
@@ -191,6 +206,7 @@ namespace Seldon
 	catch (...)
 	  {
 	    this->m_ = 0;
+	    this->capacity_ = 0;
 	    this->data_ = NULL;
 	    this->index_ = NULL;
 	    return;
@@ -198,6 +214,7 @@ namespace Seldon
 	if (this->data_ == NULL)
 	  {
 	    this->m_ = 0;
+	    this->capacity_ = 0;
 	    this->index_ = NULL;
 	    return;
 	  }
@@ -233,6 +250,78 @@ namespace Seldon
   }
 
 
+  //! Reserves memory for non-zero entries.
+  /*! On exit, at least \a n non-zero entries can be stored without
+    reallocating the arrays of indices and values. The non-zero entries are
+    kept, and the number of non-zero entries is unchanged.
+    \param n number of non-zero entries for which memory is reserved.
+  */
+  template <class T, class Allocator>
+  void Vector<T, VectSparse, Allocator>::Reserve(int n)
+  {
+    if (n <= this->capacity_)
+      return;
+
+    pointer new_data = NULL;
+    int* new_index = NULL;
+
+#ifdef SELDON_CHECK_MEMORY
+    try
+      {
+#endif
+
+	new_data = this->vect_allocator_.allocate(n, this);
+	new_index = index_allocator_.allocate(n, this);
+
+#ifdef SELDON_CHECK_MEMORY
+      }
+    catch (...)
+      {
+	new_data = NULL;
+	new_index = NULL;
+      }
+
+    if (new_data == NULL || new_index == NULL)
+      throw NoMemory("Vector<VectSparse>::Reserve(int)",
+		     string("Unable to allocate memory for ") + to_str(n)
+		     + " non-zero entries (" + to_str(n * sizeof(T))
+		     + " bytes for the values).");
+#endif
+
+    if (this->m_ > 0)
+      {
+	this->vect_allocator_.memorycpy(new_data, this->data_, this->m_);
+	index_allocator_.memorycpy(new_index, index_, this->m_);
+      }
+
+    if (this->data_ != NULL)
+      this->vect_allocator_.deallocate(this->data_, this->capacity_);
+    if (index_ != NULL)
+      index_allocator_.deallocate(index_, this->capacity_);
+
+    this->data_ = new_data;
+    index_ = new_index;
+    this->capacity_ = n;
+  }
+
+
+  //! Releases the memory reserved beyond the number of non-zero entries.
+  /*!
+    On exit, the capacity of the vector is equal to its number of non-zero
+    entries.
+  */
+  template <class T, class Allocator>
+  void Vector<T, VectSparse, Allocator>::ShrinkToFit()
+  {
+    if (this->capacity_ == this->m_)
+      return;
+
+    Vector<T, VectSparse, Allocator> X(*this);
+    SetData(X.GetM(), X.GetData(), X.GetIndex());
+    X.Nullify();
+  }
+
+
   /*! \brief Changes the length of the vector and sets its data array (low
     level method). */
   /*!
@@ -256,6 +345,7 @@ namespace Seldon
     this->Clear();
 
     this->m_ = i;
+    this->capacity_ = i;
 
     this->data_ = data;
     this->index_ = index;
@@ -324,11 +414,27 @@ namespace Seldon
   void Vector<T, VectSparse, Allocator>::Nullify()
   {
     this->m_ = 0;
+    this->capacity_ = 0;
     this->data_ = NULL;
     this->index_ = NULL;
   }
 
 
+  //! Swaps the current vector with another vector.
+  /*!
+    Only the arrays of indices and values are exchanged, together with the
+    numbers of non-zero entries: no entry is copied.
+    \param X vector to be swapped with the current instance.
+  */
+  template <class T, class Allocator>
+  inline void Vector<T, VectSparse, Allocator>
+  ::Swap(Vector<T, VectSparse, Allocator>& X)
+  {
+    Vector<T, VectFull, Allocator>::Swap(X);
+    swap(index_, X.index_);
+  }
+
+
   /**********************************
    * ELEMENT ACCESS AND AFFECTATION *
    **********************************/
@@ -425,10 +531,8 @@ namespace Seldon
   inline typename Vector<T, VectSparse, Allocator>::value_type
   Vector<T, VectSparse, Allocator>::operator() (int i) const
   {
-    int k = 0;
     // Searching for the entry.
-    while (k < this->m_ && index_[k] < i)
-      k++;
+    int k = lower_bound(index_, index_ + this->m_, i) - index_;
 
     if (k >= this->m_ || index_[k] != i)
       // The entry does not exist, a zero is returned.
@@ -447,10 +551,8 @@ namespace Seldon
   inline typename Vector<T, VectSparse, Allocator>::reference
   Vector<T, VectSparse, Allocator>::Get(int i)
   {
-    int k = 0;
     // Searching for the entry.
-    while (k < this->m_ && index_[k] < i)
-      k++;
+    int k = lower_bound(index_, index_ + this->m_, i) - index_;
 
     if (k >= this->m_ || index_[k] != i)
       // The entry does not exist yet, so a zero entry is introduced.
@@ -471,10 +573,8 @@ namespace Seldon
   inline typename Vector<T, VectSparse, Allocator>::const_reference
   Vector<T, VectSparse, Allocator>::Get(int i) const
   {
-    int k = 0;
     // Searching for the entry.
-    while (k < this->m_ && index_[k] < i)
-      k++;
+    int k = lower_bound(index_, index_ + this->m_, i) - index_;
 
     if (k >= this->m_ || index_[k] != i)
       // The entry does not exist, no reference can be returned.
@@ -497,10 +597,8 @@ namespace Seldon
   inline typename Vector<T, VectSparse, Allocator>::reference
   Vector<T, VectSparse, Allocator>::Val(int i)
   {
-    int k = 0;
     // Searching for the entry.
-    while (k < this->m_ && index_[k] < i)
-      k++;
+    int k = lower_bound(index_, index_ + this->m_, i) - index_;
 
     if (k >= this->m_ || index_[k] != i)
       throw WrongArgument("Vector<VectSparse>::Val(int)",
@@ -523,10 +621,8 @@ namespace Seldon
   inline typename Vector<T, VectSparse, Allocator>::const_reference
   Vector<T, VectSparse, Allocator>::Val(int i) const
   {
-    int k = 0;
     // Searching for the entry.
-    while (k < this->m_ && index_[k] < i)
-      k++;
+    int k = lower_bound(index_, index_ + this->m_, i) - index_;
 
     if (k >= this->m_ || index_[k] != i)
       throw WrongArgument("Vector<VectSparse>::Val(int)",
@@ -553,6 +649,23 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a vector (move assignment operator).
+  /*!
+    \param X vector to be moved. No entry is copied: the arrays of \a X and
+    of the current instance are exchanged.
+  */
+  template <class T, class Allocator>
+  inline Vector<T, VectSparse, Allocator>& Vector<T, VectSparse, Allocator>
+  ::operator= (Vector<T, VectSparse, Allocator>&& X) noexcept
+  {
+    Swap(X);
+
+    return *this;
+  }
+#endif
+
+
   //! Duplicates a vector.
   /*!
     \param X vector to be copied.
@@ -617,26 +730,26 @@ namespace Seldon
 
 
   //! Assembles the vector.
-  /*!
+  /*! The non-zero entries are sorted according to their indices, and the
+    values of duplicate entries are added. The entries are sorted in place,
+    and the memory is not reallocated.
     \warning If you use the method AddInteraction, you don't need to call
-    that method.
+    that method. It must be called after PushBack.
   */
   template <class T, class Allocator>
   void Vector<T, VectSparse, Allocator>::Assemble()
   {
     int new_size = this->m_;
-    Vector<T, VectFull, Allocator> values(new_size);
-    Vector<int> index(new_size);
-    for (int i = 0; i < new_size; i++)
-      {
-	values(i) = this->data_[i];
-	index(i) = index_[i];
-      }
+    Vector<T, VectFull, Allocator> values;
+    Vector<int> index;
+    values.SetData(new_size, this->data_);
+    index.SetData(new_size, index_);
 
     Seldon::Assemble(new_size, index, values);
-    index.Resize(new_size);
-    values.Resize(new_size);
-    SetData(values, index);
+
+    values.Nullify();
+    index.Nullify();
+    this->m_ = new_size;
   }
 
 
@@ -669,6 +782,8 @@ namespace Seldon
   //! Adds \a val to the vector component #\a i.
   /*! If the vector has no entry at \a i, a new entry with value \a val is
     introduced. Otherwise, this method sums the existing value and \a val.
+    The entry is searched by bisection. When the arrays are full, their
+    capacity is doubled, so that the reallocations are amortized.
     \param[in] i index of the component.
     \param[in] val value to be added to the vector component \a i.
   */
@@ -676,9 +791,7 @@ namespace Seldon
   void Vector<T, VectSparse, Allocator>::AddInteraction(int i, const T& val)
   {
     // Searching for the position where the entry may be.
-    int pos = 0;
-    while (pos < this->m_ && index_[pos] < i)
-      pos++;
+    int pos = lower_bound(index_, index_ + this->m_, i) - index_;
 
     // If the entry already exists, adds 'val'.
     if (pos < this->m_ && index_[pos] == i)
@@ -687,29 +800,41 @@ namespace Seldon
 	return;
       }
 
-    int k;
+    // If the entry does not exist, the following entries are shifted.
+    if (this->m_ == this->capacity_)
+      Reserve(max(2 * this->capacity_, 4));
 
-    // If the entry does not exist, the vector is reallocated.
-    Vector<T, VectFull, Allocator> new_val(this->m_ + 1);
-    Vector<int> new_ind(this->m_ + 1);
-    for (k = 0; k < pos; k++)
+    for (int k = this->m_; k > pos; k--)
       {
-	new_ind(k) = index_[k];
-	new_val(k) = this->data_[k];
+	index_[k] = index_[k - 1];
+	this->data_[k] = this->data_[k - 1];
       }
 
     // The new entry.
-    new_ind(pos) = i;
-    new_val(pos) = val;
+    index_[pos] = i;
+    this->data_[pos] = val;
+    this->m_++;
+  }
 
-    // Other values in the vector.
-    for (k = pos + 1; k <= this->m_; k++)
-      {
-	new_ind(k) = index_[k - 1];
-	new_val(k) = this->data_[k - 1];
-      }
 
-    SetData(new_val, new_ind);
+  //! Appends an entry to the vector, without sorting.
+  /*! The entry (\a i, \a val) is added at the end of the vector, in
+    constant amortized time, even if the indices are not sorted any more or
+    if an entry already exists at \a i. Assemble must then be called to sort
+    the entries and to add the values of duplicate entries, before the vector
+    is used.
+    \param[in] i index of the component.
+    \param[in] val value of the component \a i.
+  */
+  template <class T, class Allocator> inline
+  void Vector<T, VectSparse, Allocator>::PushBack(int i, const T& val)
+  {
+    if (this->m_ == this->capacity_)
+      Reserve(max(2 * this->capacity_, 4));
+
+    index_[this->m_] = i;
+    this->data_[this->m_] = val;
+    this->m_++;
   }
 
 
@@ -781,38 +906,31 @@ namespace Seldon
 
     if (Nnew > 0)
       {
-	// Some values to be added have no entry yet.
-	Vector<T> new_val(this->m_ + Nnew);
-	Vector<int> new_ind(this->m_ + Nnew);
-	int nb = 0;
-	k = 0;
-	for (int j = 0; j < n; j++)
+	// Some values to be added have no entry yet. They are merged with the
+	// current entries in place, starting from the end.
+	if (this->m_ + Nnew > this->capacity_)
+	  Reserve(max(this->m_ + Nnew, 2 * this->capacity_));
+
+	int nb = this->m_ + Nnew - 1;
+	k = this->m_ - 1;
+	for (int j = n - 1; j >= 0; j--)
 	  if (new_index(j))
 	    {
-	      while (k < this->m_ && index_[k] < index(j))
+	      while (k >= 0 && index_[k] > index(j))
 		{
-		  new_ind(nb) = index_[k];
-		  new_val(nb) = this->data_[k];
-		  k++;
-		  nb++;
+		  index_[nb] = index_[k];
+		  this->data_[nb] = this->data_[k];
+		  k--;
+		  nb--;
 		}
 
 	      // The new entry.
-	      new_ind(nb) = index(j);
-	      new_val(nb) = value(j);
-	      nb++;
+	      index_[nb] = index(j);
+	      this->data_[nb] = value(j);
+	      nb--;
 	    }
 
-	// Last entries.
-	while (k < this->m_)
-	  {
-	    new_ind(nb) = index_[k];
-	    new_val(nb) = this->data_[k];
-	    k++;
-	    nb++;
-	  }
-
-	SetData(new_val, new_ind);
+	this->m_ += Nnew;
       }
   }
 
@@ -25,6 +25,12 @@ namespace Seldon
 
 
   //! Sparse vector class.
+  /*!
+    The indices of the non-zero entries are stored in ascending order. The
+    arrays of indices and values may be larger than the number of non-zero
+    entries (see GetCapacity), so that entries can be inserted without
+    reallocating the arrays every time.
+  */
   template <class T, class Allocator>
   class Vector<T, VectSparse, Allocator>:
     public Vector<T, VectFull, Allocator>
@@ -53,6 +59,9 @@ namespace Seldon
     explicit Vector();
     explicit Vector(int i);
     Vector(const Vector<T, VectSparse, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Vector(Vector<T, VectSparse, Allocator>&& A) noexcept;
+#endif
 
     // Destructor.
     ~Vector();
@@ -61,6 +70,8 @@ namespace Seldon
     // Memory management.
     void Reallocate(int i);
     void Resize(int i);
+    void Reserve(int n);
+    void ShrinkToFit();
     void SetData(int nz, T* data, int* index);
     template<class Allocator2>
     void SetData(Vector<T, VectFull, Allocator2>& data,
@@ -68,6 +79,7 @@ namespace Seldon
     template<class Allocator2>
     void SetData(const Vector<T, VectSparse, Allocator2>& V);
     void Nullify();
+    void Swap(Vector<T, VectSparse, Allocator>& X);
 
     // Element access and affectation.
     reference Value(int i);
@@ -87,6 +99,10 @@ namespace Seldon
     const_reference Val(int i) const;
     Vector<T, VectSparse, Allocator>& operator= (const Vector<T, VectSparse,
 						 Allocator>& X);
+#ifdef SELDON_WITH_CXX11
+    Vector<T, VectSparse, Allocator>& operator= (Vector<T, VectSparse,
+						 Allocator>&& X) noexcept;
+#endif
 #endif
     void Copy(const Vector<T, VectSparse, Allocator>& X);
 
@@ -103,6 +119,7 @@ namespace Seldon
     template<class T0>
     void RemoveSmallEntry(const T0& epsilon);
     void AddInteraction(int i, const T& val);
+    void PushBack(int i, const T& val);
     void AddInteractionRow(int, int*, T*, bool already_sorted = false);
     template<class Allocator0>
     void AddInteractionRow(int nb, Vector<int> col,
@@ -0,0 +1,558 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_TINY_VECTOR_CXX
+
+#include "TinyVector.hxx"
+
+
+namespace Seldon
+{
+
+
+  /************
+   * TINYLOOP *
+   ************/
+
+
+  //! Sets the p first entries of \a x to \a a.
+  template <int p> template <class T0, class T1>
+  inline void TinyLoop<p>::Fill(T0* x, const T1& a)
+  {
+    TinyLoop<p - 1>::Fill(x, a);
+    x[p - 1] = a;
+  }
+
+
+  //! Copies the p first entries of \a x into \a y.
+  template <int p> template <class T0, class T1>
+  inline void TinyLoop<p>::Copy(const T0* x, T1* y)
+  {
+    TinyLoop<p - 1>::Copy(x, y);
+    y[p - 1] = x[p - 1];
+  }
+
+
+  //! Multiplies the p first entries of \a x by \a alpha.
+  template <int p> template <class T0, class T1>
+  inline void TinyLoop<p>::Mlt(const T0& alpha, T1* x)
+  {
+    TinyLoop<p - 1>::Mlt(alpha, x);
+    x[p - 1] *= alpha;
+  }
+
+
+  //! Adds \a alpha times the p first entries of \a x to those of \a y.
+  template <int p> template <class T0, class T1, class T2>
+  inline void TinyLoop<p>::Add(const T0& alpha, const T1* x, T2* y)
+  {
+    TinyLoop<p - 1>::Add(alpha, x, y);
+    y[p - 1] += alpha * x[p - 1];
+  }
+
+
+  //! Adds the scalar product of p entries of \a x and \a y to \a sum.
+  /*!
+    \param[in] x first array.
+    \param[in] incx distance between two entries of \a x.
+    \param[in] y second array.
+    \param[in] incy distance between two entries of \a y.
+    \param[in,out] sum value to which the scalar product is added.
+  */
+  template <int p> template <class T0, class T1, class T2>
+  inline void TinyLoop<p>::DotProd(const T0* x, long incx,
+                                   const T1* y, long incy, T2& sum)
+  {
+    TinyLoop<p - 1>::DotProd(x, incx, y, incy, sum);
+    sum += x[(p - 1) * incx] * y[(p - 1) * incy];
+  }
+
+
+  //! Computes the p first entries of the product of a matrix with a vector.
+  /*!
+    \param[in] a row-major matrix with \a n columns.
+    \param[in] x vector of length \a n.
+    \param[out] y vector whose p first entries are those of \a a \a x.
+  */
+  template <int p> template <int n, class T0, class T1, class T2>
+  inline void TinyLoop<p>::MltVect(const T0* a, const T1* x, T2* y)
+  {
+    TinyLoop<p - 1>::template MltVect<n>(a, x, y);
+    y[p - 1] = T2(0);
+    TinyLoop<n>::DotProd(a + (p - 1) * n, 1L, x, 1L, y[p - 1]);
+  }
+
+
+  //! Computes the p first entries of the product of a transposed matrix
+  //! with a vector.
+  /*!
+    \param[in] a row-major matrix with \a n rows and \a ld columns.
+    \param[in] x vector of length \a n.
+    \param[out] y vector whose p first entries are those of \f$ a^T x \f$.
+  */
+  template <int p> template <int n, int ld, class T0, class T1, class T2>
+  inline void TinyLoop<p>::MltTransVect(const T0* a, const T1* x, T2* y)
+  {
+    TinyLoop<p - 1>::template MltTransVect<n, ld>(a, x, y);
+    y[p - 1] = T2(0);
+    TinyLoop<n>::DotProd(a + p - 1, long(ld), x, 1L, y[p - 1]);
+  }
+
+
+  //! Computes the p first entries of the product of two matrices.
+  /*!
+    \param[in] a row-major matrix with \a k columns.
+    \param[in] b row-major matrix with \a k rows and \a n columns.
+    \param[out] c row-major matrix with \a n columns whose p first entries
+    are those of \a a \a b.
+  */
+  template <int p> template <int n, int k, class T0, class T1, class T2>
+  inline void TinyLoop<p>::MltMatrix(const T0* a, const T1* b, T2* c)
+  {
+    TinyLoop<p - 1>::template MltMatrix<n, k>(a, b, c);
+    c[p - 1] = T2(0);
+    TinyLoop<k>::DotProd(a + ((p - 1) / n) * k, 1L, b + (p - 1) % n,
+                         long(n), c[p - 1]);
+  }
+
+
+  /****************
+   * CONSTRUCTORS *
+   ****************/
+
+
+  //! Default constructor.
+  /*!
+    All entries are set to zero.
+  */
+  template <class T, int m>
+  inline TinyVector<T, m>::TinyVector()
+  {
+    TinyLoop<m>::Fill(data_, T(0));
+  }
+
+
+  //! Constructor.
+  /*!
+    Sets the two first entries; the other entries are set to zero. It does
+    not compile if \a m is less than 2.
+    \param[in] a0 first entry.
+    \param[in] a1 second entry.
+  */
+  template <class T, int m>
+  inline TinyVector<T, m>::TinyVector(const T& a0, const T& a1)
+  {
+    TinySizeCheck<(m >= 2)>::Check();
+    TinyLoop<m>::Fill(data_, T(0));
+    data_[0] = a0;
+    data_[1] = a1;
+  }
+
+
+  //! Constructor.
+  /*!
+    Sets the three first entries; the other entries are set to zero. It does
+    not compile if \a m is less than 3.
+    \param[in] a0 first entry.
+    \param[in] a1 second entry.
+    \param[in] a2 third entry.
+  */
+  template <class T, int m>
+  inline TinyVector<T, m>::TinyVector(const T& a0, const T& a1, const T& a2)
+  {
+    TinySizeCheck<(m >= 3)>::Check();
+    TinyLoop<m>::Fill(data_, T(0));
+    data_[0] = a0;
+    data_[1] = a1;
+    data_[2] = a2;
+  }
+
+
+  /*****************
+   * BASIC METHODS *
+   *****************/
+
+
+  //! Returns the number of rows.
+  template <class T, int m>
+  inline int TinyVector<T, m>::GetM() const
+  {
+    return m;
+  }
+
+
+  //! Returns the length of the vector.
+  template <class T, int m>
+  inline int TinyVector<T, m>::GetLength() const
+  {
+    return m;
+  }
+
+
+  //! Returns the number of elements stored.
+  template <class T, int m>
+  inline int TinyVector<T, m>::GetSize() const
+  {
+    return m;
+  }
+
+
+  //! Returns a pointer to the array of entries.
+  template <class T, int m>
+  inline typename TinyVector<T, m>::pointer TinyVector<T, m>::GetData()
+  {
+    return data_;
+  }
+
+
+  //! Returns a pointer to the array of entries.
+  template <class T, int m>
+  inline typename TinyVector<T, m>::const_pointer
+  TinyVector<T, m>::GetData() const
+  {
+    return data_;
+  }
+
+
+  /**********************************
+   * ELEMENT ACCESS AND AFFECTATION *
+   **********************************/
+
+
+  //! Access operator.
+  /*!
+    \param i index.
+    \return The value of the vector at 'i'.
+  */
+  template <class T, int m>
+  inline typename TinyVector<T, m>::reference
+  TinyVector<T, m>::operator() (int i)
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= m)
+      throw WrongIndex("TinyVector::operator()",
+		       string("Index should be in [0, ") + to_str(m - 1)
+		       + "], but is equal to " + to_str(i) + ".");
+#endif
+
+    return data_[i];
+  }
+
+
+  //! Access operator.
+  /*!
+    \param i index.
+    \return The value of the vector at 'i'.
+  */
+  template <class T, int m>
+  inline typename TinyVector<T, m>::const_reference
+  TinyVector<T, m>::operator() (int i) const
+  {
+
+#ifdef SELDON_CHECK_BOUNDS
+    if (i < 0 || i >= m)
+      throw WrongIndex("TinyVector::operator() const",
+		       string("Index should be in [0, ") + to_str(m - 1)
+		       + "], but is equal to " + to_str(i) + ".");
+#endif
+
+    return data_[i];
+  }
+
+
+  //! Adds a vector to the current vector.
+  template <class T, int m>
+  inline TinyVector<T, m>&
+  TinyVector<T, m>::operator+= (const TinyVector<T, m>& X)
+  {
+    TinyLoop<m>::Add(T(1), X.GetData(), data_);
+    return *this;
+  }
+
+
+  //! Subtracts a vector from the current vector.
+  template <class T, int m>
+  inline TinyVector<T, m>&
+  TinyVector<T, m>::operator-= (const TinyVector<T, m>& X)
+  {
+    TinyLoop<m>::Add(T(-1), X.GetData(), data_);
+    return *this;
+  }
+
+
+  //! Multiplies the current vector by a scalar.
+  template <class T, int m>
+  inline TinyVector<T, m>& TinyVector<T, m>::operator*= (const T& alpha)
+  {
+    TinyLoop<m>::Mlt(alpha, data_);
+    return *this;
+  }
+
+
+  /************************
+   * CONVENIENT FUNCTIONS *
+   ************************/
+
+
+  //! Sets all elements to zero.
+  template <class T, int m>
+  inline void TinyVector<T, m>::Zero()
+  {
+    TinyLoop<m>::Fill(data_, T(0));
+  }
+
+
+  //! Fills the vector with 0, 1, 2, ...
+  template <class T, int m>
+  inline void TinyVector<T, m>::Fill()
+  {
+    for (int i = 0; i < m; i++)
+      data_[i] = i;
+  }
+
+
+  //! Fills the vector with a given value.
+  /*!
+    \param x value to fill the vector with.
+  */
+  template <class T, int m> template <class T0>
+  inline void TinyVector<T, m>::Fill(const T0& x)
+  {
+    TinyLoop<m>::Fill(data_, T(x));
+  }
+
+
+  //! Fills the vector randomly.
+  template <class T, int m>
+  inline void TinyVector<T, m>::FillRand()
+  {
+    for (int i = 0; i < m; i++)
+      data_[i] = rand();
+  }
+
+
+  //! Displays the vector.
+  template <class T, int m>
+  void TinyVector<T, m>::Print() const
+  {
+    for (int i = 0; i < m; i++)
+      cout << data_[i] << "\t";
+  }
+
+
+  /*************
+   * FUNCTIONS *
+   *************/
+
+
+  //! Returns the sum of two vectors.
+  template <class T, int m>
+  inline TinyVector<T, m> operator+ (const TinyVector<T, m>& X,
+                                     const TinyVector<T, m>& Y)
+  {
+    TinyVector<T, m> Z(X);
+    Z += Y;
+    return Z;
+  }
+
+
+  //! Returns the difference of two vectors.
+  template <class T, int m>
+  inline TinyVector<T, m> operator- (const TinyVector<T, m>& X,
+                                     const TinyVector<T, m>& Y)
+  {
+    TinyVector<T, m> Z(X);
+    Z -= Y;
+    return Z;
+  }
+
+
+  //! Returns the product of a vector by a scalar.
+  template <class T, int m>
+  inline TinyVector<T, m> operator* (const T& alpha,
+                                     const TinyVector<T, m>& X)
+  {
+    TinyVector<T, m> Z(X);
+    Z *= alpha;
+    return Z;
+  }
+
+
+  //! Returns the product of a vector by a scalar.
+  template <class T, int m>
+  inline TinyVector<T, m> operator* (const TinyVector<T, m>& X,
+                                     const T& alpha)
+  {
+    TinyVector<T, m> Z(X);
+    Z *= alpha;
+    return Z;
+  }
+
+
+  //! Returns true if the two vectors are equal.
+  template <class T, int m>
+  inline bool operator== (const TinyVector<T, m>& X,
+                          const TinyVector<T, m>& Y)
+  {
+    for (int i = 0; i < m; i++)
+      if (X(i) != Y(i))
+        return false;
+    return true;
+  }
+
+
+  //! Multiplies a vector by a scalar.
+  /*!
+    \param[in] alpha scalar.
+    \param[in,out] X vector to be multiplied.
+  */
+  template <class T0, class T1, int m>
+  inline void Mlt(const T0 alpha, TinyVector<T1, m>& X)
+  {
+    TinyLoop<m>::Mlt(alpha, X.GetData());
+  }
+
+
+  //! Adds two vectors.
+  /*!
+    It performs \f$ Y = \alpha X + Y \f$.
+    \param[in] alpha scalar.
+    \param[in] X vector.
+    \param[in,out] Y vector.
+  */
+  template <class T0, class T1, class T2, int m>
+  inline void Add(const T0 alpha, const TinyVector<T1, m>& X,
+                  TinyVector<T2, m>& Y)
+  {
+    TinyLoop<m>::Add(alpha, X.GetData(), Y.GetData());
+  }
+
+
+  //! Scalar product between two vectors.
+  /*!
+    \param[in] X first vector.
+    \param[in] Y second vector.
+    \return The scalar product between \a X and \a Y.
+  */
+  template <class T1, class T2, int m>
+  inline T1 DotProd(const TinyVector<T1, m>& X, const TinyVector<T2, m>& Y)
+  {
+    T1 sum(0);
+    TinyLoop<m>::DotProd(X.GetData(), 1L, Y.GetData(), 1L, sum);
+    return sum;
+  }
+
+
+  //! Returns the Euclidean norm of a vector.
+  template <class T, int m>
+  inline T Norm2(const TinyVector<T, m>& X)
+  {
+    return sqrt(DotProd(X, X));
+  }
+
+
+  //! Returns the Euclidean norm of a complex vector.
+  template <class T, int m>
+  inline T Norm2(const TinyVector<complex<T>, m>& X)
+  {
+    T sum(0);
+    for (int i = 0; i < m; i++)
+      sum += real(X(i)) * real(X(i)) + imag(X(i)) * imag(X(i));
+    return sqrt(sum);
+  }
+
+
+  //! Copies a tiny vector into a vector.
+  /*!
+    \param[in] X vector to be copied.
+    \param[out] Y vector of length \a m, copy of \a X.
+  */
+  template <class T1, int m, class T2, class Allocator2>
+  inline void Copy(const TinyVector<T1, m>& X,
+                   Vector<T2, VectFull, Allocator2>& Y)
+  {
+    Y.Reallocate(m);
+    TinyLoop<m>::Copy(X.GetData(), Y.GetData());
+  }
+
+
+  //! Copies a vector into a tiny vector.
+  /*!
+    \param[in] X vector of length \a m.
+    \param[out] Y copy of \a X.
+  */
+  template <class T1, class Allocator1, class T2, int m>
+  inline void Copy(const Vector<T1, VectFull, Allocator1>& X,
+                   TinyVector<T2, m>& Y)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (X.GetM() != m)
+      throw WrongDim("Copy(X, Y)", string("The vector X should have ")
+                     + to_str(m) + " entries, but it has "
+                     + to_str(X.GetM()) + " entries.");
+#endif
+
+    TinyLoop<m>::Copy(X.GetData(), Y.GetData());
+  }
+
+
+  //! Adds a local vector to a global vector.
+  /*!
+    It performs \f$ Y_{index(i)} = Y_{index(i)} + X_i \f$ for every \a i,
+    e.g. to assemble the contribution of an element in a finite element
+    code. The entries whose index is negative are skipped.
+    \param[in] index global indices of the entries of \a X.
+    \param[in] X local vector.
+    \param[in,out] Y global vector.
+  */
+  template <int m, class T1, class T2, class Allocator2>
+  inline void AddInteraction(const TinyVector<int, m>& index,
+                             const TinyVector<T1, m>& X,
+                             Vector<T2, VectFull, Allocator2>& Y)
+  {
+    for (int i = 0; i < m; i++)
+      if (index(i) >= 0)
+        Y(index(i)) += X(i);
+  }
+
+
+  //! Writes a tiny vector in an output stream.
+  /*!
+    All elements are written, separated by tabulations.
+    \param out output stream.
+    \param X vector to be written.
+    \return The updated stream.
+  */
+  template <class T, int m>
+  ostream& operator << (ostream& out, const TinyVector<T, m>& X)
+  {
+    for (int i = 0; i < m - 1; i++)
+      out << X(i) << '\t';
+    if (m != 0)
+      out << X(m - 1);
+
+    return out;
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_TINY_VECTOR_CXX
+#endif
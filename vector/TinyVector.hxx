@@ -0,0 +1,223 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_TINY_VECTOR_HXX
+
+namespace Seldon
+{
+
+
+  //! Loops over p entries, unrolled at compile time.
+  /*!
+    The loop on the entries p - 1, p - 2, ..., 0 is replaced by the
+    recursive instantiation of TinyLoop<p - 1>, ..., TinyLoop<0>, which does
+    nothing. The entries are always processed in increasing order. These
+    functions are used by TinyVector and TinyMatrix on their arrays.
+  */
+  template <int p>
+  class TinyLoop
+  {
+  public:
+    template <class T0, class T1>
+    static void Fill(T0* x, const T1& a);
+    template <class T0, class T1>
+    static void Copy(const T0* x, T1* y);
+    template <class T0, class T1>
+    static void Mlt(const T0& alpha, T1* x);
+    template <class T0, class T1, class T2>
+    static void Add(const T0& alpha, const T1* x, T2* y);
+    template <class T0, class T1, class T2>
+    static void DotProd(const T0* x, long incx, const T1* y, long incy,
+                        T2& sum);
+
+    template <int n, class T0, class T1, class T2>
+    static void MltVect(const T0* a, const T1* x, T2* y);
+    template <int n, int ld, class T0, class T1, class T2>
+    static void MltTransVect(const T0* a, const T1* x, T2* y);
+    template <int n, int k, class T0, class T1, class T2>
+    static void MltMatrix(const T0* a, const T1* b, T2* c);
+  };
+
+
+  //! End of the unrolled loops.
+  template <>
+  class TinyLoop<0>
+  {
+  public:
+    template <class T0, class T1>
+    static void Fill(T0*, const T1&)
+    {
+    }
+
+    template <class T0, class T1>
+    static void Copy(const T0*, T1*)
+    {
+    }
+
+    template <class T0, class T1>
+    static void Mlt(const T0&, T1*)
+    {
+    }
+
+    template <class T0, class T1, class T2>
+    static void Add(const T0&, const T1*, T2*)
+    {
+    }
+
+    template <class T0, class T1, class T2>
+    static void DotProd(const T0*, long, const T1*, long, T2&)
+    {
+    }
+
+    template <int n, class T0, class T1, class T2>
+    static void MltVect(const T0*, const T1*, T2*)
+    {
+    }
+
+    template <int n, int ld, class T0, class T1, class T2>
+    static void MltTransVect(const T0*, const T1*, T2*)
+    {
+    }
+
+    template <int n, int k, class T0, class T1, class T2>
+    static void MltMatrix(const T0*, const T1*, T2*)
+    {
+    }
+  };
+
+
+  //! Compile-time check on the size of a tiny vector or matrix.
+  /*!
+    TinySizeCheck<false> is not defined, so that
+    'TinySizeCheck<condition>::Check()' does not compile when the condition
+    is false.
+  */
+  template <bool condition>
+  class TinySizeCheck;
+
+
+  //! Compile-time check that succeeded.
+  template <>
+  class TinySizeCheck<true>
+  {
+  public:
+    static void Check()
+    {
+    }
+  };
+
+
+  //! Vector of fixed size, allocated on the stack.
+  /*!
+    The length \a m of the vector is known at compile time, so that the
+    entries are stored in an array member (no dynamic allocation occurs) and
+    the operations are unrolled by TinyLoop. This class is meant for many
+    small vectors, e.g. the local vectors of the elements in a finite element
+    code. The entries are set to zero by the default constructor.
+  */
+  template <class T, int m>
+  class TinyVector
+  {
+    // typedef declaration.
+  public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+
+    // Attributes.
+  protected:
+    T data_[m];
+
+    // Methods.
+  public:
+    // Constructors.
+    TinyVector();
+    TinyVector(const T& a0, const T& a1);
+    TinyVector(const T& a0, const T& a1, const T& a2);
+
+    // Basic methods.
+    int GetM() const;
+    int GetLength() const;
+    int GetSize() const;
+    pointer GetData();
+    const_pointer GetData() const;
+
+    // Element access and affectation.
+    reference operator() (int i);
+    const_reference operator() (int i) const;
+    TinyVector<T, m>& operator+= (const TinyVector<T, m>& X);
+    TinyVector<T, m>& operator-= (const TinyVector<T, m>& X);
+    TinyVector<T, m>& operator*= (const T& alpha);
+
+    // Convenient functions.
+    void Zero();
+    void Fill();
+    template <class T0>
+    void Fill(const T0& x);
+    void FillRand();
+    void Print() const;
+  };
+
+
+  template <class T, int m>
+  TinyVector<T, m> operator+ (const TinyVector<T, m>& X,
+                              const TinyVector<T, m>& Y);
+  template <class T, int m>
+  TinyVector<T, m> operator- (const TinyVector<T, m>& X,
+                              const TinyVector<T, m>& Y);
+  template <class T, int m>
+  TinyVector<T, m> operator* (const T& alpha, const TinyVector<T, m>& X);
+  template <class T, int m>
+  TinyVector<T, m> operator* (const TinyVector<T, m>& X, const T& alpha);
+  template <class T, int m>
+  bool operator== (const TinyVector<T, m>& X, const TinyVector<T, m>& Y);
+
+  template <class T0, class T1, int m>
+  void Mlt(const T0 alpha, TinyVector<T1, m>& X);
+  template <class T0, class T1, class T2, int m>
+  void Add(const T0 alpha, const TinyVector<T1, m>& X,
+           TinyVector<T2, m>& Y);
+  template <class T1, class T2, int m>
+  T1 DotProd(const TinyVector<T1, m>& X, const TinyVector<T2, m>& Y);
+  template <class T, int m>
+  T Norm2(const TinyVector<T, m>& X);
+  template <class T, int m>
+  T Norm2(const TinyVector<complex<T>, m>& X);
+
+  template <class T1, int m, class T2, class Allocator2>
+  void Copy(const TinyVector<T1, m>& X, Vector<T2, VectFull, Allocator2>& Y);
+  template <class T1, class Allocator1, class T2, int m>
+  void Copy(const Vector<T1, VectFull, Allocator1>& X, TinyVector<T2, m>& Y);
+  template <int m, class T1, class T2, class Allocator2>
+  void AddInteraction(const TinyVector<int, m>& index,
+                      const TinyVector<T1, m>& X,
+                      Vector<T2, VectFull, Allocator2>& Y);
+
+  template <class T, int m>
+  ostream& operator << (ostream& out, const TinyVector<T, m>& X);
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_TINY_VECTOR_HXX
+#endif
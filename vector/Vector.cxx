@@ -212,6 +212,7 @@ namespace Seldon
   Vector<T, VectFull, Allocator>::Vector():
     Vector_Base<T, Allocator>()
   {
+    capacity_ = 0;
   }
 
 
@@ -223,6 +224,7 @@ namespace Seldon
   Vector<T, VectFull, Allocator>::Vector(int i):
     Vector_Base<T, Allocator>(i)
   {
+    capacity_ = i;
 
 #ifdef SELDON_CHECK_MEMORY
     try
@@ -239,7 +241,10 @@ namespace Seldon
 	this->data_ = NULL;
       }
     if (this->data_ == NULL)
-      this->m_ = 0;
+      {
+	this->m_ = 0;
+	capacity_ = 0;
+      }
     if (this->data_ == NULL && i != 0)
       throw NoMemory("Vector<VectFull>::Vector(int)",
 		     string("Unable to allocate memory for a vector of size ")
@@ -266,6 +271,7 @@ namespace Seldon
   ::Vector(int i, typename Vector<T, VectFull, Allocator>::pointer data):
     Vector_Base<T, Allocator>()
   {
+    capacity_ = 0;
     SetData(i, data);
   }
 
@@ -279,6 +285,7 @@ namespace Seldon
   Vector(const Vector<T, VectFull, Allocator>& V):
     Vector_Base<T, Allocator>(V)
   {
+    capacity_ = V.GetM();
 
 #ifdef SELDON_CHECK_MEMORY
     try
@@ -295,7 +302,10 @@ namespace Seldon
 	this->data_ = NULL;
       }
     if (this->data_ == NULL)
-      this->m_ = 0;
+      {
+	this->m_ = 0;
+	capacity_ = 0;
+      }
     if (this->data_ == NULL && V.GetM() != 0)
       throw NoMemory("Vector<VectFull>::Vector(Vector<VectFull>&)",
 		     string("Unable to allocate memory for a vector of size ")
@@ -308,15 +318,47 @@ namespace Seldon
   }
 
 
+  //! Builds a vector from an expression.
+  /*!
+    \param X expression, e.g. 2. * U - V, evaluated in a single loop.
+  */
+  template <class T, class Allocator>
+  template <class E>
+  Vector<T, VectFull, Allocator>::Vector(const VectorExpression<E>& X):
+    Vector_Base<T, Allocator>()
+  {
+    capacity_ = 0;
+    Seldon::Copy(X, *this);
+  }
+
+
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The data array of \a V is taken over, without any copy.
+    \param V vector to be moved. On exit, it is empty.
+  */
+  template <class T, class Allocator>
+  Vector<T, VectFull, Allocator>::
+  Vector(Vector<T, VectFull, Allocator>&& V) noexcept:
+    Vector_Base<T, Allocator>()
+  {
+    capacity_ = 0;
+    Swap(V);
+  }
+#endif
+
+
   /**************
    * DESTRUCTOR *
    **************/
 
 
   //! Destructor.
+  /*! The whole allocated memory (see 'GetCapacity') is released. */
   template <class T, class Allocator>
   Vector<T, VectFull, Allocator>::~Vector()
   {
+    Clear();
   }
 
 
@@ -327,13 +369,31 @@ namespace Seldon
 
   //! Clears the vector.
   /*!
-    Destructs the vector.
+    Releases the memory of the vector.
     \warning On exit, the vector is an empty vector.
   */
   template <class T, class Allocator>
   inline void Vector<T, VectFull, Allocator>::Clear()
   {
-    this->~Vector();
+
+#ifdef SELDON_CHECK_MEMORY
+    try
+      {
+#endif
+
+	if (this->data_ != NULL)
+	  this->vect_allocator_.deallocate(this->data_, capacity_);
+
+#ifdef SELDON_CHECK_MEMORY
+      }
+    catch (...)
+      {
+      }
+#endif
+
+    this->m_ = 0;
+    this->data_ = NULL;
+    capacity_ = 0;
   }
 
 
@@ -352,6 +412,7 @@ namespace Seldon
       {
 
 	this->m_ = i;
+	capacity_ = i;
 
 #ifdef SELDON_CHECK_MEMORY
 	try
@@ -368,11 +429,13 @@ namespace Seldon
 	  {
 	    this->m_ = 0;
 	    this->data_ = NULL;
+	    capacity_ = 0;
 	    return;
 	  }
 	if (this->data_ == NULL)
 	  {
 	    this->m_ = 0;
+	    capacity_ = 0;
 	    return;
 	  }
 #endif
@@ -383,7 +446,9 @@ namespace Seldon
 
   //! Changes the length of the vector, and keeps previous values.
   /*!
-    Reallocates the vector to size i. Previous values are kept.
+    Reallocates the vector to size i. Previous values are kept. No
+    reallocation is performed if 'n' does not exceed the capacity of the
+    vector.
     \param n new length of the vector.
   */
   template <class T, class Allocator>
@@ -393,12 +458,60 @@ namespace Seldon
     if (n == this->m_)
       return;
 
+    if (n > capacity_)
+      Reserve(n);
+
+    this->m_ = n;
+  }
+
+
+  //! Reserves memory for a given number of elements.
+  /*!
+    After this call, at least 'n' elements can be stored without any
+    reallocation. The length of the vector and its elements are unchanged.
+    \param n number of elements for which memory is reserved.
+  */
+  template <class T, class Allocator>
+  void Vector<T, VectFull, Allocator>::Reserve(int n)
+  {
+    if (n <= capacity_)
+      return;
+
     Vector<T, VectFull, Allocator> X_new(n);
-    for (int i = 0; i < min(this->m_, n); i++)
-      X_new(i) = this->data_[i];
+    for (int i = 0; i < this->m_; i++)
+#ifdef SELDON_WITH_CXX11
+      X_new.data_[i] = std::move(this->data_[i]);
+#else
+      X_new.data_[i] = this->data_[i];
+#endif
 
+    int m = this->m_;
     SetData(n, X_new.GetData());
     X_new.Nullify();
+    this->m_ = m;
+  }
+
+
+  //! Releases the memory reserved beyond the length of the vector.
+  /*!
+    On exit, the capacity of the vector is equal to its length.
+  */
+  template <class T, class Allocator>
+  void Vector<T, VectFull, Allocator>::ShrinkToFit()
+  {
+    if (capacity_ == this->m_)
+      return;
+
+    Vector<T, VectFull, Allocator> X_new(this->m_);
+    for (int i = 0; i < this->m_; i++)
+#ifdef SELDON_WITH_CXX11
+      X_new.data_[i] = std::move(this->data_[i]);
+#else
+      X_new.data_[i] = this->data_[i];
+#endif
+
+    SetData(this->m_, X_new.GetData());
+    X_new.Nullify();
   }
 
 
@@ -424,6 +537,7 @@ namespace Seldon
     this->Clear();
 
     this->m_ = i;
+    capacity_ = i;
 
     this->data_ = data;
   }
@@ -462,6 +576,22 @@ namespace Seldon
   {
     this->m_ = 0;
     this->data_ = NULL;
+    capacity_ = 0;
+  }
+
+
+  //! Swaps the current vector with another vector.
+  /*!
+    Only the data arrays and the lengths are exchanged: no element is copied.
+    \param X vector to be swapped with the current instance.
+  */
+  template <class T, class Allocator>
+  inline void Vector<T, VectFull, Allocator>
+  ::Swap(Vector<T, VectFull, Allocator>& X)
+  {
+    swap(this->m_, X.m_);
+    swap(this->data_, X.data_);
+    swap(capacity_, X.capacity_);
   }
 
 
@@ -570,6 +700,40 @@ namespace Seldon
   }
 
 
+  //! Evaluates an expression (assignment operator).
+  /*!
+    \param X expression, e.g. 2. * U - V. The entries are computed in a
+    single loop, without temporary vector, and the current vector may appear
+    in the expression.
+  */
+  template <class T, class Allocator>
+  template <class E>
+  inline Vector<T, VectFull, Allocator>& Vector<T, VectFull, Allocator>
+  ::operator= (const VectorExpression<E>& X)
+  {
+    Seldon::Copy(X, *this);
+
+    return *this;
+  }
+
+
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the data of a vector (move assignment operator).
+  /*!
+    \param X vector to be moved. No element is copied: the data arrays of
+    \a X and of the current instance are exchanged.
+  */
+  template <class T, class Allocator>
+  inline Vector<T, VectFull, Allocator>& Vector<T, VectFull, Allocator>
+  ::operator= (Vector<T, VectFull, Allocator>&& X) noexcept
+  {
+    Swap(X);
+
+    return *this;
+  }
+#endif
+
+
   //! Duplicates a vector.
   /*!
     \param X vector to be copied.
@@ -618,27 +782,30 @@ namespace Seldon
   //! Appends an element to the vector.
   /*!
     \param x element to be appended.
-    \warning This method will only work if the allocator preserves the
-    elements while reallocating.
+    \note When the vector is full, its capacity is doubled, so that appending
+    n elements costs O(n) operations.
   */
   template <class T, class Allocator>
   inline void Vector<T, VectFull, Allocator>::Append(const T& x)
   {
-    int i = this->GetLength();
-    this->Reallocate(i + 1);
-    this->data_[i] = x;
+    if (this->m_ == capacity_)
+      Reserve(max(2 * capacity_, 4));
+    this->data_[this->m_++] = x;
   }
 
 
   //! Appends an element at the end of the vector.
   /*!
     \param x element to be appended.
+    \note When the vector is full, its capacity is doubled, so that appending
+    n elements costs O(n) operations.
   */
   template <class T, class Allocator> template<class T0>
   inline void Vector<T, VectFull, Allocator>::PushBack(const T0& x)
   {
-    Resize(this->m_+1);
-    this->data_[this->m_-1] = x;
+    if (this->m_ == capacity_)
+      Reserve(max(2 * capacity_, 4));
+    this->data_[this->m_++] = x;
   }
 
 
@@ -651,7 +818,9 @@ namespace Seldon
   ::PushBack(const Vector<T, VectFull, Allocator0>& X)
   {
     int Nold = this->m_;
-    Resize(this->m_ + X.GetM());
+    if (this->m_ + X.GetM() > capacity_)
+      Reserve(max(this->m_ + X.GetM(), 2 * capacity_));
+    this->m_ += X.GetM();
     for (int i = 0; i < X.GetM(); i++)
       this->data_[Nold+i] = X(i);
   }
@@ -673,6 +842,18 @@ namespace Seldon
   }
 
 
+  //! Returns the number of elements that can be stored without reallocation.
+  /*!
+    \return The number of elements allocated in memory, which is greater
+    than or equal to the length of the vector.
+  */
+  template <class T, class Allocator>
+  inline int Vector<T, VectFull, Allocator>::GetCapacity() const
+  {
+    return capacity_;
+  }
+
+
   /************************
    * CONVENIENT FUNCTIONS *
    ************************/
@@ -85,7 +85,9 @@ namespace Seldon
 
   //! Full vector class.
   /*!
-    Basic vector class (i.e. not sparse).
+    Basic vector class (i.e. not sparse). The memory allocated may exceed the
+    length of the vector (see 'Reserve'), so that elements can be appended
+    without a reallocation each time.
   */
   template <class T, class Allocator>
   class Vector<T, VectFull, Allocator>: public Vector_Base<T, Allocator>
@@ -101,7 +103,9 @@ namespace Seldon
     typedef VectFull storage;
 
     // Attributes.
-  private:
+  protected:
+    // Number of elements that can be stored without reallocation.
+    int capacity_;
 
     // Methods.
   public:
@@ -110,6 +114,13 @@ namespace Seldon
     explicit Vector(int i);
     Vector(int i, pointer data);
     Vector(const Vector<T, VectFull, Allocator>& A);
+#ifndef SWIG
+    template <class E>
+    Vector(const VectorExpression<E>& X);
+#endif
+#ifdef SELDON_WITH_CXX11
+    Vector(Vector<T, VectFull, Allocator>&& A) noexcept;
+#endif
 
     // Destructor.
     ~Vector();
@@ -118,10 +129,13 @@ namespace Seldon
     // Memory management.
     void Reallocate(int i);
     void Resize(int i);
+    void Reserve(int n);
+    void ShrinkToFit();
     void SetData(int i, pointer data);
     template <class Allocator0>
     void SetData(const Vector<T, VectFull, Allocator0>& V);
     void Nullify();
+    void Swap(Vector<T, VectFull, Allocator>& X);
 
     // Element access and affectation.
     reference operator() (int i);
@@ -131,6 +145,12 @@ namespace Seldon
     const_reference Get(int i) const;
     Vector<T, VectFull, Allocator>& operator= (const Vector<T, VectFull,
 					       Allocator>& X);
+#ifdef SELDON_WITH_CXX11
+    Vector<T, VectFull, Allocator>& operator= (Vector<T, VectFull,
+					       Allocator>&& X) noexcept;
+#endif
+    template <class E>
+    Vector<T, VectFull, Allocator>& operator= (const VectorExpression<E>& X);
 #endif
     void Copy(const Vector<T, VectFull, Allocator>& X);
     Vector<T, VectFull, Allocator> Copy() const;
@@ -142,6 +162,7 @@ namespace Seldon
 
     // Basic functions.
     int GetDataSize();
+    int GetCapacity() const;
 
     // Convenient functions.
     void Zero();
@@ -429,6 +429,18 @@ namespace Seldon
   }
 
 
+  //! Swaps the vector with another vector of vectors.
+  /*! No element is copied: only the inner vectors are exchanged.
+    \param[in,out] V vector to be swapped with the current instance.
+  */
+  template <class T, class Allocator0, class Allocator1>
+  void Vector2<T, Allocator0, Allocator1>
+  ::Swap(Vector2<T, Allocator0, Allocator1>& V)
+  {
+    data_.Swap(V.data_);
+  }
+
+
   //! Fills the vector with a given value.
   /*!
     \param[in] x value to fill the vector with.
@@ -76,6 +76,14 @@ namespace Seldon
     Vector2();
     Vector2(int length);
     Vector2(const Vector<int>& length);
+#ifdef SELDON_WITH_CXX11
+    Vector2(const Vector2<T, Allocator0, Allocator1>& V) = default;
+    Vector2(Vector2<T, Allocator0, Allocator1>&& V) = default;
+    Vector2<T, Allocator0, Allocator1>&
+    operator= (const Vector2<T, Allocator0, Allocator1>& V) = default;
+    Vector2<T, Allocator0, Allocator1>&
+    operator= (Vector2<T, Allocator0, Allocator1>&& V) = default;
+#endif
     ~Vector2();
 
     /*** Management of the vectors ***/
@@ -110,6 +118,7 @@ namespace Seldon
 
     void Clear();
     void Clear(int i);
+    void Swap(Vector2<T, Allocator0, Allocator1>& V);
 
     void Fill(const T& x);
 
@@ -91,6 +91,17 @@ namespace Seldon
     Vector3(Vector<int>& length);
     template <class Allocator>
     Vector3(Vector<Vector<int>, Vect_Full, Allocator>& length);
+#ifdef SELDON_WITH_CXX11
+    Vector3(const Vector3<T, Allocator0, Allocator1, Allocator2>& V)
+      = default;
+    Vector3(Vector3<T, Allocator0, Allocator1, Allocator2>&& V) = default;
+    Vector3<T, Allocator0, Allocator1, Allocator2>&
+    operator= (const Vector3<T, Allocator0, Allocator1, Allocator2>& V)
+      = default;
+    Vector3<T, Allocator0, Allocator1, Allocator2>&
+    operator= (Vector3<T, Allocator0, Allocator1, Allocator2>&& V)
+      = default;
+#endif
     ~Vector3();
 
     /*** Management of the vectors ***/
@@ -131,6 +142,7 @@ namespace Seldon
     void Clear();
     void Clear(int i);
     void Clear(int i, int j);
+    void Swap(Vector3<T, Allocator0, Allocator1, Allocator2>& V);
 
     void Fill(const T& x);
 
@@ -78,6 +78,21 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Move constructor.
+  /*! The inner vectors of \a V are taken over, without any copy.
+    \param[in,out] V vector collection to be moved. On exit, it is empty.
+  */
+  template <class T, class Allocator>
+  Vector<T, Collection, Allocator>::
+  Vector(Vector<T, Collection, Allocator>&& V) noexcept:
+    Vector_Base<T, Allocator>(), Nvector_(0)
+  {
+    Swap(V);
+  }
+#endif
+
+
   /**************
    * DESTRUCTOR *
    **************/
@@ -321,6 +336,26 @@ namespace Seldon
   }
 
 
+  //! Swaps the current vector collection with another vector collection.
+  /*! No element is copied: only the inner vectors, their lengths and their
+    names are exchanged.
+    \param[in,out] X vector collection to be swapped with the current
+    instance.
+  */
+  template <class T, class Allocator>
+  void Vector<T, Collection, Allocator>
+  ::Swap(Vector<T, Collection, Allocator>& X)
+  {
+    swap(this->m_, X.m_);
+    swap(Nvector_, X.Nvector_);
+    length_.Swap(X.length_);
+    length_sum_.Swap(X.length_sum_);
+    vector_.Swap(X.vector_);
+    label_map_.swap(X.label_map_);
+    label_vector_.swap(X.label_vector_);
+  }
+
+
   /*****************
    * BASIC METHODS *
    *****************/
@@ -575,6 +610,23 @@ namespace Seldon
   }
 
 
+#ifdef SELDON_WITH_CXX11
+  //! Takes over the inner vectors of a collection (move assignment operator).
+  /*!
+    \param[in,out] X vector collection to be moved. No element is copied:
+    the inner vectors of \a X and of the current instance are exchanged.
+  */
+  template <class T, class Allocator >
+  inline Vector<T, Collection, Allocator>&
+  Vector<T, Collection, Allocator>::operator=
+  (Vector<T, Collection, Allocator>&& X) noexcept
+  {
+    Swap(X);
+    return *this;
+  }
+#endif
+
+
   //! Duplicates a vector collection.
   /*!
     \param[in] X vector collection to be copied.
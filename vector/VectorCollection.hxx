@@ -81,6 +81,9 @@ namespace Seldon
     explicit Vector();
     explicit Vector(int i);
     Vector(const Vector<T, Collection, Allocator>& A);
+#ifdef SELDON_WITH_CXX11
+    Vector(Vector<T, Collection, Allocator>&& A) noexcept;
+#endif
 
     // Destructor.
     ~Vector();
@@ -108,6 +111,7 @@ namespace Seldon
 
     void SetData(const Vector<T, Collection, Allocator>& X);
     void Nullify();
+    void Swap(Vector<T, Collection, Allocator>& X);
 
     // Basic methods.
     int GetM() const;
@@ -132,6 +136,10 @@ namespace Seldon
     reference operator() (int i);
     Vector<T, Collection, Allocator>& operator=
     (const Vector<T, Collection, Allocator>& X);
+#ifdef SELDON_WITH_CXX11
+    Vector<T, Collection, Allocator>& operator=
+    (Vector<T, Collection, Allocator>&& X) noexcept;
+#endif
 
     void Copy(const Vector<T, Collection, Allocator>& X);
     template <class T0, class Allocator0>
@@ -0,0 +1,428 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+#ifndef SELDON_FILE_VECTOR_EXPRESSION_CXX
+
+#include "VectorExpression.hxx"
+
+namespace Seldon
+{
+
+
+  //////////////////////
+  // VECTOREXPRESSION //
+  //////////////////////
+
+
+  //! Main constructor.
+  /*!
+    \param[in] expression operation described by the expression.
+  */
+  template <class E>
+  inline VectorExpression<E>::VectorExpression(const E& expression):
+    expression_(expression)
+  {
+  }
+
+
+  //! Returns the length of the vector described by the expression.
+  template <class E>
+  inline int VectorExpression<E>::GetM() const
+  {
+    return expression_.GetM();
+  }
+
+
+  //! Returns the length of the vector described by the expression.
+  template <class E>
+  inline int VectorExpression<E>::GetLength() const
+  {
+    return expression_.GetM();
+  }
+
+
+  //! Returns the operation described by the expression.
+  template <class E>
+  inline const E& VectorExpression<E>::GetExpression() const
+  {
+    return expression_;
+  }
+
+
+  //! Computes an entry of the expression.
+  /*!
+    \param[in] i index.
+    \return The entry \a i of the vector described by the expression.
+  */
+  template <class E>
+  inline typename VectorExpression<E>::value_type
+  VectorExpression<E>::operator() (int i) const
+  {
+    return expression_(i);
+  }
+
+
+  ///////////
+  // NODES //
+  ///////////
+
+
+  //! Refers to the entries of \a X.
+  template <class T> template <class Allocator>
+  inline VectorExpressionLeaf<T>
+  ::VectorExpressionLeaf(const Vector<T, VectFull, Allocator>& X):
+    data_(X.GetData()), m_(X.GetM())
+  {
+  }
+
+
+  template <class T>
+  inline int VectorExpressionLeaf<T>::GetM() const
+  {
+    return m_;
+  }
+
+
+  template <class T>
+  inline const T& VectorExpressionLeaf<T>::operator() (int i) const
+  {
+    return data_[i];
+  }
+
+
+  template <class E1, class E2>
+  inline VectorExpressionSum<E1, E2>::VectorExpressionSum(const E1& e1,
+                                                          const E2& e2):
+    e1_(e1), e2_(e2)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (e1.GetM() != e2.GetM())
+      throw WrongDim("operator+(X, Y)",
+                     "X is a vector of length " + to_str(e1.GetM())
+                     + " and Y is a vector of length " + to_str(e2.GetM())
+                     + ".");
+#endif
+  }
+
+
+  template <class E1, class E2>
+  inline int VectorExpressionSum<E1, E2>::GetM() const
+  {
+    return e1_.GetM();
+  }
+
+
+  template <class E1, class E2>
+  inline typename VectorExpressionSum<E1, E2>::value_type
+  VectorExpressionSum<E1, E2>::operator() (int i) const
+  {
+    return e1_(i) + e2_(i);
+  }
+
+
+  template <class E1, class E2>
+  inline VectorExpressionDifference<E1, E2>
+  ::VectorExpressionDifference(const E1& e1, const E2& e2):
+    e1_(e1), e2_(e2)
+  {
+#ifdef SELDON_CHECK_DIMENSIONS
+    if (e1.GetM() != e2.GetM())
+      throw WrongDim("operator-(X, Y)",
+                     "X is a vector of length " + to_str(e1.GetM())
+                     + " and Y is a vector of length " + to_str(e2.GetM())
+                     + ".");
+#endif
+  }
+
+
+  template <class E1, class E2>
+  inline int VectorExpressionDifference<E1, E2>::GetM() const
+  {
+    return e1_.GetM();
+  }
+
+
+  template <class E1, class E2>
+  inline typename VectorExpressionDifference<E1, E2>::value_type
+  VectorExpressionDifference<E1, E2>::operator() (int i) const
+  {
+    return e1_(i) - e2_(i);
+  }
+
+
+  template <class E>
+  inline VectorExpressionOpposite<E>::VectorExpressionOpposite(const E& e):
+    e_(e)
+  {
+  }
+
+
+  template <class E>
+  inline int VectorExpressionOpposite<E>::GetM() const
+  {
+    return e_.GetM();
+  }
+
+
+  template <class E>
+  inline typename VectorExpressionOpposite<E>::value_type
+  VectorExpressionOpposite<E>::operator() (int i) const
+  {
+    return -e_(i);
+  }
+
+
+  template <class E>
+  inline VectorExpressionScaled<E>
+  ::VectorExpressionScaled(const value_type& alpha, const E& e):
+    alpha_(alpha), e_(e)
+  {
+  }
+
+
+  template <class E>
+  inline int VectorExpressionScaled<E>::GetM() const
+  {
+    return e_.GetM();
+  }
+
+
+  template <class E>
+  inline typename VectorExpressionScaled<E>::value_type
+  VectorExpressionScaled<E>::operator() (int i) const
+  {
+    return alpha_ * e_(i);
+  }
+
+
+  ///////////////
+  // OPERATORS //
+  ///////////////
+
+
+  //! Returns the expression X + Y.
+  template <class T1, class Allocator1, class T2, class Allocator2>
+  inline VectorExpression<VectorExpressionSum<VectorExpressionLeaf<T1>,
+                                              VectorExpressionLeaf<T2> > >
+  operator+ (const Vector<T1, VectFull, Allocator1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y)
+  {
+    typedef VectorExpressionSum<VectorExpressionLeaf<T1>,
+                                VectorExpressionLeaf<T2> > E;
+    return VectorExpression<E>(E(VectorExpressionLeaf<T1>(X),
+                                 VectorExpressionLeaf<T2>(Y)));
+  }
+
+
+  //! Returns the expression X + Y.
+  template <class T1, class Allocator1, class E2>
+  inline VectorExpression<VectorExpressionSum<VectorExpressionLeaf<T1>, E2> >
+  operator+ (const Vector<T1, VectFull, Allocator1>& X,
+             const VectorExpression<E2>& Y)
+  {
+    typedef VectorExpressionSum<VectorExpressionLeaf<T1>, E2> E;
+    return VectorExpression<E>(E(VectorExpressionLeaf<T1>(X),
+                                 Y.GetExpression()));
+  }
+
+
+  //! Returns the expression X + Y.
+  template <class E1, class T2, class Allocator2>
+  inline VectorExpression<VectorExpressionSum<E1, VectorExpressionLeaf<T2> > >
+  operator+ (const VectorExpression<E1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y)
+  {
+    typedef VectorExpressionSum<E1, VectorExpressionLeaf<T2> > E;
+    return VectorExpression<E>(E(X.GetExpression(),
+                                 VectorExpressionLeaf<T2>(Y)));
+  }
+
+
+  //! Returns the expression X + Y.
+  template <class E1, class E2>
+  inline VectorExpression<VectorExpressionSum<E1, E2> >
+  operator+ (const VectorExpression<E1>& X, const VectorExpression<E2>& Y)
+  {
+    typedef VectorExpressionSum<E1, E2> E;
+    return VectorExpression<E>(E(X.GetExpression(), Y.GetExpression()));
+  }
+
+
+  //! Returns the expression X - Y.
+  template <class T1, class Allocator1, class T2, class Allocator2>
+  inline
+  VectorExpression<VectorExpressionDifference<VectorExpressionLeaf<T1>,
+                                              VectorExpressionLeaf<T2> > >
+  operator- (const Vector<T1, VectFull, Allocator1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y)
+  {
+    typedef VectorExpressionDifference<VectorExpressionLeaf<T1>,
+                                       VectorExpressionLeaf<T2> > E;
+    return VectorExpression<E>(E(VectorExpressionLeaf<T1>(X),
+                                 VectorExpressionLeaf<T2>(Y)));
+  }
+
+
+  //! Returns the expression X - Y.
+  template <class T1, class Allocator1, class E2>
+  inline
+  VectorExpression<VectorExpressionDifference<VectorExpressionLeaf<T1>, E2> >
+  operator- (const Vector<T1, VectFull, Allocator1>& X,
+             const VectorExpression<E2>& Y)
+  {
+    typedef VectorExpressionDifference<VectorExpressionLeaf<T1>, E2> E;
+    return VectorExpression<E>(E(VectorExpressionLeaf<T1>(X),
+                                 Y.GetExpression()));
+  }
+
+
+  //! Returns the expression X - Y.
+  template <class E1, class T2, class Allocator2>
+  inline
+  VectorExpression<VectorExpressionDifference<E1, VectorExpressionLeaf<T2> > >
+  operator- (const VectorExpression<E1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y)
+  {
+    typedef VectorExpressionDifference<E1, VectorExpressionLeaf<T2> > E;
+    return VectorExpression<E>(E(X.GetExpression(),
+                                 VectorExpressionLeaf<T2>(Y)));
+  }
+
+
+  //! Returns the expression X - Y.
+  template <class E1, class E2>
+  inline VectorExpression<VectorExpressionDifference<E1, E2> >
+  operator- (const VectorExpression<E1>& X, const VectorExpression<E2>& Y)
+  {
+    typedef VectorExpressionDifference<E1, E2> E;
+    return VectorExpression<E>(E(X.GetExpression(), Y.GetExpression()));
+  }
+
+
+  //! Returns the expression -X.
+  template <class T, class Allocator>
+  inline VectorExpression<VectorExpressionOpposite<VectorExpressionLeaf<T> > >
+  operator- (const Vector<T, VectFull, Allocator>& X)
+  {
+    typedef VectorExpressionOpposite<VectorExpressionLeaf<T> > E;
+    return VectorExpression<E>(E(VectorExpressionLeaf<T>(X)));
+  }
+
+
+  //! Returns the expression -X.
+  template <class E>
+  inline VectorExpression<VectorExpressionOpposite<E> >
+  operator- (const VectorExpression<E>& X)
+  {
+    return VectorExpression<VectorExpressionOpposite<E> >
+      (VectorExpressionOpposite<E>(X.GetExpression()));
+  }
+
+
+  //! Returns the expression alpha X.
+  /*!
+    \a alpha is converted to the type of the entries of \a X.
+  */
+  template <class T0, class T, class Allocator>
+  inline VectorExpression<VectorExpressionScaled<VectorExpressionLeaf<T> > >
+  operator* (const T0& alpha, const Vector<T, VectFull, Allocator>& X)
+  {
+    typedef VectorExpressionScaled<VectorExpressionLeaf<T> > E;
+    return VectorExpression<E>(E(T(alpha), VectorExpressionLeaf<T>(X)));
+  }
+
+
+  //! Returns the expression alpha X.
+  /*!
+    \a alpha is converted to the type of the entries of \a X.
+  */
+  template <class T0, class E>
+  inline VectorExpression<VectorExpressionScaled<E> >
+  operator* (const T0& alpha, const VectorExpression<E>& X)
+  {
+    typedef typename E::value_type T;
+    return VectorExpression<VectorExpressionScaled<E> >
+      (VectorExpressionScaled<E>(T(alpha), X.GetExpression()));
+  }
+
+
+  //! Returns the expression X alpha.
+  /*!
+    \a alpha is converted to the type of the entries of \a X.
+  */
+  template <class T, class Allocator, class T0>
+  inline VectorExpression<VectorExpressionScaled<VectorExpressionLeaf<T> > >
+  operator* (const Vector<T, VectFull, Allocator>& X, const T0& alpha)
+  {
+    return alpha * X;
+  }
+
+
+  //! Returns the expression X alpha.
+  /*!
+    \a alpha is converted to the type of the entries of \a X.
+  */
+  template <class E, class T0>
+  inline VectorExpression<VectorExpressionScaled<E> >
+  operator* (const VectorExpression<E>& X, const T0& alpha)
+  {
+    return alpha * X;
+  }
+
+
+  ////////////////
+  // EVALUATION //
+  ////////////////
+
+
+  //! Evaluates an expression.
+  /*!
+    The entries of \a Y are computed in a single loop over the operands of
+    \a X. The loop is split among the threads if the vectors are long
+    enough. \a Y may be an operand of \a X, e.g. in Y = 2 * Y - X.
+    \param[in] X expression.
+    \param[out] Y vector that contains the result on exit. It is reallocated
+    if its length is not the length of \a X.
+  */
+  template <class E, class T, class Allocator>
+  void Copy(const VectorExpression<E>& X, Vector<T, VectFull, Allocator>& Y)
+  {
+    int m = X.GetM();
+    Y.Reallocate(m);
+
+    const E& expression = X.GetExpression();
+    T* y = Y.GetData();
+
+#ifdef SELDON_WITH_OPENMP
+    int nb_thread = GetNumberThreads(long(m));
+#pragma omp parallel num_threads(nb_thread) if(nb_thread > 1)
+#endif
+    {
+      int begin, end;
+      GetThreadRange(m, begin, end);
+      for (int i = begin; i < end; i++)
+        y[i] = expression(i);
+    }
+  }
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_VECTOR_EXPRESSION_CXX
+#endif
@@ -0,0 +1,218 @@
+// Copyright (C) 2001-2009 Vivien Mallet
+//
+// This file is part of the linear-algebra library Seldon,
+// http://seldon.sourceforge.net/.
+//
+// Seldon is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License as published by the Free
+// Software Foundation; either version 2.1 of the License, or (at your option)
+// any later version.
+//
+// Seldon is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+// FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License for
+// more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with Seldon. If not, see http://www.gnu.org/licenses/.
+
+
+// To be included by Seldon.hxx
+
+#ifndef SELDON_FILE_VECTOR_EXPRESSION_HXX
+
+namespace Seldon
+{
+
+
+  //! Expression on full vectors, evaluated lazily.
+  /*!
+    The arithmetic operators on full vectors (X + Y, X - Y, -X, alpha * X
+    and X * alpha) do not compute anything: they return an expression which
+    stores the operands, and the entries are only computed when the
+    expression is assigned to a vector. An expression such as
+    Y = a * X + b * Z - W is thus evaluated in a single loop, without any
+    temporary vector. The class \a E describes the operation; it provides
+    GetM() and operator() (int i), which returns the entry i of the result.
+    \warning The operands are referenced, not copied, so that an expression
+    must be evaluated before its operands are modified or destroyed.
+  */
+  template <class E>
+  class VectorExpression
+  {
+    // typedef declaration.
+  public:
+    typedef typename E::value_type value_type;
+
+    // Attributes.
+  protected:
+    E expression_;
+
+    // Methods.
+  public:
+    explicit VectorExpression(const E& expression);
+
+    int GetM() const;
+    int GetLength() const;
+    const E& GetExpression() const;
+    value_type operator() (int i) const;
+  };
+
+
+  //! Full vector as an operand of an expression.
+  template <class T>
+  class VectorExpressionLeaf
+  {
+  public:
+    typedef T value_type;
+
+  protected:
+    const T* data_;
+    int m_;
+
+  public:
+    template <class Allocator>
+    explicit VectorExpressionLeaf(const Vector<T, VectFull, Allocator>& X);
+
+    int GetM() const;
+    const T& operator() (int i) const;
+  };
+
+
+  //! Sum of two expressions.
+  template <class E1, class E2>
+  class VectorExpressionSum
+  {
+  public:
+    typedef typename E1::value_type value_type;
+
+  protected:
+    E1 e1_;
+    E2 e2_;
+
+  public:
+    VectorExpressionSum(const E1& e1, const E2& e2);
+
+    int GetM() const;
+    value_type operator() (int i) const;
+  };
+
+
+  //! Difference of two expressions.
+  template <class E1, class E2>
+  class VectorExpressionDifference
+  {
+  public:
+    typedef typename E1::value_type value_type;
+
+  protected:
+    E1 e1_;
+    E2 e2_;
+
+  public:
+    VectorExpressionDifference(const E1& e1, const E2& e2);
+
+    int GetM() const;
+    value_type operator() (int i) const;
+  };
+
+
+  //! Opposite of an expression.
+  template <class E>
+  class VectorExpressionOpposite
+  {
+  public:
+    typedef typename E::value_type value_type;
+
+  protected:
+    E e_;
+
+  public:
+    explicit VectorExpressionOpposite(const E& e);
+
+    int GetM() const;
+    value_type operator() (int i) const;
+  };
+
+
+  //! Product of an expression by a scalar.
+  template <class E>
+  class VectorExpressionScaled
+  {
+  public:
+    typedef typename E::value_type value_type;
+
+  protected:
+    value_type alpha_;
+    E e_;
+
+  public:
+    VectorExpressionScaled(const value_type& alpha, const E& e);
+
+    int GetM() const;
+    value_type operator() (int i) const;
+  };
+
+
+  template <class T1, class Allocator1, class T2, class Allocator2>
+  VectorExpression<VectorExpressionSum<VectorExpressionLeaf<T1>,
+                                       VectorExpressionLeaf<T2> > >
+  operator+ (const Vector<T1, VectFull, Allocator1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y);
+  template <class T1, class Allocator1, class E2>
+  VectorExpression<VectorExpressionSum<VectorExpressionLeaf<T1>, E2> >
+  operator+ (const Vector<T1, VectFull, Allocator1>& X,
+             const VectorExpression<E2>& Y);
+  template <class E1, class T2, class Allocator2>
+  VectorExpression<VectorExpressionSum<E1, VectorExpressionLeaf<T2> > >
+  operator+ (const VectorExpression<E1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y);
+  template <class E1, class E2>
+  VectorExpression<VectorExpressionSum<E1, E2> >
+  operator+ (const VectorExpression<E1>& X, const VectorExpression<E2>& Y);
+
+  template <class T1, class Allocator1, class T2, class Allocator2>
+  VectorExpression<VectorExpressionDifference<VectorExpressionLeaf<T1>,
+                                              VectorExpressionLeaf<T2> > >
+  operator- (const Vector<T1, VectFull, Allocator1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y);
+  template <class T1, class Allocator1, class E2>
+  VectorExpression<VectorExpressionDifference<VectorExpressionLeaf<T1>, E2> >
+  operator- (const Vector<T1, VectFull, Allocator1>& X,
+             const VectorExpression<E2>& Y);
+  template <class E1, class T2, class Allocator2>
+  VectorExpression<VectorExpressionDifference<E1, VectorExpressionLeaf<T2> > >
+  operator- (const VectorExpression<E1>& X,
+             const Vector<T2, VectFull, Allocator2>& Y);
+  template <class E1, class E2>
+  VectorExpression<VectorExpressionDifference<E1, E2> >
+  operator- (const VectorExpression<E1>& X, const VectorExpression<E2>& Y);
+
+  template <class T, class Allocator>
+  VectorExpression<VectorExpressionOpposite<VectorExpressionLeaf<T> > >
+  operator- (const Vector<T, VectFull, Allocator>& X);
+  template <class E>
+  VectorExpression<VectorExpressionOpposite<E> >
+  operator- (const VectorExpression<E>& X);
+
+  template <class T0, class T, class Allocator>
+  VectorExpression<VectorExpressionScaled<VectorExpressionLeaf<T> > >
+  operator* (const T0& alpha, const Vector<T, VectFull, Allocator>& X);
+  template <class T0, class E>
+  VectorExpression<VectorExpressionScaled<E> >
+  operator* (const T0& alpha, const VectorExpression<E>& X);
+  template <class T, class Allocator, class T0>
+  VectorExpression<VectorExpressionScaled<VectorExpressionLeaf<T> > >
+  operator* (const Vector<T, VectFull, Allocator>& X, const T0& alpha);
+  template <class E, class T0>
+  VectorExpression<VectorExpressionScaled<E> >
+  operator* (const VectorExpression<E>& X, const T0& alpha);
+
+  template <class E, class T, class Allocator>
+  void Copy(const VectorExpression<E>& X, Vector<T, VectFull, Allocator>& Y);
+
+
+} // namespace Seldon.
+
+#define SELDON_FILE_VECTOR_EXPRESSION_HXX
+#endif